@@ -0,0 +1,1219 @@
+/*------------------------------------------------------------------------------
+* CrxUtil.cpp : in-process conversion of Compact RINEX (Hatanaka compression)
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) Group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader)
+*
+* References:
+*    Hatanaka Y (2008) A compression format and tools for GNSS observation data. Bulletin of the
+*        Geographical Survey Institute, 55: 21-30
+*    RNXCMP - Compact RINEX format and tools, https://terras.gsi.go.jp/ja/crx2rnx.html
+*
+* history : 2026/10/16 1.0  new, replacing the 'crx2rnx' process spawned for each file
+*           2026/10/16 1.1  convert each file by its own decoder for the sites downloaded in parallel
+*           2026/10/16 1.2  restore the data of all the types of the satellite at once from the arrays of
+*                           the differences, and format the fields two digits at a time
+*           2026/10/16 1.3  chain the compression to the indexed gzip file cut at the hours of the epochs
+*           2026/10/16 1.4  append the RINEX lines to the memory for the reader of the kept files
+*           2026/10/16 1.5  add the encoder of Compact RINEX for the RINEX files produced locally
+*           2026/10/16 1.6  write the converted file to '*.part' first, so the killed run leaves no half file
+*           2026/10/16 1.7  no SIMD kernel, which is no faster than the scalar loop vectorized by the compiler
+*                           ('make bench')
+*-----------------------------------------------------------------------------*/
+#include "Good.h"
+#include "ZipUtil.h"
+#include "CrxUtil.h"
+#include "RnxReader.h"
+#include "ThreadUtil.h"
+
+
+/* constants/macros ----------------------------------------------------------*/
+#define CHUNK           65536     /* size of the buffer of the file read */
+#define CRX_ORDER       3         /* order of the difference of the arcs encoded, the same as 'rnx2crx' */
+#define PARTSUFFIX      ".part"   /* suffix of the file being written */
+
+#define CRX_HEAD1       0         /* the 1st line of the header, "CRINEX VERS   / TYPE" */
+#define CRX_HEAD2       1         /* the 2nd line of the header, "CRINEX PROG / DATE" */
+#define CRX_HEADER      2         /* the header of the original RINEX */
+#define CRX_EPOCH       3         /* the epoch line */
+#define CRX_CLOCK       4         /* the line of the receiver clock offset */
+#define CRX_DATA        5         /* the data line of each satellite */
+#define CRX_EVENT       6         /* the lines following the special event */
+#define CRX_ERROR       7         /* the data are not valid */
+
+
+/* function definition -------------------------------------------------------*/
+
+/* check if the line has the header label */
+static bool IsLabel(const char *p, size_t n, const char *label)
+{
+    size_t len = strlen(label);
+
+    return n >= 60 + len && memcmp(p + 60, label, len) == 0;
+}
+
+/* get the integer in the columns of the line, 0 if the line is shorter */
+static int GetInt(const string &s, size_t pos, size_t len)
+{
+    if (pos >= s.size()) return 0;
+
+    return atoi(s.substr(pos, len).c_str());
+}
+
+/* parse the signed integer of the whole field */
+static bool ParseInt(const char *p, size_t n, long long &v)
+{
+    size_t i = 0;
+    bool neg = false;
+    if (i < n && (p[i] == '-' || p[i] == '+')) neg = p[i++] == '-';
+    if (i == n || n - i > 18) return false;
+
+    v = 0;
+    for (; i < n; i++)
+    {
+        if (p[i] < '0' || p[i] > '9') return false;
+        v = v * 10 + (p[i] - '0');
+    }
+    if (neg) v = -v;
+
+    return true;
+}
+
+/* repair the text from its difference, i.e., ' ': not changed, '&': changed to blank */
+static void Repair(string &s, const char *ds, size_t n)
+{
+    size_t i = 0;
+    for (; i < n && i < s.size(); i++)
+    {
+        if (ds[i] == ' ') continue;
+        s[i] = ds[i] == '&' ? ' ' : ds[i];
+    }
+    for (; i < n; i++) s.push_back(ds[i] == '&' ? ' ' : ds[i]);
+}
+
+/* parse the field, "<order>&<data>" for the start of the arc ('order' >= 0), or "<difference>" ('order' = -1) */
+static bool ParseField(const char *p, size_t n, int &order, long long &v)
+{
+    const char *amp = (const char *)memchr(p, '&', n);
+    if (!amp)
+    {
+        order = -1;
+
+        return ParseInt(p, n, v);
+    }
+    if (amp - p != 1 || *p < '0' || *p > '0' + CRX_MAXORDER) return false;
+    order = *p - '0';
+
+    return ParseInt(amp + 1, p + n - amp - 1, v);
+}
+
+/* parse the fixed-point field with 'dec' decimals to the integer, i.e., "-.005" to -5 for F14.3, false if
+   it is not a number or has more decimals */
+static bool ParseFixed(const char *p, size_t n, int dec, long long &v)
+{
+    while (n > 0 && p[0] == ' ')
+    {
+        p++;
+        n--;
+    }
+    while (n > 0 && p[n - 1] == ' ') n--;
+    size_t i = 0;
+    bool neg = false;
+    if (i < n && (p[i] == '-' || p[i] == '+')) neg = p[i++] == '-';
+
+    v = 0;
+    int ndigit = 0, ndec = -1;
+    for (; i < n; i++)
+    {
+        if (p[i] == '.' && ndec < 0) ndec = 0;
+        else if (p[i] >= '0' && p[i] <= '9')
+        {
+            v = v * 10 + (p[i] - '0');
+            ndigit++;
+            if (ndec >= 0) ndec++;
+        }
+        else return false;
+    }
+    if (ndec < 0) ndec = 0;
+    if (ndigit == 0 || ndec > dec || ndigit + dec - ndec > 18) return false;
+    for (; ndec < dec; ndec++) v *= 10;
+    if (neg) v = -v;
+
+    return true;
+}
+
+/* get the difference of the text from the previous one, i.e., ' ': not changed, '&': changed to blank,
+   and update the previous text as Repair does */
+static void Difference(const string &s, string &prev, string &ds)
+{
+    size_t n = s.size() > prev.size() ? s.size() : prev.size();
+    ds.assign(n, ' ');
+    for (size_t i = 0; i < n; i++)
+    {
+        char c = i < s.size() ? s[i] : ' ', o = i < prev.size() ? prev[i] : ' ';
+        if (c != o) ds[i] = c == ' ' ? '&' : c;
+    }
+    while (!ds.empty() && ds.back() == ' ') ds.pop_back();
+    Repair(prev, ds.data(), ds.size());
+}
+
+/* get the difference of the data in the arc, 'y[k * stride]' for order 'k', and update the arc as
+   Accumulate does, so 'y[0]' is the data */
+static long long Difference(long long x, long long *y, size_t stride, int &order, int arcOrder)
+{
+    if (order < arcOrder) order++;
+    long long v = x;
+    for (int k = 0; k < order; k++) v -= y[k * stride];
+    y[order * stride] = v;
+    for (int k = order; k > 0; k--) y[(k - 1) * stride] += y[k * stride];
+
+    return v;
+}
+
+/* get the Compact RINEX file of the RINEX file, '*.yyo' to '*.yyd' and '*.rnx' to '*.crx' (empty: not RINEX) */
+static string CrxName(const string &rnxFile, bool gzip)
+{
+    ZipUtil zip;
+    int fmt = zip.Format(rnxFile);
+    size_t len = rnxFile.size() - (fmt == ZIP_GZIP ? 3 : (fmt == ZIP_LZW ? 2 : 0));
+    string name = rnxFile.substr(0, len);
+    if (len > 4 && (name.compare(len - 4, 4, ".rnx") == 0 || name.compare(len - 4, 4, ".RNX") == 0))
+        name = name.substr(0, len - 3) + (name[len - 1] == 'x' ? "crx" : "CRX");
+    else if (len > 4 && name[len - 4] == '.' && isdigit((unsigned char)name[len - 3]) &&
+        isdigit((unsigned char)name[len - 2]) && (name[len - 1] == 'o' || name[len - 1] == 'O'))
+        name = name.substr(0, len - 1) + (name[len - 1] == 'o' ? "d" : "D");
+    else return "";
+
+    return gzip ? name + ".gz" : name;
+}
+
+/* format the integer with 'dec' implied decimals right-justified in 'width' columns without the
+   leading zero as 'crx2rnx' does, i.e., "-.005", false if it does not fit; the digits are
+   converted in pairs, which halves the divisions of the fields of F14.3 */
+static bool PutValue(long long v, int dec, int width, char *out)
+{
+    static const char digits[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+    char tmp[32];
+    int k = 0, i = 0;
+    unsigned long long a = v < 0 ? 0ULL - (unsigned long long)v : (unsigned long long)v;
+    for (; i + 2 <= dec; i += 2, a /= 100)
+    {
+        int r = (int)(a % 100);
+        tmp[k++] = digits[2 * r + 1];
+        tmp[k++] = digits[2 * r];
+    }
+    if (i < dec)
+    {
+        tmp[k++] = (char)('0' + a % 10);
+        a /= 10;
+    }
+    tmp[k++] = '.';
+    for (; a >= 10; a /= 100)
+    {
+        int r = (int)(a % 100);
+        tmp[k++] = digits[2 * r + 1];
+        tmp[k++] = digits[2 * r];
+    }
+    if (a > 0) tmp[k++] = (char)('0' + a);
+    if (v < 0) tmp[k++] = '-';
+    if (k > width) return false;
+
+    memset(out, ' ', width - k);
+    for (int j = 0; j < k; j++) out[width - 1 - j] = tmp[j];
+
+    return true;
+}
+
+/* restore the data of 'n' types from their differences up to 'order', 'y[k * n + j]' for order 'k' of type
+   'j'; the differences above the order of each type are zero, so all the types are summed in the same way */
+static void Accum(long long *y, int n, int order)
+{
+    for (int k = order; k > 0; k--)
+    {
+        long long *lo = y + (k - 1) * n, *hi = y + k * n;
+        for (int j = 0; j < n; j++) lo[j] += hi[j];
+    }
+}
+
+/**
+* @brief   : PutLine - append the line to the RINEX lines without the trailing blanks
+* @param[I]: s (line)
+* @param[I]: n (number of characters of 's')
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void CrxUtil::PutLine(const char *s, size_t n)
+{
+    while (n > 0 && s[n - 1] == ' ') n--;
+    _out.append(s, n);
+    _out.push_back('\n');
+} /* end of PutLine */
+
+/**
+* @brief   : Write - write the RINEX lines to the file
+* @param[I]: fp (file the RINEX lines are written to)
+* @param[O]: none
+* @return  : true: OK, false: the file failed to be written
+* @note    : the lines are compressed, and the gzip members are cut at the first epoch of each hour
+*            if the compression is chained by SetGzip
+**/
+bool CrxUtil::Write(FILE *fp)
+{
+    if (_mem)
+    {
+        _mem->append(_out);
+        _cutPos.clear();
+        _cutKey.clear();
+
+        return true;
+    }
+    if (!_gz) return _out.empty() || fwrite(_out.data(), 1, _out.size(), fp) == _out.size();
+
+    bool ok = true;
+    size_t pos = 0;
+    for (size_t i = 0; i < _cutPos.size() && ok; i++)
+    {
+        ok = _gz->Deflate(_out.data() + pos, _cutPos[i] - pos, fp) && _gz->Cut(_cutKey[i], fp);
+        pos = _cutPos[i];
+    }
+    _cutPos.clear();
+    _cutKey.clear();
+
+    return ok && _gz->Deflate(_out.data() + pos, _out.size() - pos, fp);
+} /* end of Write */
+
+/**
+* @brief   : Accumulate - restore the data from the differenced field
+* @param[I]: p (field, "<order>&<data>" for the start of the arc, or "<difference>")
+* @param[I]: n (number of characters of 'p')
+* @param[I/O]: arc (arc of the data)
+* @return  : true: OK, false: the field is not valid or the arc is not initialized
+* @note    :
+**/
+bool CrxUtil::Accumulate(const char *p, size_t n, arc_t &arc)
+{
+    int order;
+    long long v;
+    if (!ParseField(p, n, order, v))
+    {
+        _msg = "the field '" + string(p, n) + "' is not valid";
+
+        return false;
+    }
+
+    /* the start of the arc with the order of the difference */
+    if (order >= 0)
+    {
+        arc.arcOrder = order;
+        arc.order = 0;
+        arc.y[0] = v;
+
+        return true;
+    }
+    if (arc.order < 0)
+    {
+        _msg = "the arc is not initialized";
+
+        return false;
+    }
+
+    /* the data are restored from the highest order of the difference */
+    if (arc.order < arc.arcOrder) arc.order++;
+    arc.y[arc.order] = v;
+    for (int k = arc.order; k > 0; k--) arc.y[k - 1] += arc.y[k];
+
+    return true;
+} /* end of Accumulate */
+
+/**
+* @brief   : DecodeEpoch - decode the epoch line
+* @param[I]: p (line without the line ending)
+* @param[I]: n (number of characters of 'p')
+* @param[O]: none
+* @return  : true: OK, false: the line is not valid
+* @note    :
+**/
+bool CrxUtil::DecodeEpoch(const char *p, size_t n)
+{
+    /* the epoch is initialized with '&' (RINEX 2) or '>' (RINEX 3), or differenced from the previous one */
+    if (n > 0 && p[0] == (_rnxVer == 2 ? '&' : '>'))
+    {
+        _epoch.assign(p, n);
+        if (_rnxVer == 2) _epoch[0] = ' ';
+        _sats.clear();
+        _init = false;
+    }
+    else
+    {
+        if (_init)
+        {
+            _msg = "the epoch is not initialized";
+
+            return false;
+        }
+        Repair(_epoch, p, n);
+    }
+
+    /* the special event is followed by the header lines or the comments */
+    size_t iflag = _rnxVer == 2 ? 28 : 31;
+    char flag = iflag < _epoch.size() ? _epoch[iflag] : ' ';
+    int num = GetInt(_epoch, iflag + 1, 3);
+    if (flag >= '2' && flag <= '5')
+    {
+        PutLine(_epoch.data(), _epoch.size());
+        _nleft = num;
+        _init = true;
+        _state = num > 0 ? CRX_EVENT : CRX_EPOCH;
+
+        return true;
+    }
+
+    /* the satellites are listed after the epoch */
+    size_t isat = _rnxVer == 2 ? 32 : 41;
+    if (num < 0 || (num > 0 && _epoch.size() < isat + 3 * (size_t)num))
+    {
+        _msg = "the list of the satellites is not complete";
+
+        return false;
+    }
+    _cur.resize(num);
+    for (int i = 0; i < num; i++) _cur[i].id.assign(_epoch, isat + 3 * i, 3);
+    _state = CRX_CLOCK;
+
+    return true;
+} /* end of DecodeEpoch */
+
+/**
+* @brief   : DecodeClock - decode the line of the receiver clock offset, and write the epoch line
+* @param[I]: p (line without the line ending)
+* @param[I]: n (number of characters of 'p')
+* @param[O]: none
+* @return  : true: OK, false: the line is not valid
+* @note    :
+**/
+bool CrxUtil::DecodeClock(const char *p, size_t n)
+{
+    /* the blank line means no clock offset in the epoch */
+    _clkOn = n > 0;
+    if (!_clkOn) for (int k = 0; k <= CRX_MAXORDER; k++) _clk.y[k] = 0;
+    else if (!Accumulate(p, n, _clk)) return false;
+
+    /* F12.9 at the column 69 of RINEX 2, or F15.12 following the epoch of RINEX 3 */
+    int clkCol = _rnxVer == 2 ? 68 : 41, clkWidth = _rnxVer == 2 ? 12 : 15;
+    char clk[16];
+    if (_clkOn && !PutValue(_clk.y[0], clkWidth - 3, clkWidth, clk))
+    {
+        _msg = "the clock offset is out of the range of RINEX";
+
+        return false;
+    }
+    size_t len = _epoch.size();
+    while (len > 0 && _epoch[len - 1] == ' ') len--;
+    _buf.assign(_epoch, 0, len < (size_t)clkCol ? len : clkCol);
+    if (_clkOn)
+    {
+        /* the epoch of RINEX 3 is not padded to the column 42 as 'crx2rnx' does */
+        if (_rnxVer == 2) _buf.resize(clkCol, ' ');
+        _buf.append(clk, clkWidth);
+    }
+
+    /* the gzip member is cut at the first epoch of the hour, i.e., " yy mm dd hh" or "> yyyy mm dd hh" */
+    if (_gz)
+    {
+        int year = _rnxVer == 2 ? GetInt(_epoch, 1, 2) : GetInt(_epoch, 2, 4);
+        if (_rnxVer == 2) year += year < 80 ? 2000 : 1900;
+        size_t i0 = _rnxVer == 2 ? 4 : 7;
+        char hour[16];
+        sprintf(hour, "%04d%02d%02d%02d", year, GetInt(_epoch, i0, 2), GetInt(_epoch, i0 + 3, 2), GetInt(_epoch, i0 + 6, 2));
+        if (_hour != hour)
+        {
+            _hour = hour;
+            _cutPos.push_back(_out.size());
+            _cutKey.push_back(_hour);
+        }
+    }
+    PutLine(_buf.data(), _buf.size());
+
+    /* the satellites more than 12 are continued in the next lines of RINEX 2 */
+    size_t nsat = _cur.size();
+    for (size_t k = 1; _rnxVer == 2 && k < (nsat + 11) / 12; k++)
+    {
+        size_t pos = 68 + 36 * (k - 1);
+        _buf.assign(32, ' ');
+        if (pos < _epoch.size()) _buf.append(_epoch, pos, 36);
+        PutLine(_buf.data(), _buf.size());
+    }
+
+    _nleft = (int)nsat;
+    if (nsat > 0) _state = CRX_DATA;
+    else
+    {
+        _sats.swap(_cur);
+        _state = CRX_EPOCH;
+    }
+
+    return true;
+} /* end of DecodeClock */
+
+/**
+* @brief   : DecodeData - decode the data line of one satellite
+* @param[I]: p (line without the line ending)
+* @param[I]: n (number of characters of 'p')
+* @param[O]: none
+* @return  : true: OK, false: the line is not valid
+* @note    :
+**/
+bool CrxUtil::DecodeData(const char *p, size_t n)
+{
+    size_t isat = _cur.size() - _nleft;
+    sat_t &sat = _cur[isat];
+    int ntype = _rnxVer == 2 ? _ntype : _ntypeGnss[(unsigned char)sat.id[0]];
+    if (ntype <= 0)
+    {
+        _msg = "the system of " + sat.id + " is not defined in the header";
+
+        return false;
+    }
+
+    /* the arcs of the satellite in the previous epoch, which is usually at the same index */
+    size_t k = isat;
+    if (k >= _sats.size() || _sats[k].id != sat.id)
+    {
+        for (k = 0; k < _sats.size(); k++) if (_sats[k].id == sat.id) break;
+    }
+    if (k < _sats.size())
+    {
+        sat.y.swap(_sats[k].y);
+        sat.order.swap(_sats[k].order);
+        sat.arcOrder.swap(_sats[k].arcOrder);
+        sat.flags.swap(_sats[k].flags);
+        _sats[k].id.clear();
+    }
+    else
+    {
+        sat.y.assign((CRX_MAXORDER + 1) * ntype, 0);
+        sat.order.assign(ntype, -1);
+        sat.arcOrder.assign(ntype, 0);
+        sat.flags.assign(2 * ntype, ' ');
+    }
+
+    /* the fields are separated by one blank, and followed by the difference of LLI and SSI; the highest
+       difference of each type is stored first, and then the data of all the types are restored at once */
+    size_t pos = 0;
+    int maxOrder = 0;
+    long long *y = sat.y.data();
+    for (int j = 0; j < ntype; j++)
+    {
+        if (pos >= n)
+        {
+            sat.order[j] = -1;
+            pos = n + 1;
+            continue;
+        }
+        const char *q = (const char *)memchr(p + pos, ' ', n - pos);
+        size_t end = q ? q - p : n;
+        int order;
+        long long v;
+        if (end == pos) sat.order[j] = -1;
+        else if (!ParseField(p + pos, end - pos, order, v))
+        {
+            _msg = "the field '" + string(p + pos, end - pos) + "' is not valid";
+
+            return false;
+        }
+        else if (order >= 0)
+        {
+            /* the start of the arc, and the differences above the order are kept zero */
+            sat.arcOrder[j] = order;
+            sat.order[j] = 0;
+            y[j] = v;
+            for (int m = 1; m <= CRX_MAXORDER; m++) y[m * ntype + j] = 0;
+        }
+        else if (sat.order[j] < 0)
+        {
+            _msg = "the arc is not initialized";
+
+            return false;
+        }
+        else
+        {
+            if (sat.order[j] < sat.arcOrder[j]) sat.order[j]++;
+            y[sat.order[j] * ntype + j] = v;
+            if (sat.order[j] > maxOrder) maxOrder = sat.order[j];
+        }
+        pos = end + 1;
+    }
+    Accum(y, ntype, maxOrder);
+    if (pos < n) Repair(sat.flags, p + pos, n - pos);
+    if (sat.flags.size() < 2 * (size_t)ntype) sat.flags.resize(2 * ntype, ' ');
+    for (int j = 0; _rnxVer == 2 && j < ntype; j++)
+    {
+        /* LLI and SSI of the blank field are cleared in RINEX 2, but kept in RINEX 3 */
+        if (sat.order[j] < 0) sat.flags[2 * j] = sat.flags[2 * j + 1] = ' ';
+    }
+
+    /* F14.3 with LLI and SSI for each type, five types in one line of RINEX 2 */
+    _buf.clear();
+    if (_rnxVer != 2) _buf.append(sat.id);
+    for (int j = 0; j < ntype; j++)
+    {
+        char field[16];
+        if (sat.order[j] < 0) memset(field, ' ', 14);
+        else if (!PutValue(y[j], 3, 14, field))
+        {
+            _msg = "the data are out of the range of RINEX";
+
+            return false;
+        }
+        field[14] = sat.flags[2 * j];
+        field[15] = sat.flags[2 * j + 1];
+        _buf.append(field, 16);
+        if (_rnxVer == 2 && (j % 5 == 4 || j == ntype - 1))
+        {
+            PutLine(_buf.data(), _buf.size());
+            _buf.clear();
+        }
+    }
+    if (_rnxVer != 2) PutLine(_buf.data(), _buf.size());
+
+    if (--_nleft == 0)
+    {
+        _sats.swap(_cur);
+        _state = CRX_EPOCH;
+    }
+
+    return true;
+} /* end of DecodeData */
+
+/**
+* @brief   : DecodeLine - decode one line of Compact RINEX
+* @param[I]: p (line without the line ending)
+* @param[I]: n (number of characters of 'p')
+* @param[O]: none
+* @return  : true: OK, false: the line is not valid
+* @note    : the RINEX lines are appended to '_out'
+**/
+bool CrxUtil::DecodeLine(const char *p, size_t n)
+{
+    if (n > 0 && p[n - 1] == '\r') n--;
+    _nline++;
+
+    switch (_state)
+    {
+    case CRX_HEAD1:
+        if (!IsLabel(p, n, "CRINEX VERS   / TYPE") || (memcmp(p, "1.0", 3) != 0 && memcmp(p, "3.0", 3) != 0))
+        {
+            _msg = "the file is not Compact RINEX of version 1.0 or 3.0";
+
+            return false;
+        }
+        _crxVer = p[0] - '0';
+        _state = CRX_HEAD2;
+
+        return true;
+    case CRX_HEAD2:
+        _state = CRX_HEADER;
+
+        return true;
+    case CRX_HEADER:
+        PutLine(p, n);
+        if (IsLabel(p, n, "RINEX VERSION / TYPE")) _rnxVer = atoi(string(p, 9).c_str());
+        else if (IsLabel(p, n, "# / TYPES OF OBSERV") && strspn(p, " ") < 6) _ntype = atoi(string(p, 6).c_str());
+        else if (IsLabel(p, n, "SYS / # / OBS TYPES") && p[0] != ' ')
+            _ntypeGnss[(unsigned char)p[0]] = atoi(string(p + 3, 3).c_str());
+        else if (IsLabel(p, n, "END OF HEADER"))
+        {
+            if ((_crxVer == 1 && _rnxVer != 2) || (_crxVer == 3 && _rnxVer < 3))
+            {
+                _msg = "the version of RINEX does not match that of Compact RINEX";
+
+                return false;
+            }
+            _state = CRX_EPOCH;
+        }
+
+        return true;
+    case CRX_EPOCH:
+        return DecodeEpoch(p, n);
+    case CRX_CLOCK:
+        return DecodeClock(p, n);
+    case CRX_DATA:
+        return DecodeData(p, n);
+    case CRX_EVENT:
+        PutLine(p, n);
+        if (--_nleft == 0) _state = CRX_EPOCH;
+
+        return true;
+    }
+
+    return false;
+} /* end of DecodeLine */
+
+/**
+* @brief   : EncodeHeader - encode the header of RINEX to Compact RINEX
+* @param[I]: lines (lines of the header, up to 'END OF HEADER')
+* @param[O]: none
+* @return  : true: OK, false: the header is not of the observation file of RINEX 2, 3 or 4
+* @note    : the lines of Compact RINEX are appended to '_out'
+**/
+bool CrxUtil::EncodeHeader(const vector<string> &lines)
+{
+    _rnxVer = 0;
+    _ntype = 0;
+    for (int i = 0; i < 256; i++) _ntypeGnss[i] = 0;
+    for (size_t i = 0; i < lines.size(); i++)
+    {
+        const char *p = lines[i].data();
+        size_t n = lines[i].size();
+        if (IsLabel(p, n, "RINEX VERSION / TYPE") && n > 20 && p[20] == 'O') _rnxVer = atoi(string(p, 9).c_str());
+        else if (IsLabel(p, n, "# / TYPES OF OBSERV") && strspn(p, " ") < 6) _ntype = atoi(string(p, 6).c_str());
+        else if (IsLabel(p, n, "SYS / # / OBS TYPES") && p[0] != ' ')
+            _ntypeGnss[(unsigned char)p[0]] = atoi(string(p + 3, 3).c_str());
+    }
+    if (_rnxVer < 2 || _rnxVer > 4)
+    {
+        _msg = "the file is not the observation file of RINEX 2, 3 or 4";
+
+        return false;
+    }
+    _crxVer = _rnxVer == 2 ? 1 : 3;
+
+    /* the two lines of Compact RINEX followed by the header of the original RINEX */
+    char line[128], date[32];
+    time_t now = time(nullptr);
+    strftime(date, sizeof(date), "%d-%b-%y %H:%M", gmtime(&now));
+    sprintf(line, "%-20s%-40s%s", _crxVer == 1 ? "1.0" : "3.0", "COMPACT RINEX FORMAT", "CRINEX VERS   / TYPE");
+    PutLine(line, strlen(line));
+    sprintf(line, "%-40s%-20s%s", "GAMP II - GOOD", date, "CRINEX PROG / DATE");
+    PutLine(line, strlen(line));
+    for (size_t i = 0; i < lines.size(); i++) PutLine(lines[i].data(), lines[i].size());
+
+    _nline = 0;
+    _init = true;
+    _epoch.clear();
+    _clk.order = -1;
+    _clk.arcOrder = 0;
+    _clkOn = false;
+    _sats.clear();
+
+    return true;
+} /* end of EncodeHeader */
+
+/**
+* @brief   : EncodeEpoch - encode one epoch of RINEX to Compact RINEX
+* @param[I]: lines (epoch line followed by the data lines, or the header lines of the event)
+* @param[O]: none
+* @return  : true: OK, false: the epoch is not valid
+* @note    : the lines of Compact RINEX are appended to '_out', and the arcs are differenced up to the
+*            third order as 'rnx2crx' does
+**/
+bool CrxUtil::EncodeEpoch(const vector<string> &lines)
+{
+    _nline++;
+    const string &line = lines[0];
+    size_t iflag = _rnxVer == 2 ? 28 : 31;
+    char flag = iflag < line.size() ? line[iflag] : ' ';
+    int num = GetInt(line, iflag + 1, 3);
+
+    /* the special event is written as it is with the lines following it, and the next epoch is initialized */
+    if (flag >= '2' && flag <= '5')
+    {
+        _buf = line;
+        if (_rnxVer == 2) _buf.replace(0, 1, "&");
+        PutLine(_buf.data(), _buf.size());
+        for (size_t i = 1; i < lines.size(); i++) PutLine(lines[i].data(), lines[i].size());
+        _sats.clear();
+        _init = true;
+
+        return true;
+    }
+
+    /* the satellites are listed after the epoch, at the column 33 of RINEX 2 (with the continuation lines)
+       or 42 of RINEX 3, and the clock offset is separated */
+    string epoch, clk;
+    size_t isat = _rnxVer == 2 ? 32 : 41, idata;
+    if (_rnxVer == 2)
+    {
+        size_t ncont = num > 12 ? (num - 1) / 12 : 0;
+        epoch.assign(line, 0, 68);
+        if (ncont > 0) epoch.resize(68, ' ');
+        for (size_t k = 1; k <= ncont && k < lines.size(); k++)
+        {
+            size_t len = epoch.size();
+            if (lines[k].size() > 32) epoch.append(lines[k], 32, 36);
+            if (k < ncont) epoch.resize(len + 36, ' ');
+        }
+        if (line.size() > 68) clk.assign(line, 68, 12);
+        idata = 1 + ncont;
+    }
+    else
+    {
+        /* the clock offset of the epoch without the satellites follows the number of them, as the decoder writes */
+        size_t clkCol = num > 0 ? 41 : 35;
+        epoch.assign(line, 0, clkCol);
+        epoch.resize(41, ' ');
+        for (int i = 0; i < num && 1 + i < (int)lines.size(); i++)
+        {
+            size_t len = epoch.size();
+            epoch.append(lines[1 + i], 0, 3);
+            epoch.resize(len + 3, ' ');
+        }
+        if (line.size() > clkCol) clk.assign(line, clkCol, 15 + 41 - clkCol);
+        idata = 1;
+    }
+    while (!epoch.empty() && epoch.back() == ' ') epoch.pop_back();
+    if (num < 0 || (num > 0 && epoch.size() < isat + 3 * (size_t)num))
+    {
+        _msg = "the list of the satellites is not complete";
+
+        return false;
+    }
+
+    /* the epoch is initialized with '&' (RINEX 2) or '>' (RINEX 3), or differenced from the previous one */
+    if (_init)
+    {
+        _epoch = epoch;
+        if (_rnxVer == 2) epoch[0] = '&';
+        PutLine(epoch.data(), epoch.size());
+        _sats.clear();
+        _init = false;
+    }
+    else
+    {
+        Difference(epoch, _epoch, _buf);
+        PutLine(_buf.data(), _buf.size());
+    }
+
+    /* the clock offset starts the arc again after the epoch without it */
+    long long v;
+    bool clkOn = clk.find_first_not_of(' ') != string::npos;
+    if (clkOn && !ParseFixed(clk.data(), clk.size(), _rnxVer == 2 ? 9 : 12, v))
+    {
+        _msg = "the clock offset '" + clk + "' is not valid";
+
+        return false;
+    }
+    char field[32];
+    if (!clkOn) field[0] = '\0';
+    else if (!_clkOn)
+    {
+        _clk.arcOrder = CRX_ORDER;
+        _clk.order = 0;
+        _clk.y[0] = v;
+        sprintf(field, "%d&%lld", CRX_ORDER, v);
+    }
+    else sprintf(field, "%lld", Difference(v, _clk.y, 1, _clk.order, _clk.arcOrder));
+    PutLine(field, strlen(field));
+    _clkOn = clkOn;
+
+    /* the data of each satellite are differenced in their arcs, followed by the difference of LLI and SSI */
+    _cur.resize(num);
+    for (int i = 0; i < num; i++)
+    {
+        sat_t &sat = _cur[i];
+        sat.id.assign(epoch, isat + 3 * i, 3);
+        int ntype = _rnxVer == 2 ? _ntype : _ntypeGnss[(unsigned char)sat.id[0]];
+        if (ntype <= 0)
+        {
+            _msg = "the system of " + sat.id + " is not defined in the header";
+
+            return false;
+        }
+        size_t nline = _rnxVer == 2 ? (ntype + 4) / 5 : 1;
+        if (idata + nline * (i + 1) > lines.size())
+        {
+            _msg = "the data lines of " + sat.id + " are not complete";
+
+            return false;
+        }
+
+        /* the arcs of the satellite in the previous epoch, found in the same way as DecodeData */
+        size_t k = i;
+        if (k >= _sats.size() || _sats[k].id != sat.id)
+        {
+            for (k = 0; k < _sats.size(); k++) if (_sats[k].id == sat.id) break;
+        }
+        bool isNew = k >= _sats.size();
+        if (!isNew)
+        {
+            sat.y.swap(_sats[k].y);
+            sat.order.swap(_sats[k].order);
+            sat.arcOrder.swap(_sats[k].arcOrder);
+            sat.flags.swap(_sats[k].flags);
+            _sats[k].id.clear();
+        }
+        else
+        {
+            sat.y.assign((CRX_MAXORDER + 1) * ntype, 0);
+            sat.order.assign(ntype, -1);
+            sat.arcOrder.assign(ntype, 0);
+            sat.flags.assign(2 * ntype, ' ');
+        }
+
+        string flags = sat.flags;
+        _buf.clear();
+        long long *y = sat.y.data();
+        for (int j = 0; j < ntype; j++)
+        {
+            const string &data = lines[idata + nline * i + (_rnxVer == 2 ? j / 5 : 0)];
+            size_t col = _rnxVer == 2 ? 16 * (j % 5) : 3 + 16 * j;
+            const char *p = col < data.size() ? data.data() + col : "";
+            size_t n = col < data.size() ? data.size() - col : 0;
+            if (n > 14) n = 14;
+            if (j > 0) _buf.push_back(' ');
+            if (strspn(p, " ") >= n)
+            {
+                /* LLI and SSI of the blank field are cleared by the decoder of RINEX 2 */
+                sat.order[j] = -1;
+                if (_rnxVer == 2) continue;
+            }
+            else if (!ParseFixed(p, n, 3, v))
+            {
+                _msg = "the data '" + string(p, n) + "' of " + sat.id + " are not valid";
+
+                return false;
+            }
+            else if (sat.order[j] < 0)
+            {
+                sat.arcOrder[j] = CRX_ORDER;
+                sat.order[j] = 0;
+                y[j] = v;
+                for (int m = 1; m <= CRX_MAXORDER; m++) y[m * ntype + j] = 0;
+                sprintf(field, "%d&%lld", CRX_ORDER, v);
+                _buf.append(field);
+            }
+            else
+            {
+                sprintf(field, "%lld", Difference(v, y + j, ntype, sat.order[j], sat.arcOrder[j]));
+                _buf.append(field);
+            }
+            flags[2 * j] = col + 14 < data.size() ? data[col + 14] : ' ';
+            flags[2 * j + 1] = col + 15 < data.size() ? data[col + 15] : ' ';
+        }
+        /* LLI and SSI of the new satellite of Compact RINEX 3 are written in full with '&' for the blanks */
+        string ds;
+        if (isNew && _rnxVer != 2)
+        {
+            sat.flags = flags;
+            ds = flags;
+            replace(ds.begin(), ds.end(), ' ', '&');
+        }
+        else Difference(flags, sat.flags, ds);
+        for (int j = 0; _rnxVer == 2 && j < ntype; j++)
+        {
+            if (sat.order[j] < 0) sat.flags[2 * j] = sat.flags[2 * j + 1] = ' ';
+        }
+        if (!ds.empty())
+        {
+            _buf.push_back(' ');
+            _buf.append(ds);
+        }
+        PutLine(_buf.data(), _buf.size());
+    }
+    _sats.swap(_cur);
+
+    return true;
+} /* end of EncodeEpoch */
+
+/**
+* @brief   : BeginDecode - start the streaming decoding of Compact RINEX
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    : the stream started before is discarded
+**/
+void CrxUtil::BeginDecode()
+{
+    _state = CRX_HEAD1;
+    _rnxVer = 0;
+    _crxVer = 0;
+    _ntype = 0;
+    for (int i = 0; i < 256; i++) _ntypeGnss[i] = 0;
+    _nline = 0;
+    _init = true;
+    _nleft = 0;
+    _line.clear();
+    _epoch.clear();
+    _clk.order = -1;
+    _clk.arcOrder = 0;
+    _clkOn = false;
+    _sats.clear();
+    _cur.clear();
+    _out.clear();
+    _msg.clear();
+    _hour.clear();
+    _cutPos.clear();
+    _cutKey.clear();
+    if (_gz && !_mem) _gz->BeginDeflate();
+} /* end of BeginDecode */
+
+/**
+* @brief   : Decode - decode the next piece of Compact RINEX and write the RINEX lines to the file
+* @param[I]: data (Compact RINEX data)
+* @param[I]: n (number of bytes of 'data')
+* @param[I]: fp (file the RINEX lines are written to)
+* @return  : true: OK, false: the data are not valid or the file failed to be written
+* @note    : the output is the same as 'crx2rnx' (ver.4.0.7), including the trailing blanks removed
+**/
+bool CrxUtil::Decode(const char *data, size_t n, FILE *fp)
+{
+    if (_state == CRX_ERROR) return false;
+
+    _out.clear();
+    const char *p = data, *end = data + n;
+    while (p < end)
+    {
+        const char *q = (const char *)memchr(p, '\n', end - p);
+        if (!q)
+        {
+            _line.append(p, end - p);
+            break;
+        }
+
+        /* the line split by the pieces is completed in '_line' */
+        bool ok;
+        if (_line.empty()) ok = DecodeLine(p, q - p);
+        else
+        {
+            _line.append(p, q - p);
+            ok = DecodeLine(_line.data(), _line.size());
+            _line.clear();
+        }
+        if (!ok)
+        {
+            _state = CRX_ERROR;
+            break;
+        }
+        p = q + 1;
+    }
+    if (!Write(fp))
+    {
+        _msg = "the RINEX file failed to be written";
+        _state = CRX_ERROR;
+    }
+
+    return _state != CRX_ERROR;
+} /* end of Decode */
+
+/**
+* @brief   : EndDecode - end the streaming decoding
+* @param[I]: fp (file the RINEX lines are written to)
+* @param[O]: none
+* @return  : true: the stream ends at the end of an epoch, false: the stream is truncated or not valid
+* @note    : the last line without the line ending is decoded
+**/
+bool CrxUtil::EndDecode(FILE *fp)
+{
+    if (!_line.empty()) Decode("\n", 1, fp);
+
+    /* the rest of the compressed lines */
+    if (_gz && !_mem && !_gz->EndDeflate(fp) && _state != CRX_ERROR)
+    {
+        _msg = "the RINEX file failed to be written";
+        _state = CRX_ERROR;
+    }
+    if (_state == CRX_ERROR) return false;
+    if (_state != CRX_EPOCH)
+    {
+        _msg = "the file is truncated";
+
+        return false;
+    }
+
+    return true;
+} /* end of EndDecode */
+
+/**
+* @brief   : Crx2Rnx - convert the Compact RINEX file to the RINEX file
+* @param[I]: crxFile (Compact RINEX file, i.e., '*.yyd' or '*.crx')
+* @param[I]: rnxFile (RINEX file, i.e., '*.yyo' or '*.rnx')
+* @return  : true: OK, false: failed
+* @note    : 'rnxFile' is written as '<rnxFile>.part' and renamed when it is complete, and the object
+*            itself is not changed, so it can be called by several threads at the same time; 'rnxFile'
+*            ended with '.gz' is written as the indexed gzip file
+**/
+bool CrxUtil::Crx2Rnx(const string &crxFile, const string &rnxFile)
+{
+    FILE *fin = fopen(crxFile.c_str(), "rb");
+    if (!fin) return false;
+    string partFile = rnxFile + PARTSUFFIX;
+    FILE *fout = fopen(partFile.c_str(), "wb");
+    if (!fout)
+    {
+        fclose(fin);
+
+        return false;
+    }
+
+    /* the decoder of each file, so the files of the sites can be converted in parallel */
+    CrxUtil crx;
+    ZipUtil gz;
+    if (gz.Format(rnxFile) == ZIP_GZIP)
+    {
+        gz.SetThreads(_nzip);
+        crx.SetGzip(&gz);
+    }
+    crx.BeginDecode();
+    bool ok = true;
+    char buf[CHUNK];
+    size_t n;
+    while (ok && (n = fread(buf, 1, CHUNK, fin)) > 0) ok = crx.Decode(buf, n, fout);
+    if (ok && !crx.EndDecode(fout)) ok = false;
+    fclose(fin);
+    if (fclose(fout) != 0) ok = false;
+    if (ok)
+    {
+        remove(rnxFile.c_str());
+        ok = rename(partFile.c_str(), rnxFile.c_str()) == 0;
+    }
+    if (!ok)
+    {
+        cout << "*** WARNING(CrxUtil::Crx2Rnx): failed to convert " << crxFile << " at line " << crx._nline <<
+            ", " << (crx._msg.empty() ? "the file failed to be read or written" : crx._msg) << endl;
+        remove(partFile.c_str());
+    }
+
+    return ok;
+} /* end of Crx2Rnx */
+
+/**
+* @brief   : Rnx2Crx - convert the RINEX file to the Compact RINEX file
+* @param[I]: rnxFile (RINEX file, i.e., '*.yyo' or '*.rnx', which may be compressed as '*.gz' or '*.Z')
+* @param[I]: crxFile (Compact RINEX file, i.e., '*.yyd' or '*.crx')
+* @return  : true: OK, false: failed
+* @note    : 'crxFile' is written as '<crxFile>.part' and renamed when it is complete, and the object
+*            itself is not changed, so it can be called by several threads at the same time; 'crxFile'
+*            ended with '.gz' is compressed; the file is restored by Crx2Rnx or 'crx2rnx' as it is,
+*            except the trailing blanks
+**/
+bool CrxUtil::Rnx2Crx(const string &rnxFile, const string &crxFile)
+{
+    RnxReader rnx;
+    if (!rnx.Open(rnxFile)) return false;
+    string partFile = crxFile + PARTSUFFIX;
+    FILE *fout = fopen(partFile.c_str(), "wb");
+    if (!fout) return false;
+
+    /* the encoder of each file, so the files can be converted in parallel */
+    CrxUtil crx;
+    ZipUtil gz;
+    if (gz.Format(crxFile) == ZIP_GZIP)
+    {
+        gz.SetThreads(_nzip);
+        crx.SetGzip(&gz);
+        gz.BeginDeflate();
+    }
+    vector<string> lines;
+    bool ok = rnx.ReadHeader(lines);
+    if (!ok) crx._msg = "the header is not complete";
+    else ok = crx.EncodeHeader(lines);
+    while (ok && rnx.ReadEpoch(lines))
+    {
+        ok = crx.EncodeEpoch(lines);
+        if (ok && crx._out.size() >= CHUNK)
+        {
+            ok = crx.Write(fout);
+            crx._out.clear();
+        }
+    }
+    if (ok && rnx.Failed())
+    {
+        crx._msg = "the file is not valid or truncated";
+        ok = false;
+    }
+    if (ok) ok = crx.Write(fout) && (!crx._gz || gz.EndDeflate(fout));
+    if (fclose(fout) != 0) ok = false;
+    if (ok)
+    {
+        remove(crxFile.c_str());
+        ok = rename(partFile.c_str(), crxFile.c_str()) == 0;
+    }
+    if (!ok)
+    {
+        cout << "*** WARNING(CrxUtil::Rnx2Crx): failed to convert " << rnxFile << " at epoch " << crx._nline <<
+            ", " << (crx._msg.empty() ? "the file failed to be written" : crx._msg) << endl;
+        remove(partFile.c_str());
+    }
+
+    return ok;
+} /* end of Rnx2Crx */
+
+/**
+* @brief   : Rnx2CrxFiles - convert the RINEX files to the Compact RINEX files in parallel
+* @param[I]: rnxFiles (RINEX files, i.e., '*.yyo' or '*.rnx', which may be compressed)
+* @param[I]: gzip (true: written as '*.yyd.gz' or '*.crx.gz', false: '*.yyd' or '*.crx')
+* @param[I]: nthread (number of files converted at the same time)
+* @return  : number of the files converted
+* @note    : the Compact RINEX file is written beside the RINEX file, and the messages are printed in
+*            the order of 'rnxFiles'
+**/
+int CrxUtil::Rnx2CrxFiles(const vector<string> &rnxFiles, bool gzip, int nthread)
+{
+    std::atomic<int> nconv(0);
+    ThreadUtil thr;
+    thr.RunOrdered((int)rnxFiles.size(), nthread, [&](int k, ostringstream &log)
+    {
+        string crxFile = CrxName(rnxFiles[k], gzip);
+        if (crxFile.empty())
+        {
+            log << "*** WARNING(CrxUtil::Rnx2CrxFiles): " << rnxFiles[k] << " is not the RINEX observation file '*.yyo' or '*.rnx'" << endl;
+
+            return;
+        }
+        if (access(rnxFiles[k].c_str(), 0) == -1)
+        {
+            log << "*** WARNING(CrxUtil::Rnx2CrxFiles): " << rnxFiles[k] << " does not exist" << endl;
+
+            return;
+        }
+        if (Rnx2Crx(rnxFiles[k], crxFile))
+        {
+            log << "*** INFO(CrxUtil::Rnx2CrxFiles): successfully convert " << rnxFiles[k] << " to " << crxFile << endl;
+            nconv++;
+        }
+    });
+
+    return nconv;
+} /* end of Rnx2CrxFiles */
+
+/**
+* @brief   : SetGzip - set the compression chained after the decoding
+* @param[I]: gz (compression of the RINEX lines, nullptr: the RINEX lines are written as they are)
+* @param[O]: none
+* @return  : none
+* @note    : the compression is started by BeginDecode and ended by EndDecode, and the gzip members
+*            are indexed by the hours of the epochs
+**/
+void CrxUtil::SetGzip(ZipUtil *gz)
+{
+    _gz = gz;
+} /* end of SetGzip */
+
+/**
+* @brief   : SetZipThreads - set the number of threads compressing the RINEX file of Crx2Rnx
+* @param[I]: nthread (number of threads, < 1: one)
+* @param[O]: none
+* @return  : none
+* @note    : the RINEX file is compressed only if its name ends with '.gz'
+**/
+void CrxUtil::SetZipThreads(int nthread)
+{
+    _nzip = nthread < 1 ? 1 : nthread;
+} /* end of SetZipThreads */
+
+/**
+* @brief   : SetOutput - set the memory the RINEX lines are appended to
+* @param[I]: mem (buffer of the RINEX lines, nullptr: written to the file)
+* @param[O]: none
+* @return  : none
+* @note    : the file given to Decode and EndDecode is ignored if it is set, and the compression set
+*            by SetGzip is not used
+**/
+void CrxUtil::SetOutput(string *mem)
+{
+    _mem = mem;
+} /* end of SetOutput */
@@ -0,0 +1,253 @@
+/*------------------------------------------------------------------------------
+* CrxUtil.h : header file of CrxUtil.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+/* constants/macros ----------------------------------------------------------*/
+#define CRX_MAXORDER    5         /* maximum order of the difference in Compact RINEX */
+
+class ZipUtil;                    /* compression of the RINEX lines */
+
+class CrxUtil
+{
+private:
+    struct arc_t
+    {                             /* arc of the differenced data */
+        long long y[CRX_MAXORDER + 1];  /* data and its differences up to 'order' */
+        int order;                /* current order of the difference (-1: not initialized) */
+        int arcOrder;             /* order of the difference of the arc */
+    };
+    struct sat_t
+    {                             /* satellite in the epoch */
+        string id;                /* satellite ID, i.e., "G01" */
+        vector<long long> y;      /* data and differences of the types, 'y[k * ntype + j]' for order 'k' of type 'j' */
+        vector<int> order;        /* current order of the difference of each type (-1: not initialized) */
+        vector<int> arcOrder;     /* order of the difference of the arc of each type */
+        string flags;             /* LLI and SSI of the observation types */
+    };
+    int _state;                   /* part of the file expected in the next line */
+    int _rnxVer;                  /* major version of the original RINEX (2, 3 or 4) */
+    int _crxVer;                  /* major version of Compact RINEX (1 or 3) */
+    int _ntype;                   /* number of the observation types of RINEX 2 */
+    int _ntypeGnss[256];          /* number of the observation types of each system of RINEX 3 */
+    long _nline;                  /* number of the lines read */
+    bool _init;                   /* the next epoch has to be initialized */
+    int _nleft;                   /* number of the data or event lines left in the epoch */
+    string _line;                 /* line not completed in the data received */
+    string _epoch;                /* epoch line of the previous epoch */
+    arc_t _clk;                   /* arc of the receiver clock offset */
+    bool _clkOn;                  /* the receiver clock offset is given in the epoch */
+    vector<sat_t> _sats;          /* satellites of the previous epoch */
+    vector<sat_t> _cur;           /* satellites of the current epoch */
+    string _buf;                  /* RINEX line being formatted */
+    string _out;                  /* RINEX lines to be written */
+    string _msg;                  /* reason of the failure */
+    ZipUtil *_gz;                 /* the RINEX lines are compressed to the indexed gzip file (nullptr: written as they are) */
+    int _nzip;                    /* number of threads compressing the RINEX file of Crx2Rnx ('*.gz') */
+    string _hour;                 /* hour of the last epoch, i.e., "yyyymmddhh" */
+    vector<size_t> _cutPos;       /* positions in '_out' where the gzip members are cut at the new hours */
+    vector<string> _cutKey;       /* hours of '_cutPos' */
+    string *_mem;                 /* the RINEX lines are appended to it instead of the file (nullptr: written to the file) */
+
+    /**
+    * @brief   : DecodeLine - decode one line of Compact RINEX
+    * @param[I]: p (line without the line ending)
+    * @param[I]: n (number of characters of 'p')
+    * @param[O]: none
+    * @return  : true: OK, false: the line is not valid
+    * @note    : the RINEX lines are appended to '_out'
+    **/
+    bool DecodeLine(const char *p, size_t n);
+
+    /**
+    * @brief   : DecodeEpoch - decode the epoch line
+    * @param[I]: p (line without the line ending)
+    * @param[I]: n (number of characters of 'p')
+    * @param[O]: none
+    * @return  : true: OK, false: the line is not valid
+    * @note    :
+    **/
+    bool DecodeEpoch(const char *p, size_t n);
+
+    /**
+    * @brief   : DecodeClock - decode the line of the receiver clock offset, and write the epoch line
+    * @param[I]: p (line without the line ending)
+    * @param[I]: n (number of characters of 'p')
+    * @param[O]: none
+    * @return  : true: OK, false: the line is not valid
+    * @note    :
+    **/
+    bool DecodeClock(const char *p, size_t n);
+
+    /**
+    * @brief   : DecodeData - decode the data line of one satellite
+    * @param[I]: p (line without the line ending)
+    * @param[I]: n (number of characters of 'p')
+    * @param[O]: none
+    * @return  : true: OK, false: the line is not valid
+    * @note    :
+    **/
+    bool DecodeData(const char *p, size_t n);
+
+    /**
+    * @brief   : Accumulate - restore the data from the differenced field
+    * @param[I]: p (field, "<order>&<data>" for the start of the arc, or "<difference>")
+    * @param[I]: n (number of characters of 'p')
+    * @param[I/O]: arc (arc of the data)
+    * @return  : true: OK, false: the field is not valid or the arc is not initialized
+    * @note    :
+    **/
+    bool Accumulate(const char *p, size_t n, arc_t &arc);
+
+    /**
+    * @brief   : PutLine - append the line to the RINEX lines without the trailing blanks
+    * @param[I]: s (line)
+    * @param[I]: n (number of characters of 's')
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void PutLine(const char *s, size_t n);
+
+    /**
+    * @brief   : Write - write the RINEX lines to the file
+    * @param[I]: fp (file the RINEX lines are written to)
+    * @param[O]: none
+    * @return  : true: OK, false: the file failed to be written
+    * @note    : the lines are compressed, and the gzip members are cut at the first epoch of each hour
+    *            if the compression is chained by SetGzip
+    **/
+    bool Write(FILE *fp);
+
+    /**
+    * @brief   : EncodeHeader - encode the header of RINEX to Compact RINEX
+    * @param[I]: lines (lines of the header, up to 'END OF HEADER')
+    * @param[O]: none
+    * @return  : true: OK, false: the header is not of the observation file of RINEX 2, 3 or 4
+    * @note    : the lines of Compact RINEX are appended to '_out'
+    **/
+    bool EncodeHeader(const vector<string> &lines);
+
+    /**
+    * @brief   : EncodeEpoch - encode one epoch of RINEX to Compact RINEX
+    * @param[I]: lines (epoch line followed by the data lines, or the header lines of the event)
+    * @param[O]: none
+    * @return  : true: OK, false: the epoch is not valid
+    * @note    : the lines of Compact RINEX are appended to '_out', and the arcs are differenced up to the
+    *            third order as 'rnx2crx' does
+    **/
+    bool EncodeEpoch(const vector<string> &lines);
+
+public:
+    CrxUtil()
+	{
+        _state = 0;
+        _rnxVer = 0;
+        _crxVer = 0;
+        _ntype = 0;
+        _nline = 0;
+        _init = true;
+        _nleft = 0;
+        _clk.order = -1;
+        _clk.arcOrder = 0;
+        _clkOn = false;
+        for (int i = 0; i < 256; i++) _ntypeGnss[i] = 0;
+        _gz = nullptr;
+        _nzip = 1;
+        _mem = nullptr;
+	}
+	~CrxUtil()
+	{
+	}
+
+    /**
+    * @brief   : BeginDecode - start the streaming decoding of Compact RINEX
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    : the stream started before is discarded
+    **/
+    void BeginDecode();
+
+    /**
+    * @brief   : Decode - decode the next piece of Compact RINEX and write the RINEX lines to the file
+    * @param[I]: data (Compact RINEX data)
+    * @param[I]: n (number of bytes of 'data')
+    * @param[I]: fp (file the RINEX lines are written to)
+    * @return  : true: OK, false: the data are not valid or the file failed to be written
+    * @note    : the output is the same as 'crx2rnx' (ver.4.0.7), including the trailing blanks removed
+    **/
+    bool Decode(const char *data, size_t n, FILE *fp);
+
+    /**
+    * @brief   : EndDecode - end the streaming decoding
+    * @param[I]: fp (file the RINEX lines are written to)
+    * @param[O]: none
+    * @return  : true: the stream ends at the end of an epoch, false: the stream is truncated or not valid
+    * @note    : the last line without the line ending is decoded
+    **/
+    bool EndDecode(FILE *fp);
+
+    /**
+    * @brief   : Crx2Rnx - convert the Compact RINEX file to the RINEX file
+    * @param[I]: crxFile (Compact RINEX file, i.e., '*.yyd' or '*.crx')
+    * @param[I]: rnxFile (RINEX file, i.e., '*.yyo' or '*.rnx')
+    * @return  : true: OK, false: failed
+    * @note    : 'rnxFile' is written as '<rnxFile>.part' and renamed when it is complete, and the object
+    *            itself is not changed, so it can be called by several threads at the same time; 'rnxFile'
+    *            ended with '.gz' is written as the indexed gzip file
+    **/
+    bool Crx2Rnx(const string &crxFile, const string &rnxFile);
+
+    /**
+    * @brief   : Rnx2Crx - convert the RINEX file to the Compact RINEX file
+    * @param[I]: rnxFile (RINEX file, i.e., '*.yyo' or '*.rnx', which may be compressed as '*.gz' or '*.Z')
+    * @param[I]: crxFile (Compact RINEX file, i.e., '*.yyd' or '*.crx')
+    * @return  : true: OK, false: failed
+    * @note    : 'crxFile' is written as '<crxFile>.part' and renamed when it is complete, and the object
+    *            itself is not changed, so it can be called by several threads at the same time; 'crxFile'
+    *            ended with '.gz' is compressed; the file is restored by Crx2Rnx or 'crx2rnx' as it is,
+    *            except the trailing blanks
+    **/
+    bool Rnx2Crx(const string &rnxFile, const string &crxFile);
+
+    /**
+    * @brief   : Rnx2CrxFiles - convert the RINEX files to the Compact RINEX files in parallel
+    * @param[I]: rnxFiles (RINEX files, i.e., '*.yyo' or '*.rnx', which may be compressed)
+    * @param[I]: gzip (true: written as '*.yyd.gz' or '*.crx.gz', false: '*.yyd' or '*.crx')
+    * @param[I]: nthread (number of files converted at the same time)
+    * @return  : number of the files converted
+    * @note    : the Compact RINEX file is written beside the RINEX file, and the messages are printed in
+    *            the order of 'rnxFiles'
+    **/
+    int Rnx2CrxFiles(const vector<string> &rnxFiles, bool gzip, int nthread);
+
+    /**
+    * @brief   : SetGzip - set the compression chained after the decoding
+    * @param[I]: gz (compression of the RINEX lines, nullptr: the RINEX lines are written as they are)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the compression is started by BeginDecode and ended by EndDecode, and the gzip members
+    *            are indexed by the hours of the epochs
+    **/
+    void SetGzip(ZipUtil *gz);
+
+    /**
+    * @brief   : SetZipThreads - set the number of threads compressing the RINEX file of Crx2Rnx
+    * @param[I]: nthread (number of threads, < 1: one)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the RINEX file is compressed only if its name ends with '.gz'
+    **/
+    void SetZipThreads(int nthread);
+
+    /**
+    * @brief   : SetOutput - set the memory the RINEX lines are appended to
+    * @param[I]: mem (buffer of the RINEX lines, nullptr: written to the file)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the file given to Decode and EndDecode is ignored if it is set, and the compression set
+    *            by SetGzip is not used
+    **/
+    void SetOutput(string *mem);
+};
@@ -0,0 +1,2711 @@
+/*------------------------------------------------------------------------------
+* CurlUtil.cpp : in-process HTTP(S)/FTP(S) transfer module based on libcurl
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) Group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader)
+*
+* References:
+*    libcurl - the multiprotocol file transfer library, https://curl.se/libcurl/
+*    RFC 3659, Extensions to FTP (MLSD)
+*
+* history : 2026/10/16 1.0  new, replacing the 'wget' process spawned for each file
+*           2026/10/16 1.1  cache the remote directory listings in memory and (optionally) on disk
+*           2026/10/16 1.2  download to '*.part' file and resume the broken transfer by HTTP Range or FTP REST
+*           2026/10/16 1.3  hedge the slow transfer with a duplicate request to the mirror archive
+*           2026/10/16 1.4  record the health history of the hosts for each product class
+*           2026/10/16 1.5  download the large file of HTTP(S) in segments concurrently
+*           2026/10/16 1.6  limit the bandwidth of all the transfers by a token bucket
+*           2026/10/16 1.7  multiplex the transfers in one event loop thread based on curl_multi
+*           2026/10/16 1.8  inflate the gzip file while it is received
+*           2026/10/16 1.9  inflate the Unix compress ('*.Z') file in the same way as the gzip file
+*           2026/10/16 2.0  decode the Compact RINEX file after the inflation while it is received
+*           2026/10/16 2.1  inflate and convert the data of the event loop in the conversion threads
+*           2026/10/16 2.2  (optionally) compress the converted RINEX file to the indexed gzip file
+*           2026/10/16 2.3  (optionally) keep the compressed Compact RINEX file as it is downloaded
+*           2026/10/16 2.4  download the same local file by one thread at a time for the days in parallel
+*           2026/10/16 2.5  plan the downloads without any transfer (dry run), and request the remote file
+*                           found missing only once in one run
+*           2026/10/16 2.6  journal the states of the downloads, and skip the ones verified by the run before
+*           2026/10/16 2.7  forget the listings and the missing files of the run for each round of the daemon
+*           2026/10/16 2.8  record the delays of the new files after their nominal epochs for the latency model
+*           2026/10/16 2.9  run the backfill in the lane yielding to the real-time front of the daemon
+*           2026/10/16 3.0  share the bandwidth limits by all the days of the process, and pause the transfers
+*                           beyond them instead of sleeping in the callback
+*-----------------------------------------------------------------------------*/
+#include "Good.h"
+#include "StringUtil.h"
+#include "HealthUtil.h"
+#include "ZipUtil.h"
+#include "CrxUtil.h"
+#include "JournalUtil.h"
+#include "LatencyUtil.h"
+#include "CurlUtil.h"
+#include <curl/curl.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
+
+
+/* constants/macros ----------------------------------------------------------*/
+#define MAXRETRY        3         /* maximum number of attempts for one transfer */
+#define CONNTIMEOUT     30L       /* timeout for the connection phase (s) */
+#define LOWSPEEDTIME    120L      /* the transfer is aborted if it is stalled for so long (s) */
+#define USERAGENT       "GAMP-GOOD/2.0"
+#define PARTSUFFIX      ".part"   /* suffix of the file being downloaded */
+#define XFER_NORANGE    3         /* the server cannot resume the transfer, which is handled in GetFile */
+#define POLLTIMEOUT     200       /* timeout of waiting for the hedged transfers (ms) */
+#define LOOPTIMEOUT     1000      /* maximum time of the event loop waiting for the sockets (ms) */
+#define MAXEVENTS       256       /* maximum number of socket events handled at a time */
+#define MAXQUEUED       (1 << 20) /* maximum number of bytes of one transfer waiting for the conversion threads */
+#define HOLDTIMEOUT     100       /* maximum time of the event loop waiting with the transfers held (ms) */
+
+
+/* type definitions ----------------------------------------------------------*/
+struct rate_t
+{                                 /* token bucket of the bandwidth limit */
+    std::mutex lock;              /* lock of the bucket shared by all the threads */
+    double bps;                   /* bandwidth limit (bytes/s, <= 0: unlimited) */
+    double tokens;                /* number of bytes allowed to be received now */
+    double tlast;                 /* time of the last update (s) */
+};
+
+struct handleCache_t
+{                                 /* easy handles of the current thread, one per host */
+    std::map<string, CURL *> handles;
+
+    ~handleCache_t()
+    {
+        for (auto it = handles.begin(); it != handles.end(); ++it) curl_easy_cleanup(it->second);
+    }
+};
+
+struct listEntry_t
+{                                 /* cached listing of one remote directory */
+    std::mutex lock;              /* only one thread lists the directory, the others wait for it */
+    bool valid;                   /* the listing is valid */
+    int stat;                     /* XFER_OK or XFER_NOFILE */
+    vector<rfile_t> files;        /* files in the remote directory */
+};
+
+struct target_t
+{                                 /* remote file of the download plan */
+    string url;                   /* remote URL */
+    int stat;                     /* XFER_OK, XFER_NOFILE or XFER_FAILED of probing it */
+    long long size;               /* size of the remote file (-1: unknown) */
+};
+
+struct sink_t
+{                                 /* destination of the received data */
+    FILE *fp;                     /* local file (nullptr: not used) */
+    string *buf;                  /* memory buffer (nullptr: not used) */
+    long long nbytes;             /* number of bytes received */
+    long long limit;              /* maximum number of bytes accepted (0: no limit) */
+    bool lane;                    /* the transfer is in the backfill lane */
+    ZipUtil *zip;                 /* the data are inflated before written to 'fp' (nullptr: as received) */
+    job_t *job;                   /* the data are queued for the conversion threads (nullptr: not) */
+    job_t *xfer;                  /* transfer of the event loop, which is resumed by the loop thread (nullptr: none) */
+    CURL *curl;                   /* easy handle of the transfer */
+    bool held;                    /* the transfer is paused by the bandwidth limits or the busy real-time front */
+};
+
+struct segment_t
+{                                 /* one of the byte ranges of a file downloaded in segments */
+    FILE *fp;                     /* local file positioned at the start of the range */
+    CURL *curl;                   /* easy handle */
+    sink_t sink;                  /* destination of the received data */
+    long long from;               /* first byte of the range */
+    long long to;                 /* last byte of the range */
+    bool ok;                      /* the range is received completely */
+    char errBuf[CURL_ERROR_SIZE]; /* error message of libcurl */
+};
+
+struct attempt_t
+{                                 /* one of the hedged transfers of a file */
+    string url;                   /* remote URL */
+    string partFile;              /* local file being downloaded */
+    FILE *fp;                     /* pointer of 'partFile' */
+    CURL *curl;                   /* easy handle */
+    sink_t sink;                  /* destination of the received data */
+    long long offset;             /* number of bytes received before (resumed) */
+    double t0;                    /* start time (s) */
+    bool done;                    /* the transfer has finished */
+    int stat;                     /* XFER_OK, XFER_NOFILE or XFER_FAILED */
+    char errBuf[CURL_ERROR_SIZE]; /* error message of libcurl */
+};
+
+struct job_t
+{                                 /* transfer submitted to the event loop */
+    string url;                   /* remote URL */
+    string localFile;             /* local file */
+    string partFile;              /* local file being downloaded */
+    string outFile;               /* decompressed file of the compressed file (empty: not inflated) */
+    string rnxFile;               /* RINEX file of the compressed Compact RINEX file (empty: not converted) */
+    string cls;                   /* product class for the health history */
+    string path;                  /* full path of 'localFile', which is the key of the journal */
+    string task;                  /* download task for the latency model (empty: not recorded) */
+    long long size;               /* size of the remote file in the listing (-1: unknown) */
+    long long offset;             /* number of bytes in 'partFile' received before */
+    FILE *fp;                     /* pointer of 'partFile' */
+    CURL *curl;                   /* easy handle */
+    sink_t sink;                  /* destination of the received data */
+    int ntry;                     /* number of the failed attempts */
+    bool restart;                 /* the transfer has been restarted from the beginning */
+    int fmt;                      /* format of the compressed file, ZIP_GZIP or ZIP_LZW */
+    bool stream;                  /* the compressed file is inflated while it is received */
+    ZipUtil zip;                  /* inflation of the compressed file */
+    CrxUtil crx;                  /* decoding of the inflated Compact RINEX file */
+    ZipUtil gz;                   /* compression of the RINEX file ('*.gz') */
+    int nzip;                     /* number of threads compressing the RINEX file */
+    double notBefore;             /* the transfer is not started before it (s) */
+    xferDone_t done;              /* completion callback (empty: none) */
+    std::promise<int> result;     /* status of the transfer */
+    char errBuf[CURL_ERROR_SIZE]; /* error message of libcurl */
+    int code;                     /* result code of libcurl of the finished transfer */
+    long resp;                    /* response code of the server */
+    double ttfb;                  /* time to the first byte (s) */
+    double secs;                  /* total time of the transfer (s) */
+    bool inflated;                /* the stream is inflated completely, or the file is unpacked */
+    loop_t *loop;                 /* event loop of the transfer */
+    std::deque<string> chunks;    /* data received but not inflated yet */
+    size_t nqueued;               /* number of bytes in 'chunks' */
+    bool queued;                  /* the transfer is waiting for or being handled by the conversion threads */
+    bool ended;                   /* the transfer has finished, and its stream ends after 'chunks' */
+    bool paused;                  /* the transfer is paused as 'chunks' are full */
+    bool failed;                  /* the data failed to be inflated or converted */
+    bool claimed;                 /* 'path' is taken by the transfer until it is done */
+};
+
+struct loop_t
+{                                 /* event loop of the multiplexed transfers */
+    std::thread thr;              /* thread running the loop */
+    std::mutex lock;              /* lock of 'queue' and 'stop' */
+    std::deque<job_t *> queue;    /* transfers waiting to be started */
+    bool stop;                    /* the loop exits when all the transfers are done */
+    CURLM *multi;                 /* multi handle */
+    int nactive;                  /* number of transfers in flight */
+    vector<CURL *> idle;          /* easy handles for reuse */
+#ifdef __linux__
+    int epfd;                     /* epoll instance */
+    int wakefd;                   /* eventfd to wake the loop up for the new transfers */
+    double deadline;              /* time of the timeout requested by libcurl (s, < 0: none) */
+#endif
+    vector<std::thread> convThr;  /* conversion threads inflating and converting the received data */
+    std::mutex convLock;          /* lock of the conversion stage and the queued data of the transfers */
+    std::condition_variable convCond;  /* the conversion threads wait for the data */
+    std::deque<job_t *> convQueue;     /* transfers with data to be converted */
+    vector<job_t *> resumed;      /* paused transfers with room in their queues again */
+    vector<job_t *> converted;    /* finished transfers converted completely, which are closed in the loop thread */
+    vector<job_t *> held;         /* transfers paused by the bandwidth limits or the busy real-time front */
+    bool convStop;                /* the conversion threads exit when 'convQueue' is empty */
+    int nconv;                    /* number of the finished transfers in the conversion stage */
+};
+
+
+/* global variables ----------------------------------------------------------*/
+static std::once_flag _initFlag;                        /* libcurl is initialized once per process */
+static CURLSH *_share = nullptr;                        /* DNS and TLS sessions shared by all handles */
+static std::mutex _shareLock[CURL_LOCK_DATA_LAST];      /* locks of the shared data */
+static thread_local handleCache_t _handleCache;         /* reusable handles of the current thread */
+static std::mutex _listLock;                            /* lock of the listing cache */
+static std::map<string, std::shared_ptr<listEntry_t>> _listCache;  /* listings of the remote directories in this run */
+static std::mutex _fileLock;                            /* lock of the local files being downloaded */
+static std::condition_variable _fileCond;               /* signaled when a local file is released */
+static std::set<string> _fileBusy;                      /* full paths of the local files being downloaded */
+static std::mutex _missLock;                            /* lock of the missing remote files */
+static std::set<string> _missing;                       /* remote files found missing in this run */
+static std::mutex _planLock;                            /* lock of the download plan */
+static std::map<string, target_t> _probed;              /* remote files probed for the plan, by the URL */
+static std::map<string, string> _manifest;              /* URLs of the plan, by the full path of the local file */
+static JournalUtil _journal;                            /* journal of the downloads shared by all the days (not opened: off) */
+static std::once_flag _latencyFlag;                     /* the latency model is read once per process */
+static LatencyUtil _latency;                            /* latency model of the publication of the products */
+static std::once_flag _healthFlag;                      /* the health history is read once per process */
+static HealthUtil _health;                              /* health history of the hosts shared by all the days */
+static std::mutex _laneLock;                            /* lock of the state of the real-time front */
+static std::condition_variable _laneCond;               /* signaled when the real-time front is idle */
+static int _frontBusy = 0;                              /* number of the real-time downloads running now */
+static rate_t _allRate;                                 /* bandwidth limit of all the transfers of the process */
+static rate_t _laneRate;                                /* bandwidth limit of the backfill lane of the process */
+
+
+/* local functions -----------------------------------------------------------*/
+static void ShareLock(CURL *handle, curl_lock_data data, curl_lock_access access, void *userptr)
+{
+    _shareLock[data].lock();
+}
+
+static void ShareUnlock(CURL *handle, curl_lock_data data, void *userptr)
+{
+    _shareLock[data].unlock();
+}
+
+static void GlobalInit()
+{
+    curl_global_init(CURL_GLOBAL_ALL);
+
+    _share = curl_share_init();
+    curl_share_setopt(_share, CURLSHOPT_LOCKFUNC, ShareLock);
+    curl_share_setopt(_share, CURLSHOPT_UNLOCKFUNC, ShareUnlock);
+    curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+
+    /* the connections are not shared, as the handles are used by several threads at the same time; they are
+       reused by the easy handle of each thread and by the pool of each multi handle */
+}
+
+/* get the full path of the local file in the working directory of the calling thread */
+static string FullPath(const string &localFile)
+{
+    string path = localFile;
+    while (path.size() > 2 && path[0] == '.' && (path[1] == '/' || path[1] == '\\')) path.erase(0, 2);
+    char cwd[MAXSTRPATH];
+    bool isFull = !path.empty() && (path[0] == '/' || path[0] == '\\' || (path.size() > 1 && path[1] == ':'));
+    if (!isFull && getcwd(cwd, sizeof(cwd))) path = string(cwd) + (char)FILEPATHSEP + path;
+
+    return path;
+}
+
+/* wait until no other thread downloads the local file, and take it (the full path of the file is returned) */
+static string ClaimFile(const string &localFile)
+{
+    string path = FullPath(localFile);
+    std::unique_lock<std::mutex> lock(_fileLock);
+    _fileCond.wait(lock, [&]() { return _fileBusy.count(path) == 0; });
+    _fileBusy.insert(path);
+
+    return path;
+}
+
+/* take the local file of the full path if no other thread downloads it, without waiting */
+static bool TryClaimFile(const string &path)
+{
+    std::lock_guard<std::mutex> lock(_fileLock);
+
+    return _fileBusy.insert(path).second;
+}
+
+/* release the local file taken by ClaimFile or TryClaimFile */
+static void ReleaseFile(const string &path)
+{
+    std::lock_guard<std::mutex> lock(_fileLock);
+    _fileBusy.erase(path);
+    _fileCond.notify_all();
+}
+
+/* get the current time in seconds */
+static double NowSec()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/* wait until the real-time front is idle */
+static void WaitFront()
+{
+    std::unique_lock<std::mutex> lock(_laneLock);
+    _laneCond.wait(lock, []() { return _frontBusy == 0; });
+}
+
+/* refill the bucket, and check if it is empty */
+static bool IsSpent(rate_t *rate)
+{
+    std::lock_guard<std::mutex> lock(rate->lock);
+    if (rate->bps <= 0.0) return false;
+
+    double now = NowSec();
+    rate->tokens += (now - rate->tlast) * rate->bps;
+    if (rate->tokens > rate->bps) rate->tokens = rate->bps;  /* the burst is up to one second of data */
+    rate->tlast = now;
+
+    return rate->tokens <= 0.0;
+}
+
+/* take the data received from the bucket */
+static void Spend(rate_t *rate, size_t n)
+{
+    std::lock_guard<std::mutex> lock(rate->lock);
+    if (rate->bps > 0.0) rate->tokens -= (double)n;
+}
+
+/* set the bandwidth limit of the bucket */
+static void SetRate(rate_t *rate, double bps)
+{
+    std::lock_guard<std::mutex> lock(rate->lock);
+    if (bps == rate->bps) return;
+    rate->bps = bps;
+    rate->tokens = 0.0;
+    rate->tlast = NowSec();
+}
+
+/* check if the transfer should be held, as the bandwidth of the process or of the backfill lane is used up,
+   or the transfer of the backfill lane gives way to the busy real-time front */
+static bool IsHeld(const sink_t *sink)
+{
+    if (IsSpent(&_allRate)) return true;
+    if (!sink->lane) return false;
+    if (IsSpent(&_laneRate)) return true;
+    std::lock_guard<std::mutex> lock(_laneLock);
+
+    return _frontBusy > 0;
+}
+
+/* queue the received data for the conversion threads, and pause the transfer while its queue is full */
+static size_t PushData(job_t *job, const char *ptr, size_t n)
+{
+    loop_t *loop = job->loop;
+    std::lock_guard<std::mutex> lock(loop->convLock);
+    if (job->failed) return 0;  /* abort the transfer of the corrupted data */
+    if (job->nqueued >= MAXQUEUED)
+    {
+        job->paused = true;
+
+        return CURL_WRITEFUNC_PAUSE;
+    }
+    job->chunks.emplace_back(ptr, n);
+    job->nqueued += n;
+    if (!job->queued)
+    {
+        job->queued = true;
+        loop->convQueue.push_back(job);
+        loop->convCond.notify_one();
+    }
+
+    return n;
+}
+
+static size_t WriteData(char *ptr, size_t size, size_t nmemb, void *userdata)
+{
+    sink_t *sink = (sink_t *)userdata;
+    size_t n = size * nmemb;
+    if (sink->limit > 0 && sink->nbytes + (long long)n > sink->limit) return 0;  /* more data than the range */
+
+    /* the held transfer is paused and the data are delivered again when it is resumed, by the loop thread for
+       the transfer of the event loop, or by the progress callback for the others */
+    if (IsHeld(sink))
+    {
+        sink->held = true;
+        if (sink->xfer) sink->xfer->loop->held.push_back(sink->xfer);
+
+        return CURL_WRITEFUNC_PAUSE;
+    }
+    if (sink->job)
+    {
+        size_t ret = PushData(sink->job, ptr, n);
+        if (ret != n) return ret;  /* paused or aborted */
+    }
+    Spend(&_allRate, n);
+    if (sink->lane) Spend(&_laneRate, n);
+    if (sink->zip && !sink->zip->Inflate(ptr, n, sink->fp)) return 0;  /* corrupted data */
+    else if (!sink->zip && sink->fp && fwrite(ptr, 1, n, sink->fp) != n) return 0;  /* abort the transfer */
+    if (sink->buf) sink->buf->append(ptr, n);
+    sink->nbytes += n;
+
+    return n;
+}
+
+/* resume the held transfer out of the event loop, as libcurl calls it while the transfer is paused */
+static int ProgressData(void *clientp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal, curl_off_t ulnow)
+{
+    sink_t *sink = (sink_t *)clientp;
+    if (sink->held && !sink->xfer && !IsHeld(sink))
+    {
+        sink->held = false;
+        curl_easy_pause(sink->curl, CURLPAUSE_CONT);
+    }
+
+    return 0;
+}
+
+static size_t HeaderData(char *ptr, size_t size, size_t nmemb, void *userdata)
+{
+    size_t n = size * nmemb;
+    ((string *)userdata)->append(ptr, n);
+
+    return n;
+}
+
+/* get the scheme and host part of URL, i.e., "ftp://igs.gnsswhu.cn" */
+static string HostOf(const string &url)
+{
+    size_t pos = url.find("://");
+    if (pos == string::npos) return url;
+    pos = url.find('/', pos + 3);
+
+    return pos == string::npos ? url : url.substr(0, pos);
+}
+
+/* get the easy handle of the host, which keeps its connection alive between transfers */
+static CURL *GetHandle(const string &url)
+{
+    std::call_once(_initFlag, GlobalInit);
+
+    string host = HostOf(url);
+    auto it = _handleCache.handles.find(host);
+    if (it != _handleCache.handles.end()) return it->second;
+
+    CURL *curl = curl_easy_init();
+    _handleCache.handles[host] = curl;
+
+    return curl;
+}
+
+/* check if the error is worth retrying */
+static bool IsTransient(CURLcode code)
+{
+    switch (code)
+    {
+    case CURLE_COULDNT_CONNECT:
+    case CURLE_OPERATION_TIMEDOUT:
+    case CURLE_PARTIAL_FILE:
+    case CURLE_GOT_NOTHING:
+    case CURLE_SEND_ERROR:
+    case CURLE_RECV_ERROR:
+    case CURLE_SSL_CONNECT_ERROR:
+    case CURLE_FTP_ACCEPT_TIMEOUT:
+    case CURLE_FTP_CANT_GET_HOST:
+    case CURLE_FTP_WEIRD_PASV_REPLY:
+    case CURLE_FTP_WEIRD_227_FORMAT:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/* set the options of the transfer, and 'ftps://' of CDDIS is explicit FTPS, i.e., 'AUTH TLS' on the normal FTP port */
+static void SetOptions(CURL *curl, const string &url, sink_t *sink, char *errBuf, const char *ftpCmd, long long resume)
+{
+    string xurl = url;
+    bool useSsl = false;
+    if (xurl.compare(0, 7, "ftps://") == 0)
+    {
+        xurl = "ftp://" + xurl.substr(7);
+        useSsl = true;
+    }
+
+    /* the connection cache, DNS cache and TLS session are kept by curl_easy_reset */
+    curl_easy_reset(curl);
+    curl_easy_setopt(curl, CURLOPT_SHARE, _share);
+    curl_easy_setopt(curl, CURLOPT_URL, xurl.c_str());
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(curl, CURLOPT_USERAGENT, USERAGENT);
+    curl_easy_setopt(curl, CURLOPT_ERRORBUFFER, errBuf);
+    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, CONNTIMEOUT);
+    curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, 1L);
+    curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, LOWSPEEDTIME);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
+    curl_easy_setopt(curl, CURLOPT_NETRC, (long)CURL_NETRC_OPTIONAL);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteData);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, sink);
+    curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+    curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, ProgressData);
+    curl_easy_setopt(curl, CURLOPT_XFERINFODATA, sink);
+    curl_easy_setopt(curl, CURLOPT_PRIVATE, (void *)sink);
+    sink->curl = curl;
+    sink->held = false;
+    if (resume > 0) curl_easy_setopt(curl, CURLOPT_RESUME_FROM_LARGE, (curl_off_t)resume);
+    if (xurl.compare(0, 6, "ftp://") == 0)
+    {
+        curl_easy_setopt(curl, CURLOPT_FTP_FILEMETHOD, (long)CURLFTPMETHOD_SINGLECWD);
+        if (useSsl) curl_easy_setopt(curl, CURLOPT_USE_SSL, (long)CURLUSESSL_ALL);
+        if (ftpCmd && strcmp(ftpCmd, "NLST") == 0) curl_easy_setopt(curl, CURLOPT_DIRLISTONLY, 1L);
+        else if (ftpCmd) curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, ftpCmd);
+    }
+}
+
+/* check if the remote file or directory does not exist */
+static bool IsNoFile(CURLcode code, long resp)
+{
+    return code == CURLE_REMOTE_FILE_NOT_FOUND || code == CURLE_FTP_COULDNT_RETR_FILE ||
+        (code == CURLE_REMOTE_ACCESS_DENIED && resp == 550) ||
+        (code == CURLE_HTTP_RETURNED_ERROR && (resp == 404 || resp == 410));
+}
+
+/* wake the event loop up for the new transfers */
+static void WakeLoop(loop_t *loop)
+{
+#ifdef __linux__
+    uint64_t one = 1;
+    if (write(loop->wakefd, &one, sizeof(one)) < 0) return;
+#else
+    curl_multi_wakeup(loop->multi);
+#endif
+}
+
+#ifdef __linux__
+/* watch the sockets of libcurl by epoll */
+static int SocketCb(CURL *easy, curl_socket_t s, int what, void *userp, void *socketp)
+{
+    loop_t *loop = (loop_t *)userp;
+    if (what == CURL_POLL_REMOVE)
+    {
+        epoll_ctl(loop->epfd, EPOLL_CTL_DEL, s, nullptr);
+
+        return 0;
+    }
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.data.fd = s;
+    if (what & CURL_POLL_IN) ev.events |= EPOLLIN;
+    if (what & CURL_POLL_OUT) ev.events |= EPOLLOUT;
+    if (epoll_ctl(loop->epfd, EPOLL_CTL_MOD, s, &ev) != 0) epoll_ctl(loop->epfd, EPOLL_CTL_ADD, s, &ev);
+
+    return 0;
+}
+
+/* keep the timeout requested by libcurl for epoll_wait, which is fired only once */
+static int TimerCb(CURLM *multi, long timeoutMs, void *userp)
+{
+    ((loop_t *)userp)->deadline = timeoutMs < 0 ? -1.0 : NowSec() + timeoutMs / 1000.0;
+
+    return 0;
+}
+#endif
+
+/* get the full path of the file in the directory of the full path of the local file */
+static string SameDir(const string &path, const string &file)
+{
+    size_t i = path.find_last_of("/\\"), j = file.find_last_of("/\\");
+
+    return path.substr(0, i == string::npos ? 0 : i + 1) + (j == string::npos ? file : file.substr(j + 1));
+}
+
+/* record the end of the download in the journal, and the file it ends in is verified by its size and CRC-32 */
+static void JournalEnd(const string &path, const string &url, int stat, const string &outFile, const string &rnxFile)
+{
+    if (!_journal.IsOpen()) return;
+    if (stat != XFER_OK)
+    {
+        _journal.Record(path, url, JNL_PENDING);
+
+        return;
+    }
+
+    /* the RINEX file converted, the file decompressed, or the file as it is downloaded */
+    string file = path;
+    string rnx = rnxFile.empty() ? "" : SameDir(path, rnxFile);
+    string out = outFile.empty() ? "" : SameDir(path, outFile);
+    if (!rnx.empty() && access(rnx.c_str(), 0) == 0)
+    {
+        file = rnx;
+        _journal.Record(path, url, JNL_CONVERTED, file);
+    }
+    else if (!out.empty() && access(out.c_str(), 0) == 0)
+    {
+        file = out;
+        _journal.Record(path, url, JNL_DECOMPRESSED, file);
+    }
+
+    long long size;
+    unsigned long crc;
+    if (JournalUtil::Checksum(file, size, crc)) _journal.Record(path, url, JNL_VERIFIED, file, size, crc);
+    else _journal.Record(path, url, JNL_PENDING);
+}
+
+/* record the delay of the new file after its nominal epoch in the latency model of the task */
+static void RecordLatency(const string &task, const string &url)
+{
+    double epoch;
+    if (!task.empty() && LatencyUtil::EpochOf(url, &epoch)) _latency.Record(task, HostOf(url), epoch, (double)time(NULL));
+}
+
+/* fulfil the callback and the future of the transfer done in the event loop, and free it */
+static void Complete(job_t *job, int stat)
+{
+    if (job->loop) JournalEnd(job->path, job->url, stat, job->outFile, job->rnxFile);
+    if (job->loop && stat == XFER_OK) RecordLatency(job->task, job->url);
+    string file = job->localFile;
+    if (stat == XFER_OK && !job->rnxFile.empty() && access(job->rnxFile.c_str(), 0) == 0) file = job->rnxFile;
+    else if (stat == XFER_OK && !job->outFile.empty()) file = job->outFile;
+    if (job->claimed) ReleaseFile(job->path);
+    if (job->done) job->done(stat, file);
+    job->result.set_value(stat);
+    delete job;
+}
+
+/* get the compression format shared by the remote and local files, ZIP_NONE if they differ */
+static int ZipFormat(const string &url, const string &localFile)
+{
+    ZipUtil zip;
+    int fmt = zip.Format(url);
+
+    return fmt == zip.Format(localFile) ? fmt : ZIP_NONE;
+}
+
+/* get the RINEX file of the Compact RINEX file, '*.yyd' to '*.yyo' and '*.crx' to '*.rnx' (empty: not Compact RINEX) */
+static string RnxName(const string &crxFile)
+{
+    size_t len = crxFile.size();
+    if (len > 4 && (crxFile.compare(len - 4, 4, ".crx") == 0 || crxFile.compare(len - 4, 4, ".CRX") == 0))
+        return crxFile.substr(0, len - 3) + (crxFile[len - 1] == 'x' ? "rnx" : "RNX");
+    if (len > 4 && crxFile[len - 4] == '.' && isdigit((unsigned char)crxFile[len - 3]) &&
+        isdigit((unsigned char)crxFile[len - 2]) && (crxFile[len - 1] == 'd' || crxFile[len - 1] == 'D'))
+        return crxFile.substr(0, len - 1) + (crxFile[len - 1] == 'd' ? "o" : "O");
+
+    return "";
+}
+
+/* get the decompressed file and the RINEX file the downloaded file is saved as (empty: not inflated, or not converted) */
+static void OutNames(const string &localFile, int fmt, bool crx2rnx, int rnxGzip, string &outFile, string &rnxFile)
+{
+    outFile = fmt == ZIP_NONE ? "" : localFile.substr(0, localFile.size() - (fmt == ZIP_GZIP ? 3 : 2));
+    rnxFile = !outFile.empty() && crx2rnx ? RnxName(outFile) : "";
+    if (!rnxFile.empty() && rnxGzip > 0) rnxFile += ".gz";
+}
+
+/* get the format the downloaded file is inflated from, ZIP_NONE if it is saved as it is, i.e., the Compact RINEX file kept compressed */
+static int InflateFormat(const string &url, const string &localFile, bool inflate, bool keepCrx)
+{
+    int fmt = inflate ? ZipFormat(url, localFile) : ZIP_NONE;
+    if (fmt == ZIP_NONE || !keepCrx) return fmt;
+
+    return RnxName(localFile.substr(0, localFile.size() - (fmt == ZIP_GZIP ? 3 : 2))).empty() ? fmt : ZIP_NONE;
+}
+
+/* decompress the downloaded compressed file, and decode it to 'rnxFile' directly if it is given, compressed if it is '*.gz' */
+static bool Unpack(const string &localFile, const string &rnxFile, int nzip)
+{
+    ZipUtil zip;
+    if (!rnxFile.empty())
+    {
+        CrxUtil crx;
+        ZipUtil gz;
+        if (zip.Format(rnxFile) == ZIP_GZIP)
+        {
+            gz.SetThreads(nzip);
+            crx.SetGzip(&gz);
+        }
+        zip.SetCrx(&crx);
+        if (zip.Expand(localFile, rnxFile, zip.Format(localFile)))
+        {
+            remove(localFile.c_str());
+
+            return true;
+        }
+        zip.SetCrx(nullptr);
+        cout << "*** WARNING(CurlUtil::Unpack): " << localFile << " is not a valid Compact RINEX file, only decompress it" << endl;
+    }
+
+    return zip.Decompress(localFile);
+}
+
+/* hand the finished transfer over to the conversion threads, which end its stream or unpack its file, and it is not resumed any more */
+static void EndStage(loop_t *loop, job_t *job)
+{
+    std::lock_guard<std::mutex> lock(loop->convLock);
+    job->ended = true;
+    job->paused = false;
+    loop->resumed.erase(std::remove(loop->resumed.begin(), loop->resumed.end(), job), loop->resumed.end());
+    loop->nconv++;
+    if (!job->queued)
+    {
+        job->queued = true;
+        loop->convQueue.push_back(job);
+        loop->convCond.notify_one();
+    }
+}
+
+/* run the conversion thread, and the data of one transfer are inflated and converted in order by one thread at a time */
+static void RunStage(loop_t *loop)
+{
+    std::unique_lock<std::mutex> lock(loop->convLock);
+    while (true)
+    {
+        loop->convCond.wait(lock, [loop] { return loop->convStop || !loop->convQueue.empty(); });
+        if (loop->convQueue.empty()) return;
+        job_t *job = loop->convQueue.front();
+        loop->convQueue.pop_front();
+
+        /* the queued data, and the paused transfer is resumed by the loop thread when half of its queue is free */
+        bool wake = false;
+        while (!job->chunks.empty())
+        {
+            string data = std::move(job->chunks.front());
+            job->chunks.pop_front();
+            bool failed = job->failed;
+            lock.unlock();
+            if (!failed && !job->zip.Inflate(data.data(), data.size(), job->fp)) failed = true;
+            lock.lock();
+            job->failed = failed;
+            job->nqueued -= data.size();
+            if (job->paused && job->nqueued <= MAXQUEUED / 2)
+            {
+                job->paused = false;
+                loop->resumed.push_back(job);
+                wake = true;
+            }
+        }
+        if (!job->ended)
+        {
+            job->queued = false;
+            if (wake) WakeLoop(loop);
+            continue;
+        }
+
+        /* the end of the stream, or the downloaded compressed file */
+        lock.unlock();
+        if (job->stream) job->inflated = !job->failed && job->zip.EndInflate(job->fp);
+        else job->inflated = Unpack(job->localFile, job->rnxFile, job->nzip);
+        lock.lock();
+        loop->converted.push_back(job);
+        WakeLoop(loop);
+    }
+}
+
+/* get the file name of the on-disk listing cache of the remote directory */
+static string ListCacheFile(const string &cacheDir, const string &url)
+{
+    string name = url;
+    for (size_t i = 0; i < name.size(); i++)
+    {
+        if (!isalnum((unsigned char)name[i]) && name[i] != '.' && name[i] != '-') name[i] = '_';
+    }
+
+    return cacheDir + (char)FILEPATHSEP + name + ".lst";
+}
+
+/* decode '%xx' in URL */
+static string UrlDecode(const string &src)
+{
+    string dst;
+    for (size_t i = 0; i < src.size(); i++)
+    {
+        if (src[i] == '%' && i + 2 < src.size() && isxdigit(src[i + 1]) && isxdigit(src[i + 2]))
+        {
+            dst += (char)strtol(src.substr(i + 1, 2).c_str(), nullptr, 16);
+            i += 2;
+        }
+        else dst += src[i];
+    }
+
+    return dst;
+}
+
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : RecordHealth - record the finished transfer in the health history of the host
+* @param[I]: curl (easy handle of the transfer)
+* @param[I]: url (remote URL)
+* @param[I]: stat (XFER_OK, XFER_NOFILE or XFER_FAILED)
+* @param[I]: nbytes (number of bytes received)
+* @return  : none
+* @note    :
+**/
+void CurlUtil::RecordHealth(CURL *curl, const string &url, int stat, long long nbytes)
+{
+    double ttfb = 0.0, secs = 0.0;
+    curl_easy_getinfo(curl, CURLINFO_STARTTRANSFER_TIME, &ttfb);
+    curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME, &secs);
+    _health.Record(HostOf(url), _class, stat, ttfb, (double)nbytes, secs);
+} /* end of RecordHealth */
+
+/**
+* @brief   : Perform - run one transfer on the reusable connection of the host
+* @param[I]: url (remote URL)
+* @param[I]: fp (local file for the received data, nullptr:NO output)
+* @param[I]: offset (number of bytes in 'fp' received before, the transfer is resumed from it)
+* @param[O]: buf (memory buffer for the received data, nullptr:NO output)
+* @param[I]: ftpCmd (FTP listing command, i.e., "MLSD", "NLST", nullptr:file transfer)
+* @param[O]: nbytes (number of bytes received, nullptr:NO output)
+* @param[I]: zip (the data are inflated before written to 'fp', nullptr:as received)
+* @return  : XFER_OK, XFER_NOFILE, XFER_FAILED or XFER_NORANGE (the transfer cannot be resumed)
+* @note    : transient errors are retried up to a few times, and the file transfer is resumed from
+*            the data received in the last attempt; the inflated transfer is not retried
+**/
+int CurlUtil::Perform(const string &url, FILE *fp, long long offset, string *buf, const char *ftpCmd, long long *nbytes, ZipUtil *zip)
+{
+    CURL *curl = GetHandle(url.compare(0, 7, "ftps://") == 0 ? "ftp://" + url.substr(7) : url);
+    char errBuf[CURL_ERROR_SIZE] = { '\0' };
+    CURLcode code = CURLE_OK;
+    long resp = 0;
+    sink_t sink = { fp, buf, 0, 0, _backfill, zip, nullptr, nullptr, curl, false };
+    for (int i = 0; i < MAXRETRY; i++)
+    {
+        if (i > 0)
+        {
+            /* the inflated stream cannot be resumed, which is handled by the caller */
+            if (zip) break;
+
+            /* the data of the last attempt are kept in the file, and discarded in the memory buffer */
+            if (fp && fflush(fp) != 0) break;
+            if (buf)
+            {
+                buf->clear();
+                sink.nbytes = 0;
+            }
+#ifdef _WIN32   /* for Windows */
+            Sleep(1000 * i);
+#else           /* for Linux or Mac */
+            sleep(i);
+#endif
+        }
+
+        SetOptions(curl, url, &sink, errBuf, ftpCmd, fp ? offset + sink.nbytes : 0);
+        errBuf[0] = '\0';
+        code = curl_easy_perform(curl);
+        if (code == CURLE_OK || !IsTransient(code)) break;
+    }
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &resp);
+    if (nbytes) *nbytes = sink.nbytes;
+
+    /* the server does not support HTTP Range or FTP REST, or the range is beyond the file */
+    if (fp && offset + sink.nbytes > 0 && (code == CURLE_RANGE_ERROR || code == CURLE_FTP_COULDNT_USE_REST ||
+        code == CURLE_BAD_DOWNLOAD_RESUME || (code == CURLE_HTTP_RETURNED_ERROR && resp == 416))) return XFER_NORANGE;
+
+    /* the listing command rejected by the server is not the fault of the host */
+    int stat = code == CURLE_OK ? XFER_OK : (IsNoFile(code, resp) ? XFER_NOFILE : XFER_FAILED);
+    if (!ftpCmd || stat != XFER_FAILED) RecordHealth(curl, url, stat, sink.nbytes);
+    if (stat == XFER_OK) return XFER_OK;
+
+    /* the remote file or directory does not exist */
+    if (stat == XFER_NOFILE)
+    {
+        if (_verbose) cout << "*** INFO(CurlUtil::Perform): " << url << " does not exist" << endl;
+
+        return XFER_NOFILE;
+    }
+
+    /* listing commands may be rejected by the server, which is handled by the caller */
+    if (!ftpCmd || _verbose) cout << "*** WARNING(CurlUtil::Perform): failed to transfer " << url << ", " <<
+        (errBuf[0] != '\0' ? errBuf : curl_easy_strerror(code)) << endl;
+
+    return XFER_FAILED;
+} /* end of Perform */
+
+/**
+* @brief   : ParseMlsd - parse the reply of FTP 'MLSD' command
+* @param[I]: buf (reply of 'MLSD')
+* @param[O]: files (regular files in the directory)
+* @return  : none
+* @note    :
+**/
+void CurlUtil::ParseMlsd(const string &buf, vector<rfile_t> &files)
+{
+    /* i.e., "type=file;size=1413720;modify=20210102004911;UNIX.mode=0644; abmf0010.21d.gz" */
+    StringUtil str;
+    size_t pos = 0;
+    while (pos < buf.size())
+    {
+        size_t end = buf.find('\n', pos);
+        if (end == string::npos) end = buf.size();
+        string line = buf.substr(pos, end - pos);
+        pos = end + 1;
+        if (!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+
+        size_t sp = line.find(' ');
+        if (sp == string::npos) continue;
+        string facts = line.substr(0, sp), name = line.substr(sp + 1);
+        str.ToLower(facts);
+        if (facts.find("type=file;") == string::npos) continue;
+
+        rfile_t file = { name, -1 };
+        size_t ps = facts.find("size=");
+        if (ps != string::npos) file.size = atoll(facts.c_str() + ps + 5);
+        files.push_back(file);
+    }
+} /* end of ParseMlsd */
+
+/**
+* @brief   : ParseNlst - parse the reply of FTP 'NLST' command
+* @param[I]: buf (reply of 'NLST')
+* @param[O]: files (entries in the directory, size is unknown)
+* @return  : none
+* @note    :
+**/
+void CurlUtil::ParseNlst(const string &buf, vector<rfile_t> &files)
+{
+    size_t pos = 0;
+    while (pos < buf.size())
+    {
+        size_t end = buf.find('\n', pos);
+        if (end == string::npos) end = buf.size();
+        string name = buf.substr(pos, end - pos);
+        pos = end + 1;
+        if (!name.empty() && name[name.size() - 1] == '\r') name.erase(name.size() - 1);
+
+        /* some servers reply with the path of the entry */
+        size_t sep = name.rfind('/');
+        if (sep != string::npos) name = name.substr(sep + 1);
+        if (name.empty() || name == "." || name == "..") continue;
+
+        rfile_t file = { name, -1 };
+        files.push_back(file);
+    }
+} /* end of ParseNlst */
+
+/**
+* @brief   : ParseHtml - parse the HTML index page of HTTP(S) directory
+* @param[I]: buf (HTML page)
+* @param[O]: files (linked files in the directory, size is unknown)
+* @return  : none
+* @note    :
+**/
+void CurlUtil::ParseHtml(const string &buf, vector<rfile_t> &files)
+{
+    size_t pos = 0;
+    while ((pos = buf.find("href=", pos)) != string::npos)
+    {
+        pos += 5;
+        if (pos >= buf.size()) break;
+        char quote = buf[pos];
+        if (quote != '"' && quote != '\'') continue;
+        size_t end = buf.find(quote, pos + 1);
+        if (end == string::npos) break;
+        string link = buf.substr(pos + 1, end - pos - 1);
+        pos = end + 1;
+
+        /* skip sorting links, parent directory, sub-directories and absolute links */
+        if (link.empty() || link[0] == '?' || link[0] == '#' || link[0] == '/') continue;
+        if (link.find("://") != string::npos || link[link.size() - 1] == '/') continue;
+        if (link.compare(0, 2, "./") == 0) link = link.substr(2);
+
+        rfile_t file = { UrlDecode(link), -1 };
+        bool isNew = true;
+        for (size_t i = 0; i < files.size(); i++)
+        {
+            if (files[i].name == file.name)
+            {
+                isNew = false;
+                break;
+            }
+        }
+        if (isNew) files.push_back(file);
+    }
+} /* end of ParseHtml */
+
+/**
+* @brief   : SetVerbose - (not) print the information of each transfer
+* @param[I]: verbose (true: print, false: quiet)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void CurlUtil::SetVerbose(bool verbose)
+{
+    _verbose = verbose;
+} /* end of SetVerbose */
+
+/**
+* @brief   : Head - get the size of the remote file of HTTP(S) and whether byte ranges are supported
+* @param[I]: url (full URL of the remote file)
+* @param[O]: size (size of the remote file, -1: unknown)
+* @param[O]: ranges (true: 'Accept-Ranges: bytes' is returned by the server)
+* @return  : XFER_OK, XFER_NOFILE or XFER_FAILED
+* @note    :
+**/
+int CurlUtil::Head(const string &url, long long *size, bool *ranges)
+{
+    *size = -1;
+    *ranges = false;
+
+    CURL *curl = GetHandle(url);
+    char errBuf[CURL_ERROR_SIZE] = { '\0' };
+    sink_t sink = { nullptr, nullptr, 0, 0, false, nullptr, nullptr, nullptr, curl, false };
+    string header;
+    SetOptions(curl, url, &sink, errBuf, nullptr, 0);
+    curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, HeaderData);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, &header);
+    CURLcode code = curl_easy_perform(curl);
+    long resp = 0;
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &resp);
+    if (code != CURLE_OK) return IsNoFile(code, resp) ? XFER_NOFILE : XFER_FAILED;
+
+    curl_off_t cl = -1;
+    if (curl_easy_getinfo(curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &cl) == CURLE_OK) *size = (long long)cl;
+    for (size_t i = 0; i < header.size(); i++) header[i] = (char)tolower((unsigned char)header[i]);
+    *ranges = header.find("accept-ranges: bytes") != string::npos;
+
+    return XFER_OK;
+} /* end of Head */
+
+/**
+* @brief   : Segmented - download the remote file of HTTP(S) in byte ranges concurrently
+* @param[I]: url (full URL of the remote file)
+* @param[I]: partFile (local file the data are written to)
+* @param[I]: size (size of the remote file)
+* @param[O]: nbytes (number of bytes received)
+* @return  : XFER_OK, XFER_NOFILE or XFER_FAILED
+* @note    : the local file is preallocated, and each range is written to its own position; the transfer
+*            fails if any range is not received completely, i.e., the server ignores the range
+**/
+int CurlUtil::Segmented(const string &url, const string &partFile, long long size, long long *nbytes)
+{
+    *nbytes = 0;
+
+    /* preallocate the local file */
+    FILE *fp = fopen(partFile.c_str(), "wb");
+    if (!fp || ZipUtil::Seek64(fp, size - 1) != 0 || fputc(0, fp) == EOF)
+    {
+        if (fp) fclose(fp);
+        cerr << "*** ERROR(CurlUtil::Segmented): preallocate local file " << partFile << " failed, please check it" << endl;
+
+        return XFER_FAILED;
+    }
+    fclose(fp);
+
+    CURLM *multi = curl_multi_init();
+    long long len = (size + _segCount - 1) / _segCount;
+    vector<segment_t *> segs;
+    for (long long from = 0; from < size; from += len)
+    {
+        segment_t *seg = new segment_t();
+        seg->from = from;
+        seg->to = from + len < size ? from + len - 1 : size - 1;
+        seg->fp = fopen(partFile.c_str(), "r+b");
+        seg->curl = curl_easy_init();
+        seg->sink.fp = seg->fp;
+        seg->sink.buf = nullptr;
+        seg->sink.nbytes = 0;
+        seg->sink.limit = seg->to - seg->from + 1;
+        seg->sink.lane = _backfill;
+        seg->sink.zip = nullptr;
+        seg->sink.job = nullptr;
+        seg->sink.xfer = nullptr;
+        seg->ok = false;
+        seg->errBuf[0] = '\0';
+        segs.push_back(seg);
+        if (!seg->fp || ZipUtil::Seek64(seg->fp, seg->from) != 0) continue;
+
+        string range = to_string(seg->from) + "-" + to_string(seg->to);
+        SetOptions(seg->curl, url, &seg->sink, seg->errBuf, nullptr, 0);
+        curl_easy_setopt(seg->curl, CURLOPT_RANGE, range.c_str());
+        curl_multi_add_handle(multi, seg->curl);
+    }
+
+    int running = 1, nnofile = 0;
+    while (running > 0)
+    {
+        curl_multi_perform(multi, &running);
+
+        CURLMsg *msg;
+        int nmsg;
+        while ((msg = curl_multi_info_read(multi, &nmsg)))
+        {
+            if (msg->msg != CURLMSG_DONE) continue;
+            for (size_t k = 0; k < segs.size(); k++)
+            {
+                if (segs[k]->curl != msg->easy_handle) continue;
+                long resp = 0;
+                curl_easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE, &resp);
+                CURLcode code = msg->data.result;
+                segs[k]->ok = code == CURLE_OK && resp == 206 && segs[k]->sink.nbytes == segs[k]->sink.limit;
+                if (IsNoFile(code, resp)) nnofile++;
+                if (!segs[k]->ok && _verbose) cout << "*** WARNING(CurlUtil::Segmented): failed to transfer the range " <<
+                    segs[k]->from << "-" << segs[k]->to << " of " << url << ", " << (segs[k]->errBuf[0] != '\0' ?
+                    segs[k]->errBuf : curl_easy_strerror(code)) << endl;
+            }
+        }
+        if (running > 0) curl_multi_poll(multi, nullptr, 0, POLLTIMEOUT, nullptr);
+    }
+
+    int stat = XFER_OK;
+    for (size_t k = 0; k < segs.size(); k++)
+    {
+        curl_multi_remove_handle(multi, segs[k]->curl);
+        curl_easy_cleanup(segs[k]->curl);
+        if (segs[k]->fp && fclose(segs[k]->fp) != 0) segs[k]->ok = false;
+        if (!segs[k]->ok) stat = XFER_FAILED;
+        *nbytes += segs[k]->sink.nbytes;
+        delete segs[k];
+    }
+    curl_multi_cleanup(multi);
+    if (stat != XFER_OK && nnofile > 0) stat = XFER_NOFILE;
+    if (stat == XFER_OK && _verbose) cout << "*** INFO(CurlUtil::Segmented): " << url << " is downloaded in " <<
+        segs.size() << " segments" << endl;
+
+    return stat;
+} /* end of Segmented */
+
+/**
+* @brief   : SetRateLimit - set the bandwidth limit of all the transfers of the process
+* @param[I]: bps (bandwidth limit (bytes/s), <= 0: unlimited)
+* @param[O]: none
+* @return  : none
+* @note    : the limit is shared by all the days, the threads and the concurrent transfers; the transfer
+*            beyond it is paused by libcurl until the bucket is refilled
+**/
+void CurlUtil::SetRateLimit(double bps)
+{
+    SetRate(&_allRate, bps);
+} /* end of SetRateLimit */
+
+/**
+* @brief   : SetSegment - set the segmented download of the large file of HTTP(S)
+* @param[I]: count (number of segments, <= 1: off)
+* @param[I]: minSize (the file not smaller than it (bytes) is downloaded in segments)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void CurlUtil::SetSegment(int count, double minSize)
+{
+    _segCount = count;
+    _segMin = (long long)minSize;
+} /* end of SetSegment */
+
+/**
+* @brief   : IsSegmented - check if the remote file is large enough to be downloaded in segments
+* @param[I]: url (full URL of the remote file)
+* @param[I/O]: size (size of the remote file, -1: unknown, which is set by HEAD if it is segmented)
+* @return  : true: the file of HTTP(S) is not smaller than segMin, false: otherwise
+* @note    : the file of unknown size, i.e., most of the files listed by HTTPS, is segmented only if
+*            HEAD returns its size and the server supports byte ranges
+**/
+bool CurlUtil::IsSegmented(const string &url, long long *size)
+{
+    bool isHttp = url.compare(0, 7, "http://") == 0 || url.compare(0, 8, "https://") == 0;
+    if (!isHttp || _segCount <= 1) return false;
+    if (*size >= 0) return *size >= _segMin;
+
+    long long rsize = -1;
+    bool ranges = false;
+    if (Head(url, &rsize, &ranges) != XFER_OK || !ranges || rsize <= 0 || rsize < _segMin) return false;
+    *size = rsize;
+
+    return true;
+} /* end of IsSegmented */
+
+/**
+* @brief   : MirrorsOf - get the URLs of the remote file in all the mirror archives
+* @param[I]: url (full URL of the remote file in the preferred archive)
+* @param[O]: none
+* @return  : URLs of the remote file, the preferred one is the first
+* @note    : the mirror archive with the longest matched prefix is used
+**/
+vector<string> CurlUtil::MirrorsOf(const string &url)
+{
+    vector<string> urls(1, url);
+    size_t igrp = 0, imem = 0, len = 0;
+    for (size_t i = 0; i < _mirrors.size(); i++)
+    {
+        for (size_t j = 0; j < _mirrors[i].size(); j++)
+        {
+            const string &prefix = _mirrors[i][j];
+            if (prefix.size() <= len || url.compare(0, prefix.size(), prefix) != 0) continue;
+            if (url.size() > prefix.size() && url[prefix.size()] != '/') continue;
+            igrp = i;
+            imem = j;
+            len = prefix.size();
+        }
+    }
+    if (len == 0) return urls;
+
+    for (size_t j = 0; j < _mirrors[igrp].size(); j++)
+    {
+        if (j != imem) urls.push_back(_mirrors[igrp][j] + url.substr(len));
+    }
+
+    return urls;
+} /* end of MirrorsOf */
+
+/**
+* @brief   : Hedge - download one remote file from the mirror archives, and the slow transfer is hedged
+*            by a duplicate request to the next mirror
+* @param[I]: urls (URLs of the remote file, the preferred one is the first)
+* @param[I]: partFile (local file the data are written to)
+* @param[I/O]: offset (number of bytes in 'partFile' received before, 0 if it is not resumed)
+* @param[O]: nbytes (number of bytes received)
+* @return  : XFER_OK, XFER_NOFILE or XFER_FAILED
+* @note    : the first finished transfer wins and the others are cancelled, and the data of the winner
+*            are moved to 'partFile'
+**/
+int CurlUtil::Hedge(const vector<string> &urls, const string &partFile, long long &offset, long long *nbytes)
+{
+    std::call_once(_initFlag, GlobalInit);
+
+    CURLM *multi = curl_multi_init();
+    vector<attempt_t *> atts;
+    int winner = -1, nnofile = 0;
+    bool noRange = false;
+    double tLaunch = 0.0;
+    while (true)
+    {
+        /* the next mirror is started if the last one failed, or it is stalled or too slow */
+        double now = NowSec();
+        bool launch = atts.empty();
+        if (!atts.empty() && atts.size() < urls.size())
+        {
+            attempt_t *last = atts.back();
+            double dt = now - last->t0;
+            if (last->done) launch = true;
+            else if (now - tLaunch >= _hedgeDelay && (last->sink.nbytes == 0 || last->sink.nbytes / dt < _hedgeSpeed))
+            {
+                launch = true;
+                if (_verbose) cout << "*** INFO(CurlUtil::Hedge): " << last->url << " is slow (" << last->sink.nbytes <<
+                    " bytes in " << (int)dt << " s), hedged by " << urls[atts.size()] << endl;
+            }
+        }
+        if (launch)
+        {
+            size_t k = atts.size();
+            attempt_t *att = new attempt_t();
+            att->url = urls[k];
+            att->partFile = k == 0 ? partFile : partFile + to_string(k);
+            att->offset = k == 0 ? offset : 0;
+            att->fp = fopen(att->partFile.c_str(), att->offset > 0 ? "ab" : "wb");
+            att->curl = curl_easy_init();
+            att->sink.fp = att->fp;
+            att->sink.buf = nullptr;
+            att->sink.nbytes = 0;
+            att->sink.limit = 0;
+            att->sink.lane = _backfill;
+            att->sink.zip = nullptr;
+            att->sink.job = nullptr;
+            att->sink.xfer = nullptr;
+            att->t0 = now;
+            att->done = att->fp == nullptr;
+            att->stat = XFER_FAILED;
+            att->errBuf[0] = '\0';
+            atts.push_back(att);
+            tLaunch = now;
+            if (att->fp)
+            {
+                SetOptions(att->curl, att->url, &att->sink, att->errBuf, nullptr, att->offset);
+                curl_multi_add_handle(multi, att->curl);
+            }
+            else cerr << "*** ERROR(CurlUtil::Hedge): open local file " << att->partFile << " failed, please check it" << endl;
+        }
+
+        int running = 0;
+        curl_multi_perform(multi, &running);
+
+        /* check the finished transfers */
+        CURLMsg *msg;
+        int nmsg;
+        while ((msg = curl_multi_info_read(multi, &nmsg)))
+        {
+            if (msg->msg != CURLMSG_DONE) continue;
+            for (size_t k = 0; k < atts.size(); k++)
+            {
+                if (atts[k]->curl != msg->easy_handle) continue;
+                long resp = 0;
+                curl_easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE, &resp);
+                CURLcode code = msg->data.result;
+                atts[k]->done = true;
+                if (code == CURLE_OK) atts[k]->stat = XFER_OK;
+                else if (k == 0 && offset > 0 && (code == CURLE_RANGE_ERROR || code == CURLE_FTP_COULDNT_USE_REST ||
+                    code == CURLE_BAD_DOWNLOAD_RESUME || (code == CURLE_HTTP_RETURNED_ERROR && resp == 416))) noRange = true;
+                else if (IsNoFile(code, resp)) atts[k]->stat = XFER_NOFILE;
+                else atts[k]->stat = XFER_FAILED;
+                if (!noRange || k > 0) RecordHealth(atts[k]->curl, atts[k]->url, atts[k]->stat, atts[k]->sink.nbytes);
+                if (atts[k]->stat == XFER_OK && winner < 0) winner = (int)k;
+                else if (atts[k]->stat == XFER_NOFILE) nnofile++;
+                else if (atts[k]->stat == XFER_FAILED && _verbose) cout << "*** WARNING(CurlUtil::Hedge): failed to transfer " <<
+                    atts[k]->url << ", " << (atts[k]->errBuf[0] != '\0' ? atts[k]->errBuf : curl_easy_strerror(code)) << endl;
+            }
+        }
+        if (winner >= 0) break;
+
+        /* all the mirrors are tried */
+        bool allDone = atts.size() == urls.size();
+        for (size_t k = 0; k < atts.size() && allDone; k++) allDone = atts[k]->done;
+        if (allDone) break;
+
+        curl_multi_poll(multi, nullptr, 0, POLLTIMEOUT, nullptr);
+    }
+
+    /* the transfers not finished are cancelled */
+    for (size_t k = 0; k < atts.size(); k++)
+    {
+        curl_multi_remove_handle(multi, atts[k]->curl);
+        curl_easy_cleanup(atts[k]->curl);
+        if (atts[k]->fp && fclose(atts[k]->fp) != 0 && (int)k == winner) winner = -1;
+        if (k > 0 && (int)k != winner) remove(atts[k]->partFile.c_str());
+    }
+
+    /* the preferred archive cannot resume the transfer, so it is downloaded again from the beginning next time */
+    if (noRange && winner < 0) remove(partFile.c_str());
+    curl_multi_cleanup(multi);
+
+    int stat = XFER_FAILED;
+    if (winner >= 0)
+    {
+        stat = XFER_OK;
+        *nbytes = atts[winner]->sink.nbytes;
+        if (winner > 0)
+        {
+            /* the data of the mirror are moved to 'partFile' */
+            remove(partFile.c_str());
+            if (rename(atts[winner]->partFile.c_str(), partFile.c_str()) != 0) stat = XFER_FAILED;
+            offset = 0;
+        }
+        if (_verbose && winner > 0) cout << "*** INFO(CurlUtil::Hedge): " << atts[winner]->url << " wins" << endl;
+    }
+    else
+    {
+        *nbytes = atts.empty() ? 0 : atts[0]->sink.nbytes;
+        if (nnofile == (int)atts.size()) stat = XFER_NOFILE;
+        else cout << "*** WARNING(CurlUtil::Hedge): failed to transfer " << urls[0] << " from all the mirrors" << endl;
+    }
+    for (size_t k = 0; k < atts.size(); k++) delete atts[k];
+
+    return stat;
+} /* end of Hedge */
+
+/**
+* @brief   : AddMirrors - add the equivalent directory trees of the mirror archives
+* @param[I]: prefixes (URL prefixes of the same directory tree in the mirror archives)
+* @param[O]: none
+* @return  : none
+* @note    : the file under one of the prefixes can be downloaded from all the others
+**/
+void CurlUtil::AddMirrors(const vector<string> &prefixes)
+{
+    if (prefixes.size() > 1) _mirrors.push_back(prefixes);
+} /* end of AddMirrors */
+
+/**
+* @brief   : SetHedge - set the hedged requests to the mirror archives
+* @param[I]: delay (a duplicate request is sent to the next mirror if the transfer has no data or is
+*            too slow after so long (s), <= 0: off)
+* @param[I]: speed (minimum throughput of the transfer (bytes/s))
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void CurlUtil::SetHedge(double delay, double speed)
+{
+    _hedgeDelay = delay;
+    _hedgeSpeed = speed;
+} /* end of SetHedge */
+
+/**
+* @brief   : Finalize - check the downloaded '<localFile>.part' and rename it to 'localFile'
+* @param[I]: url (full URL of the remote file)
+* @param[I]: localFile (local file name, with or without path)
+* @param[I]: stat (status of the transfer, XFER_OK, XFER_NOFILE or XFER_FAILED)
+* @param[I]: size (size of the remote file in the listing, -1: unknown)
+* @param[I]: offset (number of bytes received before, 0 if it is not resumed)
+* @param[I]: total (size of '<localFile>.part')
+* @return  : XFER_OK, XFER_NOFILE or XFER_FAILED
+* @note    : the '.part' file is kept to be resumed next time unless nothing has been received
+**/
+int CurlUtil::Finalize(const string &url, const string &localFile, int stat, long long size, long long offset, long long total)
+{
+    string partFile = localFile + PARTSUFFIX;
+
+    /* check the size of the local file, and the short transfer without the size in the listing is detected by libcurl */
+    if (stat == XFER_OK && size >= 0 && total != size)
+    {
+        stat = XFER_FAILED;
+        cout << "*** WARNING(CurlUtil::Finalize): the size of " << partFile << " (" << total <<
+            " bytes) is different from the remote one, it will be resumed next time" << endl;
+    }
+
+    if (stat == XFER_OK)
+    {
+        remove(localFile.c_str());
+        if (rename(partFile.c_str(), localFile.c_str()) != 0)
+        {
+            cerr << "*** ERROR(CurlUtil::Finalize): rename " << partFile << " to " << localFile << " failed, please check it" << endl;
+
+            return XFER_FAILED;
+        }
+        if (_verbose) cout << "*** INFO(CurlUtil::Finalize): " << url << " -> " << localFile << " (" << total << " bytes" <<
+            (offset > 0 ? ", resumed from " + to_string(offset) : "") << ")" << endl;
+    }
+    else if (stat == XFER_NOFILE || total == 0) remove(partFile.c_str());  /* nothing to be resumed */
+
+    return stat;
+} /* end of Finalize */
+
+/**
+* @brief   : Download - download one remote file as it is
+* @param[I]: url (full URL of the remote file)
+* @param[I]: localFile (local file name, with or without path)
+* @param[O]: nbytes (size of the local file, nullptr:NO output)
+* @param[I]: size (size of the remote file in the listing, -1: unknown)
+* @return  : XFER_OK, XFER_NOFILE or XFER_FAILED
+* @note    : the data are written to '<localFile>.part', which is resumed by HTTP Range or FTP REST in
+*            the next attempt if the transfer is broken, and renamed to 'localFile' only when the size
+*            is the same as the remote one
+**/
+int CurlUtil::Download(const string &url, const string &localFile, long long *nbytes, long long size)
+{
+    if (nbytes) *nbytes = 0;
+
+    /* the size of the data received before */
+    string partFile = localFile + PARTSUFFIX;
+    long long offset = 0;
+    struct stat st;
+    if (stat(partFile.c_str(), &st) == 0) offset = (long long)st.st_size;
+    if (size >= 0 && offset > size) offset = 0;
+
+    int stat = XFER_OK;
+    long long n = 0;
+
+    /* the large file of HTTP(S) is downloaded in segments if the server supports byte ranges */
+    bool isSeg = false;
+    bool isHttp = url.compare(0, 7, "http://") == 0 || url.compare(0, 8, "https://") == 0;
+    if (isHttp && offset == 0 && _segCount > 1 && (size < 0 || size >= _segMin))
+    {
+        long long rsize = -1;
+        bool ranges = false;
+        stat = Head(url, &rsize, &ranges);
+        if (stat == XFER_NOFILE) return stat;
+        if (stat == XFER_OK && ranges && rsize >= _segMin && rsize > 0)
+        {
+            stat = Segmented(url, partFile, rsize, &n);
+            if (stat == XFER_NOFILE)
+            {
+                remove(partFile.c_str());
+
+                return stat;
+            }
+            isSeg = stat == XFER_OK;
+            if (isSeg && size < 0) size = rsize;
+        }
+
+        /* download it as a whole */
+        if (!isSeg)
+        {
+            remove(partFile.c_str());
+            n = 0;
+            stat = XFER_OK;
+        }
+    }
+
+    if (!isSeg && (size < 0 || offset < size))
+    {
+        FILE *fp = fopen(partFile.c_str(), offset > 0 ? "ab" : "wb");
+        if (!fp)
+        {
+            cerr << "*** ERROR(CurlUtil::Download): open local file " << partFile << " failed, please check it" << endl;
+
+            return XFER_FAILED;
+        }
+
+        /* the transfer is hedged by the mirror archives */
+        vector<string> urls;
+        if (_hedgeDelay > 0.0) urls = MirrorsOf(url);
+        if (urls.size() > 1)
+        {
+            fclose(fp);
+            fp = nullptr;
+            stat = Hedge(urls, partFile, offset, &n);
+        }
+        else stat = Perform(url, fp, offset, nullptr, nullptr, &n);
+        if (stat == XFER_NORANGE)
+        {
+            /* the server cannot resume the transfer, so download it again from the beginning */
+            if (_verbose) cout << "*** INFO(CurlUtil::Download): " << url << " cannot be resumed, download it again" << endl;
+            fclose(fp);
+            fp = fopen(partFile.c_str(), "wb");
+            offset = 0;
+            n = 0;
+            stat = fp ? Perform(url, fp, 0, nullptr, nullptr, &n) : XFER_FAILED;
+        }
+        if (fp && fclose(fp) != 0 && stat == XFER_OK) stat = XFER_FAILED;
+    }
+
+    stat = Finalize(url, localFile, stat, size, offset, offset + n);
+    if (stat == XFER_OK && nbytes) *nbytes = offset + n;
+
+    return stat;
+} /* end of Download */
+
+/**
+* @brief   : Stream - download one remote compressed file and inflate it while it is received
+* @param[I]: url (full URL of the remote file)
+* @param[I]: outFile (decompressed local file, with or without path)
+* @param[I]: fmt (format of the remote file, ZIP_GZIP or ZIP_LZW)
+* @param[O]: nbytes (number of compressed bytes received, nullptr:NO output)
+* @param[I]: size (size of the remote file in the listing, -1: unknown)
+* @param[I]: isCrx (true: the decompressed data are Compact RINEX, which are decoded and 'outFile' is
+*            the RINEX file, false: as they are)
+* @return  : XFER_OK, XFER_NOFILE or XFER_FAILED
+* @note    : the decompressed data are written to '<outFile>.part', which cannot be resumed and is
+*            removed if the transfer fails
+**/
+int CurlUtil::Stream(const string &url, const string &outFile, int fmt, long long *nbytes, long long size, bool isCrx)
+{
+    if (nbytes) *nbytes = 0;
+
+    string partFile = outFile + PARTSUFFIX;
+    FILE *fp = fopen(partFile.c_str(), "wb");
+    if (!fp)
+    {
+        cerr << "*** ERROR(CurlUtil::Stream): open local file " << partFile << " failed, please check it" << endl;
+
+        return XFER_FAILED;
+    }
+
+    ZipUtil zip, gz;
+    CrxUtil crx;
+    if (isCrx) zip.SetCrx(&crx);
+    if (isCrx && zip.Format(outFile) == ZIP_GZIP)
+    {
+        gz.SetThreads(_rnxGzip);
+        crx.SetGzip(&gz);
+    }
+    long long n = 0;
+    int stat = zip.BeginInflate(fmt) ? Perform(url, fp, 0, nullptr, nullptr, &n, &zip) : XFER_FAILED;
+    if (!zip.EndInflate(fp) && stat == XFER_OK)
+    {
+        stat = XFER_FAILED;
+        cout << "*** WARNING(CurlUtil::Stream): " << url << " is not a complete compressed " <<
+            (isCrx ? "Compact RINEX file" : "file") << endl;
+    }
+    if (fclose(fp) != 0 && stat == XFER_OK) stat = XFER_FAILED;
+
+    stat = Finalize(url, outFile, stat, size, 0, n);
+    if (stat != XFER_OK) remove(partFile.c_str());
+    else if (nbytes) *nbytes = n;
+
+    return stat;
+} /* end of Stream */
+
+/**
+* @brief   : GetFile - download one remote file
+* @param[I]: url (full URL of the remote file)
+* @param[I]: localFile (local file name, with or without path)
+* @param[O]: nbytes (number of bytes received, nullptr:NO output)
+* @param[I]: size (size of the remote file in the listing, -1: unknown)
+* @return  : XFER_OK, XFER_NOFILE or XFER_FAILED
+* @note    : the data are written to '<localFile>.part', which is resumed by HTTP Range or FTP REST in
+*            the next attempt if the transfer is broken, and renamed to 'localFile' only when the size
+*            is the same as the remote one; if the inflation is on, the gzip or Unix compress file is
+*            saved as the one without '.gz' or '.Z', and it is inflated while it is received unless it is
+*            resumed, hedged or downloaded in segments; the Compact RINEX file is also decoded on the
+*            fly and saved as the RINEX file if it is set by SetCrx2Rnx
+**/
+int CurlUtil::GetFile(const string &url, const string &localFile, long long *nbytes, long long size)
+{
+    if (_dryRun) return Plan(url, localFile, size);
+
+    /* the new file of the backfill lane waits for the real-time front */
+    if (_backfill) WaitFront();
+
+    /* the file not published yet is wanted by several days, i.e., the products of the day after */
+    {
+        std::lock_guard<std::mutex> lock(_missLock);
+        if (_missing.count(url) > 0) return XFER_NOFILE;
+    }
+
+    /* the same file may be wanted by the days downloaded in parallel, i.e., the weekly products */
+    string path = ClaimFile(localFile);
+    int stat = XFER_OK;
+    if (_journal.IsVerified(path, url))
+    {
+        /* it was downloaded by the run before, which may have been killed later */
+        if (nbytes) *nbytes = 0;
+        if (_verbose) cout << "*** INFO(CurlUtil::GetFile): " << url << " is verified in the journal, skip it" << endl;
+    }
+    else
+    {
+        _journal.Record(path, url, JNL_DOWNLOADING);
+        stat = Fetch(url, localFile, nbytes, size);
+        if (stat == XFER_OK) RecordLatency(_task, url);
+        string outFile, rnxFile;
+        OutNames(localFile, InflateFormat(url, localFile, _inflate, _keepCrx), _crx2rnx, _rnxGzip, outFile, rnxFile);
+        JournalEnd(path, url, stat, outFile, rnxFile);
+    }
+    ReleaseFile(path);
+    if (stat == XFER_NOFILE)
+    {
+        std::lock_guard<std::mutex> lock(_missLock);
+        _missing.insert(url);
+    }
+
+    return stat;
+} /* end of GetFile */
+
+/**
+* @brief   : Plan - add the remote file to the download plan instead of downloading it
+* @param[I]: url (full URL of the remote file)
+* @param[I]: localFile (local file name, with or without path)
+* @param[I]: size (size of the remote file in the listing, -1: unknown)
+* @return  : XFER_OK, XFER_NOFILE or XFER_FAILED of probing the remote file
+* @note    : the file not listed is probed once by HEAD (or SIZE of FTP) for its existence and size, and
+*            the plan is deduplicated by the local files, so the file wanted by several days is counted
+*            once
+**/
+int CurlUtil::Plan(const string &url, const string &localFile, long long size)
+{
+    string path = FullPath(localFile);
+    if (_journal.IsVerified(path, url)) return XFER_OK;
+
+    target_t target = { url, XFER_OK, size };
+    bool probed;
+    {
+        std::lock_guard<std::mutex> lock(_planLock);
+        auto it = _probed.find(url);
+        probed = it != _probed.end();
+        if (probed) target = it->second;
+    }
+    if (!probed && size < 0)
+    {
+        bool ranges;
+        target.stat = Head(url, &target.size, &ranges);
+    }
+
+    std::lock_guard<std::mutex> lock(_planLock);
+    _probed[url] = target;
+    if (target.stat == XFER_OK && _manifest.count(path) == 0) _manifest[path] = url;
+
+    return target.stat;
+} /* end of Plan */
+
+/**
+* @brief   : Fetch - download one remote file, which is taken by the calling thread
+* @param[I]: url (full URL of the remote file)
+* @param[I]: localFile (local file name, with or without path)
+* @param[O]: nbytes (number of bytes received, nullptr:NO output)
+* @param[I]: size (size of the remote file in the listing, -1: unknown)
+* @return  : XFER_OK, XFER_NOFILE or XFER_FAILED
+* @note    : see GetFile
+**/
+int CurlUtil::Fetch(const string &url, const string &localFile, long long *nbytes, long long size)
+{
+    int fmt = InflateFormat(url, localFile, _inflate, _keepCrx);
+    if (fmt == ZIP_NONE) return Download(url, localFile, nbytes, size);
+
+    /* the compressed file is written only once, already decompressed, or even decoded if it is Compact RINEX */
+    string outFile, rnxFile;
+    OutNames(localFile, fmt, _crx2rnx, _rnxGzip, outFile, rnxFile);
+    struct stat st;
+    bool isHedge = _hedgeDelay > 0.0 && MirrorsOf(url).size() > 1;
+    if (stat((localFile + PARTSUFFIX).c_str(), &st) != 0 && !isHedge && !IsSegmented(url, &size))
+    {
+        int stat = Stream(url, rnxFile.empty() ? outFile : rnxFile, fmt, nbytes, size, !rnxFile.empty());
+        if (stat != XFER_FAILED) return stat;
+
+        /* the broken stream is downloaded again as the compressed file, which can be resumed next time */
+        if (_verbose) cout << "*** INFO(CurlUtil::GetFile): " << url << " failed to be inflated on the fly, download it again" << endl;
+    }
+
+    int stat = Download(url, localFile, nbytes, size);
+    if (stat == XFER_OK && !Unpack(localFile, rnxFile, _rnxGzip)) stat = XFER_FAILED;
+
+    return stat;
+} /* end of Fetch */
+
+/**
+* @brief   : ReadListCache - read the listing of the remote directory from the on-disk cache
+* @param[I]: url (URL of the remote directory, ended with '/')
+* @param[O]: files (files in the remote directory)
+* @return  : true: the cache exists and has not expired, false: otherwise
+* @note    :
+**/
+bool CurlUtil::ReadListCache(const string &url, vector<rfile_t> &files)
+{
+    if (_listTtl <= 0 || _listDir.empty()) return false;
+
+    string cacheFile = ListCacheFile(_listDir, url);
+    struct stat st;
+    if (stat(cacheFile.c_str(), &st) != 0 || difftime(time(NULL), st.st_mtime) > _listTtl * 60.0) return false;
+
+    ifstream cacheLst(cacheFile.c_str());
+    if (!cacheLst.is_open()) return false;
+
+    /* the 1st line is the URL, and then 'size name' for each file */
+    string line;
+    if (!getline(cacheLst, line) || line != url) return false;
+    files.clear();
+    while (getline(cacheLst, line))
+    {
+        size_t pos = line.find(' ');
+        if (pos == string::npos) continue;
+        rfile_t file = { line.substr(pos + 1), atoll(line.substr(0, pos).c_str()) };
+        files.push_back(file);
+    }
+
+    return true;
+} /* end of ReadListCache */
+
+/**
+* @brief   : WriteListCache - write the listing of the remote directory to the on-disk cache
+* @param[I]: url (URL of the remote directory, ended with '/')
+* @param[I]: files (files in the remote directory)
+* @return  : none
+* @note    : the cache is written to a temporary file first, and then renamed
+**/
+void CurlUtil::WriteListCache(const string &url, const vector<rfile_t> &files)
+{
+    if (_listTtl <= 0 || _listDir.empty()) return;
+
+    if (access(_listDir.c_str(), 0) == -1)
+    {
+#ifdef _WIN32   /* for Windows */
+        string cmd = "mkdir " + _listDir;
+#else           /* for Linux or Mac */
+        string cmd = "mkdir -p " + _listDir;
+#endif
+        std::system(cmd.c_str());
+    }
+
+    string cacheFile = ListCacheFile(_listDir, url);
+    string tmpFile = cacheFile + ".tmp";
+    ofstream cacheLst(tmpFile.c_str());
+    if (!cacheLst.is_open()) return;
+    cacheLst << url << "\n";
+    for (size_t i = 0; i < files.size(); i++) cacheLst << files[i].size << " " << files[i].name << "\n";
+    cacheLst.close();
+
+    remove(cacheFile.c_str());
+    if (rename(tmpFile.c_str(), cacheFile.c_str()) != 0) remove(tmpFile.c_str());
+} /* end of WriteListCache */
+
+/**
+* @brief   : ListRemote - get the list of files in the remote directory from the server
+* @param[I]: url (URL of the remote directory, ended with '/')
+* @param[O]: files (files in the remote directory)
+* @return  : XFER_OK, XFER_NOFILE or XFER_FAILED
+* @note    : 'MLSD' (or 'NLST' as fallback) is used for FTP(S), and the index page for HTTP(S)
+**/
+int CurlUtil::ListRemote(const string &url, vector<rfile_t> &files)
+{
+    files.clear();
+    string buf;
+    int stat;
+    if (url.compare(0, 6, "ftp://") == 0 || url.compare(0, 7, "ftps://") == 0)
+    {
+        /* 'MLSD' gives the type and size of each entry, but it is not supported by all the servers */
+        stat = Perform(url, nullptr, 0, &buf, "MLSD", nullptr);
+        if (stat == XFER_OK) ParseMlsd(buf, files);
+        else if (stat == XFER_FAILED)
+        {
+            buf.clear();
+            stat = Perform(url, nullptr, 0, &buf, "NLST", nullptr);
+            if (stat == XFER_OK) ParseNlst(buf, files);
+        }
+    }
+    else
+    {
+        stat = Perform(url, nullptr, 0, &buf, nullptr, nullptr);
+        if (stat == XFER_OK) ParseHtml(buf, files);
+    }
+
+    return stat;
+} /* end of ListRemote */
+
+/**
+* @brief   : SetClass - set the product class of the following transfers for the health history
+* @param[I]: cls (product class, i.e., "OBSD", "SP3", "ION")
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void CurlUtil::SetClass(const string &cls)
+{
+    _class = cls;
+} /* end of SetClass */
+
+/**
+* @brief   : LoadHealth - read the health history of the hosts
+* @param[I]: file (file of the history)
+* @param[O]: none
+* @return  : none
+* @note    : the history is shared by all the threads and read only once, and it is written back by SaveHealth
+**/
+void CurlUtil::LoadHealth(const string &file)
+{
+    std::call_once(_healthFlag, [&file]() { _health.Load(file); });
+} /* end of LoadHealth */
+
+/**
+* @brief   : SaveHealth - write the health history of the hosts
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    : it is called once at the end of the run (or of each round of the daemon), after all the days
+**/
+void CurlUtil::SaveHealth()
+{
+    _health.Save();
+} /* end of SaveHealth */
+
+/**
+* @brief   : SetTask - set the download task of the following transfers for the latency model
+* @param[I]: task (download task, i.e., "OBS", "ORBCLK", "NAV", empty: not recorded)
+* @param[O]: none
+* @return  : none
+* @note    : the delay of each new file after the nominal epoch in its name is recorded for the task
+**/
+void CurlUtil::SetTask(const string &task)
+{
+    _task = task;
+} /* end of SetTask */
+
+/**
+* @brief   : LoadLatency - read the latency model of the publication of the products
+* @param[I]: file (file of the model)
+* @param[O]: none
+* @return  : none
+* @note    : the model is shared by all the threads and read only once, and it is written back by SaveLatency
+**/
+void CurlUtil::LoadLatency(const string &file)
+{
+    std::call_once(_latencyFlag, [&file]() { _latency.Load(file); });
+} /* end of LoadLatency */
+
+/**
+* @brief   : SaveLatency - write the latency model of the publication of the products
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    : it is written only if new files have been recorded
+**/
+void CurlUtil::SaveLatency()
+{
+    _latency.Save();
+} /* end of SaveLatency */
+
+/**
+* @brief   : PublishWindow - get the publication window of the task predicted by the latency model
+* @param[I]: task (download task, i.e., "OBS", "ORBCLK", "NAV")
+* @param[O]: lo (start of the window after the nominal epoch (hours))
+* @param[O]: hi (end of the window after the nominal epoch (hours))
+* @param[O]: latest (latest nominal epoch of the new files of the task in this run (s since 1970), 0: none)
+* @return  : true: OK, false: too few delays have been recorded for the task
+* @note    :
+**/
+bool CurlUtil::PublishWindow(const string &task, double *lo, double *hi, double *latest)
+{
+    *latest = _latency.Latest(task);
+
+    return _latency.Window(task, lo, hi);
+} /* end of PublishWindow */
+
+/**
+* @brief   : ExpectedTime - get the expected completion time of the transfer from the host of URL
+* @param[I]: url (URL of the remote directory or file)
+* @param[I]: cls (product class, i.e., "OBSD", "SP3", "ION")
+* @param[I]: size (size of the file (bytes))
+* @return  : expected completion time (s), 0 if the host has not been used for the class
+* @note    :
+**/
+double CurlUtil::ExpectedTime(const string &url, const string &cls, double size)
+{
+    return _health.Expected(HostOf(url), cls, size);
+} /* end of ExpectedTime */
+
+/**
+* @brief   : SetListCache - set the on-disk cache of the remote directory listings
+* @param[I]: cacheDir (directory of the cache files)
+* @param[I]: ttl (time to live of the cache files in minutes, <= 0: the listings are only cached in memory)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void CurlUtil::SetListCache(const string &cacheDir, int ttl)
+{
+    _listDir = cacheDir;
+    _listTtl = ttl;
+} /* end of SetListCache */
+
+/**
+* @brief   : ListDir - get the list of files in the remote directory
+* @param[I]: dirUrl (URL of the remote directory)
+* @param[O]: files (files in the remote directory)
+* @return  : XFER_OK, XFER_NOFILE or XFER_FAILED
+* @note    : the remote directory is listed only once in a run, and the listing is shared by all the
+*            threads; the failed listing is not cached and tried again next time
+**/
+int CurlUtil::ListDir(const string &dirUrl, vector<rfile_t> &files)
+{
+    files.clear();
+    string url = dirUrl;
+    if (url.empty() || url[url.size() - 1] != '/') url += "/";
+
+    std::shared_ptr<listEntry_t> entry;
+    {
+        std::lock_guard<std::mutex> lock(_listLock);
+        std::shared_ptr<listEntry_t> &ptr = _listCache[url];
+        if (!ptr)
+        {
+            ptr = std::make_shared<listEntry_t>();
+            ptr->valid = false;
+            ptr->stat = XFER_FAILED;
+        }
+        entry = ptr;
+    }
+
+    std::lock_guard<std::mutex> lock(entry->lock);
+    if (!entry->valid)
+    {
+        vector<rfile_t> list;
+        int stat = XFER_OK;
+        if (!ReadListCache(url, list))
+        {
+            stat = ListRemote(url, list);
+            if (stat == XFER_FAILED)
+            {
+                cout << "*** WARNING(CurlUtil::ListDir): failed to list the remote directory " << dirUrl << endl;
+
+                return stat;
+            }
+            if (stat == XFER_OK && !_dryRun) WriteListCache(url, list);
+        }
+        else if (_verbose) cout << "*** INFO(CurlUtil::ListDir): the listing of " << url << " is read from the cache" << endl;
+
+        entry->files.swap(list);
+        entry->stat = stat;
+        entry->valid = true;
+    }
+    files = entry->files;
+
+    return entry->stat;
+} /* end of ListDir */
+
+/**
+* @brief   : GetFiles - download the files matching the wildcard pattern in the remote directory
+* @param[I]: dirUrl (URL of the remote directory)
+* @param[I]: pattern (wildcard pattern of file name with '*' and '?', i.e., "*0010.21d.*")
+* @param[I]: localDir (local directory the files are saved to)
+* @param[O]: localFiles (local files downloaded, without '.gz' or '.Z' if inflated, or the RINEX files
+*            if converted, nullptr:NO output)
+* @return  : XFER_OK, XFER_NOFILE (nothing matched) or XFER_FAILED
+* @note    : it replaces 'wget -r -nH -A <pattern> --cut-dirs=<n> <dirUrl>', and the remote directory
+*            is not crawled again as its listing is cached; the matched files are downloaded in the event
+*            loop concurrently if it is on
+**/
+int CurlUtil::GetFiles(const string &dirUrl, const string &pattern, const string &localDir, vector<string> *localFiles)
+{
+    vector<rfile_t> files;
+    int stat = ListDir(dirUrl, files);
+
+    /* the files in the mirror archives are the same */
+    if (stat == XFER_FAILED && _hedgeDelay > 0.0)
+    {
+        vector<string> urls = MirrorsOf(dirUrl);
+        for (size_t i = 1; i < urls.size() && stat == XFER_FAILED; i++) stat = ListDir(urls[i], files);
+    }
+    if (stat != XFER_OK) return stat;
+
+    StringUtil str;
+    string url = dirUrl;
+    if (url[url.size() - 1] != '/') url += "/";
+    char sep = (char)FILEPATHSEP;
+    int nget = 0, nfail = 0;
+    vector<size_t> matched;
+    for (size_t i = 0; i < files.size(); i++)
+    {
+        if (str.WildMatch(pattern.c_str(), files[i].name.c_str())) matched.push_back(i);
+    }
+
+    /* the names are updated by the callbacks in the loop thread, i.e., the inflated file without '.gz' or '.Z' */
+    vector<string> names(matched.size());
+    vector<std::future<int>> results;
+    for (size_t k = 0; k < matched.size(); k++)
+    {
+        const rfile_t &file = files[matched[k]];
+        names[k] = localDir + sep + file.name;
+        results.push_back(Submit(url + file.name, names[k], file.size, [&names, k](int stat, const string &localFile)
+        {
+            names[k] = localFile;
+        }));
+    }
+
+    /* wait for all the transfers, and the local files are in the order of the listing */
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        if (results[i].get() == XFER_OK)
+        {
+            nget++;
+            if (localFiles) localFiles->push_back(names[i]);
+        }
+        else nfail++;
+    }
+
+    if (nfail > 0) return XFER_FAILED;
+
+    return nget > 0 ? XFER_OK : XFER_NOFILE;
+} /* end of GetFiles */
+
+/**
+* @brief   : SetInflate - (not) inflate the downloaded gzip and Unix compress files
+* @param[I]: inflate (true: the compressed file is saved as the decompressed one without '.gz' or '.Z',
+*            false: as it is)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void CurlUtil::SetInflate(bool inflate)
+{
+    _inflate = inflate;
+} /* end of SetInflate */
+
+/**
+* @brief   : SetCrx2Rnx - (not) convert the compressed Compact RINEX files to RINEX while they are received
+* @param[I]: crx2rnx (true: '*.yyd.gz', '*.yyd.Z' and '*.crx.gz' are saved as '*.yyo' and '*.rnx',
+*            false: as the inflated '*.yyd' and '*.crx')
+* @param[O]: none
+* @return  : none
+* @note    : it works only if the inflation is on, and the file that cannot be decoded is saved as the
+*            inflated one
+**/
+void CurlUtil::SetCrx2Rnx(bool crx2rnx)
+{
+    _crx2rnx = crx2rnx;
+} /* end of SetCrx2Rnx */
+
+/**
+* @brief   : SetRnxGzip - (not) compress the RINEX files converted from Compact RINEX
+* @param[I]: nthread (number of threads compressing each file, <= 0: the RINEX file is written as it is)
+* @param[O]: none
+* @return  : none
+* @note    : the RINEX file is saved as the indexed gzip file '*.yyo.gz' or '*.rnx.gz' by the decoder
+*            directly, whose gzip members are cut at the hours of the epochs
+**/
+void CurlUtil::SetRnxGzip(int nthread)
+{
+    _rnxGzip = nthread;
+} /* end of SetRnxGzip */
+
+/**
+* @brief   : SetKeepCrx - (not) keep the compressed Compact RINEX files as they are downloaded
+* @param[I]: keepCrx (true: '*.yyd.gz', '*.yyd.Z' and '*.crx.gz' are saved as they are, false: inflated
+*            and converted as set by SetInflate and SetCrx2Rnx)
+* @param[O]: none
+* @return  : none
+* @note    : the other compressed files are still inflated, and the kept files are read by RnxReader
+**/
+void CurlUtil::SetKeepCrx(bool keepCrx)
+{
+    _keepCrx = keepCrx;
+} /* end of SetKeepCrx */
+
+/**
+* @brief   : SetDryRun - (not) plan the downloads instead of downloading the files
+* @param[I]: dryRun (true: the files are only added to the download plan, false: downloaded)
+* @param[O]: none
+* @return  : none
+* @note    : the remote directories are still listed, and nothing is written to the local files
+**/
+void CurlUtil::SetDryRun(bool dryRun)
+{
+    _dryRun = dryRun;
+} /* end of SetDryRun */
+
+/**
+* @brief   : ResetRun - forget the listings and the missing files of this run in all the threads
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    : it is called by the daemon before each round, so the files published since the last round are
+*            listed and requested again; the transfers of the backfill lane in flight only list the
+*            directories again
+**/
+void CurlUtil::ResetRun()
+{
+    {
+        std::lock_guard<std::mutex> lock(_listLock);
+        _listCache.clear();
+    }
+    std::lock_guard<std::mutex> lock(_missLock);
+    _missing.clear();
+} /* end of ResetRun */
+
+/**
+* @brief   : SetBackfill - (not) run the transfers in the backfill lane, which yields to the real-time front
+* @param[I]: backfill (true: the new transfers wait while the front is busy, and the transfers in flight
+*            are paused, false: the transfers do not wait)
+* @param[O]: none
+* @return  : none
+* @note    : the transfer is paused by libcurl and resumed when the front is idle, and the paused transfer
+*            is not aborted as stalled
+**/
+void CurlUtil::SetBackfill(bool backfill)
+{
+    _backfill = backfill;
+} /* end of SetBackfill */
+
+/**
+* @brief   : SetLaneLimit - set the bandwidth limit of the backfill lane of the process
+* @param[I]: bps (bandwidth limit (bytes/s), <= 0: unlimited)
+* @param[O]: none
+* @return  : none
+* @note    : the transfers of the lane are also within the limit of all the transfers
+**/
+void CurlUtil::SetLaneLimit(double bps)
+{
+    SetRate(&_laneRate, bps);
+} /* end of SetLaneLimit */
+
+/**
+* @brief   : SetFrontBusy - mark the real-time front busy (or idle) in all the threads
+* @param[I]: busy (true: the front begins to download the target due, false: it has done)
+* @param[O]: none
+* @return  : none
+* @note    : the calls are counted, so each 'true' should be followed by one 'false'
+**/
+void CurlUtil::SetFrontBusy(bool busy)
+{
+    std::lock_guard<std::mutex> lock(_laneLock);
+    _frontBusy += busy ? 1 : -1;
+    if (_frontBusy <= 0)
+    {
+        _frontBusy = 0;
+        _laneCond.notify_all();
+    }
+} /* end of SetFrontBusy */
+
+/**
+* @brief   : OpenJournal - open the journal of the downloads shared by all the days
+* @param[I]: file (file of the journal)
+* @param[O]: none
+* @return  : none
+* @note    : the journal is opened once in the process, and the file verified in it is neither planned nor
+*            downloaded again as long as it keeps the size recorded, and the dry run only reads it
+**/
+void CurlUtil::OpenJournal(const string &file)
+{
+    _journal.Open(file, _dryRun);
+} /* end of OpenJournal */
+
+/**
+* @brief   : WritePlan - write the download plan of all the threads of this run to the file
+* @param[I]: file (file of the plan, 'size  URL  local file' per line)
+* @param[O]: nfile (number of the files in the plan)
+* @param[O]: nbytes (total size of the files whose sizes are known)
+* @param[O]: nunknown (number of the files whose sizes are unknown)
+* @return  : true: OK, false: the file failed to be written
+* @note    :
+**/
+bool CurlUtil::WritePlan(const string &file, int *nfile, long long *nbytes, int *nunknown)
+{
+    std::lock_guard<std::mutex> lock(_planLock);
+    *nfile = (int)_manifest.size();
+    *nbytes = 0;
+    *nunknown = 0;
+    ofstream planLst(file.c_str());
+    for (auto it = _manifest.begin(); it != _manifest.end(); ++it)
+    {
+        long long size = _probed[it->second].size;
+        if (size >= 0) *nbytes += size;
+        else (*nunknown)++;
+        planLst << setw(12) << size << "  " << it->second << "  " << it->first << endl;
+    }
+
+    return planLst.good();
+} /* end of WritePlan */
+
+/**
+* @brief   : SetMulti - set the event loop of the multiplexed transfers
+* @param[I]: maxXfer (maximum number of transfers in flight, <= 0: off)
+* @param[I]: maxHostConn (maximum number of connections to one host)
+* @param[O]: none
+* @return  : none
+* @note    : it should be called before the first transfer is submitted
+**/
+void CurlUtil::SetMulti(int maxXfer, int maxHostConn)
+{
+    _maxXfer = maxXfer;
+    _maxHostConn = maxHostConn < 1 ? 1 : maxHostConn;
+} /* end of SetMulti */
+
+/**
+* @brief   : SetConvThreads - set the threads inflating and converting the data received by the event loop
+* @param[I]: nthread (number of threads, <= 0: in the loop thread)
+* @param[O]: none
+* @return  : none
+* @note    : the received data of each transfer wait in a bounded queue, and the transfer is paused
+*            while its queue is full; it should be called before the first transfer is submitted
+**/
+void CurlUtil::SetConvThreads(int nthread)
+{
+    _convThreads = nthread < 0 ? 0 : nthread;
+} /* end of SetConvThreads */
+
+/**
+* @brief   : Submit - submit one remote file to be downloaded in the event loop
+* @param[I]: url (full URL of the remote file)
+* @param[I]: localFile (local file name, with or without path)
+* @param[I]: size (size of the remote file in the listing, -1: unknown)
+* @param[I]: done (callback called in the loop thread when the transfer is done with the status and
+*            the local file, which is the one without '.gz' or '.Z' if it is inflated, or the RINEX file
+*            if it is converted; may be empty)
+* @return  : future of the status, XFER_OK, XFER_NOFILE or XFER_FAILED
+* @note    : the file is downloaded by GetFile in the calling thread if the event loop is off, the file
+*            is hedged by the mirrors or downloaded in segments, or it is being downloaded by another
+*            transfer; otherwise the local file is taken by the transfer until it is done, and the relative
+*            'localFile' is in the current directory, so the directory should not be changed until then
+**/
+std::future<int> CurlUtil::Submit(const string &url, const string &localFile, long long size, const xferDone_t &done)
+{
+    /* the new file of the backfill lane waits for the real-time front, so its queue does not grow meanwhile */
+    if (_backfill && !_dryRun) WaitFront();
+
+    job_t *job = new job_t();
+    job->url = url;
+    job->localFile = localFile;
+    job->partFile = localFile + PARTSUFFIX;
+    job->cls = _class;
+    job->task = _task;
+    job->size = size;
+    job->offset = 0;
+    job->fp = nullptr;
+    job->curl = nullptr;
+    job->ntry = 0;
+    job->restart = false;
+    job->fmt = InflateFormat(url, localFile, _inflate, _keepCrx);
+    job->stream = false;
+    job->notBefore = 0.0;
+    job->done = done;
+    job->code = 0;
+    job->resp = 0;
+    job->ttfb = 0.0;
+    job->secs = 0.0;
+    job->inflated = false;
+    job->loop = nullptr;
+    job->nqueued = 0;
+    job->queued = false;
+    job->ended = false;
+    job->paused = false;
+    job->failed = false;
+    job->claimed = false;
+    std::future<int> result = job->result.get_future();
+    OutNames(localFile, job->fmt, _crx2rnx, _rnxGzip, job->outFile, job->rnxFile);
+    if (!job->rnxFile.empty()) job->zip.SetCrx(&job->crx);
+    job->nzip = _rnxGzip;
+    if (!job->rnxFile.empty() && _rnxGzip > 0)
+    {
+        job->gz.SetThreads(_rnxGzip);
+        job->crx.SetGzip(&job->gz);
+    }
+
+    bool isHedge = _hedgeDelay > 0.0 && MirrorsOf(url).size() > 1;
+    job->path = FullPath(localFile);
+
+    /* the file not published yet is wanted by several days, i.e., the products of the day after */
+    if (!_dryRun)
+    {
+        bool missing;
+        {
+            std::lock_guard<std::mutex> lock(_missLock);
+            missing = _missing.count(url) > 0;
+        }
+        if (missing)
+        {
+            Complete(job, XFER_NOFILE);
+
+            return result;
+        }
+    }
+
+    /* the file being downloaded by another transfer, i.e., the weekly products wanted by several days, waits for it in
+       GetFile, and the large file is segmented there */
+    if (_maxXfer <= 0 || isHedge || _dryRun || _journal.IsVerified(job->path, url) || IsSegmented(url, &job->size) ||
+        !TryClaimFile(job->path))
+    {
+        Complete(job, GetFile(url, localFile, nullptr, job->size));
+
+        return result;
+    }
+    job->claimed = true;
+    _journal.Record(job->path, url, JNL_PENDING);
+
+    /* the compressed file is inflated while it is received unless it is resumed */
+    struct stat st;
+    if (!job->outFile.empty() && stat(job->partFile.c_str(), &st) != 0)
+    {
+        job->stream = true;
+        job->partFile = (job->rnxFile.empty() ? job->outFile : job->rnxFile) + PARTSUFFIX;
+    }
+
+    StartLoop();
+    {
+        std::lock_guard<std::mutex> lock(_loop->lock);
+        _loop->queue.push_back(job);
+    }
+    WakeLoop(_loop);
+
+    return result;
+} /* end of Submit */
+
+/**
+* @brief   : StartLoop - start the event loop of the multiplexed transfers if it is not running
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void CurlUtil::StartLoop()
+{
+    std::lock_guard<std::mutex> lock(_loopLock);
+    if (_loop) return;
+
+    std::call_once(_initFlag, GlobalInit);
+    _loop = new loop_t();
+    _loop->stop = false;
+    _loop->nactive = 0;
+    _loop->convStop = false;
+    _loop->nconv = 0;
+    _loop->multi = curl_multi_init();
+    curl_multi_setopt(_loop->multi, CURLMOPT_MAX_HOST_CONNECTIONS, (long)_maxHostConn);
+    curl_multi_setopt(_loop->multi, CURLMOPT_PIPELINING, (long)CURLPIPE_MULTIPLEX);
+#ifdef __linux__
+    _loop->epfd = epoll_create1(EPOLL_CLOEXEC);
+    _loop->wakefd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    _loop->deadline = -1.0;
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = _loop->wakefd;
+    epoll_ctl(_loop->epfd, EPOLL_CTL_ADD, _loop->wakefd, &ev);
+    curl_multi_setopt(_loop->multi, CURLMOPT_SOCKETFUNCTION, SocketCb);
+    curl_multi_setopt(_loop->multi, CURLMOPT_SOCKETDATA, (void *)_loop);
+    curl_multi_setopt(_loop->multi, CURLMOPT_TIMERFUNCTION, TimerCb);
+    curl_multi_setopt(_loop->multi, CURLMOPT_TIMERDATA, (void *)_loop);
+#endif
+    for (int i = 0; i < _convThreads; i++) _loop->convThr.push_back(std::thread(RunStage, _loop));
+    _loop->thr = std::thread(&CurlUtil::RunLoop, this);
+} /* end of StartLoop */
+
+/**
+* @brief   : StopLoop - wait for all the submitted transfers and stop the event loop
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void CurlUtil::StopLoop()
+{
+    std::lock_guard<std::mutex> lock(_loopLock);
+    if (!_loop) return;
+
+    {
+        std::lock_guard<std::mutex> qlock(_loop->lock);
+        _loop->stop = true;
+    }
+    WakeLoop(_loop);
+    _loop->thr.join();
+    {
+        std::lock_guard<std::mutex> clock(_loop->convLock);
+        _loop->convStop = true;
+    }
+    _loop->convCond.notify_all();
+    for (size_t i = 0; i < _loop->convThr.size(); i++) _loop->convThr[i].join();
+
+    for (size_t i = 0; i < _loop->idle.size(); i++) curl_easy_cleanup(_loop->idle[i]);
+    curl_multi_cleanup(_loop->multi);
+#ifdef __linux__
+    close(_loop->wakefd);
+    close(_loop->epfd);
+#endif
+    delete _loop;
+    _loop = nullptr;
+} /* end of StopLoop */
+
+/**
+* @brief   : RunLoop - run the event loop of the multiplexed transfers in its own thread
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    : the sockets of all the transfers are watched by epoll on Linux, and by curl_multi_poll
+*            on the other platforms
+**/
+void CurlUtil::RunLoop()
+{
+    loop_t *loop = _loop;
+    int running = 0;
+#ifdef __linux__
+    struct epoll_event evs[MAXEVENTS];
+#endif
+    while (true)
+    {
+        /* the paused transfers with room in their queues again, and the converted ones are closed */
+        vector<job_t *> resumed, converted;
+        if (!loop->convThr.empty())
+        {
+            std::lock_guard<std::mutex> lock(loop->convLock);
+            resumed.swap(loop->resumed);
+            converted.swap(loop->converted);
+        }
+        for (size_t i = 0; i < resumed.size(); i++) curl_easy_pause(resumed[i]->curl, CURLPAUSE_CONT);
+
+        /* the held transfers go on when the bandwidth is refilled and the real-time front is idle for the
+           backfill lane, which is checked at least once per HOLDTIMEOUT */
+        if (!loop->held.empty())
+        {
+            vector<job_t *> held;
+            held.swap(loop->held);
+            for (size_t i = 0; i < held.size(); i++)
+            {
+                if (IsHeld(&held[i]->sink)) loop->held.push_back(held[i]);
+                else
+                {
+                    held[i]->sink.held = false;
+                    curl_easy_pause(held[i]->curl, CURLPAUSE_CONT);
+                }
+            }
+        }
+        for (size_t i = 0; i < converted.size(); i++)
+        {
+            loop->nconv--;
+            if (converted[i]->stream) CloseJob(converted[i]);
+            else Complete(converted[i], converted[i]->inflated ? XFER_OK : XFER_FAILED);
+        }
+
+        /* take the transfers to be started, and the retried ones wait for their time */
+        vector<job_t *> jobs;
+        double now = NowSec(), next = 0.0;
+        {
+            std::lock_guard<std::mutex> lock(loop->lock);
+            if (loop->stop && loop->queue.empty() && loop->nactive == 0 && loop->nconv == 0) break;
+            for (auto it = loop->queue.begin(); it != loop->queue.end() && loop->nactive + (int)jobs.size() < _maxXfer;)
+            {
+                if ((*it)->notBefore <= now)
+                {
+                    jobs.push_back(*it);
+                    it = loop->queue.erase(it);
+                }
+                else
+                {
+                    if (next <= 0.0 || (*it)->notBefore < next) next = (*it)->notBefore;
+                    ++it;
+                }
+            }
+        }
+        for (size_t i = 0; i < jobs.size(); i++) StartJob(jobs[i]);
+
+        /* wait for the sockets, the timeout of libcurl or the new transfers */
+        long wait = loop->held.empty() ? LOOPTIMEOUT : HOLDTIMEOUT;
+        if (next > 0.0 && (long)((next - now) * 1000.0) + 1 < wait) wait = (long)((next - now) * 1000.0) + 1;
+#ifdef __linux__
+        if (loop->deadline >= 0.0)
+        {
+            long tout = (long)((loop->deadline - now) * 1000.0);
+            if (tout < wait) wait = tout < 0 ? 0 : tout;
+        }
+        int n = epoll_wait(loop->epfd, evs, MAXEVENTS, (int)wait);
+        for (int i = 0; i < n; i++)
+        {
+            /* new transfers are submitted */
+            if (evs[i].data.fd == loop->wakefd)
+            {
+                uint64_t val = 0;
+                if (read(loop->wakefd, &val, sizeof(val)) < 0) val = 0;
+
+                continue;
+            }
+            int mask = 0;
+            if (evs[i].events & EPOLLIN) mask |= CURL_CSELECT_IN;
+            if (evs[i].events & EPOLLOUT) mask |= CURL_CSELECT_OUT;
+            if (evs[i].events & (EPOLLERR | EPOLLHUP)) mask |= CURL_CSELECT_ERR;
+            curl_multi_socket_action(loop->multi, evs[i].data.fd, mask, &running);
+        }
+        if (loop->deadline >= 0.0 && NowSec() >= loop->deadline)
+        {
+            loop->deadline = -1.0;
+            curl_multi_socket_action(loop->multi, CURL_SOCKET_TIMEOUT, 0, &running);
+        }
+#else
+        curl_multi_poll(loop->multi, nullptr, 0, (int)wait, nullptr);
+        curl_multi_perform(loop->multi, &running);
+#endif
+
+        /* the finished transfers */
+        CURLMsg *msg;
+        int nmsg;
+        while ((msg = curl_multi_info_read(loop->multi, &nmsg)))
+        {
+            if (msg->msg != CURLMSG_DONE) continue;
+            CURL *curl = msg->easy_handle;
+            CURLcode code = msg->data.result;
+            job_t *job = nullptr;
+            curl_easy_getinfo(curl, CURLINFO_PRIVATE, (char **)&job);
+            curl_multi_remove_handle(loop->multi, curl);
+            loop->nactive--;
+            FinishJob(job, (int)code);
+        }
+    }
+} /* end of RunLoop */
+
+/**
+* @brief   : StartJob - add the submitted transfer to the event loop
+* @param[I]: job (submitted transfer)
+* @param[O]: none
+* @return  : none
+* @note    : the transfer is resumed from '<localFile>.part' if it exists
+**/
+void CurlUtil::StartJob(job_t *job)
+{
+    if (job->ntry == 0) _journal.Record(job->path, job->url, JNL_DOWNLOADING);
+
+    /* the size of the data received before, and the inflated stream is always started from the beginning */
+    struct stat st;
+    job->offset = !job->stream && stat(job->partFile.c_str(), &st) == 0 ? (long long)st.st_size : 0;
+    if (job->size >= 0 && job->offset > job->size) job->offset = 0;
+    job->loop = _loop;
+    job->chunks.clear();
+    job->nqueued = 0;
+    job->queued = false;
+    job->ended = false;
+    job->paused = false;
+    job->failed = false;
+    if (!job->stream && job->size >= 0 && job->offset == job->size)
+    {
+        /* it has been received completely */
+        int stat = Finalize(job->url, job->localFile, XFER_OK, job->size, job->offset, job->offset);
+        if (stat == XFER_OK && !job->outFile.empty() && !_loop->convThr.empty())
+        {
+            EndStage(_loop, job);
+
+            return;
+        }
+        if (stat == XFER_OK && !job->outFile.empty() && !Unpack(job->localFile, job->rnxFile, job->nzip)) stat = XFER_FAILED;
+        Complete(job, stat);
+
+        return;
+    }
+
+    job->fp = fopen(job->partFile.c_str(), job->offset > 0 ? "ab" : "wb");
+    if (!job->fp || (job->stream && !job->zip.BeginInflate(job->fmt)))
+    {
+        cerr << "*** ERROR(CurlUtil::StartJob): open local file " << job->partFile << " failed, please check it" << endl;
+        if (job->fp) fclose(job->fp);
+        Complete(job, XFER_FAILED);
+
+        return;
+    }
+
+    if (_loop->idle.empty()) job->curl = curl_easy_init();
+    else
+    {
+        job->curl = _loop->idle.back();
+        _loop->idle.pop_back();
+    }
+    bool conv = job->stream && !_loop->convThr.empty();
+    job->sink.fp = conv ? nullptr : job->fp;
+    job->sink.buf = nullptr;
+    job->sink.nbytes = 0;
+    job->sink.limit = 0;
+    job->sink.lane = _backfill;
+    job->sink.zip = job->stream && !conv ? &job->zip : nullptr;
+    job->sink.job = conv ? job : nullptr;
+    job->sink.xfer = job;
+    job->errBuf[0] = '\0';
+    SetOptions(job->curl, job->url, &job->sink, job->errBuf, nullptr, job->offset);
+    curl_easy_setopt(job->curl, CURLOPT_PRIVATE, (void *)job);
+    curl_easy_setopt(job->curl, CURLOPT_PIPEWAIT, 1L);
+    curl_multi_add_handle(_loop->multi, job->curl);
+    _loop->nactive++;
+} /* end of StartJob */
+
+/**
+* @brief   : FinishJob - handle the finished transfer of the event loop
+* @param[I]: job (finished transfer)
+* @param[I]: code (result code of libcurl)
+* @param[O]: none
+* @return  : none
+* @note    : the transient error is retried in the loop, and the callback and the future of the
+*            transfer are fulfilled when it is done; the stream of the conversion threads is ended by
+*            them, and the transfer is closed when they are done
+**/
+void CurlUtil::FinishJob(job_t *job, int code)
+{
+    job->code = code;
+    job->resp = 0;
+    job->ttfb = job->secs = 0.0;
+    curl_easy_getinfo(job->curl, CURLINFO_RESPONSE_CODE, &job->resp);
+    curl_easy_getinfo(job->curl, CURLINFO_STARTTRANSFER_TIME, &job->ttfb);
+    curl_easy_getinfo(job->curl, CURLINFO_TOTAL_TIME, &job->secs);
+    _loop->idle.push_back(job->curl);
+    job->curl = nullptr;
+    if (job->sink.held)
+    {
+        job->sink.held = false;
+        _loop->held.erase(std::remove(_loop->held.begin(), _loop->held.end(), job), _loop->held.end());
+    }
+    if (job->sink.job)
+    {
+        EndStage(_loop, job);
+
+        return;
+    }
+    job->inflated = job->stream && job->zip.EndInflate(job->fp);
+    CloseJob(job);
+} /* end of FinishJob */
+
+/**
+* @brief   : CloseJob - close the local file of the finished transfer, and retry or complete it
+* @param[I]: job (finished transfer, whose stream has been ended)
+* @param[O]: none
+* @return  : none
+* @note    : the downloaded compressed file is unpacked by the conversion threads if they are on
+**/
+void CurlUtil::CloseJob(job_t *job)
+{
+    long resp = job->resp;
+    bool inflated = job->inflated;
+    bool closed = fclose(job->fp) == 0;
+    job->fp = nullptr;
+    long long n = job->sink.nbytes;
+    CURLcode ccode = (CURLcode)job->code;
+
+    /* the broken stream is downloaded again as the compressed file, which can be resumed */
+    if (job->stream)
+    {
+        if (!(ccode != CURLE_OK && IsNoFile(ccode, resp)) && (ccode != CURLE_OK || !inflated || !closed))
+        {
+            if (_verbose) cout << "*** INFO(CurlUtil::FinishJob): " << job->url << " failed to be inflated on the fly, download it again" << endl;
+            remove(job->partFile.c_str());
+            job->stream = false;
+            job->partFile = job->localFile + PARTSUFFIX;
+            std::lock_guard<std::mutex> lock(_loop->lock);
+            _loop->queue.push_back(job);
+
+            return;
+        }
+    }
+
+    /* the server cannot resume the transfer, so download it again from the beginning */
+    bool noRange = ccode == CURLE_RANGE_ERROR || ccode == CURLE_FTP_COULDNT_USE_REST ||
+        ccode == CURLE_BAD_DOWNLOAD_RESUME || (ccode == CURLE_HTTP_RETURNED_ERROR && resp == 416);
+    if (job->offset + n > 0 && noRange && !job->restart)
+    {
+        if (_verbose) cout << "*** INFO(CurlUtil::FinishJob): " << job->url << " cannot be resumed, download it again" << endl;
+        remove(job->partFile.c_str());
+        job->restart = true;
+        std::lock_guard<std::mutex> lock(_loop->lock);
+        _loop->queue.push_back(job);
+
+        return;
+    }
+
+    /* the transient error is retried later, and resumed from the data received */
+    if (ccode != CURLE_OK && IsTransient(ccode) && ++job->ntry < MAXRETRY)
+    {
+        job->notBefore = NowSec() + job->ntry;
+        std::lock_guard<std::mutex> lock(_loop->lock);
+        _loop->queue.push_back(job);
+
+        return;
+    }
+
+    int stat = ccode == CURLE_OK ? (closed ? XFER_OK : XFER_FAILED) : (IsNoFile(ccode, resp) ? XFER_NOFILE : XFER_FAILED);
+    _health.Record(HostOf(job->url), job->cls, stat, job->ttfb, (double)n, job->secs);
+    if (stat == XFER_NOFILE)
+    {
+        std::lock_guard<std::mutex> lock(_missLock);
+        _missing.insert(job->url);
+    }
+    if (stat == XFER_NOFILE && _verbose) cout << "*** INFO(CurlUtil::FinishJob): " << job->url << " does not exist" << endl;
+    else if (stat == XFER_FAILED) cout << "*** WARNING(CurlUtil::FinishJob): failed to transfer " << job->url << ", " <<
+        (job->errBuf[0] != '\0' ? job->errBuf : curl_easy_strerror(ccode)) << endl;
+
+    if (job->stream)
+    {
+        stat = Finalize(job->url, job->rnxFile.empty() ? job->outFile : job->rnxFile, stat, job->size, 0, n);
+        if (stat != XFER_OK) remove(job->partFile.c_str());
+    }
+    else
+    {
+        stat = Finalize(job->url, job->localFile, stat, job->size, job->offset, job->offset + n);
+        if (stat == XFER_OK && !job->outFile.empty() && !_loop->convThr.empty())
+        {
+            EndStage(_loop, job);
+
+            return;
+        }
+        if (stat == XFER_OK && !job->outFile.empty() && !Unpack(job->localFile, job->rnxFile, job->nzip)) stat = XFER_FAILED;
+    }
+    Complete(job, stat);
+} /* end of CloseJob */
@@ -0,0 +1,650 @@
+/*------------------------------------------------------------------------------
+* CurlUtil.h : header file of CurlUtil.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+/* constants/macros ----------------------------------------------------------*/
+#define XFER_OK         0         /* transfer finished successfully */
+#define XFER_NOFILE     1         /* remote file or directory does not exist */
+#define XFER_FAILED     2         /* transfer failed (network, login, TLS, local I/O, ...) */
+
+/* type definitions ----------------------------------------------------------*/
+struct rfile_t
+{                                 /* entry of remote directory listing */
+    string name;                  /* file name without path */
+    long long size;               /* file size in bytes (-1: unknown) */
+};
+
+class ZipUtil;                    /* inflation of the compressed data */
+struct job_t;                     /* transfer submitted to the event loop */
+struct loop_t;                    /* event loop of the multiplexed transfers */
+
+typedef std::function<void(int, const string &)> xferDone_t;  /* completion callback, the arguments are the status and local file */
+
+class CurlUtil
+{
+private:
+    bool _verbose;                /* print the information of each transfer */
+    string _listDir;              /* directory of the on-disk listing cache */
+    int _listTtl;                 /* time to live of the on-disk listing cache in minutes (<= 0: off) */
+    double _hedgeDelay;           /* delay of the hedged request to the mirror archive (s, <= 0: off) */
+    double _hedgeSpeed;           /* the transfer slower than it (bytes/s) is hedged */
+    vector<vector<string>> _mirrors;  /* URL prefixes of the same directory trees in the mirror archives */
+    string _class;                /* product class of the transfers, i.e., "OBSD", "SP3", "ION" */
+    string _task;                 /* download task of the transfers for the latency model (empty: not recorded) */
+    int _segCount;                /* number of segments of the large file of HTTP(S) (<= 1: off) */
+    long long _segMin;            /* the file not smaller than it (bytes) is downloaded in segments */
+    bool _inflate;                /* the compressed file is saved as the decompressed one without '.gz' or '.Z' */
+    bool _crx2rnx;                /* the compressed Compact RINEX file is saved as the RINEX one */
+    int _rnxGzip;                 /* number of threads compressing the converted RINEX file to '*.gz' (<= 0: not compressed) */
+    bool _keepCrx;                /* the compressed Compact RINEX file is saved as it is, neither inflated nor converted */
+    int _maxXfer;                 /* maximum number of transfers in flight in the event loop (<= 0: off) */
+    int _maxHostConn;             /* maximum number of connections to one host in the event loop */
+    int _convThreads;             /* number of threads inflating and converting the data of the event loop (<= 0: in the loop thread) */
+    bool _dryRun;                 /* the files are only added to the download plan, not downloaded */
+    bool _backfill;               /* the transfers are in the backfill lane, which yields to the real-time front */
+    std::mutex _loopLock;         /* lock of starting the event loop */
+    loop_t *_loop;                /* event loop, which is started by the first submitted transfer */
+
+    /**
+    * @brief   : RecordHealth - record the finished transfer in the health history of the host
+    * @param[I]: curl (easy handle of the transfer)
+    * @param[I]: url (remote URL)
+    * @param[I]: stat (XFER_OK, XFER_NOFILE or XFER_FAILED)
+    * @param[I]: nbytes (number of bytes received)
+    * @return  : none
+    * @note    :
+    **/
+    void RecordHealth(void *curl, const string &url, int stat, long long nbytes);
+
+    /**
+    * @brief   : Perform - run one transfer on the reusable connection of the host
+    * @param[I]: url (remote URL)
+    * @param[I]: fp (local file for the received data, nullptr:NO output)
+    * @param[I]: offset (number of bytes in 'fp' received before, the transfer is resumed from it)
+    * @param[O]: buf (memory buffer for the received data, nullptr:NO output)
+    * @param[I]: ftpCmd (FTP listing command, i.e., "MLSD", "NLST", nullptr:file transfer)
+    * @param[O]: nbytes (number of bytes received, nullptr:NO output)
+    * @param[I]: zip (the data are inflated before written to 'fp', nullptr:as received)
+    * @return  : XFER_OK, XFER_NOFILE, XFER_FAILED or XFER_NORANGE (the transfer cannot be resumed)
+    * @note    : transient errors are retried up to a few times, and the file transfer is resumed from
+    *            the data received in the last attempt; the inflated transfer is not retried
+    **/
+    int Perform(const string &url, FILE *fp, long long offset, string *buf, const char *ftpCmd, long long *nbytes,
+        ZipUtil *zip = nullptr);
+
+    /**
+    * @brief   : ParseMlsd - parse the reply of FTP 'MLSD' command
+    * @param[I]: buf (reply of 'MLSD')
+    * @param[O]: files (regular files in the directory)
+    * @return  : none
+    * @note    :
+    **/
+    void ParseMlsd(const string &buf, vector<rfile_t> &files);
+
+    /**
+    * @brief   : ParseNlst - parse the reply of FTP 'NLST' command
+    * @param[I]: buf (reply of 'NLST')
+    * @param[O]: files (entries in the directory, size is unknown)
+    * @return  : none
+    * @note    :
+    **/
+    void ParseNlst(const string &buf, vector<rfile_t> &files);
+
+    /**
+    * @brief   : ParseHtml - parse the HTML index page of HTTP(S) directory
+    * @param[I]: buf (HTML page)
+    * @param[O]: files (linked files in the directory, size is unknown)
+    * @return  : none
+    * @note    :
+    **/
+    void ParseHtml(const string &buf, vector<rfile_t> &files);
+
+    /**
+    * @brief   : ReadListCache - read the listing of the remote directory from the on-disk cache
+    * @param[I]: url (URL of the remote directory, ended with '/')
+    * @param[O]: files (files in the remote directory)
+    * @return  : true: the cache exists and has not expired, false: otherwise
+    * @note    :
+    **/
+    bool ReadListCache(const string &url, vector<rfile_t> &files);
+
+    /**
+    * @brief   : WriteListCache - write the listing of the remote directory to the on-disk cache
+    * @param[I]: url (URL of the remote directory, ended with '/')
+    * @param[I]: files (files in the remote directory)
+    * @return  : none
+    * @note    : the cache is written to a temporary file first, and then renamed
+    **/
+    void WriteListCache(const string &url, const vector<rfile_t> &files);
+
+    /**
+    * @brief   : ListRemote - get the list of files in the remote directory from the server
+    * @param[I]: url (URL of the remote directory, ended with '/')
+    * @param[O]: files (files in the remote directory)
+    * @return  : XFER_OK, XFER_NOFILE or XFER_FAILED
+    * @note    : 'MLSD' (or 'NLST' as fallback) is used for FTP(S), and the index page for HTTP(S)
+    **/
+    int ListRemote(const string &url, vector<rfile_t> &files);
+
+    /**
+    * @brief   : Head - get the size of the remote file of HTTP(S) and whether byte ranges are supported
+    * @param[I]: url (full URL of the remote file)
+    * @param[O]: size (size of the remote file, -1: unknown)
+    * @param[O]: ranges (true: 'Accept-Ranges: bytes' is returned by the server)
+    * @return  : XFER_OK, XFER_NOFILE or XFER_FAILED
+    * @note    :
+    **/
+    int Head(const string &url, long long *size, bool *ranges);
+
+    /**
+    * @brief   : Segmented - download the remote file of HTTP(S) in byte ranges concurrently
+    * @param[I]: url (full URL of the remote file)
+    * @param[I]: partFile (local file the data are written to)
+    * @param[I]: size (size of the remote file)
+    * @param[O]: nbytes (number of bytes received)
+    * @return  : XFER_OK, XFER_NOFILE or XFER_FAILED
+    * @note    : the local file is preallocated, and each range is written to its own position; the transfer
+    *            fails if any range is not received completely, i.e., the server ignores the range
+    **/
+    int Segmented(const string &url, const string &partFile, long long size, long long *nbytes);
+
+    /**
+    * @brief   : IsSegmented - check if the remote file is large enough to be downloaded in segments
+    * @param[I]: url (full URL of the remote file)
+    * @param[I/O]: size (size of the remote file, -1: unknown, which is set by HEAD if it is segmented)
+    * @return  : true: the file of HTTP(S) is not smaller than segMin, false: otherwise
+    * @note    : the file of unknown size, i.e., most of the files listed by HTTPS, is segmented only if
+    *            HEAD returns its size and the server supports byte ranges
+    **/
+    bool IsSegmented(const string &url, long long *size);
+
+    /**
+    * @brief   : MirrorsOf - get the URLs of the remote file in all the mirror archives
+    * @param[I]: url (full URL of the remote file in the preferred archive)
+    * @param[O]: none
+    * @return  : URLs of the remote file, the preferred one is the first
+    * @note    : the mirror archive with the longest matched prefix is used
+    **/
+    vector<string> MirrorsOf(const string &url);
+
+    /**
+    * @brief   : Hedge - download one remote file from the mirror archives, and the slow transfer is hedged
+    *            by a duplicate request to the next mirror
+    * @param[I]: urls (URLs of the remote file, the preferred one is the first)
+    * @param[I]: partFile (local file the data are written to)
+    * @param[I/O]: offset (number of bytes in 'partFile' received before, 0 if it is not resumed)
+    * @param[O]: nbytes (number of bytes received)
+    * @return  : XFER_OK, XFER_NOFILE or XFER_FAILED
+    * @note    : the first finished transfer wins and the others are cancelled, and the data of the winner
+    *            are moved to 'partFile'
+    **/
+    int Hedge(const vector<string> &urls, const string &partFile, long long &offset, long long *nbytes);
+
+    /**
+    * @brief   : Finalize - check the downloaded '<localFile>.part' and rename it to 'localFile'
+    * @param[I]: url (full URL of the remote file)
+    * @param[I]: localFile (local file name, with or without path)
+    * @param[I]: stat (status of the transfer, XFER_OK, XFER_NOFILE or XFER_FAILED)
+    * @param[I]: size (size of the remote file in the listing, -1: unknown)
+    * @param[I]: offset (number of bytes received before, 0 if it is not resumed)
+    * @param[I]: total (size of '<localFile>.part')
+    * @return  : XFER_OK, XFER_NOFILE or XFER_FAILED
+    * @note    : the '.part' file is kept to be resumed next time unless nothing has been received
+    **/
+    int Finalize(const string &url, const string &localFile, int stat, long long size, long long offset, long long total);
+
+    /**
+    * @brief   : Download - download one remote file as it is
+    * @param[I]: url (full URL of the remote file)
+    * @param[I]: localFile (local file name, with or without path)
+    * @param[O]: nbytes (size of the local file, nullptr:NO output)
+    * @param[I]: size (size of the remote file in the listing, -1: unknown)
+    * @return  : XFER_OK, XFER_NOFILE or XFER_FAILED
+    * @note    : the data are written to '<localFile>.part', which is resumed by HTTP Range or FTP REST in
+    *            the next attempt if the transfer is broken, and renamed to 'localFile' only when the size
+    *            is the same as the remote one
+    **/
+    int Download(const string &url, const string &localFile, long long *nbytes, long long size);
+
+    /**
+    * @brief   : Fetch - download one remote file, which is taken by the calling thread
+    * @param[I]: url (full URL of the remote file)
+    * @param[I]: localFile (local file name, with or without path)
+    * @param[O]: nbytes (number of bytes received, nullptr:NO output)
+    * @param[I]: size (size of the remote file in the listing, -1: unknown)
+    * @return  : XFER_OK, XFER_NOFILE or XFER_FAILED
+    * @note    : see GetFile
+    **/
+    int Fetch(const string &url, const string &localFile, long long *nbytes, long long size);
+
+    /**
+    * @brief   : Plan - add the remote file to the download plan instead of downloading it
+    * @param[I]: url (full URL of the remote file)
+    * @param[I]: localFile (local file name, with or without path)
+    * @param[I]: size (size of the remote file in the listing, -1: unknown)
+    * @return  : XFER_OK, XFER_NOFILE or XFER_FAILED of probing the remote file
+    * @note    : the file not listed is probed once by HEAD (or SIZE of FTP) for its existence and size, and
+    *            the plan is deduplicated by the local files, so the file wanted by several days is counted
+    *            once
+    **/
+    int Plan(const string &url, const string &localFile, long long size);
+
+    /**
+    * @brief   : Stream - download one remote compressed file and inflate it while it is received
+    * @param[I]: url (full URL of the remote file)
+    * @param[I]: outFile (decompressed local file, with or without path)
+    * @param[I]: fmt (format of the remote file, ZIP_GZIP or ZIP_LZW)
+    * @param[O]: nbytes (number of compressed bytes received, nullptr:NO output)
+    * @param[I]: size (size of the remote file in the listing, -1: unknown)
+    * @param[I]: isCrx (true: the decompressed data are Compact RINEX, which are decoded and 'outFile' is
+    *            the RINEX file, false: as they are)
+    * @return  : XFER_OK, XFER_NOFILE or XFER_FAILED
+    * @note    : the decompressed data are written to '<outFile>.part', which cannot be resumed and is
+    *            removed if the transfer fails
+    **/
+    int Stream(const string &url, const string &outFile, int fmt, long long *nbytes, long long size, bool isCrx);
+
+    /**
+    * @brief   : StartLoop - start the event loop of the multiplexed transfers if it is not running
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void StartLoop();
+
+    /**
+    * @brief   : StopLoop - wait for all the submitted transfers and stop the event loop
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void StopLoop();
+
+    /**
+    * @brief   : RunLoop - run the event loop of the multiplexed transfers in its own thread
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    : the sockets of all the transfers are watched by epoll on Linux, and by curl_multi_poll
+    *            on the other platforms
+    **/
+    void RunLoop();
+
+    /**
+    * @brief   : StartJob - add the submitted transfer to the event loop
+    * @param[I]: job (submitted transfer)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the transfer is resumed from '<localFile>.part' if it exists
+    **/
+    void StartJob(job_t *job);
+
+    /**
+    * @brief   : FinishJob - handle the finished transfer of the event loop
+    * @param[I]: job (finished transfer)
+    * @param[I]: code (result code of libcurl)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the transient error is retried in the loop, and the callback and the future of the
+    *            transfer are fulfilled when it is done
+    **/
+    void FinishJob(job_t *job, int code);
+
+    /**
+    * @brief   : CloseJob - close the local file of the finished transfer, and retry or complete it
+    * @param[I]: job (finished transfer, whose stream has been ended)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the downloaded compressed file is unpacked by the conversion threads if they are on
+    **/
+    void CloseJob(job_t *job);
+
+public:
+    CurlUtil()
+	{
+        _verbose = false;
+        _listTtl = 0;
+        _hedgeDelay = 0.0;
+        _hedgeSpeed = 0.0;
+        _segCount = 1;
+        _segMin = 0;
+        _inflate = false;
+        _crx2rnx = false;
+        _rnxGzip = 0;
+        _keepCrx = false;
+        _maxXfer = 0;
+        _maxHostConn = 8;
+        _convThreads = 0;
+        _dryRun = false;
+        _backfill = false;
+        _loop = nullptr;
+	}
+	~CurlUtil()
+	{
+        StopLoop();
+	}
+
+    /**
+    * @brief   : SetVerbose - (not) print the information of each transfer
+    * @param[I]: verbose (true: print, false: quiet)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void SetVerbose(bool verbose);
+
+    /**
+    * @brief   : SetListCache - set the on-disk cache of the remote directory listings
+    * @param[I]: cacheDir (directory of the cache files)
+    * @param[I]: ttl (time to live of the cache files in minutes, <= 0: the listings are only cached in memory)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void SetListCache(const string &cacheDir, int ttl);
+
+    /**
+    * @brief   : SetClass - set the product class of the following transfers for the health history
+    * @param[I]: cls (product class, i.e., "OBSD", "SP3", "ION")
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void SetClass(const string &cls);
+
+    /**
+    * @brief   : LoadHealth - read the health history of the hosts
+    * @param[I]: file (file of the history)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the history is shared by all the threads and read only once, and it is written back by SaveHealth
+    **/
+    void LoadHealth(const string &file);
+
+    /**
+    * @brief   : SaveHealth - write the health history of the hosts
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    : it is called once at the end of the run (or of each round of the daemon), after all the days
+    **/
+    static void SaveHealth();
+
+    /**
+    * @brief   : SetTask - set the download task of the following transfers for the latency model
+    * @param[I]: task (download task, i.e., "OBS", "ORBCLK", "NAV", empty: not recorded)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the delay of each new file after the nominal epoch in its name is recorded for the task
+    **/
+    void SetTask(const string &task);
+
+    /**
+    * @brief   : LoadLatency - read the latency model of the publication of the products
+    * @param[I]: file (file of the model)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the model is shared by all the threads and read only once, and it is written back by SaveLatency
+    **/
+    void LoadLatency(const string &file);
+
+    /**
+    * @brief   : SaveLatency - write the latency model of the publication of the products
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    : it is written only if new files have been recorded
+    **/
+    void SaveLatency();
+
+    /**
+    * @brief   : PublishWindow - get the publication window of the task predicted by the latency model
+    * @param[I]: task (download task, i.e., "OBS", "ORBCLK", "NAV")
+    * @param[O]: lo (start of the window after the nominal epoch (hours))
+    * @param[O]: hi (end of the window after the nominal epoch (hours))
+    * @param[O]: latest (latest nominal epoch of the new files of the task in this run (s since 1970), 0: none)
+    * @return  : true: OK, false: too few delays have been recorded for the task
+    * @note    :
+    **/
+    bool PublishWindow(const string &task, double *lo, double *hi, double *latest);
+
+    /**
+    * @brief   : ExpectedTime - get the expected completion time of the transfer from the host of URL
+    * @param[I]: url (URL of the remote directory or file)
+    * @param[I]: cls (product class, i.e., "OBSD", "SP3", "ION")
+    * @param[I]: size (size of the file (bytes))
+    * @return  : expected completion time (s), 0 if the host has not been used for the class
+    * @note    :
+    **/
+    double ExpectedTime(const string &url, const string &cls, double size);
+
+    /**
+    * @brief   : AddMirrors - add the equivalent directory trees of the mirror archives
+    * @param[I]: prefixes (URL prefixes of the same directory tree in the mirror archives)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the file under one of the prefixes can be downloaded from all the others
+    **/
+    void AddMirrors(const vector<string> &prefixes);
+
+    /**
+    * @brief   : SetHedge - set the hedged requests to the mirror archives
+    * @param[I]: delay (a duplicate request is sent to the next mirror if the transfer has no data or is
+    *            too slow after so long (s), <= 0: off)
+    * @param[I]: speed (minimum throughput of the transfer (bytes/s))
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void SetHedge(double delay, double speed);
+
+    /**
+    * @brief   : SetSegment - set the segmented download of the large file of HTTP(S)
+    * @param[I]: count (number of segments, <= 1: off)
+    * @param[I]: minSize (the file not smaller than it (bytes) is downloaded in segments)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void SetSegment(int count, double minSize);
+
+    /**
+    * @brief   : SetRateLimit - set the bandwidth limit of all the transfers of the process
+    * @param[I]: bps (bandwidth limit (bytes/s), <= 0: unlimited)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the limit is shared by all the days, the threads and the concurrent transfers; the transfer
+    *            beyond it is paused by libcurl until the bucket is refilled
+    **/
+    static void SetRateLimit(double bps);
+
+    /**
+    * @brief   : SetInflate - (not) inflate the downloaded gzip and Unix compress files
+    * @param[I]: inflate (true: the compressed file is saved as the decompressed one without '.gz' or '.Z',
+    *            false: as it is)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void SetInflate(bool inflate);
+
+    /**
+    * @brief   : SetCrx2Rnx - (not) convert the compressed Compact RINEX files to RINEX while they are received
+    * @param[I]: crx2rnx (true: '*.yyd.gz', '*.yyd.Z' and '*.crx.gz' are saved as '*.yyo' and '*.rnx',
+    *            false: as the inflated '*.yyd' and '*.crx')
+    * @param[O]: none
+    * @return  : none
+    * @note    : it works only if the inflation is on, and the file that cannot be decoded is saved as the
+    *            inflated one
+    **/
+    void SetCrx2Rnx(bool crx2rnx);
+
+    /**
+    * @brief   : SetRnxGzip - (not) compress the RINEX files converted from Compact RINEX
+    * @param[I]: nthread (number of threads compressing each file, <= 0: the RINEX file is written as it is)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the RINEX file is saved as the indexed gzip file '*.yyo.gz' or '*.rnx.gz' by the decoder
+    *            directly, whose gzip members are cut at the hours of the epochs
+    **/
+    void SetRnxGzip(int nthread);
+
+    /**
+    * @brief   : SetKeepCrx - (not) keep the compressed Compact RINEX files as they are downloaded
+    * @param[I]: keepCrx (true: '*.yyd.gz', '*.yyd.Z' and '*.crx.gz' are saved as they are, false: inflated
+    *            and converted as set by SetInflate and SetCrx2Rnx)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the other compressed files are still inflated, and the kept files are read by RnxReader
+    **/
+    void SetKeepCrx(bool keepCrx);
+
+    /**
+    * @brief   : GetFile - download one remote file
+    * @param[I]: url (full URL of the remote file)
+    * @param[I]: localFile (local file name, with or without path)
+    * @param[O]: nbytes (number of bytes received, nullptr:NO output)
+    * @param[I]: size (size of the remote file in the listing, -1: unknown)
+    * @return  : XFER_OK, XFER_NOFILE or XFER_FAILED
+    * @note    : the data are written to '<localFile>.part', which is resumed by HTTP Range or FTP REST in
+    *            the next attempt if the transfer is broken, and renamed to 'localFile' only when the size
+    *            is the same as the remote one; if the inflation is on, the gzip or Unix compress file is
+    *            saved as the one without '.gz' or '.Z', and it is inflated while it is received unless it is
+    *            resumed, hedged or downloaded in segments; the Compact RINEX file is also decoded on the
+    *            fly and saved as the RINEX file if it is set by SetCrx2Rnx
+    **/
+    int GetFile(const string &url, const string &localFile, long long *nbytes = nullptr, long long size = -1);
+
+    /**
+    * @brief   : SetMulti - set the event loop of the multiplexed transfers
+    * @param[I]: maxXfer (maximum number of transfers in flight, <= 0: off)
+    * @param[I]: maxHostConn (maximum number of connections to one host)
+    * @param[O]: none
+    * @return  : none
+    * @note    : it should be called before the first transfer is submitted
+    **/
+    void SetMulti(int maxXfer, int maxHostConn);
+
+    /**
+    * @brief   : SetConvThreads - set the threads inflating and converting the data received by the event loop
+    * @param[I]: nthread (number of threads, <= 0: in the loop thread)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the received data of each transfer wait in a bounded queue, and the transfer is paused
+    *            while its queue is full; it should be called before the first transfer is submitted
+    **/
+    void SetConvThreads(int nthread);
+
+    /**
+    * @brief   : SetDryRun - (not) plan the downloads instead of downloading the files
+    * @param[I]: dryRun (true: the files are only added to the download plan, false: downloaded)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the remote directories are still listed, and nothing is written to the local files
+    **/
+    void SetDryRun(bool dryRun);
+
+    /**
+    * @brief   : ResetRun - forget the listings and the missing files of this run in all the threads
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    : it is called by the daemon before each round, so the files published since the last round are
+    *            listed and requested again; the transfers of the backfill lane in flight only list the
+    *            directories again
+    **/
+    static void ResetRun();
+
+    /**
+    * @brief   : SetBackfill - (not) run the transfers in the backfill lane, which yields to the real-time front
+    * @param[I]: backfill (true: the new transfers wait while the front is busy, and the transfers in flight
+    *            are paused, false: the transfers do not wait)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the transfer is paused by libcurl and resumed when the front is idle, and the paused transfer
+    *            is not aborted as stalled
+    **/
+    void SetBackfill(bool backfill);
+
+    /**
+    * @brief   : SetLaneLimit - set the bandwidth limit of the backfill lane of the process
+    * @param[I]: bps (bandwidth limit (bytes/s), <= 0: unlimited)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the transfers of the lane are also within the limit of all the transfers
+    **/
+    static void SetLaneLimit(double bps);
+
+    /**
+    * @brief   : SetFrontBusy - mark the real-time front busy (or idle) in all the threads
+    * @param[I]: busy (true: the front begins to download the target due, false: it has done)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the calls are counted, so each 'true' should be followed by one 'false'
+    **/
+    static void SetFrontBusy(bool busy);
+
+    /**
+    * @brief   : OpenJournal - open the journal of the downloads shared by all the days
+    * @param[I]: file (file of the journal)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the journal is opened once in the process, and the file verified in it is neither planned nor
+    *            downloaded again as long as it keeps the size recorded, and the dry run only reads it
+    **/
+    void OpenJournal(const string &file);
+
+    /**
+    * @brief   : WritePlan - write the download plan of all the threads of this run to the file
+    * @param[I]: file (file of the plan, 'size  URL  local file' per line)
+    * @param[O]: nfile (number of the files in the plan)
+    * @param[O]: nbytes (total size of the files whose sizes are known)
+    * @param[O]: nunknown (number of the files whose sizes are unknown)
+    * @return  : true: OK, false: the file failed to be written
+    * @note    :
+    **/
+    bool WritePlan(const string &file, int *nfile, long long *nbytes, int *nunknown);
+
+    /**
+    * @brief   : Submit - submit one remote file to be downloaded in the event loop
+    * @param[I]: url (full URL of the remote file)
+    * @param[I]: localFile (local file name, with or without path)
+    * @param[I]: size (size of the remote file in the listing, -1: unknown)
+    * @param[I]: done (callback called in the loop thread when the transfer is done with the status and
+    *            the local file, which is the one without '.gz' or '.Z' if it is inflated, or the RINEX file
+    *            if it is converted; may be empty)
+    * @return  : future of the status, XFER_OK, XFER_NOFILE or XFER_FAILED
+    * @note    : the file is downloaded by GetFile in the calling thread if the event loop is off, the file
+    *            is hedged by the mirrors or downloaded in segments, or it is being downloaded by another
+    *            transfer; otherwise the local file is taken by the transfer until it is done, and the relative
+    *            'localFile' is in the current directory, so the directory should not be changed until then
+    **/
+    std::future<int> Submit(const string &url, const string &localFile, long long size = -1, const xferDone_t &done = nullptr);
+
+    /**
+    * @brief   : ListDir - get the list of files in the remote directory
+    * @param[I]: dirUrl (URL of the remote directory)
+    * @param[O]: files (files in the remote directory)
+    * @return  : XFER_OK, XFER_NOFILE or XFER_FAILED
+    * @note    : the remote directory is listed only once in a run, and the listing is shared by all the
+    *            threads; the failed listing is not cached and tried again next time
+    **/
+    int ListDir(const string &dirUrl, vector<rfile_t> &files);
+
+    /**
+    * @brief   : GetFiles - download the files matching the wildcard pattern in the remote directory
+    * @param[I]: dirUrl (URL of the remote directory)
+    * @param[I]: pattern (wildcard pattern of file name with '*' and '?', i.e., "*0010.21d.*")
+    * @param[I]: localDir (local directory the files are saved to)
+    * @param[O]: localFiles (local files downloaded, without '.gz' or '.Z' if inflated, or the RINEX files
+    *            if converted, nullptr:NO output)
+    * @return  : XFER_OK, XFER_NOFILE (nothing matched) or XFER_FAILED
+    * @note    : it replaces 'wget -r -nH -A <pattern> --cut-dirs=<n> <dirUrl>', and the remote directory
+    *            is not crawled again as its listing is cached; the matched files are downloaded in the event
+    *            loop concurrently if it is on
+    **/
+    int GetFiles(const string &dirUrl, const string &pattern, const string &localDir, vector<string> *localFiles = nullptr);
+};
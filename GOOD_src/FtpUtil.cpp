@@ -30,10 +30,38 @@
             2021/09/04      add the option for NGS/NOAA CORS (from Amazon Web Services (AWS)) and EUREF Permanent Network (EPN) observation downloading (by Feng Zhou @ SDUST)
             2021/09/05      fix the bug of broadcast ephemeris downloading via WHU FTP before and after 2020 (by Feng Zhou @ SDUST and Zan Liu @ CUMT)
             2021/09/06      modify the setting of directories of GNSS observations and products in configure file to make them more elastic (by Feng Zhou @ SDUST and Caoming Fan @ SDU)
+            2026/10/16      replace the 'wget' process of each file with the in-process libcurl transfer engine (CurlUtil) keeping connections alive per host
+            2026/10/16      add the option 'maxParallel' for site-by-site observation downloading with a bounded pool of worker threads
+            2026/10/16      add the option 'listCacheTtl' for the on-disk cache of remote directory listings shared by all the sites
+            2026/10/16      add the option 'hedgeMirror' for the hedged requests to the mirror archives of CDDIS, IGN, and WHU
+            2026/10/16      add 'ftpFrom = auto' for the archive selection according to the health history of the hosts
+            2026/10/16      add the option 'segDownload' for the segmented download of the large file of HTTP(S)
+            2026/10/16      add the option 'schedPriority' for the download tasks run by priority class within the bandwidth limit
+            2026/10/16      add the option 'multiXfer' for the transfers multiplexed in one event loop thread
+            2026/10/16      decompress the downloaded files in process instead of spawning 'gzip -d -f'
+            2026/10/16      decompress the '*.Z' files in process as well, so 'gzip' is no longer needed
+            2026/10/16      convert Compact RINEX to RINEX in process (CrxUtil) instead of spawning 'crx2rnx'
+            2026/10/16      convert the compressed Compact RINEX to RINEX while it is received, so only the 'o' file is written
+            2026/10/16      add the option 'convThreads' for the conversion threads behind the event loop of 'multiXfer'
+            2026/10/16      unpack and convert the observation files downloaded in 'all' mode on a pool of threads
+            2026/10/16      add the option 'gzipObs' for the observation files written as the indexed gzip files
+            2026/10/16      add the option 'keepCrx' for the observation files kept compressed as downloaded
+            2026/10/16      plan the downloads of all the days without transferring anything by '--dry-run'
+            2026/10/16      add the option 'journal' for the crash-safe journal of the downloads under 'mainDir'
+            2026/10/16      run only the tasks due by the publication cadences of their products for the daemon
+            2026/10/16      poll the publication windows predicted by the latency model of the products for the daemon
+            2026/10/16      run the downloads of the backfill in the lane capped in bandwidth, which yields to the daemon
+            2026/10/16      the local files are given with the directory of the task (LocalFile) instead of changing the
+                               working directory of the process (chdir), so the days can be downloaded in parallel on all the OS
 *-----------------------------------------------------------------------------*/
 #include "Good.h"
 #include "TimeUtil.h"
 #include "StringUtil.h"
+#include "HealthUtil.h"
+#include "ZipUtil.h"
+#include "CrxUtil.h"
+#include "CurlUtil.h"
+#include "ThreadUtil.h"
 #include "FtpUtil.h"
 
 
@@ -55,6 +83,103 @@
 #define IDX_ION    14   /* index for global ionosphere map (GIM) downloaded */
 #define IDX_ROTI   15   /* index for Rate of TEC index (ROTI) downloaded */
 #define IDX_ZTD    16   /* index for IGS final tropospheric product downloaded */
+#define TYPSIZE    2.0E6   /* typical size of the file for the archive selection (bytes) */
+#define ARC_CDDIS  1       /* CDDIS in the archives supported for the product */
+#define ARC_IGN    2       /* IGN in the archives supported for the product */
+#define ARC_WHU    4       /* WHU in the archives supported for the product */
+#define ARC_ALL    7       /* all the archives (CDDIS, IGN, and WHU) are supported for the product */
+
+#define TASK_OBS       0   /* task of IGS observation downloading */
+#define TASK_OBM       1   /* task of MGEX observation downloading */
+#define TASK_OBC       2   /* task of CUT observation downloading */
+#define TASK_OBG       3   /* task of GA observation downloading */
+#define TASK_OBH       4   /* task of Hong Kong CORS observation downloading */
+#define TASK_OBN       5   /* task of NGS/NOAA CORS observation downloading */
+#define TASK_OBE       6   /* task of EPN observation downloading */
+#define TASK_NAV       7   /* task of broadcast ephemeris downloading */
+#define TASK_ORBCLK    8   /* task of precise orbit and clock product downloading */
+#define TASK_EOP       9   /* task of EOP file downloading */
+#define TASK_SNX       10  /* task of IGS SINEX file downloading */
+#define TASK_DCB       11  /* task of DCB file downloading */
+#define TASK_ION       12  /* task of GIM downloading */
+#define TASK_ROTI      13  /* task of ROTI file downloading */
+#define TASK_TRP       14  /* task of tropospheric product downloading */
+#define TASK_RTORBCLK  15  /* task of real-time orbit and clock product downloading */
+#define TASK_RTBIAS    16  /* task of real-time bias product downloading */
+#define TASK_ATX       17  /* task of ANTEX file downloading */
+#define NTASK          18  /* number of tasks */
+
+#define POLL_HOURLY    60    /* poll interval of the daemon for the hourly files, and the WHU ultra-rapid products (minutes) */
+#define POLL_3HOURLY   180   /* poll interval of the daemon for the daily files, and the GFZ ultra-rapid products (minutes) */
+#define POLL_6HOURLY   360   /* poll interval of the daemon for the IGS and ESA ultra-rapid products (minutes) */
+#define POLL_DAILY     1440  /* poll interval of the daemon for the rapid, final and the other products (minutes) */
+#define POLL_WINDOW    5     /* poll interval of the daemon in the publication window predicted (minutes) */
+#define MJD1970        40587 /* MJD of 1970-01-01 */
+
+/* priority classes of the tasks */
+static const int TASK_PRIO[NTASK] = { PRIO_BULK, PRIO_BULK, PRIO_BULK, PRIO_BULK, PRIO_BULK, PRIO_BULK, PRIO_BULK,
+    PRIO_CRITICAL, PRIO_CRITICAL, PRIO_CRITICAL, PRIO_NORMAL, PRIO_CRITICAL, PRIO_NORMAL, PRIO_NORMAL, PRIO_NORMAL,
+    PRIO_CRITICAL, PRIO_CRITICAL, PRIO_CRITICAL };
+
+/* product classes of the indexes for the health history of the hosts */
+static const char *IDX_NAMES[] = { "OBSD", "OBSH", "OBSHR", "OBMD", "OBMH", "OBMHR", "NAV", "SP3", "CLK",
+    "EOP", "SNX", "SP3M", "CLKM", "DCBM", "ION", "ROTI", "ZTD" };
+
+
+/* names of the tasks for the latency model */
+static const char *TASK_NAMES[NTASK] = { "OBS", "OBM", "OBC", "OBG", "OBH", "OBN", "OBE", "NAV", "ORBCLK", "EOP", "SNX",
+    "DCB", "ION", "ROTI", "TRP", "RTORBCLK", "RTBIAS", "ATX" };
+
+/* get the interval between the nominal epochs of the files of the task, i.e., 60 for the hourly files (minutes) */
+static int IssueMinutes(int task, const ftpopt_t *fopt)
+{
+    string ac;
+    switch (task)
+    {
+    case TASK_OBS: return strcmp(fopt->obsTyp, "daily") == 0 ? POLL_DAILY : POLL_HOURLY;
+    case TASK_OBM: return strcmp(fopt->obmTyp, "daily") == 0 ? POLL_DAILY : POLL_HOURLY;
+    case TASK_OBG: return strcmp(fopt->obgTyp, "daily") == 0 ? POLL_DAILY : POLL_HOURLY;
+    case TASK_OBH: return strcmp(fopt->obhTyp, "30s") == 0 ? POLL_DAILY : POLL_HOURLY;
+    case TASK_NAV: return strcmp(fopt->navTyp, "daily") == 0 ? POLL_DAILY : POLL_HOURLY;
+    case TASK_ORBCLK: ac = fopt->orbClkOpt; break;
+    case TASK_EOP: ac = fopt->eopOpt; break;
+    default: return POLL_DAILY;
+    }
+
+    StringUtil str;
+    str.ToLower(ac);
+    if (ac == "wuu") return POLL_HOURLY;
+    if (ac == "gfu") return POLL_3HOURLY;
+    if (ac == "igu" || ac == "esu") return POLL_6HOURLY;
+
+    return POLL_DAILY;
+}
+
+/* get the poll interval of the task for the daemon, which follows the publication cadence of its product (minutes) */
+static int PollMinutes(int task, const ftpopt_t *fopt)
+{
+    string ac;
+    switch (task)
+    {
+    case TASK_OBS: return strcmp(fopt->obsTyp, "daily") == 0 ? POLL_3HOURLY : POLL_HOURLY;
+    case TASK_OBM: return strcmp(fopt->obmTyp, "daily") == 0 ? POLL_3HOURLY : POLL_HOURLY;
+    case TASK_OBG: return strcmp(fopt->obgTyp, "daily") == 0 ? POLL_3HOURLY : POLL_HOURLY;
+    case TASK_OBH: return strcmp(fopt->obhTyp, "30s") == 0 ? POLL_3HOURLY : POLL_HOURLY;
+    case TASK_OBC: case TASK_OBN: case TASK_OBE: return POLL_3HOURLY;
+    case TASK_NAV: return strcmp(fopt->navTyp, "daily") == 0 ? POLL_3HOURLY : POLL_HOURLY;
+    case TASK_ORBCLK: ac = fopt->orbClkOpt; break;
+    case TASK_EOP: ac = fopt->eopOpt; break;
+    default: return POLL_DAILY;
+    }
+
+    StringUtil str;
+    str.ToLower(ac);
+    if (ac == "wuu") return POLL_HOURLY;
+    if (ac == "gfu") return POLL_3HOURLY;
+    if (ac == "igu" || ac == "esu") return POLL_6HOURLY;
+
+    return POLL_DAILY;
+}
 
 
 /* function definition -------------------------------------------------------*/
@@ -68,6 +193,9 @@
 **/
 void FtpUtil::init()
 {
+    /* the archives are set only once, as FtpDownload is called day by day */
+    if (!_ftpArchive.CDDIS.empty()) return;
+
     /* FTP archive for CDDIS */
     _ftpArchive.CDDIS.push_back("ftps://gdc.cddis.eosdis.nasa.gov/pub/gnss/data/daily");                /* IGS daily observation (30s) files */
     _ftpArchive.CDDIS.push_back("ftps://gdc.cddis.eosdis.nasa.gov/pub/gnss/data/hourly");               /* IGS hourly observation (30s) files */
@@ -124,8 +252,233 @@ void FtpUtil::init()
     _ftpArchive.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products/ionex");                           /* global ionosphere map (GIM) files */
     _ftpArchive.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products/ionex");                           /* Rate of TEC index (ROTI) files */
     _ftpArchive.WHU.push_back("ftp://igs.gnsswhu.cn/pub/gps/products/troposphere/new");                 /* IGS final tropospheric product files */
+
+    /* the directory trees with the same layout in the archives, which are used for the hedged requests */
+    const int idxMirror[] = { IDX_OBSD, IDX_OBSH, IDX_SP3, IDX_SP3M };
+    for (int i = 0; i < (int)(sizeof(idxMirror) / sizeof(idxMirror[0])); i++)
+    {
+        int k = idxMirror[i];
+        vector<string> prefixes;
+        prefixes.push_back(_ftpArchive.CDDIS[k]);
+        if (k == IDX_SP3 || k == IDX_SP3M) prefixes.push_back(_ftpArchive.IGN[k]);  /* the observations of IGN are in 'yyyy/doy' */
+        prefixes.push_back(_ftpArchive.WHU[k]);
+        _curl.AddMirrors(prefixes);
+    }
 } /* end of init */
 
+/**
+* @brief   : SelectArchive - select the FTP archive (CDDIS, IGN, or WHU) for the product
+* @param[I]: idx (index of the product, i.e., IDX_OBSD, IDX_SP3, ...)
+* @param[I]: arcs (archives supported by the caller for the product, i.e., ARC_CDDIS | ARC_IGN, ARC_ALL)
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : name of the archive in upper case
+* @note    : for 'ftpFrom = auto', the archive with the shortest expected completion time in the
+*            health history is selected among the ones supported, and the one never used for the
+*            product is tried first
+**/
+string FtpUtil::SelectArchive(int idx, int arcs, const ftpopt_t *fopt)
+{
+    _curl.SetClass(IDX_NAMES[idx]);
+
+    StringUtil str;
+    string ftpName = fopt->ftpFrom;
+    str.ToUpper(ftpName);
+    if (ftpName != "AUTO") return ftpName;
+
+    const string arcNames[3] = { "CDDIS", "IGN", "WHU" };
+    const int arcFlags[3] = { ARC_CDDIS, ARC_IGN, ARC_WHU };
+    const string *urls[3] = { &_ftpArchive.CDDIS[idx], &_ftpArchive.IGN[idx], &_ftpArchive.WHU[idx] };
+    int ibest = 0;
+    double tbest = -1.0;
+    for (int i = 0; i < 3; i++)
+    {
+        if (!(arcs & arcFlags[i])) continue;
+        double t = _curl.ExpectedTime(*urls[i], IDX_NAMES[idx], TYPSIZE);
+        if (tbest < 0.0 || t < tbest)
+        {
+            ibest = i;
+            tbest = t;
+        }
+    }
+    ostringstream oss;
+    oss << fixed << setprecision(1) << tbest;
+    cout << "*** INFO(FtpUtil::SelectArchive): " << arcNames[ibest] << " is selected for " << IDX_NAMES[idx] <<
+        " (expected " << oss.str() << " s for " << (int)(TYPSIZE / 1.0E6) << " MB)" << endl;
+
+    return arcNames[ibest];
+} /* end of SelectArchive */
+
+/**
+* @brief   : IsDue - check whether the task of the day is due to be polled by the daemon
+* @param[I]: task (task of downloading, i.e., TASK_OBS, TASK_ORBCLK, ...)
+* @param[I]: popt (processing options)
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : true: the task is run (and its poll is recorded), false: it was polled recently
+* @note    : it is always true out of the daemon
+**/
+bool FtpUtil::IsDue(int task, const prcopt_t *popt, const ftpopt_t *fopt)
+{
+    if (!_daemon) return true;
+
+    TimeUtil tu;
+    int yyyy, doy;
+    tu.time2yrdoy(popt->ts, &yyyy, &doy);
+    char key[32];
+    sprintf(key, "%d %04d %03d", task, yyyy, doy);
+    time_t now = time(NULL);
+    double interval = PollMinutes(task, fopt) * 60.0;
+
+    /* the window learned from the delays of the files after their nominal epochs, which is polled often until
+       the latest file expected is seen, and the task is not polled before the window of the next file opens */
+    double lo, hi, latest;
+    if (_curl.PublishWindow(TASK_NAMES[task], &lo, &hi, &latest))
+    {
+        double t0 = (popt->ts.mjd - MJD1970) * 86400.0, period = IssueMinutes(task, fopt) * 60.0;
+        double k = floor(((double)now - t0 - lo * 3600.0) / period);
+        if (k < 0.0) return false;
+
+        double epoch = t0 + std::min(k, floor(86400.0 / period) - 1.0) * period;
+        if (latest >= epoch) interval = POLL_DAILY * 60.0;
+        else if ((double)now <= epoch + hi * 3600.0) interval = POLL_WINDOW * 60.0;
+    }
+
+    auto it = _polled.find(key);
+    if (it != _polled.end() && difftime(now, it->second) < interval) return false;
+    _polled[key] = now;
+
+    return true;
+} /* end of IsDue */
+
+/**
+* @brief   : GetMaxParallel - get the maximum number of sites downloaded in parallel from the archive
+* @param[I]: arcName (archive name, i.e., "CDDIS", "IGN", "WHU", "CUT", "GA", "HK", "NGS", or "EPN")
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : maximum number of sites in flight
+* @note    : the setting for the archive in 'maxParallel' is used first, and then the default one
+**/
+int FtpUtil::GetMaxParallel(const string &arcName, const ftpopt_t *fopt)
+{
+    auto it = fopt->maxParallelArc.find(arcName);
+    int n = it != fopt->maxParallelArc.end() ? it->second : fopt->maxParallel;
+
+    return n < 1 ? 1 : n;
+} /* end of GetMaxParallel */
+
+/**
+* @brief   : RenameRnx - rename the RINEX file converted from Compact RINEX while it was received to the 'o' file
+* @param[I]: rnxFile (local file downloaded, which is '*.rnx' or '*.rnx.gz' if it has been converted)
+* @param[I]: oFile ('o' file)
+* @param[O]: none
+* @return  : true: 'oFile' exists, false: 'rnxFile' has not been converted
+* @note    : the compressed RINEX file is renamed to '<oFile>.gz', and with 'keepCrx' the compressed
+*            Compact RINEX file is renamed to the 'd' file of 'oFile' with the same suffix
+**/
+bool FtpUtil::RenameRnx(const string &rnxFile, const string &oFile)
+{
+    if (_keepCrx)
+    {
+        /* the compressed Compact RINEX file is kept as it is downloaded, only the name is changed */
+        int fmt = _zip.Format(rnxFile);
+        size_t len = rnxFile.size() - (fmt == ZIP_GZIP ? 3 : (fmt == ZIP_LZW ? 2 : 0));
+        bool isCrx = fmt != ZIP_NONE && len > 4 && (rnxFile.compare(len - 4, 4, ".crx") == 0 ||
+            rnxFile.compare(len - 4, 4, ".CRX") == 0 || (rnxFile[len - 4] == '.' && (rnxFile[len - 1] == 'd' ||
+            rnxFile[len - 1] == 'D')));
+        string dstFile = oFile.substr(0, oFile.size() - 1) + "d" + rnxFile.substr(len);
+        if (isCrx && dstFile != rnxFile && access(LocalFile(rnxFile).c_str(), 0) == 0) rename(LocalFile(rnxFile).c_str(), LocalFile(dstFile).c_str());
+
+        return access(ObsFile(oFile).c_str(), 0) == 0;
+    }
+
+    string srcFile = rnxFile, dstFile = ObsFile(oFile);
+    size_t len = srcFile.size();
+    if (_gzipObs && (len < 3 || srcFile.compare(len - 3, 3, ".gz") != 0)) srcFile += ".gz";
+    len = srcFile.size() - (_gzipObs ? 3 : 0);
+    bool isRnx = len > 4 && (srcFile.compare(len - 4, 4, ".rnx") == 0 || srcFile.compare(len - 4, 4, ".RNX") == 0);
+    if (isRnx && access(LocalFile(srcFile).c_str(), 0) == 0) rename(LocalFile(srcFile).c_str(), dstFile.c_str());
+
+    return access(dstFile.c_str(), 0) == 0;
+} /* end of RenameRnx */
+
+/**
+* @brief   : ObsFile - get the observation file written for the 'o' file
+* @param[I]: oFile ('o' file)
+* @param[O]: none
+* @return  : 'oFile', or '<oFile>.gz' if the observation files are compressed, or the 'd' file '*.yyd.gz'
+*            ('*.yyd.Z' if it has been kept so) if the compressed Compact RINEX files are kept, in the directory
+*            of the task
+* @note    :
+**/
+string FtpUtil::ObsFile(const string &oFile)
+{
+    if (_keepCrx)
+    {
+        string dFile = oFile.substr(0, oFile.size() - 1) + "d";
+
+        return access(LocalFile(dFile + ".Z").c_str(), 0) == 0 ? LocalFile(dFile + ".Z") : LocalFile(dFile + ".gz");
+    }
+
+    return LocalFile(_gzipObs ? oFile + ".gz" : oFile);
+} /* end of ObsFile */
+
+/**
+* @brief   : LocalFile - get the path of the local file in the directory of the task
+* @param[I]: file (local file)
+* @param[O]: none
+* @return  : '<_workDir>/<file>' if 'file' is a bare name, otherwise 'file'
+* @note    : the days downloaded in parallel have their own directories, so the working directory of the
+*            process is never changed
+**/
+string FtpUtil::LocalFile(const string &file)
+{
+    if (_workDir.empty() || file.empty() || file.find_first_of("/\\:") != string::npos) return file;
+
+    return _workDir + (char)FILEPATHSEP + file;
+} /* end of LocalFile */
+
+/**
+* @brief   : GetMaxConvert - get the number of threads unpacking and converting the files downloaded in 'all' mode
+* @param[I]: none
+* @param[O]: none
+* @return  : number of threads, which is the number of hardware threads of the machine
+* @note    :
+**/
+int FtpUtil::GetMaxConvert()
+{
+    int n = (int)std::thread::hardware_concurrency();
+
+    return n < 1 ? 1 : n;
+} /* end of GetMaxConvert */
+
+/**
+* @brief   : GroupBySite - group the local files by the site, i.e., the first four characters of the file name
+* @param[I]: files (local files)
+* @param[O]: sitFiles (files of each site, in the order of 'files')
+* @return  : none
+* @note    : the files of one site are converted to the same 'o' file, so they are handled one by one
+**/
+void FtpUtil::GroupBySite(const vector<string> &files, vector<vector<string>> &sitFiles)
+{
+    StringUtil str;
+    std::map<string, size_t> index;
+    sitFiles.clear();
+    for (size_t i = 0; i < files.size(); i++)
+    {
+        string site = files[i].substr(0, 4);
+        str.ToLower(site);
+        auto it = index.find(site);
+        if (it == index.end())
+        {
+            index[site] = sitFiles.size();
+            sitFiles.push_back(vector<string>());
+            sitFiles.back().push_back(files[i]);
+        }
+        else sitFiles[it->second].push_back(files[i]);
+    }
+} /* end of GroupBySite */
+
 /**
 * @brief   : GetDailyObsIgs - download IGS RINEX daily observation (30s) files (short name "d") according to 'site.list' file
 * @param[I]: ts (start time)
@@ -142,7 +495,7 @@ void FtpUtil::GetDailyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "daily");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
+    if (!_dryRun && access(subDir.c_str(), 0) == -1)
     {
         /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -153,12 +506,8 @@ void FtpUtil::GetDailyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         std::system(cmd.c_str());
     }
 
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(subDir.c_str());
-#else           /* for Linux or Mac */
-    chdir(subDir.c_str());
-#endif
+    /* the local files are in the directory */
+    _workDir = subDir;
 
     /* compute day of year */
     TimeUtil tu;
@@ -171,20 +520,15 @@ void FtpUtil::GetDailyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sDoy = str.doy2str(doy);
 
     /* FTP archive: CDDIS, IGN, or WHU */
-    string ftpName = fopt->ftpFrom;
+    string ftpName = SelectArchive(IDX_OBSD, ARC_ALL, fopt);
     str.ToUpper(ftpName);
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     if (strlen(fopt->obsOpt) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
         /* download all the IGS observation files */
-        string url, cutDirs = " --cut-dirs=7 ";
+        string url;
         if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBSD] + "/" +
             sYyyy + "/" + sDoy + "/" + sYy + "d";
-        else if (ftpName == "IGN")
-        {
-            url = _ftpArchive.IGN[IDX_OBSD] + "/" + sYyyy + "/" + sDoy;
-            cutDirs = " --cut-dirs=5 ";
-        }
+        else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_OBSD] + "/" + sYyyy + "/" + sDoy;
         else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBSD] + "/" +
             sYyyy + "/" + sDoy + "/" + sYy + "d";
         else url = _ftpArchive.CDDIS[IDX_OBSD] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d";
@@ -192,45 +536,44 @@ void FtpUtil::GetDailyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         /* it is OK for '*.Z' or '*.gz' format */
         string dFile = "*" + sDoy + "0." + sYy + "d";
         string dxFile = dFile + ".*";
-        string cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-        std::system(cmd.c_str());
+        _curl.GetFiles(url, dxFile, _workDir);
 
         /* get the file list */
         string suffix = "." + sYy + "d";
         vector<string> dFiles;
         str.GetFilesAll(subDir, suffix, dFiles);
-        char sitName[MAXCHARS];
-        for (int i = 0; i < dFiles.size(); i++)
+        /* the sites are unpacked and converted in parallel, and the files of one site one by one */
+        vector<vector<string>> sitFiles;
+        GroupBySite(dFiles, sitFiles);
+        ThreadUtil thr;
+        thr.RunOrdered((int)sitFiles.size(), GetMaxConvert(), [&](int k, ostringstream &log)
         {
-            if (access(dFiles[i].c_str(), 0) == 0)
+            const vector<string> &files = sitFiles[k];
+            char sitName[MAXCHARS];
+            for (int i = 0; i < files.size(); i++)
             {
-                /* extract it */
-                cmd = gzipFull + " -d -f " + dFiles[i];
-                std::system(cmd.c_str());
+                if (access(LocalFile(files[i]).c_str(), 0) == 0)
+                {
+                    /* the file is kept compressed as it is downloaded */
+                    if (_keepCrx) continue;
 
-                str.StrMid(sitName, dFiles[i].c_str(), 0, 4);
-                string site = sitName;
-                str.ToLower(site);
-                dFile = site + sDoy + "0." + sYy + "d";
-                if (access(dFile.c_str(), 0) == -1) continue;
-                string oFile = site + sDoy + "0." + sYy + "o";
-                /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
+                    /* extract it */
+                    _zip.Decompress(LocalFile(files[i]));
 
-                /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                cmd = "rm -rf " + dFile;
-#endif
-                std::system(cmd.c_str());
+                    str.StrMid(sitName, files[i].c_str(), 0, 4);
+                    string site = sitName;
+                    str.ToLower(site);
+                    string dFile = site + sDoy + "0." + sYy + "d";
+                    if (access(LocalFile(dFile).c_str(), 0) == -1) continue;
+                    string oFile = site + sDoy + "0." + sYy + "o";
+                    /* convert from 'd' file to 'o' file */
+                    _crx.Crx2Rnx(LocalFile(dFile), ObsFile(oFile));
+
+                    /* delete 'd' file */
+                    remove(LocalFile(dFile).c_str());
+                }
             }
-        }
+        });
     }
     else  /* the option of full path of site list file is selected */
     {
@@ -246,74 +589,69 @@ void FtpUtil::GetDailyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 return;
             }
 
+            /* the sites are processed in parallel, and the messages are printed in the order of 'site.list' */
+            vector<string> sitNames;
             string sitName;
-            while (getline(sitLst, sitName))
+            while (getline(sitLst, sitName)) sitNames.push_back(sitName);
+            ThreadUtil thr;
+            thr.RunOrdered((int)sitNames.size(), GetMaxParallel(ftpName, fopt), [&](int k, ostringstream &log)
             {
+                string sitName = sitNames[k];
                 str.ToLower(sitName);
                 string oFile = sitName + sDoy + "0." + sYy + "o";
                 string dFile = sitName + sDoy + "0." + sYy + "d";
-                if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                if (access(ObsFile(oFile).c_str(), 0) == -1 && access(LocalFile(dFile).c_str(), 0) == -1)
                 {
-                    string url, cutDirs = " --cut-dirs=7 ";
+                    string url;
                     if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBSD] + "/" +
                         sYyyy + "/" + sDoy + "/" + sYy + "d";
-                    else if (ftpName == "IGN")
-                    {
-                        url = _ftpArchive.IGN[IDX_OBSD] + "/" + sYyyy + "/" + sDoy;
-                        cutDirs = " --cut-dirs=5 ";
-                    }
+                    else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_OBSD] + "/" + sYyyy + "/" + sDoy;
                     else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBSD] + "/" +
                         sYyyy + "/" + sDoy + "/" + sYy + "d";
                     else url = _ftpArchive.CDDIS[IDX_OBSD] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d";
 
                     /* it is OK for '*.Z' or '*.gz' format */
                     string dxFile = dFile + ".*";
-                    string cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-                    std::system(cmd.c_str());
+                    _curl.GetFiles(url, dxFile, _workDir);
+                    string cmd;
 
                     string dgzFile = dFile + ".gz", dzFile = dFile + ".Z";
-                    if (access(dgzFile.c_str(), 0) == 0)
+                    if (!_keepCrx && access(LocalFile(dgzFile).c_str(), 0) == 0)
                     {
                         /* extract '*.gz' */
-                        cmd = gzipFull + " -d -f " + dgzFile;
-                        std::system(cmd.c_str());
+                        _zip.Decompress(LocalFile(dgzFile));
                     }
-                    if (access(dFile.c_str(), 0) == -1 && access(dzFile.c_str(), 0) == 0)
+                    if (!_keepCrx && access(LocalFile(dFile).c_str(), 0) == -1 && access(LocalFile(dzFile).c_str(), 0) == 0)
                     {
                         /* extract '*.Z' */
-                        cmd = gzipFull + " -d -f " + dzFile;
-                        std::system(cmd.c_str());
+                        _zip.Decompress(LocalFile(dzFile));
                     }
-                    if (access(dFile.c_str(), 0) == -1)
+                    if (access(LocalFile(dFile).c_str(), 0) == -1 && access(ObsFile(oFile).c_str(), 0) == -1)
                     {
-                        cout << "*** WARNING(FtpUtil::GetDailyObsIgs): failed to download IGS daily observation file " << oFile << endl;
+                        log << "*** WARNING(FtpUtil::GetDailyObsIgs): failed to download IGS daily observation file " << oFile << endl;
 
-                        continue;
+                        return;
                     }
 
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
+                    /* the 'd' file has been converted to the 'o' file while it was received */
+                    if (access(ObsFile(oFile).c_str(), 0) == -1) _crx.Crx2Rnx(LocalFile(dFile), ObsFile(oFile));
 
-                    if (access(oFile.c_str(), 0) == 0)
+                    if (access(ObsFile(oFile).c_str(), 0) == 0)
                     {
-                        cout << "*** INFO(FtpUtil::GetDailyObsIgs): successfully download IGS daily observation file " << oFile << endl;
+                        log << "*** INFO(FtpUtil::GetDailyObsIgs): successfully download IGS daily observation file " << oFile << endl;
 
                         /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
-                        cmd = "del " + dFile;
+                        cmd = "del " + LocalFile(dFile);
 #else           /* for Linux or Mac */
-                        cmd = "rm -rf " + dFile;
+                        cmd = "rm -rf " + LocalFile(dFile);
 #endif
                         std::system(cmd.c_str());
                     }
                 }
-                else cout << "*** INFO(FtpUtil::GetDailyObsIgs): IGS daily observation file " << oFile << 
+                else log << "*** INFO(FtpUtil::GetDailyObsIgs): IGS daily observation file " << oFile << 
                     " or " << dFile << " has existed!" << endl;
-            }
+            });
 
             /* close 'site.list' */
             sitLst.close();
@@ -337,7 +675,7 @@ void FtpUtil::GetHourlyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "hourly");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
+    if (!_dryRun && access(subDir.c_str(), 0) == -1)
     {
         /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -359,9 +697,8 @@ void FtpUtil::GetHourlyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt
     string sDoy = str.doy2str(doy);
 
     /* FTP archive: CDDIS, IGN, or WHU */
-    string ftpName = fopt->ftpFrom;
+    string ftpName = SelectArchive(IDX_OBSH, ARC_ALL, fopt);
     str.ToUpper(ftpName);
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     if (strlen(fopt->obsOpt) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
         /* download all the IGS observation files */
@@ -372,7 +709,7 @@ void FtpUtil::GetHourlyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt
             char sep = (char)FILEPATHSEP;
             sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
             string sHhDir = tmpDir;
-            if (access(sHhDir.c_str(), 0) == -1)
+            if (!_dryRun && access(sHhDir.c_str(), 0) == -1)
             {
                 /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -383,21 +720,13 @@ void FtpUtil::GetHourlyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt
                 std::system(cmd.c_str());
             }
 
-            /* change directory */
-#ifdef _WIN32   /* for Windows */
-            _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-            chdir(sHhDir.c_str());
-#endif
+            /* the local files are in the directory */
+            _workDir = sHhDir;
 
-            string url, cutDirs = " --cut-dirs=7 ";
+            string url;
             if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBSH] + "/" +
                 sYyyy + "/" + sDoy + "/" + sHh;
-            else if (ftpName == "IGN")
-            {
-                url = _ftpArchive.IGN[IDX_OBSH] + "/" + sYyyy + "/" + sDoy;
-                cutDirs = " --cut-dirs=6 ";
-            }
+            else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_OBSH] + "/" + sYyyy + "/" + sDoy;
             else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBSH] + "/" +
                 sYyyy + "/" + sDoy + "/" + sHh;
             else url = _ftpArchive.CDDIS[IDX_OBSH] + "/" + sYyyy + "/" + sDoy + "/" + sHh;
@@ -410,45 +739,44 @@ void FtpUtil::GetHourlyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt
             /* it is OK for '*.Z' or '*.gz' format */
             string dFile = "*" + sDoy + sch + "." + sYy + "d";
             string dxFile = dFile + ".*";
-            string cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-            std::system(cmd.c_str());
+            _curl.GetFiles(url, dxFile, _workDir);
 
             /* get the file list */
             string suffix = "." + sYy + "d";
             vector<string> dFiles;
             str.GetFilesAll(sHhDir, suffix, dFiles);
-            char sitName[MAXCHARS];
-            for (int i = 0; i < dFiles.size(); i++)
+            /* the sites are unpacked and converted in parallel, and the files of one site one by one */
+            vector<vector<string>> sitFiles;
+            GroupBySite(dFiles, sitFiles);
+            ThreadUtil thr;
+            thr.RunOrdered((int)sitFiles.size(), GetMaxConvert(), [&](int k, ostringstream &log)
             {
-                if (access(dFiles[i].c_str(), 0) == 0)
+                const vector<string> &files = sitFiles[k];
+                char sitName[MAXCHARS];
+                for (int i = 0; i < files.size(); i++)
                 {
-                    /* extract it */
-                    cmd = gzipFull + " -d -f " + dFiles[i];
-                    std::system(cmd.c_str());
+                    if (access(LocalFile(files[i]).c_str(), 0) == 0)
+                    {
+                        /* the file is kept compressed as it is downloaded */
+                        if (_keepCrx) continue;
 
-                    str.StrMid(sitName, dFiles[i].c_str(), 0, 4);
-                    string site = sitName;
-                    str.ToLower(site);
-                    dFile = site + sDoy + sch + "." + sYy + "d";
-                    if (access(dFile.c_str(), 0) == -1) continue;
-                    string oFile = site + sDoy + sch + "." + sYy + "o";
-                    /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
+                        /* extract it */
+                        _zip.Decompress(LocalFile(files[i]));
 
-                    /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                    cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                    cmd = "rm -rf " + dFile;
-#endif
-                    std::system(cmd.c_str());
+                        str.StrMid(sitName, files[i].c_str(), 0, 4);
+                        string site = sitName;
+                        str.ToLower(site);
+                        string dFile = site + sDoy + sch + "." + sYy + "d";
+                        if (access(LocalFile(dFile).c_str(), 0) == -1) continue;
+                        string oFile = site + sDoy + sch + "." + sYy + "o";
+                        /* convert from 'd' file to 'o' file */
+                        _crx.Crx2Rnx(LocalFile(dFile), ObsFile(oFile));
+
+                        /* delete 'd' file */
+                        remove(LocalFile(dFile).c_str());
+                    }
                 }
-            }
+            });
         }
     }
     else  /* the option of full path of site list file is selected */
@@ -475,7 +803,7 @@ void FtpUtil::GetHourlyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt
                     char sep = (char)FILEPATHSEP;
                     sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
                     string sHhDir = tmpDir;
-                    if (access(sHhDir.c_str(), 0) == -1)
+                    if (!_dryRun && access(sHhDir.c_str(), 0) == -1)
                     {
                         /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -486,12 +814,8 @@ void FtpUtil::GetHourlyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt
                         std::system(cmd.c_str());
                     }
 
-                    /* change directory */
-#ifdef _WIN32   /* for Windows */
-                    _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-                    chdir(sHhDir.c_str());
-#endif
+                    /* the local files are in the directory */
+                    _workDir = sHhDir;
 
                     /* 'a' = 97, 'b' = 98, ... */
                     int ii = fopt->hhObs[i] + 97;
@@ -501,61 +825,51 @@ void FtpUtil::GetHourlyObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt
                     str.ToLower(sitName);
                     string oFile = sitName + sDoy + sch + "." + sYy + "o";
                     string dFile = sitName + sDoy + sch + "." + sYy + "d";
-                    if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                    if (access(ObsFile(oFile).c_str(), 0) == -1 && access(LocalFile(dFile).c_str(), 0) == -1)
                     {
-                        string url, cutDirs = " --cut-dirs=7 ";
+                        string url;
                         if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBSH] + "/" +
                             sYyyy + "/" + sDoy + "/" + sHh;
-                        else if (ftpName == "IGN")
-                        {
-                            url = _ftpArchive.IGN[IDX_OBSH] + "/" + sYyyy + "/" + sDoy;
-                            cutDirs = " --cut-dirs=6 ";
-                        }
+                        else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_OBSH] + "/" + sYyyy + "/" + sDoy;
                         else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBSH] + "/" +
                             sYyyy + "/" + sDoy + "/" + sHh;
                         else url = _ftpArchive.CDDIS[IDX_OBSH] + "/" + sYyyy + "/" + sDoy + "/" + sHh;
 
                         /* it is OK for '*.Z' or '*.gz' format */
                         string dxFile = dFile + ".*";
-                        string cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-                        std::system(cmd.c_str());
+                        _curl.GetFiles(url, dxFile, _workDir);
+                        string cmd;
 
                         string dgzFile = dFile + ".gz", dzFile = dFile + ".Z";
-                        if (access(dgzFile.c_str(), 0) == 0)
+                        if (!_keepCrx && access(LocalFile(dgzFile).c_str(), 0) == 0)
                         {
                             /* extract '*.gz' */
-                            cmd = gzipFull + " -d -f " + dgzFile;
-                            std::system(cmd.c_str());
+                            _zip.Decompress(LocalFile(dgzFile));
                         }
-                        if (access(dFile.c_str(), 0) == -1 && access(dzFile.c_str(), 0) == 0)
+                        if (!_keepCrx && access(LocalFile(dFile).c_str(), 0) == -1 && access(LocalFile(dzFile).c_str(), 0) == 0)
                         {
                             /* extract '*.Z' */
-                            cmd = gzipFull + " -d -f " + dzFile;
-                            std::system(cmd.c_str());
+                            _zip.Decompress(LocalFile(dzFile));
                         }
-                        if (access(dFile.c_str(), 0) == -1)
+                        if (access(LocalFile(dFile).c_str(), 0) == -1 && access(ObsFile(oFile).c_str(), 0) == -1)
                         {
                             cout << "*** WARNING(FtpUtil::GetHourlyObsIgs): failed to download IGS Hourly observation file " << oFile << endl;
 
                             continue;
                         }
 
-#ifdef _WIN32  /* for Windows */
-                        cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                        cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                        std::system(cmd.c_str());
+                        /* the 'd' file has been converted to the 'o' file while it was received */
+                        if (access(ObsFile(oFile).c_str(), 0) == -1) _crx.Crx2Rnx(LocalFile(dFile), ObsFile(oFile));
 
-                        if (access(oFile.c_str(), 0) == 0)
+                        if (access(ObsFile(oFile).c_str(), 0) == 0)
                         {
                             cout << "*** INFO(FtpUtil::GetHourlyObsIgs): successfully download IGS hourly observation file " << oFile << endl;
 
                             /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
-                            cmd = "del " + dFile;
+                            cmd = "del " + LocalFile(dFile);
 #else           /* for Linux or Mac */
-                            cmd = "rm -rf " + dFile;
+                            cmd = "rm -rf " + LocalFile(dFile);
 #endif
                             std::system(cmd.c_str());
                         }
@@ -587,7 +901,7 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "highrate");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
+    if (!_dryRun && access(subDir.c_str(), 0) == -1)
     {
         /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -609,9 +923,8 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sDoy = str.doy2str(doy);
 
     /* FTP archive: CDDIS, IGN, or WHU */
-    string ftpName = fopt->ftpFrom;
+    string ftpName = SelectArchive(IDX_OBSHR, ARC_CDDIS | ARC_IGN, fopt);
     str.ToUpper(ftpName);
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     if (strlen(fopt->obsOpt) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
         /* download all the IGS observation files */
@@ -622,7 +935,7 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             char sep = (char)FILEPATHSEP;
             sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
             string sHhDir = tmpDir;
-            if (access(sHhDir.c_str(), 0) == -1)
+            if (!_dryRun && access(sHhDir.c_str(), 0) == -1)
             {
                 /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -633,21 +946,13 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 std::system(cmd.c_str());
             }
 
-            /* change directory */
-#ifdef _WIN32   /* for Windows */
-            _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-            chdir(sHhDir.c_str());
-#endif
+            /* the local files are in the directory */
+            _workDir = sHhDir;
 
-            string url, cutDirs = " --cut-dirs=8 ";
+            string url;
             if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBSHR] + "/" +
                 sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
-            else if (ftpName == "IGN")
-            {
-                url = _ftpArchive.IGN[IDX_OBSHR] + "/" + sYyyy + "/" + sDoy;
-                cutDirs = " --cut-dirs=6 ";
-            }
+            else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_OBSHR] + "/" + sYyyy + "/" + sDoy;
             else url = _ftpArchive.CDDIS[IDX_OBSHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
 
             /* 'a' = 97, 'b' = 98, ... */
@@ -658,8 +963,7 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             /* it is OK for '*.Z' or '*.gz' format */
             string dFile = "*" + sDoy + sch + "*." + sYy + "d";
             string dxFile = dFile + ".*";
-            string cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-            std::system(cmd.c_str());
+            _curl.GetFiles(url, dxFile, _workDir);
 
             std::vector<string> minuStr = { "00", "15", "30", "45" };
             for (int i = 0; i < minuStr.size(); i++)
@@ -668,38 +972,38 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 string suffix = minuStr[i] + "." + sYy + "d";
                 vector<string> dFiles;
                 str.GetFilesAll(sHhDir, suffix, dFiles);
-                char sitName[MAXCHARS];
-                for (int j = 0; j < dFiles.size(); j++)
+                /* the sites are unpacked and converted in parallel, and the files of one site one by one */
+                vector<vector<string>> sitFiles;
+                GroupBySite(dFiles, sitFiles);
+                ThreadUtil thr;
+                thr.RunOrdered((int)sitFiles.size(), GetMaxConvert(), [&](int k, ostringstream &log)
                 {
-                    if (access(dFiles[j].c_str(), 0) == 0)
+                    const vector<string> &files = sitFiles[k];
+                    char sitName[MAXCHARS];
+                    for (int j = 0; j < files.size(); j++)
                     {
-                        /* extract it */
-                        cmd = gzipFull + " -d -f " + dFiles[j];
-                        std::system(cmd.c_str());
+                        if (access(LocalFile(files[j]).c_str(), 0) == 0)
+                        {
+                            /* the file is kept compressed as it is downloaded */
+                            if (_keepCrx) continue;
 
-                        str.StrMid(sitName, dFiles[j].c_str(), 0, 4);
-                        string site = sitName;
-                        str.ToLower(site);
-                        dFile = site + sDoy + sch + minuStr[i] + "." + sYy + "d";
-                        if (access(dFile.c_str(), 0) == -1) continue;
-                        string oFile = site + sDoy + sch + minuStr[i] + "." + sYy + "o";
-                        /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                        cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                        cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                        std::system(cmd.c_str());
+                            /* extract it */
+                            _zip.Decompress(LocalFile(files[j]));
 
-                        /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                        cmd = "del " + dFile;
-#else           /* for Linux or Mac */
-                        cmd = "rm -rf " + dFile;
-#endif
-                        std::system(cmd.c_str());
+                            str.StrMid(sitName, files[j].c_str(), 0, 4);
+                            string site = sitName;
+                            str.ToLower(site);
+                            string dFile = site + sDoy + sch + minuStr[i] + "." + sYy + "d";
+                            if (access(LocalFile(dFile).c_str(), 0) == -1) continue;
+                            string oFile = site + sDoy + sch + minuStr[i] + "." + sYy + "o";
+                            /* convert from 'd' file to 'o' file */
+                            _crx.Crx2Rnx(LocalFile(dFile), ObsFile(oFile));
+
+                            /* delete 'd' file */
+                            remove(LocalFile(dFile).c_str());
+                        }
                     }
-                }
+                });
             }
         }
     }
@@ -727,7 +1031,7 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     char sep = (char)FILEPATHSEP;
                     sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
                     string sHhDir = tmpDir;
-                    if (access(sHhDir.c_str(), 0) == -1)
+                    if (!_dryRun && access(sHhDir.c_str(), 0) == -1)
                     {
                         /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -738,12 +1042,8 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                         std::system(cmd.c_str());
                     }
 
-                    /* change directory */
-#ifdef _WIN32   /* for Windows */
-                    _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-                    chdir(sHhDir.c_str());
-#endif
+                    /* the local files are in the directory */
+                    _workDir = sHhDir;
 
                     /* 'a' = 97, 'b' = 98, ... */
                     int ii = fopt->hhObs[i] + 97;
@@ -757,59 +1057,49 @@ void FtpUtil::GetHrObsIgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                         str.ToLower(sitName);
                         string oFile = sitName + sDoy + sch + minuStr[i] + "." + sYy + "o";
                         string dFile = sitName + sDoy + sch + minuStr[i] + "." + sYy + "d";
-                        if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                        if (access(ObsFile(oFile).c_str(), 0) == -1 && access(LocalFile(dFile).c_str(), 0) == -1)
                         {
-                            string url, cutDirs = " --cut-dirs=8 ";
+                            string url;
                             if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBSHR] + "/" +
                                 sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
-                            else if (ftpName == "IGN")
-                            {
-                                url = _ftpArchive.IGN[IDX_OBSHR] + "/" + sYyyy + "/" + sDoy;
-                                cutDirs = " --cut-dirs=6 ";
-                            }
+                            else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_OBSHR] + "/" + sYyyy + "/" + sDoy;
                             else url = _ftpArchive.CDDIS[IDX_OBSHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
 
                             /* it is OK for '*.Z' or '*.gz' format */
                             string dxFile = dFile + ".*";
-                            string cmd = wgetFull + " " + qr + " -nH -A " + dxFile + cutDirs + url;
-                            std::system(cmd.c_str());
+                            _curl.GetFiles(url, dxFile, _workDir);
+                            string cmd;
 
                             string dgzFile = dFile + ".gz", dzFile = dFile + ".Z";
-                            if (access(dgzFile.c_str(), 0) == 0)
+                            if (!_keepCrx && access(LocalFile(dgzFile).c_str(), 0) == 0)
                             {
                                 /* extract '*.gz' */
-                                cmd = gzipFull + " -d -f " + dgzFile;
-                                std::system(cmd.c_str());
+                                _zip.Decompress(LocalFile(dgzFile));
                             }
-                            if (access(dFile.c_str(), 0) == -1 && access(dzFile.c_str(), 0) == 0)
+                            if (!_keepCrx && access(LocalFile(dFile).c_str(), 0) == -1 && access(LocalFile(dzFile).c_str(), 0) == 0)
                             {
                                 /* extract '*.Z' */
-                                cmd = gzipFull + " -d -f " + dzFile;
-                                std::system(cmd.c_str());
+                                _zip.Decompress(LocalFile(dzFile));
                             }
-                            if (access(dFile.c_str(), 0) == -1)
+                            if (access(LocalFile(dFile).c_str(), 0) == -1 && access(ObsFile(oFile).c_str(), 0) == -1)
                             {
                                 cout << "*** WARNING(FtpUtil::GetHrObsIgs): failed to download IGS high-rate observation file " << oFile << endl;
 
                                 continue;
                             }
 
-#ifdef _WIN32  /* for Windows */
-                            cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                            cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                            std::system(cmd.c_str());
+                            /* the 'd' file has been converted to the 'o' file while it was received */
+                            if (access(ObsFile(oFile).c_str(), 0) == -1) _crx.Crx2Rnx(LocalFile(dFile), ObsFile(oFile));
 
-                            if (access(oFile.c_str(), 0) == 0)
+                            if (access(ObsFile(oFile).c_str(), 0) == 0)
                             {
                                 cout << "*** INFO(FtpUtil::GetHrObsIgs): successfully download IGS high-rate observation file " << oFile << endl;
 
                                 /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
-                                cmd = "del " + dFile;
+                                cmd = "del " + LocalFile(dFile);
 #else           /* for Linux or Mac */
-                                cmd = "rm -rf " + dFile;
+                                cmd = "rm -rf " + LocalFile(dFile);
 #endif
                                 std::system(cmd.c_str());
                             }
@@ -842,7 +1132,7 @@ void FtpUtil::GetDailyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "daily");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
+    if (!_dryRun && access(subDir.c_str(), 0) == -1)
     {
         /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -853,12 +1143,8 @@ void FtpUtil::GetDailyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt
         std::system(cmd.c_str());
     }
 
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(subDir.c_str());
-#else           /* for Linux or Mac */
-    chdir(subDir.c_str());
-#endif
+    /* the local files are in the directory */
+    _workDir = subDir;
 
     /* compute day of year */
     TimeUtil tu;
@@ -871,20 +1157,15 @@ void FtpUtil::GetDailyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt
     string sDoy = str.doy2str(doy);
 
     /* FTP archive: CDDIS, IGN, or WHU */
-    string ftpName = fopt->ftpFrom;
+    string ftpName = SelectArchive(IDX_OBMD, ARC_ALL, fopt);
     str.ToUpper(ftpName);
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     if (strlen(fopt->obmOpt) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
         /* download all the MGEX observation files */
-        string url, cutDirs = " --cut-dirs=7 ";
+        string url;
         if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMD] + "/" + 
             sYyyy + "/" + sDoy + "/" + sYy + "d";
-        else if (ftpName == "IGN")
-        {
-            url = _ftpArchive.IGN[IDX_OBMD] + "/" + sYyyy + "/" + sDoy;
-            cutDirs = " --cut-dirs=5 ";
-        }
+        else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_OBMD] + "/" + sYyyy + "/" + sDoy;
         else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBMD] + "/" + 
             sYyyy + "/" + sDoy + "/" + sYy + "d";
         else url = _ftpArchive.CDDIS[IDX_OBMD] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d";
@@ -892,46 +1173,45 @@ void FtpUtil::GetDailyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt
         /* it is OK for '*.Z' or '*.gz' format */
         string crxFile = "*" + sYyyy + sDoy + "0000_01D_30S_MO.crx";
         string crxxFile = crxFile + ".*";
-        string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-        std::system(cmd.c_str());
+        _curl.GetFiles(url, crxxFile, _workDir);
 
         /* get the file list */
         string suffix = ".crx";
         vector<string> crxFiles;
         str.GetFilesAll(subDir, suffix, crxFiles);
-        char sitName[MAXCHARS];
-        for (int i = 0; i < crxFiles.size(); i++)
+        /* the 'crx' files converted to RINEX while they were received are listed as well */
+        str.GetFilesAll(subDir, ".rnx", crxFiles);
+        /* the sites are unpacked and converted in parallel, and the files of one site one by one */
+        vector<vector<string>> sitFiles;
+        GroupBySite(crxFiles, sitFiles);
+        ThreadUtil thr;
+        thr.RunOrdered((int)sitFiles.size(), GetMaxConvert(), [&](int k, ostringstream &log)
         {
-            if (access(crxFiles[i].c_str(), 0) == 0)
+            const vector<string> &files = sitFiles[k];
+            char sitName[MAXCHARS];
+            for (int i = 0; i < files.size(); i++)
             {
-                /* extract it */
-                cmd = gzipFull + " -d -f " + crxFiles[i];
-                std::system(cmd.c_str());
+                if (access(LocalFile(files[i]).c_str(), 0) == 0)
+                {
+                    str.StrMid(sitName, files[i].c_str(), 0, 4);
+                    string site = sitName;
+                    str.ToLower(site);
+                    string oFile = site + sDoy + "0." + sYy + "o";
+                    /* the 'crx' file has been converted to RINEX while it was received */
+                    if (RenameRnx(files[i], oFile)) continue;
 
-                str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
-                string site = sitName;
-                str.ToLower(site);
-                str.StrMid(sitName, crxFiles[i].c_str(), 0, (int)crxFiles[i].find_last_of('.'));
-                crxFile = sitName;
-                if (access(crxFile.c_str(), 0) == -1) continue;
-                string oFile = site + sDoy + "0." + sYy + "o";
-                /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
+                    /* extract it */
+                    _zip.Decompress(LocalFile(files[i]));
+                    string crxFile = files[i].substr(0, files[i].rfind(".crx") + 4);
+                    if (access(LocalFile(crxFile).c_str(), 0) == -1) continue;
+                    /* convert from 'd' file to 'o' file */
+                    _crx.Crx2Rnx(LocalFile(crxFile), ObsFile(oFile));
 
-                /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                cmd = "rm -rf " + crxFile;
-#endif
-                std::system(cmd.c_str());
+                    /* delete 'd' file */
+                    remove(LocalFile(crxFile).c_str());
+                }
             }
-        }
+        });
     }
     else  /* the option of full path of site list file is selected */
     {
@@ -946,22 +1226,23 @@ void FtpUtil::GetDailyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt
                 return;
             }
 
+            /* the sites are processed in parallel, and the messages are printed in the order of 'site.list' */
+            vector<string> sitNames;
             string sitName;
-            while (getline(sitLst, sitName))
+            while (getline(sitLst, sitName)) sitNames.push_back(sitName);
+            ThreadUtil thr;
+            thr.RunOrdered((int)sitNames.size(), GetMaxParallel(ftpName, fopt), [&](int k, ostringstream &log)
             {
+                string sitName = sitNames[k];
                 str.ToLower(sitName);
                 string oFile = sitName + sDoy + "0." + sYy + "o";
                 string dFile = sitName + sDoy + "0." + sYy + "d";
-                if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                if (access(ObsFile(oFile).c_str(), 0) == -1 && access(LocalFile(dFile).c_str(), 0) == -1)
                 {
-                    string url, cutDirs = " --cut-dirs=7 ";
+                    string url;
                     if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMD] + "/" + 
                         sYyyy + "/" + sDoy + "/" + sYy + "d";
-                    else if (ftpName == "IGN")
-                    {
-                        url = _ftpArchive.IGN[IDX_OBMD] + "/" + sYyyy + "/" + sDoy;
-                        cutDirs = " --cut-dirs=5 ";
-                    }
+                    else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_OBMD] + "/" + sYyyy + "/" + sDoy;
                     else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBMD] + "/" + 
                         sYyyy + "/" + sDoy + "/" + sYy + "d";
                     else url = _ftpArchive.CDDIS[IDX_OBMD] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d";
@@ -970,61 +1251,59 @@ void FtpUtil::GetDailyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt
                     str.ToUpper(sitName);
                     string crxFile = sitName + "*" + sYyyy + sDoy + "0000_01D_30S_MO.crx";
                     string crxxFile = crxFile + ".*";
-                    string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-                    std::system(cmd.c_str());
+                    vector<string> localFiles;
+                    _curl.GetFiles(url, crxxFile, _workDir, &localFiles);
+                    string cmd;
 
-                    /* extract '*.gz' */
-                    string crxgzFile = crxFile + ".gz";
-                    cmd = gzipFull + " -d -f " + crxgzFile;
-                    std::system(cmd.c_str());
-                    string changeFileName;
+                    /* the 'crx' file has been converted to the 'o' file while it was received */
+                    if (localFiles.empty() || !RenameRnx(localFiles[0], oFile))
+                    {
+                        /* extract '*.gz' */
+                        string crxgzFile = crxFile + ".gz";
+                        _zip.Decompress(LocalFile(crxgzFile));
+                        string changeFileName;
 #ifdef _WIN32  /* for Windows */
-                    changeFileName = "rename";
+                        changeFileName = "move /y";
 #else          /* for Linux or Mac */
-                    changeFileName = "mv";
+                        changeFileName = "mv";
 #endif
-                    cmd = changeFileName + " " + crxFile + " " + dFile;
-                    std::system(cmd.c_str());
-                    if (access(dFile.c_str(), 0) == -1)
-                    {
-                        /* extract '*.Z' */
-                        string crxzFile = crxFile + ".Z";
-                        cmd = gzipFull + " -d -f " + crxzFile;
-                        std::system(cmd.c_str());
-
-                        cmd = changeFileName + " " + crxFile + " " + dFile;
+                        cmd = changeFileName + " " + LocalFile(crxFile) + " " + LocalFile(dFile);
                         std::system(cmd.c_str());
-                        if (access(dFile.c_str(), 0) == -1)
+                        if (access(LocalFile(dFile).c_str(), 0) == -1)
                         {
-                            cout << "*** WARNING(FtpUtil::GetDailyObsMgex): failed to download MGEX daily observation file " << oFile << endl;
+                            /* extract '*.Z' */
+                            string crxzFile = crxFile + ".Z";
+                            _zip.Decompress(LocalFile(crxzFile));
 
-                            continue;
+                            cmd = changeFileName + " " + LocalFile(crxFile) + " " + LocalFile(dFile);
+                            std::system(cmd.c_str());
+                            if (access(LocalFile(dFile).c_str(), 0) == -1)
+                            {
+                                log << "*** WARNING(FtpUtil::GetDailyObsMgex): failed to download MGEX daily observation file " << oFile << endl;
+
+                                return;
+                            }
                         }
-                    }
 
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
+                        _crx.Crx2Rnx(LocalFile(dFile), ObsFile(oFile));
+                    }
 
-                    if (access(oFile.c_str(), 0) == 0)
+                    if (access(ObsFile(oFile).c_str(), 0) == 0)
                     {
-                        cout << "*** INFO(FtpUtil::GetDailyObsMgex): successfully download MGEX daily observation file " << oFile << endl;
+                        log << "*** INFO(FtpUtil::GetDailyObsMgex): successfully download MGEX daily observation file " << oFile << endl;
 
                         /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
-                        cmd = "del " + dFile;
+                        cmd = "del " + LocalFile(dFile);
 #else           /* for Linux or Mac */
-                        cmd = "rm -rf " + dFile;
+                        cmd = "rm -rf " + LocalFile(dFile);
 #endif
                         std::system(cmd.c_str());
                     }
                 }
-                else cout << "*** INFO(FtpUtil::GetDailyObsMgex): MGEX daily observation file " << oFile << 
+                else log << "*** INFO(FtpUtil::GetDailyObsMgex): MGEX daily observation file " << oFile << 
                     " or " << dFile << " has existed!" << endl;
-            }
+            });
 
             /* close 'site.list' */
             sitLst.close();
@@ -1048,7 +1327,7 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fop
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "hourly");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
+    if (!_dryRun && access(subDir.c_str(), 0) == -1)
     {
         /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -1070,9 +1349,8 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fop
     string sDoy = str.doy2str(doy);
 
     /* FTP archive: CDDIS, IGN, or WHU */
-    string ftpName = fopt->ftpFrom;
+    string ftpName = SelectArchive(IDX_OBMH, ARC_ALL, fopt);
     str.ToUpper(ftpName);
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     if (strlen(fopt->obmOpt) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
         /* download all the MGEX observation files */
@@ -1083,7 +1361,7 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fop
             char sep = (char)FILEPATHSEP;
             sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
             string sHhDir = tmpDir;
-            if (access(sHhDir.c_str(), 0) == -1)
+            if (!_dryRun && access(sHhDir.c_str(), 0) == -1)
             {
                 /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -1094,21 +1372,13 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fop
                 std::system(cmd.c_str());
             }
 
-            /* change directory */
-#ifdef _WIN32   /* for Windows */
-            _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-            chdir(sHhDir.c_str());
-#endif
+            /* the local files are in the directory */
+            _workDir = sHhDir;
 
-            string url, cutDirs = " --cut-dirs=7 ";
+            string url;
             if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMH] + "/" +
                 sYyyy + "/" + sDoy + "/" + sHh;
-            else if (ftpName == "IGN")
-            {
-                url = _ftpArchive.IGN[IDX_OBMH] + "/" + sYyyy + "/" + sDoy;
-                cutDirs = " --cut-dirs=6 ";
-            }
+            else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_OBMH] + "/" + sYyyy + "/" + sDoy;
             else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBMH] + "/" +
                 sYyyy + "/" + sDoy + "/" + sHh;
             else url = _ftpArchive.CDDIS[IDX_OBMH] + "/" + sYyyy + "/" + sDoy + "/" + sHh;
@@ -1116,8 +1386,8 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fop
             /* it is OK for '*.Z' or '*.gz' format */
             string crxFile = "*" + sYyyy + sDoy + sHh + "00_01H_30S_MO.crx";
             string crxxFile = crxFile + ".*";
-            string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-            std::system(cmd.c_str());
+            _curl.GetFiles(url, crxxFile, _workDir);
+            string cmd;
 
             /* 'a' = 97, 'b' = 98, ... */
             int ii = fopt->hhObm[i] + 97;
@@ -1129,39 +1399,39 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fop
             string suffix = ".crx";
             vector<string> crxFiles;
             str.GetFilesAll(sHhDir, suffix, crxFiles);
-            char sitName[MAXCHARS];
-            for (int i = 0; i < crxFiles.size(); i++)
+            /* the 'crx' files converted to RINEX while they were received are listed as well */
+            str.GetFilesAll(sHhDir, ".rnx", crxFiles);
+            /* the sites are unpacked and converted in parallel, and the files of one site one by one */
+            vector<vector<string>> sitFiles;
+            GroupBySite(crxFiles, sitFiles);
+            ThreadUtil thr;
+            thr.RunOrdered((int)sitFiles.size(), GetMaxConvert(), [&](int k, ostringstream &log)
             {
-                if (access(crxFiles[i].c_str(), 0) == 0)
+                const vector<string> &files = sitFiles[k];
+                char sitName[MAXCHARS];
+                for (int i = 0; i < files.size(); i++)
                 {
-                    /* extract it */
-                    cmd = gzipFull + " -d -f " + crxFiles[i];
-                    std::system(cmd.c_str());
+                    if (access(LocalFile(files[i]).c_str(), 0) == 0)
+                    {
+                        str.StrMid(sitName, files[i].c_str(), 0, 4);
+                        string site = sitName;
+                        str.ToLower(site);
+                        string oFile = site + sDoy + sch + "." + sYy + "o";
+                        /* the 'crx' file has been converted to RINEX while it was received */
+                        if (RenameRnx(files[i], oFile)) continue;
 
-                    str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
-                    string site = sitName;
-                    str.ToLower(site);
-                    str.StrMid(sitName, crxFiles[i].c_str(), 0, (int)crxFiles[i].find_last_of('.'));
-                    crxFile = sitName;
-                    if (access(crxFile.c_str(), 0) == -1) continue;
-                    string oFile = site + sDoy + sch + "." + sYy + "o";
-                    /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
+                        /* extract it */
+                        _zip.Decompress(LocalFile(files[i]));
+                        string crxFile = files[i].substr(0, files[i].rfind(".crx") + 4);
+                        if (access(LocalFile(crxFile).c_str(), 0) == -1) continue;
+                        /* convert from 'd' file to 'o' file */
+                        _crx.Crx2Rnx(LocalFile(crxFile), ObsFile(oFile));
 
-                    /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                    cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                    cmd = "rm -rf " + crxFile;
-#endif
-                    std::system(cmd.c_str());
+                        /* delete 'd' file */
+                        remove(LocalFile(crxFile).c_str());
+                    }
                 }
-            }
+            });
         }
     }
     else  /* the option of full path of site list file is selected */
@@ -1187,7 +1457,7 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fop
                     char sep = (char)FILEPATHSEP;
                     sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
                     string sHhDir = tmpDir;
-                    if (access(sHhDir.c_str(), 0) == -1)
+                    if (!_dryRun && access(sHhDir.c_str(), 0) == -1)
                     {
                         /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -1198,12 +1468,8 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fop
                         std::system(cmd.c_str());
                     }
 
-                    /* change directory */
-#ifdef _WIN32   /* for Windows */
-                    _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-                    chdir(sHhDir.c_str());
-#endif
+                    /* the local files are in the directory */
+                    _workDir = sHhDir;
 
                     /* 'a' = 97, 'b' = 98, ... */
                     int ii = fopt->hhObm[i] + 97;
@@ -1213,16 +1479,12 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fop
                     str.ToLower(sitName);
                     string oFile = sitName + sDoy + sch + "." + sYy + "o";
                     string dFile = sitName + sDoy + sch + "." + sYy + "d";
-                    if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                    if (access(ObsFile(oFile).c_str(), 0) == -1 && access(LocalFile(dFile).c_str(), 0) == -1)
                     {
-                        string url, cutDirs = " --cut-dirs=7 ";
+                        string url;
                         if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMH] + "/" +
                             sYyyy + "/" + sDoy + "/" + sHh;
-                        else if (ftpName == "IGN")
-                        {
-                            url = _ftpArchive.IGN[IDX_OBMH] + "/" + sYyyy + "/" + sDoy;
-                            cutDirs = " --cut-dirs=6 ";
-                        }
+                        else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_OBMH] + "/" + sYyyy + "/" + sDoy;
                         else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_OBMH] + "/" +
                             sYyyy + "/" + sDoy + "/" + sHh;
                         else url = _ftpArchive.CDDIS[IDX_OBMH] + "/" + sYyyy + "/" + sDoy + "/" + sHh;
@@ -1231,54 +1493,52 @@ void FtpUtil::GetHourlyObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fop
                         str.ToUpper(sitName);
                         string crxFile = sitName + "*" + sYyyy + sDoy + sHh + "00_01H_30S_MO.crx";
                         string crxxFile = crxFile + ".*";
-                        string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-                        std::system(cmd.c_str());
+                        vector<string> localFiles;
+                        _curl.GetFiles(url, crxxFile, _workDir, &localFiles);
+                        string cmd;
 
-                        /* extract '*.gz' */
-                        string crxgzFile = crxFile + ".gz";
-                        cmd = gzipFull + " -d -f " + crxgzFile;
-                        std::system(cmd.c_str());
-                        string changeFileName;
+                        /* the 'crx' file has been converted to the 'o' file while it was received */
+                        if (localFiles.empty() || !RenameRnx(localFiles[0], oFile))
+                        {
+                            /* extract '*.gz' */
+                            string crxgzFile = crxFile + ".gz";
+                            _zip.Decompress(LocalFile(crxgzFile));
+                            string changeFileName;
 #ifdef _WIN32  /* for Windows */
-                        changeFileName = "rename";
+                            changeFileName = "move /y";
 #else          /* for Linux or Mac */
-                        changeFileName = "mv";
+                            changeFileName = "mv";
 #endif
-                        cmd = changeFileName + " " + crxFile + " " + dFile;
-                        std::system(cmd.c_str());
-                        if (access(dFile.c_str(), 0) == -1)
-                        {
-                            /* extract '*.Z' */
-                            string crxzFile = crxFile + ".Z";
-                            cmd = gzipFull + " -d -f " + crxzFile;
+                            cmd = changeFileName + " " + LocalFile(crxFile) + " " + LocalFile(dFile);
                             std::system(cmd.c_str());
-
-                            cmd = changeFileName + " " + crxFile + " " + dFile;
-                            std::system(cmd.c_str());
-                            if (access(dFile.c_str(), 0) == -1)
+                            if (access(LocalFile(dFile).c_str(), 0) == -1)
                             {
-                                cout << "*** WARNING(FtpUtil::GetDailyObsMgex): failed to download MGEX daily observation file " << oFile << endl;
+                                /* extract '*.Z' */
+                                string crxzFile = crxFile + ".Z";
+                                _zip.Decompress(LocalFile(crxzFile));
 
-                                continue;
+                                cmd = changeFileName + " " + LocalFile(crxFile) + " " + LocalFile(dFile);
+                                std::system(cmd.c_str());
+                                if (access(LocalFile(dFile).c_str(), 0) == -1)
+                                {
+                                    cout << "*** WARNING(FtpUtil::GetDailyObsMgex): failed to download MGEX daily observation file " << oFile << endl;
+
+                                    continue;
+                                }
                             }
-                        }
 
-#ifdef _WIN32  /* for Windows */
-                        cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                        cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                        std::system(cmd.c_str());
+                            _crx.Crx2Rnx(LocalFile(dFile), ObsFile(oFile));
+                        }
 
-                        if (access(oFile.c_str(), 0) == 0)
+                        if (access(ObsFile(oFile).c_str(), 0) == 0)
                         {
                             cout << "*** INFO(FtpUtil::GetHourlyObsMgex): successfully download MGEX hourly observation file " << oFile << endl;
 
                             /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
-                            cmd = "del " + dFile;
+                            cmd = "del " + LocalFile(dFile);
 #else           /* for Linux or Mac */
-                            cmd = "rm -rf " + dFile;
+                            cmd = "rm -rf " + LocalFile(dFile);
 #endif
                             std::system(cmd.c_str());
                         }
@@ -1310,7 +1570,7 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "highrate");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
+    if (!_dryRun && access(subDir.c_str(), 0) == -1)
     {
         /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -1332,9 +1592,8 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sDoy = str.doy2str(doy);
 
     /* FTP archive: CDDIS, IGN, or WHU */
-    string ftpName = fopt->ftpFrom;
+    string ftpName = SelectArchive(IDX_OBMHR, ARC_CDDIS | ARC_IGN, fopt);
     str.ToUpper(ftpName);
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     if (strlen(fopt->obmOpt) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
         /* download all the MGEX observation files */
@@ -1345,7 +1604,7 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             char sep = (char)FILEPATHSEP;
             sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
             string sHhDir = tmpDir;
-            if (access(sHhDir.c_str(), 0) == -1)
+            if (!_dryRun && access(sHhDir.c_str(), 0) == -1)
             {
                 /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -1356,28 +1615,20 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 std::system(cmd.c_str());
             }
 
-            /* change directory */
-#ifdef _WIN32   /* for Windows */
-            _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-            chdir(sHhDir.c_str());
-#endif
+            /* the local files are in the directory */
+            _workDir = sHhDir;
 
-            string url, cutDirs = " --cut-dirs=8 ";
+            string url;
             if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMHR] + "/" +
                 sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
-            else if (ftpName == "IGN")
-            {
-                url = _ftpArchive.IGN[IDX_OBMHR] + "/" + sYyyy + "/" + sDoy;
-                cutDirs = " --cut-dirs=6 ";
-            }
+            else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_OBMHR] + "/" + sYyyy + "/" + sDoy;
             else url = _ftpArchive.CDDIS[IDX_OBMHR] + "/" + sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
 
             /* it is OK for '*.Z' or '*.gz' format */
             string crxFile = "*_15M_01S_MO.crx";
             string crxxFile = crxFile + ".*";
-            string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-            std::system(cmd.c_str());
+            _curl.GetFiles(url, crxxFile, _workDir);
+            string cmd;
 
             /* 'a' = 97, 'b' = 98, ... */
             int ii = fopt->hhObm[i] + 97;
@@ -1392,39 +1643,39 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 string suffix = minuStr[i] + "_15M_01S_MO.crx";
                 vector<string> crxFiles;
                 str.GetFilesAll(sHhDir, suffix, crxFiles);
-                char sitName[MAXCHARS];
-                for (int j = 0; j < crxFiles.size(); j++)
+                /* the 'crx' files converted to RINEX while they were received are listed as well */
+                str.GetFilesAll(sHhDir, minuStr[i] + "_15M_01S_MO.rnx", crxFiles);
+                /* the sites are unpacked and converted in parallel, and the files of one site one by one */
+                vector<vector<string>> sitFiles;
+                GroupBySite(crxFiles, sitFiles);
+                ThreadUtil thr;
+                thr.RunOrdered((int)sitFiles.size(), GetMaxConvert(), [&](int k, ostringstream &log)
                 {
-                    if (access(crxFiles[j].c_str(), 0) == 0)
+                    const vector<string> &files = sitFiles[k];
+                    char sitName[MAXCHARS];
+                    for (int j = 0; j < files.size(); j++)
                     {
-                        /* extract it */
-                        cmd = gzipFull + " -d -f " + crxFiles[j];
-                        std::system(cmd.c_str());
-
-                        str.StrMid(sitName, crxFiles[j].c_str(), 0, 4);
-                        string site = sitName;
-                        str.ToLower(site);
-                        str.StrMid(sitName, crxFiles[j].c_str(), 0, (int)crxFiles[j].find_last_of('.'));
-                        crxFile = sitName;
-                        if (access(crxFile.c_str(), 0) == -1) continue;
-                        string oFile = site + sDoy + sch + minuStr[i] +  "." + sYy + "o";
-                        /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                        cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                        cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                        std::system(cmd.c_str());
+                        if (access(LocalFile(files[j]).c_str(), 0) == 0)
+                        {
+                            str.StrMid(sitName, files[j].c_str(), 0, 4);
+                            string site = sitName;
+                            str.ToLower(site);
+                            string oFile = site + sDoy + sch + minuStr[i] +  "." + sYy + "o";
+                            /* the 'crx' file has been converted to RINEX while it was received */
+                            if (RenameRnx(files[j], oFile)) continue;
+
+                            /* extract it */
+                            _zip.Decompress(LocalFile(files[j]));
+                            string crxFile = files[j].substr(0, files[j].rfind(".crx") + 4);
+                            if (access(LocalFile(crxFile).c_str(), 0) == -1) continue;
+                            /* convert from 'd' file to 'o' file */
+                            _crx.Crx2Rnx(LocalFile(crxFile), ObsFile(oFile));
 
-                        /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                        cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                        cmd = "rm -rf " + crxFile;
-#endif
-                        std::system(cmd.c_str());
+                            /* delete 'd' file */
+                            remove(LocalFile(crxFile).c_str());
+                        }
                     }
-                }
+                });
             }
         }
     }
@@ -1451,7 +1702,7 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     char sep = (char)FILEPATHSEP;
                     sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
                     string sHhDir = tmpDir;
-                    if (access(sHhDir.c_str(), 0) == -1)
+                    if (!_dryRun && access(sHhDir.c_str(), 0) == -1)
                     {
                         /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -1462,12 +1713,8 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                         std::system(cmd.c_str());
                     }
 
-                    /* change directory */
-#ifdef _WIN32   /* for Windows */
-                    _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-                    chdir(sHhDir.c_str());
-#endif
+                    /* the local files are in the directory */
+                    _workDir = sHhDir;
 
                     /* 'a' = 97, 'b' = 98, ... */
                     int ii = fopt->hhObm[i] + 97;
@@ -1481,16 +1728,12 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                         str.ToLower(sitName);
                         string oFile = sitName + sDoy + sch + minuStr[i] + "." + sYy + "o";
                         string dFile = sitName + sDoy + sch + minuStr[i] + "." + sYy + "d";
-                        if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                        if (access(ObsFile(oFile).c_str(), 0) == -1 && access(LocalFile(dFile).c_str(), 0) == -1)
                         {
-                            string url, cutDirs = " --cut-dirs=8 ";
+                            string url;
                             if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMHR] + "/" +
                                 sYyyy + "/" + sDoy + "/" + sYy + "d" + "/" + sHh;
-                            else if (ftpName == "IGN")
-                            {
-                                url = _ftpArchive.IGN[IDX_OBMHR] + "/" + sYyyy + "/" + sDoy;
-                                cutDirs = " --cut-dirs=6 ";
-                            }
+                            else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_OBMHR] + "/" + sYyyy + "/" + sDoy;
                             else url = _ftpArchive.CDDIS[IDX_OBMHR] + "/" + sYyyy + "/" + sDoy + "/" + 
                                 sYy + "d" + "/" + sHh;
 
@@ -1498,54 +1741,52 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                             str.ToUpper(sitName);
                             string crxFile = sitName + "*" + sYyyy + sDoy + sHh + minuStr[i] + "_15M_01S_MO.crx";
                             string crxxFile = crxFile + ".*";
-                            string cmd = wgetFull + " " + qr + " -nH -A " + crxxFile + cutDirs + url;
-                            std::system(cmd.c_str());
+                            vector<string> localFiles;
+                            _curl.GetFiles(url, crxxFile, _workDir, &localFiles);
+                            string cmd;
 
-                            /* extract '*.gz' */
-                            string crxgzFile = crxFile + ".gz";
-                            cmd = gzipFull + " -d -f " + crxgzFile;
-                            std::system(cmd.c_str());
-                            string changeFileName;
+                            /* the 'crx' file has been converted to the 'o' file while it was received */
+                            if (localFiles.empty() || !RenameRnx(localFiles[0], oFile))
+                            {
+                                /* extract '*.gz' */
+                                string crxgzFile = crxFile + ".gz";
+                                _zip.Decompress(LocalFile(crxgzFile));
+                                string changeFileName;
 #ifdef _WIN32  /* for Windows */
-                            changeFileName = "rename";
+                                changeFileName = "move /y";
 #else          /* for Linux or Mac */
-                            changeFileName = "mv";
+                                changeFileName = "mv";
 #endif
-                            cmd = changeFileName + " " + crxFile + " " + dFile;
-                            std::system(cmd.c_str());
-                            if (access(dFile.c_str(), 0) == -1)
-                            {
-                                /* extract '*.Z' */
-                                string crxzFile = crxFile + ".Z";
-                                cmd = gzipFull + " -d -f " + crxzFile;
-                                std::system(cmd.c_str());
-
-                                cmd = changeFileName + " " + crxFile + " " + dFile;
+                                cmd = changeFileName + " " + LocalFile(crxFile) + " " + LocalFile(dFile);
                                 std::system(cmd.c_str());
-                                if (access(dFile.c_str(), 0) == -1)
+                                if (access(LocalFile(dFile).c_str(), 0) == -1)
                                 {
-                                    cout << "*** WARNING(FtpUtil::GetDailyObsMgex): failed to download MGEX daily observation file " << oFile << endl;
-
-                                    continue;
+                                    /* extract '*.Z' */
+                                    string crxzFile = crxFile + ".Z";
+                                    _zip.Decompress(LocalFile(crxzFile));
+
+                                    cmd = changeFileName + " " + LocalFile(crxFile) + " " + LocalFile(dFile);
+                                    std::system(cmd.c_str());
+                                    if (access(LocalFile(dFile).c_str(), 0) == -1)
+                                    {
+                                        cout << "*** WARNING(FtpUtil::GetDailyObsMgex): failed to download MGEX daily observation file " << oFile << endl;
+
+                                        continue;
+                                    }
                                 }
-                            }
 
-#ifdef _WIN32  /* for Windows */
-                            cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                            cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                            std::system(cmd.c_str());
+                                _crx.Crx2Rnx(LocalFile(dFile), ObsFile(oFile));
+                            }
 
-                            if (access(oFile.c_str(), 0) == 0)
+                            if (access(ObsFile(oFile).c_str(), 0) == 0)
                             {
                                 cout << "*** INFO(FtpUtil::GetHrObsMgex): successfully download MGEX high-rate observation file " << oFile << endl;
 
                                 /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
-                                cmd = "del " + dFile;
+                                cmd = "del " + LocalFile(dFile);
 #else           /* for Linux or Mac */
-                                cmd = "rm -rf " + dFile;
+                                cmd = "rm -rf " + LocalFile(dFile);
 #endif
                                 std::system(cmd.c_str());
                             }
@@ -1573,12 +1814,15 @@ void FtpUtil::GetHrObsMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 **/
 void FtpUtil::GetDailyObsCut(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
+    /* product class of the transfers for the health history */
+    _curl.SetClass(IDX_NAMES[IDX_OBSD]);
+
     /* creation of sub-directory ('daily') */
     char tmpDir[MAXSTRPATH] = { '\0' };
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "daily");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
+    if (!_dryRun && access(subDir.c_str(), 0) == -1)
     {
         /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -1589,12 +1833,8 @@ void FtpUtil::GetDailyObsCut(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         std::system(cmd.c_str());
     }
 
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(subDir.c_str());
-#else           /* for Linux or Mac */
-    chdir(subDir.c_str());
-#endif
+    /* the local files are in the directory */
+    _workDir = subDir;
 
     /* compute day of year */
     TimeUtil tu;
@@ -1606,9 +1846,7 @@ void FtpUtil::GetDailyObsCut(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
 
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     string url = "http://saegnss2.curtin.edu/ldc/rinex3/daily/" + sYyyy + "/" + sDoy;
-    string cutDirs = " --cut-dirs=5 ";
     /* download the Curtin University of Technology (CUT) observation file site-by-site */
     if (access(fopt->obcOpt, 0) == 0)
     {
@@ -1620,53 +1858,53 @@ void FtpUtil::GetDailyObsCut(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             return;
         }
 
+        /* the sites are processed in parallel, and the messages are printed in the order of 'site.list' */
+        vector<string> sitNames;
         string sitName;
-        while (getline(sitLst, sitName))
+        while (getline(sitLst, sitName)) sitNames.push_back(sitName);
+        ThreadUtil thr;
+        thr.RunOrdered((int)sitNames.size(), GetMaxParallel("CUT", fopt), [&](int k, ostringstream &log)
         {
+            string sitName = sitNames[k];
             str.ToLower(sitName);
             string oFile = sitName + sDoy + "0." + sYy + "o";
-            if (access(oFile.c_str(), 0) == -1)
+            if (access(ObsFile(oFile).c_str(), 0) == -1)
             {
                 /* it is OK for '*.gz' format */
                 str.ToUpper(sitName);
                 string crxFile = sitName + "00AUS_R_" + sYyyy + sDoy + "0000_01D_30S_MO.crx";
                 string crxgzFile = crxFile + ".gz";
-                string cmd = wgetFull + " " + qr + " -nH " + cutDirs + url + "/" + crxgzFile;
-                std::system(cmd.c_str());
+                _curl.GetFile(url + "/" + crxgzFile, LocalFile(crxgzFile));
 
-                /* extract '*.gz' */
-                cmd = gzipFull + " -d -f " + crxgzFile;
-                std::system(cmd.c_str());
-                if (access(crxFile.c_str(), 0) == -1)
+                /* extract '*.gz' unless it is kept compressed */
+                if (!RenameRnx(crxgzFile, oFile)) _zip.Decompress(LocalFile(crxgzFile));
+                string cmd;
+                if (access(LocalFile(crxFile).c_str(), 0) == -1 && !RenameRnx(crxFile.substr(0, crxFile.size() - 3) + "rnx", oFile))
                 {
-                    cout << "*** WARNING(FtpUtil::GetDailyObsCut): failed to download CUT daily observation file " << oFile << endl;
+                    log << "*** WARNING(FtpUtil::GetDailyObsCut): failed to download CUT daily observation file " << oFile << endl;
 
-                    continue;
+                    return;
                 }
 
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
+                /* the 'crx' file has been converted to the 'o' file while it was received */
+                if (access(ObsFile(oFile).c_str(), 0) == -1) _crx.Crx2Rnx(LocalFile(crxFile), ObsFile(oFile));
 
-                if (access(oFile.c_str(), 0) == 0)
+                if (access(ObsFile(oFile).c_str(), 0) == 0)
                 {
-                    cout << "*** INFO(FtpUtil::GetDailyObsCut): successfully download CUT daily observation file " << oFile << endl;
+                    log << "*** INFO(FtpUtil::GetDailyObsCut): successfully download CUT daily observation file " << oFile << endl;
 
                     /* delete 'crx' file */
 #ifdef _WIN32   /* for Windows */
-                    cmd = "del " + crxFile;
+                    cmd = "del " + LocalFile(crxFile);
 #else           /* for Linux or Mac */
-                    cmd = "rm -rf " + crxFile;
+                    cmd = "rm -rf " + LocalFile(crxFile);
 #endif
                     std::system(cmd.c_str());
                 }
             }
-            else cout << "*** INFO(FtpUtil::GetDailyObsCut): CUT daily observation file " << oFile <<
+            else log << "*** INFO(FtpUtil::GetDailyObsCut): CUT daily observation file " << oFile <<
                 " has existed!" << endl;
-        }
+        });
 
         /* close 'site.list' */
         sitLst.close();
@@ -1684,12 +1922,15 @@ void FtpUtil::GetDailyObsCut(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 **/
 void FtpUtil::GetDailyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
+    /* product class of the transfers for the health history */
+    _curl.SetClass(IDX_NAMES[IDX_OBSD]);
+
     /* creation of sub-directory ('daily') */
     char tmpDir[MAXSTRPATH] = { '\0' };
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "daily");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
+    if (!_dryRun && access(subDir.c_str(), 0) == -1)
     {
         /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -1700,12 +1941,8 @@ void FtpUtil::GetDailyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         std::system(cmd.c_str());
     }
 
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(subDir.c_str());
-#else           /* for Linux or Mac */
-    chdir(subDir.c_str());
-#endif
+    /* the local files are in the directory */
+    _workDir = subDir;
 
     /* compute day of year */
     TimeUtil tu;
@@ -1717,54 +1954,51 @@ void FtpUtil::GetDailyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
 
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     string url = "ftp://ftp.data.gnss.ga.gov.au/daily/" + sYyyy + "/" + sDoy;
-    string cutDirs = " --cut-dirs=3 ";
     if (strlen(fopt->obgOpt) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
         /* it is OK for '*.gz' format */
         string crxFile = "*" + sYyyy + sDoy + "0000_01D_30S_MO.crx";
         string crxgzFile = crxFile + ".gz";
-        string cmd = wgetFull + " " + qr + " -nH -A " + crxgzFile + cutDirs + url;
-        std::system(cmd.c_str());
+        _curl.GetFiles(url, crxgzFile, _workDir);
 
         /* get the file list */
         string suffix = ".crx";
         vector<string> crxFiles;
         str.GetFilesAll(subDir, suffix, crxFiles);
-        char sitName[MAXCHARS];
-        for (int i = 0; i < crxFiles.size(); i++)
+        /* the 'crx' files converted to RINEX while they were received are listed as well */
+        str.GetFilesAll(subDir, ".rnx", crxFiles);
+        /* the sites are unpacked and converted in parallel, and the files of one site one by one */
+        vector<vector<string>> sitFiles;
+        GroupBySite(crxFiles, sitFiles);
+        ThreadUtil thr;
+        thr.RunOrdered((int)sitFiles.size(), GetMaxConvert(), [&](int k, ostringstream &log)
         {
-            if (access(crxFiles[i].c_str(), 0) == 0)
+            const vector<string> &files = sitFiles[k];
+            char sitName[MAXCHARS];
+            for (int i = 0; i < files.size(); i++)
             {
-                /* extract it */
-                cmd = gzipFull + " -d -f " + crxFiles[i];
-                std::system(cmd.c_str());
-
-                str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
-                string site = sitName;
-                str.ToLower(site);
-                str.StrMid(sitName, crxFiles[i].c_str(), 0, (int)crxFiles[i].find_last_of('.'));
-                crxFile = sitName;
-                if (access(crxFile.c_str(), 0) == -1) continue;
-                string oFile = site + sDoy + "0." + sYy + "o";
-                /* convert from 'crx' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
+                if (access(LocalFile(files[i]).c_str(), 0) == 0)
+                {
+                    str.StrMid(sitName, files[i].c_str(), 0, 4);
+                    string site = sitName;
+                    str.ToLower(site);
+                    string oFile = site + sDoy + "0." + sYy + "o";
+                    /* the 'crx' file has been converted to RINEX while it was received */
+                    if (RenameRnx(files[i], oFile)) continue;
 
-                /* delete crxFile */
-#ifdef _WIN32   /* for Windows */
-                cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                cmd = "rm -rf " + crxFile;
-#endif
-                std::system(cmd.c_str());
+                    /* extract it */
+                    _zip.Decompress(LocalFile(files[i]));
+                    string crxFile = files[i].substr(0, files[i].rfind(".crx") + 4);
+                    if (access(LocalFile(crxFile).c_str(), 0) == -1) continue;
+                    /* convert from 'crx' file to 'o' file */
+                    _crx.Crx2Rnx(LocalFile(crxFile), ObsFile(oFile));
+
+                    /* delete crxFile */
+                    remove(LocalFile(crxFile).c_str());
+                }
             }
-        }
+        });
     }
     else  /* the option of full path of site list file is selected */
     {
@@ -1779,62 +2013,66 @@ void FtpUtil::GetDailyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 return;
             }
 
+            /* the sites are processed in parallel, and the messages are printed in the order of 'site.list' */
+            vector<string> sitNames;
             string sitName;
-            while (getline(sitLst, sitName))
+            while (getline(sitLst, sitName)) sitNames.push_back(sitName);
+            ThreadUtil thr;
+            thr.RunOrdered((int)sitNames.size(), GetMaxParallel("GA", fopt), [&](int k, ostringstream &log)
             {
+                string sitName = sitNames[k];
                 str.ToLower(sitName);
                 string oFile = sitName + sDoy + "0." + sYy + "o";
                 string dFile = sitName + sDoy + "0." + sYy + "d";
-                if (access(oFile.c_str(), 0) == -1)
+                if (access(ObsFile(oFile).c_str(), 0) == -1)
                 {
                     /* it is OK for '*.gz' format */
                     str.ToUpper(sitName);
                     string crxFile = sitName + "*" + sYyyy + sDoy + "0000_01D_30S_MO.crx";
                     string crxgzFile = crxFile + ".gz";
-                    string cmd = wgetFull + " " + qr + " -nH -A " + crxgzFile + cutDirs + url;
-                    std::system(cmd.c_str());
+                    vector<string> localFiles;
+                    _curl.GetFiles(url, crxgzFile, _workDir, &localFiles);
+                    string cmd;
 
-                    /* extract '*.gz' */
-                    cmd = gzipFull + " -d -f " + crxgzFile;
-                    std::system(cmd.c_str());
-                    string changeFileName;
+                    /* the 'crx' file has been converted to the 'o' file while it was received */
+                    if (localFiles.empty() || !RenameRnx(localFiles[0], oFile))
+                    {
+                        /* extract '*.gz' */
+                        _zip.Decompress(LocalFile(crxgzFile));
+                        string changeFileName;
 #ifdef _WIN32  /* for Windows */
-                    changeFileName = "rename";
+                        changeFileName = "move /y";
 #else          /* for Linux or Mac */
-                    changeFileName = "mv";
+                        changeFileName = "mv";
 #endif
-                    cmd = changeFileName + " " + crxFile + " " + dFile;
-                    std::system(cmd.c_str());
-                    if (access(dFile.c_str(), 0) == -1)
-                    {
-                        cout << "*** WARNING(FtpUtil::GetDailyObsGa): failed to download GA daily observation file " << oFile << endl;
+                        cmd = changeFileName + " " + LocalFile(crxFile) + " " + LocalFile(dFile);
+                        std::system(cmd.c_str());
+                        if (access(LocalFile(dFile).c_str(), 0) == -1)
+                        {
+                            log << "*** WARNING(FtpUtil::GetDailyObsGa): failed to download GA daily observation file " << oFile << endl;
 
-                        continue;
-                    }
+                            return;
+                        }
 
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
+                        _crx.Crx2Rnx(LocalFile(dFile), ObsFile(oFile));
+                    }
 
-                    if (access(oFile.c_str(), 0) == 0)
+                    if (access(ObsFile(oFile).c_str(), 0) == 0)
                     {
-                        cout << "*** INFO(FtpUtil::GetDailyObsGa): successfully download GA daily observation file " << oFile << endl;
+                        log << "*** INFO(FtpUtil::GetDailyObsGa): successfully download GA daily observation file " << oFile << endl;
 
                         /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
-                        cmd = "del " + dFile;
+                        cmd = "del " + LocalFile(dFile);
 #else           /* for Linux or Mac */
-                        cmd = "rm -rf " + dFile;
+                        cmd = "rm -rf " + LocalFile(dFile);
 #endif
                         std::system(cmd.c_str());
                     }
                 }
-                else cout << "*** INFO(FtpUtil::GetDailyObsGa): GA daily observation file " << oFile <<
+                else log << "*** INFO(FtpUtil::GetDailyObsGa): GA daily observation file " << oFile <<
                     " has existed!" << endl;
-            }
+            });
 
             /* close 'site.list' */
             sitLst.close();
@@ -1853,12 +2091,15 @@ void FtpUtil::GetDailyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 **/
 void FtpUtil::GetHourlyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
+    /* product class of the transfers for the health history */
+    _curl.SetClass(IDX_NAMES[IDX_OBSH]);
+
     /* creation of sub-directory ('hourly') */
     char tmpDir[MAXSTRPATH] = { '\0' };
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "hourly");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
+    if (!_dryRun && access(subDir.c_str(), 0) == -1)
     {
         /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -1879,9 +2120,7 @@ void FtpUtil::GetHourlyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
 
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     string url0 = "ftp://ftp.data.gnss.ga.gov.au/hourly/" + sYyyy + "/" + sDoy;
-    string cutDirs = " --cut-dirs=4 ";
     if (strlen(fopt->obgOpt) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
         /* download all the GA observation files */
@@ -1892,7 +2131,7 @@ void FtpUtil::GetHourlyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             char sep = (char)FILEPATHSEP;
             sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
             string sHhDir = tmpDir;
-            if (access(sHhDir.c_str(), 0) == -1)
+            if (!_dryRun && access(sHhDir.c_str(), 0) == -1)
             {
                 /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -1903,19 +2142,15 @@ void FtpUtil::GetHourlyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 std::system(cmd.c_str());
             }
 
-            /* change directory */
-#ifdef _WIN32   /* for Windows */
-            _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-            chdir(sHhDir.c_str());
-#endif
+            /* the local files are in the directory */
+            _workDir = sHhDir;
 
             string url = url0 + "/" + sHh;
             /* it is OK for '*.gz' format */
             string crxFile = "*" + sYyyy + sDoy + sHh + "00_01H_30S_MO.crx";
             string crxgzFile = crxFile + ".gz";
-            string cmd = wgetFull + " " + qr + " -nH -A " + crxgzFile + cutDirs + url;
-            std::system(cmd.c_str());
+            _curl.GetFiles(url, crxgzFile, _workDir);
+            string cmd;
 
             /* 'a' = 97, 'b' = 98, ... */
             int ii = fopt->hhObg[i] + 97;
@@ -1927,39 +2162,39 @@ void FtpUtil::GetHourlyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             string suffix = ".crx";
             vector<string> crxFiles;
             str.GetFilesAll(sHhDir, suffix, crxFiles);
-            char sitName[MAXCHARS];
-            for (int i = 0; i < crxFiles.size(); i++)
+            /* the 'crx' files converted to RINEX while they were received are listed as well */
+            str.GetFilesAll(sHhDir, ".rnx", crxFiles);
+            /* the sites are unpacked and converted in parallel, and the files of one site one by one */
+            vector<vector<string>> sitFiles;
+            GroupBySite(crxFiles, sitFiles);
+            ThreadUtil thr;
+            thr.RunOrdered((int)sitFiles.size(), GetMaxConvert(), [&](int k, ostringstream &log)
             {
-                if (access(crxFiles[i].c_str(), 0) == 0)
+                const vector<string> &files = sitFiles[k];
+                char sitName[MAXCHARS];
+                for (int i = 0; i < files.size(); i++)
                 {
-                    /* extract it */
-                    cmd = gzipFull + "  -d -f " + crxFiles[i];
-                    std::system(cmd.c_str());
+                    if (access(LocalFile(files[i]).c_str(), 0) == 0)
+                    {
+                        str.StrMid(sitName, files[i].c_str(), 0, 4);
+                        string site = sitName;
+                        str.ToLower(site);
+                        string oFile = site + sDoy + sch + "." + sYy + "o";
+                        /* the 'crx' file has been converted to RINEX while it was received */
+                        if (RenameRnx(files[i], oFile)) continue;
 
-                    str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
-                    string site = sitName;
-                    str.ToLower(site);
-                    str.StrMid(sitName, crxFiles[i].c_str(), 0, (int)crxFiles[i].find_last_of('.'));
-                    crxFile = sitName;
-                    if (access(crxFile.c_str(), 0) == -1) continue;
-                    string oFile = site + sDoy + sch + "." + sYy + "o";
-                    /* convert from 'd' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
+                        /* extract it */
+                        _zip.Decompress(LocalFile(files[i]));
+                        string crxFile = files[i].substr(0, files[i].rfind(".crx") + 4);
+                        if (access(LocalFile(crxFile).c_str(), 0) == -1) continue;
+                        /* convert from 'd' file to 'o' file */
+                        _crx.Crx2Rnx(LocalFile(crxFile), ObsFile(oFile));
 
-                    /* delete 'd' file */
-#ifdef _WIN32   /* for Windows */
-                    cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                    cmd = "rm -rf " + crxFile;
-#endif
-                    std::system(cmd.c_str());
+                        /* delete 'd' file */
+                        remove(LocalFile(crxFile).c_str());
+                    }
                 }
-            }
+            });
         }
     }
     else  /* the option of full path of site list file is selected */
@@ -1985,7 +2220,7 @@ void FtpUtil::GetHourlyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     char sep = (char)FILEPATHSEP;
                     sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
                     string sHhDir = tmpDir;
-                    if (access(sHhDir.c_str(), 0) == -1)
+                    if (!_dryRun && access(sHhDir.c_str(), 0) == -1)
                     {
                         /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -1996,12 +2231,8 @@ void FtpUtil::GetHourlyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                         std::system(cmd.c_str());
                     }
 
-                    /* change directory */
-#ifdef _WIN32   /* for Windows */
-                    _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-                    chdir(sHhDir.c_str());
-#endif
+                    /* the local files are in the directory */
+                    _workDir = sHhDir;
 
                     /* 'a' = 97, 'b' = 98, ... */
                     int ii = fopt->hhObg[i] + 97;
@@ -2011,50 +2242,49 @@ void FtpUtil::GetHourlyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     str.ToLower(sitName);
                     string oFile = sitName + sDoy + sch + "." + sYy + "o";
                     string dFile = sitName + sDoy + sch + "." + sYy + "d";
-                    if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                    if (access(ObsFile(oFile).c_str(), 0) == -1 && access(LocalFile(dFile).c_str(), 0) == -1)
                     {
                         string url = url0 + "/" + sHh;
                         /* it is OK for '*.gz' format */
                         str.ToUpper(sitName);
                         string crxFile = sitName + "*" + sYyyy + sDoy + sHh + "00_01H_30S_MO.crx";
                         string crxgzFile = crxFile + ".gz";
-                        string cmd = wgetFull + " " + qr + " -nH -A " + crxgzFile + cutDirs + url;
-                        std::system(cmd.c_str());
+                        vector<string> localFiles;
+                        _curl.GetFiles(url, crxgzFile, _workDir, &localFiles);
+                        string cmd;
 
-                        /* extract '*.gz' */
-                        cmd = gzipFull + " -d -f " + crxgzFile;
-                        std::system(cmd.c_str());
-                        string changeFileName;
+                        /* the 'crx' file has been converted to the 'o' file while it was received */
+                        if (localFiles.empty() || !RenameRnx(localFiles[0], oFile))
+                        {
+                            /* extract '*.gz' */
+                            _zip.Decompress(LocalFile(crxgzFile));
+                            string changeFileName;
 #ifdef _WIN32  /* for Windows */
-                        changeFileName = "rename";
+                            changeFileName = "move /y";
 #else          /* for Linux or Mac */
-                        changeFileName = "mv";
+                            changeFileName = "mv";
 #endif
-                        cmd = changeFileName + " " + crxFile + " " + dFile;
-                        std::system(cmd.c_str());
-                        if (access(dFile.c_str(), 0) == -1)
-                        {
-                            cout << "*** WARNING(FtpUtil::GetDailyObsGa): failed to download GA daily observation file " << oFile << endl;
+                            cmd = changeFileName + " " + LocalFile(crxFile) + " " + LocalFile(dFile);
+                            std::system(cmd.c_str());
+                            if (access(LocalFile(dFile).c_str(), 0) == -1)
+                            {
+                                cout << "*** WARNING(FtpUtil::GetDailyObsGa): failed to download GA daily observation file " << oFile << endl;
 
-                            continue;
+                                continue;
+                            }
+
+                            _crx.Crx2Rnx(LocalFile(dFile), ObsFile(oFile));
                         }
 
-#ifdef _WIN32  /* for Windows */
-                        cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                        cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                        std::system(cmd.c_str());
-
-                        if (access(oFile.c_str(), 0) == 0)
+                        if (access(ObsFile(oFile).c_str(), 0) == 0)
                         {
                             cout << "*** INFO(FtpUtil::GetHourlyObsGa): successfully download GA hourly observation file " << oFile << endl;
 
                             /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
-                            cmd = "del " + dFile;
+                            cmd = "del " + LocalFile(dFile);
 #else           /* for Linux or Mac */
-                            cmd = "rm -rf " + dFile;
+                            cmd = "rm -rf " + LocalFile(dFile);
 #endif
                             std::system(cmd.c_str());
                         }
@@ -2081,12 +2311,15 @@ void FtpUtil::GetHourlyObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 **/
 void FtpUtil::GetHrObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
+    /* product class of the transfers for the health history */
+    _curl.SetClass(IDX_NAMES[IDX_OBSHR]);
+
     /* creation of sub-directory ('highrate') */
     char tmpDir[MAXSTRPATH] = { '\0' };
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "highrate");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
+    if (!_dryRun && access(subDir.c_str(), 0) == -1)
     {
         /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -2107,9 +2340,7 @@ void FtpUtil::GetHrObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
 
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     string url0 = "ftp://ftp.data.gnss.ga.gov.au/highrate/" + sYyyy + "/" + sDoy;
-    string cutDirs = " --cut-dirs=4 ";
     if (strlen(fopt->obgOpt) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
         /* download all the MGEX observation files */
@@ -2120,7 +2351,7 @@ void FtpUtil::GetHrObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             char sep = (char)FILEPATHSEP;
             sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
             string sHhDir = tmpDir;
-            if (access(sHhDir.c_str(), 0) == -1)
+            if (!_dryRun && access(sHhDir.c_str(), 0) == -1)
             {
                 /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -2131,19 +2362,15 @@ void FtpUtil::GetHrObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 std::system(cmd.c_str());
             }
 
-            /* change directory */
-#ifdef _WIN32   /* for Windows */
-            _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-            chdir(sHhDir.c_str());
-#endif
+            /* the local files are in the directory */
+            _workDir = sHhDir;
 
             string url = url0 + "/" + sHh;
             /* it is OK for '*.gz' format */
             string crxFile = "*_15M_01S_MO.crx";
             string crxgzFile = crxFile + ".gz";
-            string cmd = wgetFull + " " + qr + " -nH -A " + crxgzFile + cutDirs + url;
-            std::system(cmd.c_str());
+            _curl.GetFiles(url, crxgzFile, _workDir);
+            string cmd;
 
             /* 'a' = 97, 'b' = 98, ... */
             int ii = fopt->hhObg[i] + 97;
@@ -2158,39 +2385,39 @@ void FtpUtil::GetHrObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 string suffix = minuStr[i] + "_15M_01S_MO.crx";
                 vector<string> crxFiles;
                 str.GetFilesAll(sHhDir, suffix, crxFiles);
-                char sitName[MAXCHARS];
-                for (int j = 0; j < crxFiles.size(); j++)
+                /* the 'crx' files converted to RINEX while they were received are listed as well */
+                str.GetFilesAll(sHhDir, minuStr[i] + "_15M_01S_MO.rnx", crxFiles);
+                /* the sites are unpacked and converted in parallel, and the files of one site one by one */
+                vector<vector<string>> sitFiles;
+                GroupBySite(crxFiles, sitFiles);
+                ThreadUtil thr;
+                thr.RunOrdered((int)sitFiles.size(), GetMaxConvert(), [&](int k, ostringstream &log)
                 {
-                    if (access(crxFiles[j].c_str(), 0) == 0)
+                    const vector<string> &files = sitFiles[k];
+                    char sitName[MAXCHARS];
+                    for (int j = 0; j < files.size(); j++)
                     {
-                        /* extract it */
-                        cmd = gzipFull + " -d -f " + crxFiles[j];
-                        std::system(cmd.c_str());
-
-                        str.StrMid(sitName, crxFiles[j].c_str(), 0, 4);
-                        string site = sitName;
-                        str.ToLower(site);
-                        str.StrMid(sitName, crxFiles[j].c_str(), 0, (int)crxFiles[j].find_last_of('.'));
-                        crxFile = sitName;
-                        if (access(crxFile.c_str(), 0) == -1) continue;
-                        string oFile = site + sDoy + sch + minuStr[i] + "." + sYy + "o";
-                        /* convert from 'crx' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                        cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                        cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                        std::system(cmd.c_str());
-
-                        /* delete 'crx' file */
-#ifdef _WIN32   /* for Windows */
-                        cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                        cmd = "rm -rf " + crxFile;
-#endif
-                        std::system(cmd.c_str());
+                        if (access(LocalFile(files[j]).c_str(), 0) == 0)
+                        {
+                            str.StrMid(sitName, files[j].c_str(), 0, 4);
+                            string site = sitName;
+                            str.ToLower(site);
+                            string oFile = site + sDoy + sch + minuStr[i] + "." + sYy + "o";
+                            /* the 'crx' file has been converted to RINEX while it was received */
+                            if (RenameRnx(files[j], oFile)) continue;
+
+                            /* extract it */
+                            _zip.Decompress(LocalFile(files[j]));
+                            string crxFile = files[j].substr(0, files[j].rfind(".crx") + 4);
+                            if (access(LocalFile(crxFile).c_str(), 0) == -1) continue;
+                            /* convert from 'crx' file to 'o' file */
+                            _crx.Crx2Rnx(LocalFile(crxFile), ObsFile(oFile));
+
+                            /* delete 'crx' file */
+                            remove(LocalFile(crxFile).c_str());
+                        }
                     }
-                }
+                });
             }
         }
     }
@@ -2217,7 +2444,7 @@ void FtpUtil::GetHrObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     char sep = (char)FILEPATHSEP;
                     sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
                     string sHhDir = tmpDir;
-                    if (access(sHhDir.c_str(), 0) == -1)
+                    if (!_dryRun && access(sHhDir.c_str(), 0) == -1)
                     {
                         /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -2228,12 +2455,8 @@ void FtpUtil::GetHrObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                         std::system(cmd.c_str());
                     }
 
-                    /* change directory */
-#ifdef _WIN32   /* for Windows */
-                    _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-                    chdir(sHhDir.c_str());
-#endif
+                    /* the local files are in the directory */
+                    _workDir = sHhDir;
 
                     /* 'a' = 97, 'b' = 98, ... */
                     int ii = fopt->hhObg[i] + 97;
@@ -2248,49 +2471,48 @@ void FtpUtil::GetHrObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                         str.ToLower(sitName);
                         string oFile = sitName + sDoy + sch + minuStr[i] + "." + sYy + "o";
                         string dFile = sitName + sDoy + sch + minuStr[i] + "." + sYy + "d";
-                        if (access(oFile.c_str(), 0) == -1 && access(dFile.c_str(), 0) == -1)
+                        if (access(ObsFile(oFile).c_str(), 0) == -1 && access(LocalFile(dFile).c_str(), 0) == -1)
                         {
                             /* it is OK for '*.gz' format */
                             str.ToUpper(sitName);
                             string crxFile = sitName + "*" + sYyyy + sDoy + sHh + minuStr[i] + "_15M_01S_MO.crx";
                             string crxgzFile = crxFile + ".gz";
-                            string cmd = wgetFull + " " + qr + " -nH -A " + crxgzFile + cutDirs + url;
-                            std::system(cmd.c_str());
+                            vector<string> localFiles;
+                            _curl.GetFiles(url, crxgzFile, _workDir, &localFiles);
+                            string cmd;
 
-                            /* extract '*.gz' */
-                            cmd = gzipFull + " -d -f " + crxgzFile;
-                            std::system(cmd.c_str());
-                            string changeFileName;
+                            /* the 'crx' file has been converted to the 'o' file while it was received */
+                            if (localFiles.empty() || !RenameRnx(localFiles[0], oFile))
+                            {
+                                /* extract '*.gz' */
+                                _zip.Decompress(LocalFile(crxgzFile));
+                                string changeFileName;
 #ifdef _WIN32  /* for Windows */
-                            changeFileName = "rename";
+                                changeFileName = "move /y";
 #else          /* for Linux or Mac */
-                            changeFileName = "mv";
+                                changeFileName = "mv";
 #endif
-                            cmd = changeFileName + " " + crxFile + " " + dFile;
-                            std::system(cmd.c_str());
-                            if (access(dFile.c_str(), 0) == -1)
-                            {
-                                cout << "*** WARNING(FtpUtil::GetDailyObsGa): failed to download GA daily observation file " << oFile << endl;
+                                cmd = changeFileName + " " + LocalFile(crxFile) + " " + LocalFile(dFile);
+                                std::system(cmd.c_str());
+                                if (access(LocalFile(dFile).c_str(), 0) == -1)
+                                {
+                                    cout << "*** WARNING(FtpUtil::GetDailyObsGa): failed to download GA daily observation file " << oFile << endl;
 
-                                continue;
-                            }
+                                    continue;
+                                }
 
-#ifdef _WIN32  /* for Windows */
-                            cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                            cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                            std::system(cmd.c_str());
+                                _crx.Crx2Rnx(LocalFile(dFile), ObsFile(oFile));
+                            }
 
-                            if (access(oFile.c_str(), 0) == 0)
+                            if (access(ObsFile(oFile).c_str(), 0) == 0)
                             {
                                 cout << "*** INFO(FtpUtil::GetHrObsGa): successfully download GA high-rate observation file " << oFile << endl;
 
                                 /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
-                                cmd = "del " + dFile;
+                                cmd = "del " + LocalFile(dFile);
 #else           /* for Linux or Mac */
-                                cmd = "rm -rf " + dFile;
+                                cmd = "rm -rf " + LocalFile(dFile);
 #endif
                                 std::system(cmd.c_str());
                             }
@@ -2318,12 +2540,15 @@ void FtpUtil::GetHrObsGa(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 **/
 void FtpUtil::Get30sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
+    /* product class of the transfers for the health history */
+    _curl.SetClass(IDX_NAMES[IDX_OBSD]);
+
     /* creation of sub-directory ('daily') */
     char tmpDir[MAXSTRPATH] = { '\0' };
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "30s");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
+    if (!_dryRun && access(subDir.c_str(), 0) == -1)
     {
         /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -2334,12 +2559,8 @@ void FtpUtil::Get30sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         std::system(cmd.c_str());
     }
 
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(subDir.c_str());
-#else           /* for Linux or Mac */
-    chdir(subDir.c_str());
-#endif
+    /* the local files are in the directory */
+    _workDir = subDir;
 
     /* compute day of year */
     TimeUtil tu;
@@ -2351,9 +2572,7 @@ void FtpUtil::Get30sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
 
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     string url0 = "ftp://ftp.geodetic.gov.hk/rinex3/" + sYyyy + "/" + sDoy;
-    string cutDirs = " --cut-dirs=5 ";
     /* download the Hong Kong CORS observation file site-by-site */
     if (access(fopt->obhOpt, 0) == 0)
     {
@@ -2365,55 +2584,55 @@ void FtpUtil::Get30sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             return;
         }
 
+        /* the sites are processed in parallel, and the messages are printed in the order of 'site.list' */
+        vector<string> sitNames;
         string sitName;
-        while (getline(sitLst, sitName))
+        while (getline(sitLst, sitName)) sitNames.push_back(sitName);
+        ThreadUtil thr;
+        thr.RunOrdered((int)sitNames.size(), GetMaxParallel("HK", fopt), [&](int k, ostringstream &log)
         {
+            string sitName = sitNames[k];
             str.ToLower(sitName);
             string oFile = sitName + sDoy + "0." + sYy + "o";
             string url = url0 + "/" + sitName + "/30s";
-            if (access(oFile.c_str(), 0) == -1)
+            if (access(ObsFile(oFile).c_str(), 0) == -1)
             {
                 /* it is OK for '*.gz' format */
                 str.ToUpper(sitName);
                 string crxFile = sitName + "00HKG_R_" + sYyyy + sDoy + "0000_01D_30S_MO.crx";
                 string crxgzFile = crxFile + ".gz";
                 str.ToLower(sitName);
-                string cmd = wgetFull + " " + qr + " -nH " + cutDirs + url + "/" + crxgzFile;
-                std::system(cmd.c_str());
+                _curl.GetFile(url + "/" + crxgzFile, LocalFile(crxgzFile));
 
-                /* extract '*.gz' */
-                cmd = gzipFull + " -d -f " + crxgzFile;
-                std::system(cmd.c_str());
-                if (access(crxFile.c_str(), 0) == -1)
+                /* extract '*.gz' unless it is kept compressed */
+                if (!RenameRnx(crxgzFile, oFile)) _zip.Decompress(LocalFile(crxgzFile));
+                string cmd;
+                if (access(LocalFile(crxFile).c_str(), 0) == -1 && !RenameRnx(crxFile.substr(0, crxFile.size() - 3) + "rnx", oFile))
                 {
-                    cout << "*** WARNING(FtpUtil::Get30sObsHk): failed to download HK CORS 30s observation file " << oFile << endl;
+                    log << "*** WARNING(FtpUtil::Get30sObsHk): failed to download HK CORS 30s observation file " << oFile << endl;
 
-                    continue;
+                    return;
                 }
 
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
+                /* the 'crx' file has been converted to the 'o' file while it was received */
+                if (access(ObsFile(oFile).c_str(), 0) == -1) _crx.Crx2Rnx(LocalFile(crxFile), ObsFile(oFile));
 
-                if (access(oFile.c_str(), 0) == 0)
+                if (access(ObsFile(oFile).c_str(), 0) == 0)
                 {
-                    cout << "*** INFO(FtpUtil::Get30sObsHk): successfully download HK CORS 30s observation file " << oFile << endl;
+                    log << "*** INFO(FtpUtil::Get30sObsHk): successfully download HK CORS 30s observation file " << oFile << endl;
 
                     /* delete 'crx' file */
 #ifdef _WIN32   /* for Windows */
-                    cmd = "del " + crxFile;
+                    cmd = "del " + LocalFile(crxFile);
 #else           /* for Linux or Mac */
-                    cmd = "rm -rf " + crxFile;
+                    cmd = "rm -rf " + LocalFile(crxFile);
 #endif
                     std::system(cmd.c_str());
                 }
             }
-            else cout << "*** INFO(FtpUtil::Get30sObsHk): HK CORS 30s observation file " << oFile <<
+            else log << "*** INFO(FtpUtil::Get30sObsHk): HK CORS 30s observation file " << oFile <<
                 " has existed!" << endl;
-        }
+        });
 
         /* close 'site.list' */
         sitLst.close();
@@ -2431,12 +2650,15 @@ void FtpUtil::Get30sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 **/
 void FtpUtil::Get5sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
+    /* product class of the transfers for the health history */
+    _curl.SetClass(IDX_NAMES[IDX_OBSHR]);
+
     /* creation of sub-directory ('daily') */
     char tmpDir[MAXSTRPATH] = { '\0' };
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "5s");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
+    if (!_dryRun && access(subDir.c_str(), 0) == -1)
     {
         /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -2447,12 +2669,8 @@ void FtpUtil::Get5sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         std::system(cmd.c_str());
     }
 
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(subDir.c_str());
-#else           /* for Linux or Mac */
-    chdir(subDir.c_str());
-#endif
+    /* the local files are in the directory */
+    _workDir = subDir;
 
     /* compute day of year */
     TimeUtil tu;
@@ -2464,9 +2682,7 @@ void FtpUtil::Get5sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
 
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     string url0 = "ftp://ftp.geodetic.gov.hk/rinex3/" + sYyyy + "/" + sDoy;
-    string cutDirs = " --cut-dirs=5 ";
     /* download the Hong Kong CORS observation file site-by-site */
     if (access(fopt->obhOpt, 0) == 0)
     {
@@ -2488,7 +2704,7 @@ void FtpUtil::Get5sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 char sep = (char)FILEPATHSEP;
                 sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
                 string sHhDir = tmpDir;
-                if (access(sHhDir.c_str(), 0) == -1)
+                if (!_dryRun && access(sHhDir.c_str(), 0) == -1)
                 {
                     /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -2499,12 +2715,8 @@ void FtpUtil::Get5sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     std::system(cmd.c_str());
                 }
 
-                /* change directory */
-#ifdef _WIN32   /* for Windows */
-                _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-                chdir(sHhDir.c_str());
-#endif
+                /* the local files are in the directory */
+                _workDir = sHhDir;
 
                 /* 'a' = 97, 'b' = 98, ... */
                 int ii = fopt->hhObh[i] + 97;
@@ -2514,42 +2726,37 @@ void FtpUtil::Get5sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 str.ToLower(sitName);
                 string oFile = sitName + sDoy + sch + "." + sYy + "o";
                 string url = url0 + "/" + sitName + "/5s";
-                if (access(oFile.c_str(), 0) == -1)
+                if (access(ObsFile(oFile).c_str(), 0) == -1)
                 {
                     /* it is OK for '*.gz' format */
                     str.ToUpper(sitName);
                     string crxFile = sitName + "00HKG_R_" + sYyyy + sDoy + sHh + "00_01H_05S_MO.crx";
                     string crxgzFile = crxFile + ".gz";
                     str.ToLower(sitName);
-                    string cmd = wgetFull + " " + qr + " -nH " + cutDirs + url + "/" + crxgzFile;
-                    std::system(cmd.c_str());
+                    _curl.GetFile(url + "/" + crxgzFile, LocalFile(crxgzFile));
 
-                    /* extract '*.gz' */
-                    cmd = gzipFull + " -d -f " + crxgzFile;
-                    std::system(cmd.c_str());
-                    if (access(crxFile.c_str(), 0) == -1)
+                    /* extract '*.gz' unless it is kept compressed */
+                    if (!RenameRnx(crxgzFile, oFile)) _zip.Decompress(LocalFile(crxgzFile));
+                    string cmd;
+                    if (access(LocalFile(crxFile).c_str(), 0) == -1 && !RenameRnx(crxFile.substr(0, crxFile.size() - 3) + "rnx", oFile))
                     {
                         cout << "*** WARNING(FtpUtil::Get5sObsHk): failed to download HK CORS 5s observation file " << oFile << endl;
 
                         continue;
                     }
 
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
+                    /* the 'crx' file has been converted to the 'o' file while it was received */
+                    if (access(ObsFile(oFile).c_str(), 0) == -1) _crx.Crx2Rnx(LocalFile(crxFile), ObsFile(oFile));
 
-                    if (access(oFile.c_str(), 0) == 0)
+                    if (access(ObsFile(oFile).c_str(), 0) == 0)
                     {
                         cout << "*** INFO(FtpUtil::Get5sObsHk): successfully download HK CORS 5s observation file " << oFile << endl;
 
                         /* delete 'crx' file */
 #ifdef _WIN32   /* for Windows */
-                        cmd = "del " + crxFile;
+                        cmd = "del " + LocalFile(crxFile);
 #else           /* for Linux or Mac */
-                        cmd = "rm -rf " + crxFile;
+                        cmd = "rm -rf " + LocalFile(crxFile);
 #endif
                         std::system(cmd.c_str());
                     }
@@ -2575,12 +2782,15 @@ void FtpUtil::Get5sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 **/
 void FtpUtil::Get1sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
+    /* product class of the transfers for the health history */
+    _curl.SetClass(IDX_NAMES[IDX_OBSHR]);
+
     /* creation of sub-directory ('daily') */
     char tmpDir[MAXSTRPATH] = { '\0' };
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "1s");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
+    if (!_dryRun && access(subDir.c_str(), 0) == -1)
     {
         /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -2591,12 +2801,8 @@ void FtpUtil::Get1sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         std::system(cmd.c_str());
     }
 
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(subDir.c_str());
-#else           /* for Linux or Mac */
-    chdir(subDir.c_str());
-#endif
+    /* the local files are in the directory */
+    _workDir = subDir;
 
     /* compute day of year */
     TimeUtil tu;
@@ -2608,9 +2814,7 @@ void FtpUtil::Get1sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
 
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     string url0 = "ftp://ftp.geodetic.gov.hk/rinex3/" + sYyyy + "/" + sDoy;
-    string cutDirs = " --cut-dirs=5 ";
     /* download the Hong Kong CORS observation file site-by-site */
     if (access(fopt->obhOpt, 0) == 0)
     {
@@ -2632,7 +2836,7 @@ void FtpUtil::Get1sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 char sep = (char)FILEPATHSEP;
                 sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
                 string sHhDir = tmpDir;
-                if (access(sHhDir.c_str(), 0) == -1)
+                if (!_dryRun && access(sHhDir.c_str(), 0) == -1)
                 {
                     /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -2643,12 +2847,8 @@ void FtpUtil::Get1sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     std::system(cmd.c_str());
                 }
 
-                /* change directory */
-#ifdef _WIN32   /* for Windows */
-                _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-                chdir(sHhDir.c_str());
-#endif
+                /* the local files are in the directory */
+                _workDir = sHhDir;
 
                 /* 'a' = 97, 'b' = 98, ... */
                 int ii = fopt->hhObh[i] + 97;
@@ -2658,42 +2858,37 @@ void FtpUtil::Get1sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 str.ToLower(sitName);
                 string oFile = sitName + sDoy + sch + "." + sYy + "o";
                 string url = url0 + "/" + sitName + "/1s";
-                if (access(oFile.c_str(), 0) == -1)
+                if (access(ObsFile(oFile).c_str(), 0) == -1)
                 {
                     /* it is OK for '*.gz' format */
                     str.ToUpper(sitName);
                     string crxFile = sitName + "00HKG_R_" + sYyyy + sDoy + sHh + "00_01H_01S_MO.crx";
                     string crxgzFile = crxFile + ".gz";
                     str.ToLower(sitName);
-                    string cmd = wgetFull + " " + qr + " -nH " + cutDirs + url + "/" + crxgzFile;
-                    std::system(cmd.c_str());
+                    _curl.GetFile(url + "/" + crxgzFile, LocalFile(crxgzFile));
 
-                    /* extract '*.gz' */
-                    cmd = gzipFull + " -d -f " + crxgzFile;
-                    std::system(cmd.c_str());
-                    if (access(crxFile.c_str(), 0) == -1)
+                    /* extract '*.gz' unless it is kept compressed */
+                    if (!RenameRnx(crxgzFile, oFile)) _zip.Decompress(LocalFile(crxgzFile));
+                    string cmd;
+                    if (access(LocalFile(crxFile).c_str(), 0) == -1 && !RenameRnx(crxFile.substr(0, crxFile.size() - 3) + "rnx", oFile))
                     {
                         cout << "*** WARNING(FtpUtil::Get1sObsHk): failed to download HK CORS 1s observation file " << oFile << endl;
 
                         continue;
                     }
 
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
+                    /* the 'crx' file has been converted to the 'o' file while it was received */
+                    if (access(ObsFile(oFile).c_str(), 0) == -1) _crx.Crx2Rnx(LocalFile(crxFile), ObsFile(oFile));
 
-                    if (access(oFile.c_str(), 0) == 0)
+                    if (access(ObsFile(oFile).c_str(), 0) == 0)
                     {
                         cout << "*** INFO(FtpUtil::Get1sObsHk): successfully download HK CORS 1s observation file " << oFile << endl;
 
                         /* delete 'crx' file */
 #ifdef _WIN32   /* for Windows */
-                        cmd = "del " + crxFile;
+                        cmd = "del " + LocalFile(crxFile);
 #else           /* for Linux or Mac */
-                        cmd = "rm -rf " + crxFile;
+                        cmd = "rm -rf " + LocalFile(crxFile);
 #endif
                         std::system(cmd.c_str());
                     }
@@ -2719,12 +2914,15 @@ void FtpUtil::Get1sObsHk(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 **/
 void FtpUtil::GetDailyObsNgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
+    /* product class of the transfers for the health history */
+    _curl.SetClass(IDX_NAMES[IDX_OBSD]);
+
     /* creation of sub-directory ('daily') */
     char tmpDir[MAXSTRPATH] = { '\0' };
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "daily");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
+    if (!_dryRun && access(subDir.c_str(), 0) == -1)
     {
         /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -2735,12 +2933,8 @@ void FtpUtil::GetDailyObsNgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         std::system(cmd.c_str());
     }
 
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(subDir.c_str());
-#else           /* for Linux or Mac */
-    chdir(subDir.c_str());
-#endif
+    /* the local files are in the directory */
+    _workDir = subDir;
 
     /* compute day of year */
     TimeUtil tu;
@@ -2752,9 +2946,7 @@ void FtpUtil::GetDailyObsNgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
 
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     string url = "https://noaa-cors-pds.s3.amazonaws.com/rinex/" + sYyyy + "/" + sDoy;
-    string cutDirs = " --cut-dirs=4 ";
     /* download the NGS/NOAA CORS observation file site-by-site */
     if (access(fopt->obnOpt, 0) == 0)
     {
@@ -2766,52 +2958,52 @@ void FtpUtil::GetDailyObsNgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             return;
         }
 
+        /* the sites are processed in parallel, and the messages are printed in the order of 'site.list' */
+        vector<string> sitNames;
         string sitName;
-        while (getline(sitLst, sitName))
+        while (getline(sitLst, sitName)) sitNames.push_back(sitName);
+        ThreadUtil thr;
+        thr.RunOrdered((int)sitNames.size(), GetMaxParallel("NGS", fopt), [&](int k, ostringstream &log)
         {
+            string sitName = sitNames[k];
             str.ToLower(sitName);
             string oFile = sitName + sDoy + "0." + sYy + "o";
-            if (access(oFile.c_str(), 0) == -1)
+            if (access(ObsFile(oFile).c_str(), 0) == -1)
             {
                 /* it is OK for '*.gz' format */
                 string dFile = sitName + sDoy + "0." + sYy + "d";
                 string dgzFile = dFile + ".gz";
-                string cmd = wgetFull + " " + qr + " -nH " + cutDirs + url + "/" + sitName + "/" + dgzFile;
-                std::system(cmd.c_str());
+                _curl.GetFile(url + "/" + sitName + "/" + dgzFile, LocalFile(dgzFile));
 
-                /* extract '*.gz' */
-                cmd = gzipFull + " -d -f " + dgzFile;
-                std::system(cmd.c_str());
-                if (access(dFile.c_str(), 0) == -1)
+                /* extract '*.gz' unless it is kept compressed */
+                if (!_keepCrx) _zip.Decompress(LocalFile(dgzFile));
+                string cmd;
+                if (access(LocalFile(dFile).c_str(), 0) == -1 && access(ObsFile(oFile).c_str(), 0) == -1)
                 {
-                    cout << "*** WARNING(FtpUtil::GetDailyObsNgs): failed to download NGS/NOAA CORS daily observation file " << oFile << endl;
+                    log << "*** WARNING(FtpUtil::GetDailyObsNgs): failed to download NGS/NOAA CORS daily observation file " << oFile << endl;
 
-                    continue;
+                    return;
                 }
 
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
+                /* the 'd' file has been converted to the 'o' file while it was received */
+                if (access(ObsFile(oFile).c_str(), 0) == -1) _crx.Crx2Rnx(LocalFile(dFile), ObsFile(oFile));
 
-                if (access(oFile.c_str(), 0) == 0)
+                if (access(ObsFile(oFile).c_str(), 0) == 0)
                 {
-                    cout << "*** INFO(FtpUtil::GetDailyObsNgs): successfully download NGS/NOAA CORS daily observation file " << oFile << endl;
+                    log << "*** INFO(FtpUtil::GetDailyObsNgs): successfully download NGS/NOAA CORS daily observation file " << oFile << endl;
 
                     /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
-                    cmd = "del " + dFile;
+                    cmd = "del " + LocalFile(dFile);
 #else           /* for Linux or Mac */
-                    cmd = "rm -rf " + dFile;
+                    cmd = "rm -rf " + LocalFile(dFile);
 #endif
                     std::system(cmd.c_str());
                 }
             }
-            else cout << "*** INFO(FtpUtil::GetDailyObsNgs): NGS/NOAA CORS daily observation file " << oFile <<
+            else log << "*** INFO(FtpUtil::GetDailyObsNgs): NGS/NOAA CORS daily observation file " << oFile <<
                 " has existed!" << endl;
-        }
+        });
 
         /* close 'site.list' */
         sitLst.close();
@@ -2829,12 +3021,15 @@ void FtpUtil::GetDailyObsNgs(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 **/
 void FtpUtil::GetDailyObsEpn(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
+    /* product class of the transfers for the health history */
+    _curl.SetClass(IDX_NAMES[IDX_OBSD]);
+
     /* creation of sub-directory ('daily') */
     char tmpDir[MAXSTRPATH] = { '\0' };
     char sep = (char)FILEPATHSEP;
     sprintf(tmpDir, "%s%c%s", dir, sep, "daily");
     string subDir = tmpDir;
-    if (access(subDir.c_str(), 0) == -1)
+    if (!_dryRun && access(subDir.c_str(), 0) == -1)
     {
         /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -2845,12 +3040,8 @@ void FtpUtil::GetDailyObsEpn(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         std::system(cmd.c_str());
     }
 
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(subDir.c_str());
-#else           /* for Linux or Mac */
-    chdir(subDir.c_str());
-#endif
+    /* the local files are in the directory */
+    _workDir = subDir;
 
     /* compute day of year */
     TimeUtil tu;
@@ -2862,54 +3053,51 @@ void FtpUtil::GetDailyObsEpn(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
 
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, crx2rnxFull = fopt->crx2rnxFull, qr = fopt->qr;
     string url = "ftp://ftp.epncb.oma.be/pub/obs/" + sYyyy + "/" + sDoy;
-    string cutDirs = " --cut-dirs=4 ";
     if (strlen(fopt->obeOpt) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
     {
         /* it is OK for '*.gz' format */
         string crxFile = "*" + sYyyy + sDoy + "0000_01D_30S_MO.crx";
         string crxgzFile = crxFile + ".gz";
-        string cmd = wgetFull + " " + qr + " -nH -A " + crxgzFile + cutDirs + url;
-        std::system(cmd.c_str());
+        _curl.GetFiles(url, crxgzFile, _workDir);
 
         /* get the file list */
         string suffix = ".crx";
         vector<string> crxFiles;
         str.GetFilesAll(subDir, suffix, crxFiles);
-        char sitName[MAXCHARS];
-        for (int i = 0; i < crxFiles.size(); i++)
+        /* the 'crx' files converted to RINEX while they were received are listed as well */
+        str.GetFilesAll(subDir, ".rnx", crxFiles);
+        /* the sites are unpacked and converted in parallel, and the files of one site one by one */
+        vector<vector<string>> sitFiles;
+        GroupBySite(crxFiles, sitFiles);
+        ThreadUtil thr;
+        thr.RunOrdered((int)sitFiles.size(), GetMaxConvert(), [&](int k, ostringstream &log)
         {
-            if (access(crxFiles[i].c_str(), 0) == 0)
+            const vector<string> &files = sitFiles[k];
+            char sitName[MAXCHARS];
+            for (int i = 0; i < files.size(); i++)
             {
-                /* extract it */
-                cmd = gzipFull + " -d -f " + crxFiles[i];
-                std::system(cmd.c_str());
-
-                str.StrMid(sitName, crxFiles[i].c_str(), 0, 4);
-                string site = sitName;
-                str.ToLower(site);
-                str.StrMid(sitName, crxFiles[i].c_str(), 0, (int)crxFiles[i].find_last_of('.'));
-                crxFile = sitName;
-                if (access(crxFile.c_str(), 0) == -1) continue;
-                string oFile = site + sDoy + "0." + sYy + "o";
-                /* convert from 'crx' file to 'o' file */
-#ifdef _WIN32  /* for Windows */
-                cmd = crx2rnxFull + " " + crxFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                cmd = "cat " + crxFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                std::system(cmd.c_str());
+                if (access(LocalFile(files[i]).c_str(), 0) == 0)
+                {
+                    str.StrMid(sitName, files[i].c_str(), 0, 4);
+                    string site = sitName;
+                    str.ToLower(site);
+                    string oFile = site + sDoy + "0." + sYy + "o";
+                    /* the 'crx' file has been converted to RINEX while it was received */
+                    if (RenameRnx(files[i], oFile)) continue;
 
-                /* delete crxFile */
-#ifdef _WIN32   /* for Windows */
-                cmd = "del " + crxFile;
-#else           /* for Linux or Mac */
-                cmd = "rm -rf " + crxFile;
-#endif
-                std::system(cmd.c_str());
+                    /* extract it */
+                    _zip.Decompress(LocalFile(files[i]));
+                    string crxFile = files[i].substr(0, files[i].rfind(".crx") + 4);
+                    if (access(LocalFile(crxFile).c_str(), 0) == -1) continue;
+                    /* convert from 'crx' file to 'o' file */
+                    _crx.Crx2Rnx(LocalFile(crxFile), ObsFile(oFile));
+
+                    /* delete crxFile */
+                    remove(LocalFile(crxFile).c_str());
+                }
             }
-        }
+        });
     }
     else  /* the option of full path of site list file is selected */
     {
@@ -2924,62 +3112,66 @@ void FtpUtil::GetDailyObsEpn(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 return;
             }
 
+            /* the sites are processed in parallel, and the messages are printed in the order of 'site.list' */
+            vector<string> sitNames;
             string sitName;
-            while (getline(sitLst, sitName))
+            while (getline(sitLst, sitName)) sitNames.push_back(sitName);
+            ThreadUtil thr;
+            thr.RunOrdered((int)sitNames.size(), GetMaxParallel("EPN", fopt), [&](int k, ostringstream &log)
             {
+                string sitName = sitNames[k];
                 str.ToLower(sitName);
                 string oFile = sitName + sDoy + "0." + sYy + "o";
                 string dFile = sitName + sDoy + "0." + sYy + "d";
-                if (access(oFile.c_str(), 0) == -1)
+                if (access(ObsFile(oFile).c_str(), 0) == -1)
                 {
                     /* it is OK for '*.gz' format */
                     str.ToUpper(sitName);
                     string crxFile = sitName + "*" + sYyyy + sDoy + "0000_01D_30S_MO.crx";
                     string crxgzFile = crxFile + ".gz";
-                    string cmd = wgetFull + " " + qr + " -nH -A " + crxgzFile + cutDirs + url;
-                    std::system(cmd.c_str());
+                    vector<string> localFiles;
+                    _curl.GetFiles(url, crxgzFile, _workDir, &localFiles);
+                    string cmd;
 
-                    /* extract '*.gz' */
-                    cmd = gzipFull + " -d -f " + crxgzFile;
-                    std::system(cmd.c_str());
-                    string changeFileName;
+                    /* the 'crx' file has been converted to the 'o' file while it was received */
+                    if (localFiles.empty() || !RenameRnx(localFiles[0], oFile))
+                    {
+                        /* extract '*.gz' */
+                        _zip.Decompress(LocalFile(crxgzFile));
+                        string changeFileName;
 #ifdef _WIN32  /* for Windows */
-                    changeFileName = "rename";
+                        changeFileName = "move /y";
 #else          /* for Linux or Mac */
-                    changeFileName = "mv";
+                        changeFileName = "mv";
 #endif
-                    cmd = changeFileName + " " + crxFile + " " + dFile;
-                    std::system(cmd.c_str());
-                    if (access(dFile.c_str(), 0) == -1)
-                    {
-                        cout << "*** WARNING(FtpUtil::GetDailyObsEpn): failed to download EPN daily observation file " << oFile << endl;
+                        cmd = changeFileName + " " + LocalFile(crxFile) + " " + LocalFile(dFile);
+                        std::system(cmd.c_str());
+                        if (access(LocalFile(dFile).c_str(), 0) == -1)
+                        {
+                            log << "*** WARNING(FtpUtil::GetDailyObsEpn): failed to download EPN daily observation file " << oFile << endl;
 
-                        continue;
-                    }
+                            return;
+                        }
 
-#ifdef _WIN32  /* for Windows */
-                    cmd = crx2rnxFull + " " + dFile + " -f - > " + oFile;
-#else          /* for Linux or Mac */
-                    cmd = "cat " + dFile + " | " + crx2rnxFull + " -f - > " + oFile;
-#endif
-                    std::system(cmd.c_str());
+                        _crx.Crx2Rnx(LocalFile(dFile), ObsFile(oFile));
+                    }
 
-                    if (access(oFile.c_str(), 0) == 0)
+                    if (access(ObsFile(oFile).c_str(), 0) == 0)
                     {
-                        cout << "*** INFO(FtpUtil::GetDailyObsEpn): successfully download EPN daily observation file " << oFile << endl;
+                        log << "*** INFO(FtpUtil::GetDailyObsEpn): successfully download EPN daily observation file " << oFile << endl;
 
                         /* delete 'd' file */
 #ifdef _WIN32   /* for Windows */
-                        cmd = "del " + dFile;
+                        cmd = "del " + LocalFile(dFile);
 #else           /* for Linux or Mac */
-                        cmd = "rm -rf " + dFile;
+                        cmd = "rm -rf " + LocalFile(dFile);
 #endif
                         std::system(cmd.c_str());
                     }
                 }
-                else cout << "*** INFO(FtpUtil::GetDailyObsEpn): EPN daily observation file " << oFile <<
+                else log << "*** INFO(FtpUtil::GetDailyObsEpn): EPN daily observation file " << oFile <<
                     " has existed!" << endl;
-            }
+            });
 
             /* close 'site.list' */
             sitLst.close();
@@ -3008,12 +3200,13 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
 
-    string ftpName = fopt->ftpFrom;
-    str.ToUpper(ftpName);
     string nTyp(fopt->navTyp);
     str.ToLower(nTyp);
     string nOpt(fopt->navOpt);
     str.ToLower(nOpt);
+    /* the hourly files are not in WHU */
+    string ftpName = SelectArchive(IDX_NAV, nTyp == "hourly" ? ARC_CDDIS | ARC_IGN : ARC_ALL, fopt);
+    str.ToUpper(ftpName);
     if (nTyp == "daily")
     {
         /* creation of sub-directory ('daily') */
@@ -3021,7 +3214,7 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         char sep = (char)FILEPATHSEP;
         sprintf(tmpDir, "%s%c%s", dir, sep, "daily");
         string subDir = tmpDir;
-        if (access(subDir.c_str(), 0) == -1)
+        if (!_dryRun && access(subDir.c_str(), 0) == -1)
         {
             /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -3032,12 +3225,8 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             std::system(cmd.c_str());
         }
 
-        /* change directory */
-#ifdef _WIN32   /* for Windows */
-        _chdir(subDir.c_str());
-#else           /* for Linux or Mac */
-        chdir(subDir.c_str());
-#endif
+        /* the local files are in the directory */
+        _workDir = subDir;
 
         string navFile, nav0File;
         if (nOpt == "gps")
@@ -3060,20 +3249,14 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             nav0File = "brdm" + sDoy + "0." + sYy + "p";
         }
 
-        if (access(navFile.c_str(), 0) == -1 && access(nav0File.c_str(), 0) == -1)
+        if (access(LocalFile(navFile).c_str(), 0) == -1 && access(LocalFile(nav0File).c_str(), 0) == -1)
         {
-            string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
-            string url, cutDirs = " --cut-dirs=6 ";
+            string url;
             if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_NAV] + "/" +
                 sYyyy + "/brdc";
-            else if (ftpName == "IGN")
-            {
-                url = _ftpArchive.IGN[IDX_NAV] + "/" + sYyyy + "/" + sDoy;
-                cutDirs = " --cut-dirs=5 ";
-            }
+            else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_NAV] + "/" + sYyyy + "/" + sDoy;
             else if (ftpName == "WHU")
             {
-                cutDirs = " --cut-dirs=7 ";
                 if (yyyy >= 2020) url = _ftpArchive.WHU[IDX_NAV] + "/" + sYyyy + "/brdc";
                 else
                 {
@@ -3086,38 +3269,36 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
             /* it is OK for '*.Z' or '*.gz' format */
             string navxFile = navFile + ".*";
-            string cmd = wgetFull + " " + qr + " -nH -A " + navxFile + cutDirs + url;
-            std::system(cmd.c_str());
+            _curl.GetFiles(url, navxFile, _workDir);
+            string cmd;
 
             string navgzFile = navFile + ".gz", navzFile = navFile + ".Z";
-            if (access(navgzFile.c_str(), 0) == 0)
+            if (access(LocalFile(navgzFile).c_str(), 0) == 0)
             {
                 /* extract '*.gz' */
-                cmd = gzipFull + " -d -f " + navgzFile;
-                std::system(cmd.c_str());
+                _zip.Decompress(LocalFile(navgzFile));
             }
-            else if (access(navzFile.c_str(), 0) == 0)
+            else if (access(LocalFile(navzFile).c_str(), 0) == 0)
             {
                 /* extract '*.Z' */
-                cmd = gzipFull + " -d -f " + navzFile;
-                std::system(cmd.c_str());
+                _zip.Decompress(LocalFile(navzFile));
             }
-            if (access(navFile.c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetNav): failed to download broadcast ephemeris file " <<
+            if (access(LocalFile(navFile).c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetNav): failed to download broadcast ephemeris file " <<
                 nav0File << endl;
 
             if (nOpt == "mixed")
             {
                 string changeFileName;
 #ifdef _WIN32  /* for Windows */
-                changeFileName = "rename";
+                changeFileName = "move /y";
 #else          /* for Linux or Mac */
                 changeFileName = "mv";
 #endif
-                cmd = changeFileName + " " + navFile + " " + nav0File;
+                cmd = changeFileName + " " + LocalFile(navFile) + " " + LocalFile(nav0File);
                 std::system(cmd.c_str());
             }
 
-            if (access(nav0File.c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetNav): successfully download broadcast ephemeris file " << nav0File << endl;
+            if (access(LocalFile(nav0File).c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetNav): successfully download broadcast ephemeris file " << nav0File << endl;
         }
         else cout << "*** INFO(FtpUtil::GetNav): broadcast ephemeris file " << nav0File << " or " <<
             navFile << " has existed!" << endl;
@@ -3129,7 +3310,7 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         char sep = (char)FILEPATHSEP;
         sprintf(tmpDir, "%s%c%s", dir, sep, "hourly");
         string subDir = tmpDir;
-        if (access(subDir.c_str(), 0) == -1)
+        if (!_dryRun && access(subDir.c_str(), 0) == -1)
         {
             /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -3164,7 +3345,7 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     char sep = (char)FILEPATHSEP;
                     sprintf(tmpDir, "%s%c%s", subDir.c_str(), sep, sHh.c_str());
                     string sHhDir = tmpDir;
-                    if (access(sHhDir.c_str(), 0) == -1)
+                    if (!_dryRun && access(sHhDir.c_str(), 0) == -1)
                     {
                         /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -3175,12 +3356,8 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                         std::system(cmd.c_str());
                     }
 
-                    /* change directory */
-#ifdef _WIN32   /* for Windows */
-                    _chdir(sHhDir.c_str());
-#else           /* for Linux or Mac */
-                    chdir(sHhDir.c_str());
-#endif
+                    /* the local files are in the directory */
+                    _workDir = sHhDir;
 
                     /* 'a' = 97, 'b' = 98, ... */
                     int ii = fopt->hhNav[i] + 97;
@@ -3269,44 +3446,37 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                     
                     for (int i = 0; i < navFiles.size(); i++)
                     {
-                        string url, cutDirs = " --cut-dirs=7 ";
+                        string url;
                         if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_OBMH] + "/" +
                             sYyyy + "/" + sDoy + "/" + sHh;
-                        else if (ftpName == "IGN")
-                        {
-                            url = _ftpArchive.IGN[IDX_OBMH] + "/" + sYyyy + "/" + sDoy;
-                            cutDirs = " --cut-dirs=6 ";
-                        }
+                        else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_OBMH] + "/" + sYyyy + "/" + sDoy;
                         else url = _ftpArchive.CDDIS[IDX_OBMH] + "/" + sYyyy + "/" + sDoy + "/" + sHh;
 
                         /* it is OK for '*.Z' or '*.gz' format */
-                        string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
                         string navxFile = navFiles[i] + ".*";
-                        string cmd = wgetFull + " " + qr + " -nH -A " + navxFile + cutDirs + url;
-                        std::system(cmd.c_str());
+                        _curl.GetFiles(url, navxFile, _workDir);
+                        string cmd;
 
                         /* extract '*.gz' */
                         string navgzFile = navFiles[i] + ".gz";
-                        cmd = gzipFull + " -d -f " + navgzFile;
-                        std::system(cmd.c_str());
+                        _zip.Decompress(LocalFile(navgzFile));
                         string changeFileName;
 #ifdef _WIN32  /* for Windows */
-                        changeFileName = "rename";
+                        changeFileName = "move /y";
 #else          /* for Linux or Mac */
                         changeFileName = "mv";
 #endif
-                        cmd = changeFileName + " " + navFiles[i] + " " + nav0Files[i];
+                        cmd = changeFileName + " " + LocalFile(navFiles[i]) + " " + LocalFile(nav0Files[i]);
                         std::system(cmd.c_str());
-                        if (access(nav0Files[i].c_str(), 0) == -1)
+                        if (access(LocalFile(nav0Files[i]).c_str(), 0) == -1)
                         {
                             /* extract '*.Z' */
                             string navzFile = navFiles[i] + ".Z";
-                            cmd = gzipFull + " -d -f " + navzFile;
-                            std::system(cmd.c_str());
+                            _zip.Decompress(LocalFile(navzFile));
 
-                            cmd = changeFileName + " " + navFiles[i] + " " + nav0Files[i];
+                            cmd = changeFileName + " " + LocalFile(navFiles[i]) + " " + LocalFile(nav0Files[i]);
                             std::system(cmd.c_str());
-                            if (access(nav0Files[i].c_str(), 0) == -1)
+                            if (access(LocalFile(nav0Files[i]).c_str(), 0) == -1)
                             {
                                 cout << "*** WARNING(FtpUtil::GetNav): failed to download hourly broadcast ephemeris file " << 
                                     navFiles[i] << endl;
@@ -3341,7 +3511,7 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         char sep = (char)FILEPATHSEP;
         sprintf(tmpDir, "%s%c%s", dir, sep, "daily");
         string subDir = tmpDir;
-        if (access(subDir.c_str(), 0) == -1)
+        if (!_dryRun && access(subDir.c_str(), 0) == -1)
         {
             /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
@@ -3352,42 +3522,34 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             std::system(cmd.c_str());
         }
 
-        /* change directory */
-#ifdef _WIN32   /* for Windows */
-        _chdir(subDir.c_str());
-#else           /* for Linux or Mac */
-        chdir(subDir.c_str());
-#endif
+        /* the local files are in the directory */
+        _workDir = subDir;
 
         string navFile = "brdm" + sDoy + "z." + sYy + "p";
-        if (access(navFile.c_str(), 0) == -1)
+        if (access(LocalFile(navFile).c_str(), 0) == -1)
         {
             /* download brdmDDDz.YYp.Z file */
-            string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
             string url = "ftp://ftp.lrz.de/transfer/steigenb/brdm";
 
             /* it is OK for '*.Z' or '*.gz' format */
             string navxFile = navFile + ".*";
-            string cmd = wgetFull + " " + qr + " -nH -A " + navxFile + " --cut-dirs=3 " + url;
-            std::system(cmd.c_str());
+            _curl.GetFiles(url, navxFile, _workDir);
 
             string navgzFile = navFile + ".gz", navzFile = navFile + ".Z";
-            if (access(navgzFile.c_str(), 0) == 0)
+            if (access(LocalFile(navgzFile).c_str(), 0) == 0)
             {
                 /* extract '*.gz' */
-                cmd = gzipFull + " -d -f " + navgzFile;
-                std::system(cmd.c_str());
+                _zip.Decompress(LocalFile(navgzFile));
             }
-            else if (access(navzFile.c_str(), 0) == 0)
+            else if (access(LocalFile(navzFile).c_str(), 0) == 0)
             {
                 /* extract '*.Z' */
-                cmd = gzipFull + " -d -f " + navzFile;
-                std::system(cmd.c_str());
+                _zip.Decompress(LocalFile(navzFile));
             }
 
-            if (access(navFile.c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetNav): failed to download real-time broadcast ephemeris file " <<
+            if (access(LocalFile(navFile).c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetNav): failed to download real-time broadcast ephemeris file " <<
                 navFile << endl;
-            else if (access(navFile.c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetNav): successfully download real-time broadcast ephemeris file " <<
+            else if (access(LocalFile(navFile).c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetNav): successfully download real-time broadcast ephemeris file " <<
                 navFile << endl;
         }
         else cout << "*** INFO(FtpUtil::GetNav): real-time broadcast ephemeris file " << navFile <<
@@ -3407,12 +3569,8 @@ void FtpUtil::GetNav(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 **/
 void FtpUtil::GetOrbClk(gtime_t ts, const char dir[], int mode, const ftpopt_t *fopt)
 {
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(dir);
-#else           /* for Linux or Mac */
-    chdir(dir);
-#endif
+    /* the local files are in the directory */
+    _workDir = dir;
 
     /* compute GPS week and day of week */
     TimeUtil tu;
@@ -3482,22 +3640,19 @@ void FtpUtil::GetOrbClk(gtime_t ts, const char dir[], int mode, const ftpopt_t *
         if (ac == acMGEX[i]) isMGEX = true;
     }
 
-    string ftpName = fopt->ftpFrom;
+    string ftpName = SelectArchive(IDX_SP3, ARC_ALL, fopt);
     str.ToUpper(ftpName);
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
     if (isUltra)  /* for ultra-rapid orbit and clock products  */
     {
-        string url, cutDirs, acName;
+        string url, acName;
         if (ac == "esu")       /* ESA */
         {
             url = "http://navigation-office.esa.int/products/gnss-products/" + sWwww;
-            cutDirs = " --cut-dirs=3 ";
             acName = "ESA";
         }
         else if (ac == "gfu")  /* GFZ */
         {
             url = "ftp://ftp.gfz-potsdam.de/pub/GNSS/products/ultra/w" + sWwww;
-            cutDirs = " --cut-dirs=5 ";
             acName = "GFZ";
         }
         else if (ac == "igu")  /* IGS */
@@ -3506,7 +3661,6 @@ void FtpUtil::GetOrbClk(gtime_t ts, const char dir[], int mode, const ftpopt_t *
             else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_SP3] + "/" + sWwww;
             else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_SP3] + "/" + sWwww;
             else url = _ftpArchive.CDDIS[IDX_SP3] + "/" + sWwww;
-            cutDirs = " --cut-dirs=4 ";
             acName = "IGS";
         }
         else if (ac == "wuu")  /* WHU */
@@ -3515,7 +3669,6 @@ void FtpUtil::GetOrbClk(gtime_t ts, const char dir[], int mode, const ftpopt_t *
             else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_SP3M] + "/" + sWwww;
             else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_SP3M] + "/" + sWwww;
             else url = _ftpArchive.CDDIS[IDX_SP3M] + "/" + sWwww;
-            cutDirs = " --cut-dirs=5 ";
             acName = "WHU";
         }
             
@@ -3523,34 +3676,24 @@ void FtpUtil::GetOrbClk(gtime_t ts, const char dir[], int mode, const ftpopt_t *
         {
             string sHh = str.hh2str(fopt->hhOrbClk[i]);
             string sp3File = ac + sWwww + sDow + "_" + sHh + ".sp3";
-            if (access(sp3File.c_str(), 0) == -1)
+            if (access(LocalFile(sp3File).c_str(), 0) == -1)
             {
                 string cmd;
                 if (ac == "esu")  /* ESA */
                 {
                     string sp3zFile = sp3File + ".Z";
-                    string url0 = url + "/" + sp3zFile;
-                    cmd = wgetFull + " " + qr + " -nH " + cutDirs + url0;
-                    std::system(cmd.c_str());
-
-                    if (access(sp3zFile.c_str(), 0) == 0)
+                    if (_curl.GetFile(url + "/" + sp3zFile, LocalFile(sp3zFile)) == XFER_OK)
                     {
                         /* extract '*.Z' */
-                        cmd = gzipFull + " -d -f " + sp3zFile;
-                        std::system(cmd.c_str());
+                        _zip.Decompress(LocalFile(sp3zFile));
                     }
                     else
                     {
                         string sp3gzFile = sp3File + ".gz";
-                        string url0 = url + "/" + sp3gzFile;
-                        cmd = wgetFull + " " + qr + " -nH " + cutDirs + url0;
-                        std::system(cmd.c_str());
-
-                        if (access(sp3gzFile.c_str(), 0) == 0)
+                        if (_curl.GetFile(url + "/" + sp3gzFile, LocalFile(sp3gzFile)) == XFER_OK)
                         {
                             /* extract '*.gz' */
-                            cmd = gzipFull + " -d -f " + sp3gzFile;
-                            std::system(cmd.c_str());
+                            _zip.Decompress(LocalFile(sp3gzFile));
                         }
                     }
                 }
@@ -3559,30 +3702,27 @@ void FtpUtil::GetOrbClk(gtime_t ts, const char dir[], int mode, const ftpopt_t *
                     string sp30File = "WUM0MGXULA_" + sYyyy + sDoy + sHh + "00_01D_*_ORB.SP3";
                     /* it is OK for '*.Z' or '*.gz' format */
                     string sp3xFile = sp30File + ".*";
-                    string cmd = wgetFull + " " + qr + " -nH -A " + sp3xFile + cutDirs + url;
-                    std::system(cmd.c_str());
+                    _curl.GetFiles(url, sp3xFile, _workDir);
 
                     /* extract '*.gz' */
                     string sp3gzFile = sp30File + ".gz";
-                    cmd = gzipFull + " -d -f " + sp3gzFile;
-                    std::system(cmd.c_str());
+                    _zip.Decompress(LocalFile(sp3gzFile));
                     string changeFileName;
 #ifdef _WIN32  /* for Windows */
-                    changeFileName = "rename";
+                    changeFileName = "move /y";
 #else          /* for Linux or Mac */
                     changeFileName = "mv";
 #endif
                     string sp3File = ac + sWwww + sDow + "_" + sHh + ".sp3";
-                    cmd = changeFileName + " " + sp30File + " " + sp3File;
+                    cmd = changeFileName + " " + LocalFile(sp30File) + " " + LocalFile(sp3File);
                     std::system(cmd.c_str());
-                    if (access(sp3File.c_str(), 0) == -1)
+                    if (access(LocalFile(sp3File).c_str(), 0) == -1)
                     {
                         /* extract '*.Z' */
                         string sp3zFile = sp30File + ".Z";
-                        cmd = gzipFull + " -d -f " + sp3zFile;
-                        std::system(cmd.c_str());
+                        _zip.Decompress(LocalFile(sp3zFile));
 
-                        cmd = changeFileName + " " + sp30File + " " + sp3File;
+                        cmd = changeFileName + " " + LocalFile(sp30File) + " " + LocalFile(sp3File);
                         std::system(cmd.c_str());
                     }
                 }
@@ -3590,39 +3730,36 @@ void FtpUtil::GetOrbClk(gtime_t ts, const char dir[], int mode, const ftpopt_t *
                 {
                     /* it is OK for '*.Z' or '*.gz' format */
                     string sp3xFile = sp3File + ".*";
-                    string cmd = wgetFull + " " + qr + " -nH -A " + sp3xFile + cutDirs + url;
-                    std::system(cmd.c_str());
+                    _curl.GetFiles(url, sp3xFile, _workDir);
 
                     string sp3gzFile = sp3File + ".gz", sp3zFile = sp3File + ".Z";
-                    if (access(sp3gzFile.c_str(), 0) == 0)
+                    if (access(LocalFile(sp3gzFile).c_str(), 0) == 0)
                     {
                         /* extract '*.gz' */
-                        cmd = gzipFull + " -d -f " + sp3gzFile;
-                        std::system(cmd.c_str());
+                        _zip.Decompress(LocalFile(sp3gzFile));
                     }
-                    if (access(sp3File.c_str(), 0) == -1 && access(sp3zFile.c_str(), 0) == 0)
+                    if (access(LocalFile(sp3File).c_str(), 0) == -1 && access(LocalFile(sp3zFile).c_str(), 0) == 0)
                     {
                         /* extract '*.Z' */
-                        cmd = gzipFull + " -d -f " + sp3zFile;
-                        std::system(cmd.c_str());
+                        _zip.Decompress(LocalFile(sp3zFile));
                     }
                 }
 
-                if (access(sp3File.c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetOrbClk): failed to download " << acName << " ultra-rapid orbit file " <<
+                if (access(LocalFile(sp3File).c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetOrbClk): failed to download " << acName << " ultra-rapid orbit file " <<
                     sp3File << endl;
-                else if (access(sp3File.c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetOrbClk): successfully download " << acName << " ultra-rapid orbit file " <<
+                else if (access(LocalFile(sp3File).c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetOrbClk): successfully download " << acName << " ultra-rapid orbit file " <<
                     sp3File << endl;
 
                 if (ac == "igu")
                 {
                     /* delete some temporary directories */
                     string tmpDir = "repro3";
-                    if (access(tmpDir.c_str(), 0) == 0)
+                    if (access(LocalFile(tmpDir).c_str(), 0) == 0)
                     {
 #ifdef _WIN32  /* for Windows */
-                        cmd = "rd /s /q " + tmpDir;
+                        cmd = "rd /s /q " + LocalFile(tmpDir);
 #else          /* for Linux or Mac */
-                        cmd = "rm -rf " + tmpDir;
+                        cmd = "rm -rf " + LocalFile(tmpDir);
 #endif
                         std::system(cmd.c_str());
                     }
@@ -3634,7 +3771,7 @@ void FtpUtil::GetOrbClk(gtime_t ts, const char dir[], int mode, const ftpopt_t *
     }
     else if (isRapid)  /* for rapid orbit and clock products  */
     {
-        string url, cutDirs, acName;
+        string url, acName;
         string sp3File = ac + sWwww + sDow + ".sp3";
         string clkFile = ac + sWwww + sDow + ".clk";
         if (ac == "cor")  /* CODE */
@@ -3642,7 +3779,6 @@ void FtpUtil::GetOrbClk(gtime_t ts, const char dir[], int mode, const ftpopt_t *
             sp3File = "COD" + sWwww + sDow + ".EPH_M";
             clkFile = "COD" + sWwww + sDow + ".CLK_M";
             url = "ftp://ftp.aiub.unibe.ch/CODE/" + sYyyy + "_M";
-            cutDirs = " --cut-dirs=2 ";
             acName = "CODE";
         }
         else if (ac == "emp")  /* NRCan */
@@ -3650,13 +3786,11 @@ void FtpUtil::GetOrbClk(gtime_t ts, const char dir[], int mode, const ftpopt_t *
             sp3File = "emr" + sWwww + sDow + ".sp3";
             clkFile = "emr" + sWwww + sDow + ".clk";
             url = "ftp://rtopsdata1.geod.nrcan.gc.ca/gps/products/rapid/" + sWwww;
-            cutDirs = " --cut-dirs=4 ";
             acName = "NRCan";
         }
         else if (ac == "esr")  /* ESA */
         {
             url = "http://navigation-office.esa.int/products/gnss-products/" + sWwww;
-            cutDirs = " --cut-dirs=3 ";
             acName = "ESA";
         }
         else if (ac == "gfr")  /* GFZ */
@@ -3664,7 +3798,6 @@ void FtpUtil::GetOrbClk(gtime_t ts, const char dir[], int mode, const ftpopt_t *
             sp3File = "gfz" + sWwww + sDow + ".sp3";
             clkFile = "gfz" + sWwww + sDow + ".clk";
             url = "ftp://ftp.gfz-potsdam.de/pub/GNSS/products/rapid/w" + sWwww;
-            cutDirs = " --cut-dirs=5 ";
             acName = "GFZ";
         }
         else if (ac == "igr")  /* IGS */
@@ -3673,40 +3806,29 @@ void FtpUtil::GetOrbClk(gtime_t ts, const char dir[], int mode, const ftpopt_t *
             else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_SP3] + "/" + sWwww;
             else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_SP3] + "/" + sWwww;
             else url = _ftpArchive.CDDIS[IDX_SP3] + "/" + sWwww;
-            cutDirs = " --cut-dirs=4 ";
             acName = "IGS";
         }
 
         if (mode == 1)       /* SP3 file downloaded */
         {
-            if (access(sp3File.c_str(), 0) == -1)
+            if (access(LocalFile(sp3File).c_str(), 0) == -1)
             {
                 string cmd;
                 if (ac == "esr")  /* ESA */
                 {
                     string sp3zFile = sp3File + ".Z";
-                    string url0 = url + "/" + sp3zFile;
-                    cmd = wgetFull + " " + qr + " -nH " + cutDirs + url0;
-                    std::system(cmd.c_str());
-
-                    if (access(sp3zFile.c_str(), 0) == 0)
+                    if (_curl.GetFile(url + "/" + sp3zFile, LocalFile(sp3zFile)) == XFER_OK)
                     {
                         /* extract '*.Z' */
-                        cmd = gzipFull + " -d -f " + sp3zFile;
-                        std::system(cmd.c_str());
+                        _zip.Decompress(LocalFile(sp3zFile));
                     }
                     else
                     {
                         string sp3gzFile = sp3File + ".gz";
-                        string url0 = url + "/" + sp3gzFile;
-                        cmd = wgetFull + " " + qr + " -nH " + cutDirs + url0;
-                        std::system(cmd.c_str());
-
-                        if (access(sp3gzFile.c_str(), 0) == 0)
+                        if (_curl.GetFile(url + "/" + sp3gzFile, LocalFile(sp3gzFile)) == XFER_OK)
                         {
                             /* extract '*.gz' */
-                            cmd = gzipFull + " -d -f " + sp3gzFile;
-                            std::system(cmd.c_str());
+                            _zip.Decompress(LocalFile(sp3gzFile));
                         }
                     }
                 }
@@ -3714,38 +3836,35 @@ void FtpUtil::GetOrbClk(gtime_t ts, const char dir[], int mode, const ftpopt_t *
                 {
                     /* it is OK for '*.Z' or '*.gz' format */
                     string sp3xFile = sp3File + ".*";
-                    cmd = wgetFull + " " + qr + " -nH -A " + sp3xFile + cutDirs + url;
-                    std::system(cmd.c_str());
+                    _curl.GetFiles(url, sp3xFile, _workDir);
 
                     string sp3gzFile = sp3File + ".gz", sp3zFile = sp3File + ".Z";
-                    if (access(sp3gzFile.c_str(), 0) == 0)
+                    if (access(LocalFile(sp3gzFile).c_str(), 0) == 0)
                     {
                         /* extract '*.gz' */
-                        cmd = gzipFull + " -d -f " + sp3gzFile;
-                        std::system(cmd.c_str());
+                        _zip.Decompress(LocalFile(sp3gzFile));
 
-                        if (access(sp3File.c_str(), 0) == 0 && access(sp3zFile.c_str(), 0) == 0)
+                        if (access(LocalFile(sp3File).c_str(), 0) == 0 && access(LocalFile(sp3zFile).c_str(), 0) == 0)
                         {
                             /* delete '*.Z' file */
 #ifdef _WIN32   /* for Windows */
-                            cmd = "del " + sp3zFile;
+                            cmd = "del " + LocalFile(sp3zFile);
 #else           /* for Linux or Mac */
-                            cmd = "rm -rf " + sp3zFile;
+                            cmd = "rm -rf " + LocalFile(sp3zFile);
 #endif
                             std::system(cmd.c_str());
                         }
                     }
-                    if (access(sp3File.c_str(), 0) == -1 && access(sp3zFile.c_str(), 0) == 0)
+                    if (access(LocalFile(sp3File).c_str(), 0) == -1 && access(LocalFile(sp3zFile).c_str(), 0) == 0)
                     {
                         /* extract '*.Z' */
-                        cmd = gzipFull + " -d -f " + sp3zFile;
-                        std::system(cmd.c_str());
+                        _zip.Decompress(LocalFile(sp3zFile));
                     }
                 }
 
-                if (access(sp3File.c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetOrbClk): failed to download " << acName << " rapid orbit file " <<
+                if (access(LocalFile(sp3File).c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetOrbClk): failed to download " << acName << " rapid orbit file " <<
                     sp3File << endl;
-                else if (access(sp3File.c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetOrbClk): successfully download " << acName << " rapid orbit file " <<
+                else if (access(LocalFile(sp3File).c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetOrbClk): successfully download " << acName << " rapid orbit file " <<
                     sp3File << endl;
 
                 if (ac == "emp" || ac == "igr")
@@ -3754,12 +3873,12 @@ void FtpUtil::GetOrbClk(gtime_t ts, const char dir[], int mode, const ftpopt_t *
                     string tmpDir;
                     if (ac == "emp") tmpDir = "dcm";
                     else if (ac == "igr") tmpDir = "repro3";
-                    if (access(tmpDir.c_str(), 0) == 0)
+                    if (access(LocalFile(tmpDir).c_str(), 0) == 0)
                     {
 #ifdef _WIN32  /* for Windows */
-                        cmd = "rd /s /q " + tmpDir;
+                        cmd = "rd /s /q " + LocalFile(tmpDir);
 #else          /* for Linux or Mac */
-                        cmd = "rm -rf " + tmpDir;
+                        cmd = "rm -rf " + LocalFile(tmpDir);
 #endif
                         std::system(cmd.c_str());
                     }
@@ -3770,34 +3889,24 @@ void FtpUtil::GetOrbClk(gtime_t ts, const char dir[], int mode, const ftpopt_t *
         }
         else if (mode == 2)  /* CLK file downloaded */
         {
-            if (access(clkFile.c_str(), 0) == -1)
+            if (access(LocalFile(clkFile).c_str(), 0) == -1)
             {
                 string cmd;
                 if (ac == "esr")  /* ESA */
                 {
                     string clkzFile = clkFile + ".Z";
-                    url += "/" + clkzFile;
-                    cmd = wgetFull + " " + qr + " -nH " + cutDirs + url;
-                    std::system(cmd.c_str());
-
-                    if (access(clkzFile.c_str(), 0) == 0)
+                    if (_curl.GetFile(url + "/" + clkzFile, LocalFile(clkzFile)) == XFER_OK)
                     {
                         /* extract '*.Z' */
-                        cmd = gzipFull + " -d -f " + clkzFile;
-                        std::system(cmd.c_str());
+                        _zip.Decompress(LocalFile(clkzFile));
                     }
                     else
                     {
                         string clkgzFile = clkFile + ".gz";
-                        url += "/" + clkgzFile;
-                        cmd = wgetFull + " " + qr + " -nH " + cutDirs + url;
-                        std::system(cmd.c_str());
-
-                        if (access(clkgzFile.c_str(), 0) == 0)
+                        if (_curl.GetFile(url + "/" + clkgzFile, LocalFile(clkgzFile)) == XFER_OK)
                         {
                             /* extract '*.gz' */
-                            cmd = gzipFull + " -d -f " + clkgzFile;
-                            std::system(cmd.c_str());
+                            _zip.Decompress(LocalFile(clkgzFile));
                         }
                     }
                 }
@@ -3805,38 +3914,35 @@ void FtpUtil::GetOrbClk(gtime_t ts, const char dir[], int mode, const ftpopt_t *
                 {
                     /* it is OK for '*.Z' or '*.gz' format */
                     string clkxFile = clkFile + ".*";
-                    string cmd = wgetFull + " " + qr + " -nH -A " + clkxFile + cutDirs + url;
-                    std::system(cmd.c_str());
+                    _curl.GetFiles(url, clkxFile, _workDir);
 
                     string clkgzFile = clkFile + ".gz", clkzFile = clkFile + ".Z";
-                    if (access(clkgzFile.c_str(), 0) == 0)
+                    if (access(LocalFile(clkgzFile).c_str(), 0) == 0)
                     {
                         /* extract '*.gz' */
-                        cmd = gzipFull + " -d -f " + clkgzFile;
-                        std::system(cmd.c_str());
+                        _zip.Decompress(LocalFile(clkgzFile));
 
-                        if (access(clkFile.c_str(), 0) == 0 && access(clkzFile.c_str(), 0) == 0)
+                        if (access(LocalFile(clkFile).c_str(), 0) == 0 && access(LocalFile(clkzFile).c_str(), 0) == 0)
                         {
                             /* delete '*.Z' file */
 #ifdef _WIN32   /* for Windows */
-                            cmd = "del " + clkzFile;
+                            cmd = "del " + LocalFile(clkzFile);
 #else           /* for Linux or Mac */
-                            cmd = "rm -rf " + clkzFile;
+                            cmd = "rm -rf " + LocalFile(clkzFile);
 #endif
                             std::system(cmd.c_str());
                         }
                     }
-                    if (access(clkFile.c_str(), 0) == -1 && access(clkzFile.c_str(), 0) == 0)
+                    if (access(LocalFile(clkFile).c_str(), 0) == -1 && access(LocalFile(clkzFile).c_str(), 0) == 0)
                     {
                         /* extract '*.Z' */
-                        cmd = gzipFull + " -d -f " + clkzFile;
-                        std::system(cmd.c_str());
+                        _zip.Decompress(LocalFile(clkzFile));
                     }
                 }
 
-                if (access(clkFile.c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetOrbClk): failed to download " << acName << " rapid clock file " <<
+                if (access(LocalFile(clkFile).c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetOrbClk): failed to download " << acName << " rapid clock file " <<
                     clkFile << endl;
-                else if (access(clkFile.c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetOrbClk): successfully download " << acName << " rapid clock file " <<
+                else if (access(LocalFile(clkFile).c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetOrbClk): successfully download " << acName << " rapid clock file " <<
                     clkFile << endl;
 
                 if (ac == "emp" || ac == "igr")
@@ -3845,12 +3951,12 @@ void FtpUtil::GetOrbClk(gtime_t ts, const char dir[], int mode, const ftpopt_t *
                     string tmpDir;
                     if (ac == "emp") tmpDir = "dcm";
                     else if (ac == "igr") tmpDir = "repro3";
-                    if (access(tmpDir.c_str(), 0) == 0)
+                    if (access(LocalFile(tmpDir).c_str(), 0) == 0)
                     {
 #ifdef _WIN32  /* for Windows */
-                        cmd = "rd /s /q " + tmpDir;
+                        cmd = "rd /s /q " + LocalFile(tmpDir);
 #else          /* for Linux or Mac */
-                        cmd = "rm -rf " + tmpDir;
+                        cmd = "rm -rf " + LocalFile(tmpDir);
 #endif
                         std::system(cmd.c_str());
                     }
@@ -3883,47 +3989,45 @@ void FtpUtil::GetOrbClk(gtime_t ts, const char dir[], int mode, const ftpopt_t *
         else if (ac == "grg") acName = "CNES";
         else if (ac == "jpl") acName = "JPL";
 
-        string url, cutDirs = " --cut-dirs=4 ";
+        string url;
         if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_SP3] + "/" + sWwww;
         else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_SP3] + "/" + sWwww;
         else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_SP3] + "/" + sWwww;
         else url = _ftpArchive.CDDIS[IDX_SP3] + "/" + sWwww;
         if (mode == 1)       /* SP3 file downloaded */
         {
-            if (access(sp3File.c_str(), 0) == -1)
+            if (access(LocalFile(sp3File).c_str(), 0) == -1)
             {
                 /* it is OK for '*.Z' or '*.gz' format */
                 string sp3xFile = sp3File + ".*";
-                string cmd = wgetFull + " " + qr + " -nH -A " + sp3xFile + cutDirs + url;
-                std::system(cmd.c_str());
+                _curl.GetFiles(url, sp3xFile, _workDir);
+                string cmd;
 
                 string sp3gzFile = sp3File + ".gz", sp3zFile = sp3File + ".Z";
-                if (access(sp3gzFile.c_str(), 0) == 0)
+                if (access(LocalFile(sp3gzFile).c_str(), 0) == 0)
                 {
                     /* extract '*.gz' */
-                    cmd = gzipFull + " -d -f " + sp3gzFile;
-                    std::system(cmd.c_str());
+                    _zip.Decompress(LocalFile(sp3gzFile));
                 }
-                if (access(sp3File.c_str(), 0) == -1 && access(sp3zFile.c_str(), 0) == 0)
+                if (access(LocalFile(sp3File).c_str(), 0) == -1 && access(LocalFile(sp3zFile).c_str(), 0) == 0)
                 {
                     /* extract '*.Z' */
-                    cmd = gzipFull + " -d -f " + sp3zFile;
-                    std::system(cmd.c_str());
+                    _zip.Decompress(LocalFile(sp3zFile));
                 }
 
-                if (access(sp3File.c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetOrbClk): failed to download " << acName << " precise orbit file " <<
+                if (access(LocalFile(sp3File).c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetOrbClk): failed to download " << acName << " precise orbit file " <<
                     sp3File << endl;
-                else if (access(sp3File.c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetOrbClk): successfully download " << acName << " precise orbit file " <<
+                else if (access(LocalFile(sp3File).c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetOrbClk): successfully download " << acName << " precise orbit file " <<
                     sp3File << endl;
 
                 /* delete some temporary directories */
                 string tmpDir = "repro3";
-                if (access(tmpDir.c_str(), 0) == 0)
+                if (access(LocalFile(tmpDir).c_str(), 0) == 0)
                 {
     #ifdef _WIN32  /* for Windows */
-                    cmd = "rd /s /q " + tmpDir;
+                    cmd = "rd /s /q " + LocalFile(tmpDir);
     #else          /* for Linux or Mac */
-                    cmd = "rm -rf " + tmpDir;
+                    cmd = "rm -rf " + LocalFile(tmpDir);
     #endif
                     std::system(cmd.c_str());
                 }
@@ -3933,40 +4037,38 @@ void FtpUtil::GetOrbClk(gtime_t ts, const char dir[], int mode, const ftpopt_t *
         }
         else if (mode == 2)  /* CLK file downloaded */
         {
-            if (access(clkFile.c_str(), 0) == -1)
+            if (access(LocalFile(clkFile).c_str(), 0) == -1)
             {
                 /* it is OK for '*.Z' or '*.gz' format */
                 string clkxFile = clkFile + ".*";
-                string cmd = wgetFull + " " + qr + " -nH -A " + clkxFile + cutDirs + url;
-                std::system(cmd.c_str());
+                _curl.GetFiles(url, clkxFile, _workDir);
+                string cmd;
 
                 string clkgzFile = clkFile + ".gz", clkzFile = clkFile + ".Z";
-                if (access(clkgzFile.c_str(), 0) == 0)
+                if (access(LocalFile(clkgzFile).c_str(), 0) == 0)
                 {
                     /* extract '*.gz' */
-                    cmd = gzipFull + " -d -f " + clkgzFile;
-                    std::system(cmd.c_str());
+                    _zip.Decompress(LocalFile(clkgzFile));
                 }
-                if (access(clkFile.c_str(), 0) == -1 && access(clkzFile.c_str(), 0) == 0)
+                if (access(LocalFile(clkFile).c_str(), 0) == -1 && access(LocalFile(clkzFile).c_str(), 0) == 0)
                 {
                     /* extract '*.Z' */
-                    cmd = gzipFull + " -d -f " + clkzFile;
-                    std::system(cmd.c_str());
+                    _zip.Decompress(LocalFile(clkzFile));
                 }
 
-                if (access(clkFile.c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetOrbClk): failed to download " << acName << " precise clock file " <<
+                if (access(LocalFile(clkFile).c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetOrbClk): failed to download " << acName << " precise clock file " <<
                     clkFile << endl;
-                else if (access(clkFile.c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetOrbClk): successfully download " << acName << " precise clock file " <<
+                else if (access(LocalFile(clkFile).c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetOrbClk): successfully download " << acName << " precise clock file " <<
                     clkFile << endl;
 
                 /* delete some temporary directories */
                 string tmpDir = "repro3";
-                if (access(tmpDir.c_str(), 0) == 0)
+                if (access(LocalFile(tmpDir).c_str(), 0) == 0)
                 {
     #ifdef _WIN32  /* for Windows */
-                    cmd = "rd /s /q " + tmpDir;
+                    cmd = "rd /s /q " + LocalFile(tmpDir);
     #else          /* for Linux or Mac */
-                    cmd = "rm -rf " + tmpDir;
+                    cmd = "rm -rf " + LocalFile(tmpDir);
     #endif
                     std::system(cmd.c_str());
                 }
@@ -3977,7 +4079,7 @@ void FtpUtil::GetOrbClk(gtime_t ts, const char dir[], int mode, const ftpopt_t *
     }
     else if (isMGEX)  /* for MGEX final orbit and clock products */
     {
-        string url, cutDirs = " --cut-dirs=5 ";
+        string url;
         if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_SP3M] + "/" + sWwww;
         else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_SP3M] + "/" + sWwww;
         else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_SP3M] + "/" + sWwww;
@@ -4019,80 +4121,76 @@ void FtpUtil::GetOrbClk(gtime_t ts, const char dir[], int mode, const ftpopt_t *
 
         if (mode == 1)       /* SP3 file downloaded */
         {
-            if (access(sp30File.c_str(), 0) == -1)
+            if (access(LocalFile(sp30File).c_str(), 0) == -1)
             {
                 /* it is OK for '*.Z' or '*.gz' format */
                 string sp3xFile = sp3File + ".*";
-                string cmd = wgetFull + " " + qr + " -nH -A " + sp3xFile + cutDirs + url;
-                std::system(cmd.c_str());
+                _curl.GetFiles(url, sp3xFile, _workDir);
+                string cmd;
 
                 /* extract '*.gz' */
                 string sp3gzFile = sp3File + ".gz";
-                cmd = gzipFull + " -d -f " + sp3gzFile;
-                std::system(cmd.c_str());
+                _zip.Decompress(LocalFile(sp3gzFile));
                 string changeFileName;
 #ifdef _WIN32  /* for Windows */
-                changeFileName = "rename";
+                changeFileName = "move /y";
 #else          /* for Linux or Mac */
                 changeFileName = "mv";
 #endif
-                cmd = changeFileName + " " + sp3File + " " + sp30File;
+                cmd = changeFileName + " " + LocalFile(sp3File) + " " + LocalFile(sp30File);
                 std::system(cmd.c_str());
-                if (access(sp30File.c_str(), 0) == -1)
+                if (access(LocalFile(sp30File).c_str(), 0) == -1)
                 {
                     /* extract '*.Z' */
                     string sp3zFile = sp3File + ".Z";
-                    cmd = gzipFull + " -d -f " + sp3zFile;
-                    std::system(cmd.c_str());
+                    _zip.Decompress(LocalFile(sp3zFile));
 
-                    cmd = changeFileName + " " + sp3File + " " + sp30File;
+                    cmd = changeFileName + " " + LocalFile(sp3File) + " " + LocalFile(sp30File);
                     std::system(cmd.c_str());
 
-                    if (access(sp30File.c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetOrbClk): failed to download " << acName << " MGEX precise orbit file " <<
+                    if (access(LocalFile(sp30File).c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetOrbClk): failed to download " << acName << " MGEX precise orbit file " <<
                         sp30File << endl;
                 }
 
-                if (access(sp30File.c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetOrbClk): successfully download " << acName << " MGEX precise orbit file " << sp30File << endl;
+                if (access(LocalFile(sp30File).c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetOrbClk): successfully download " << acName << " MGEX precise orbit file " << sp30File << endl;
             }
             else cout << "*** INFO(FtpUtil::GetOrbClk): " << acName << " MGEX precise orbit file " << sp30File <<
                 " has existed!" << endl;
         }
         else if (mode == 2)  /* CLK file downloaded */
         {
-            if (access(clk0File.c_str(), 0) == -1)
+            if (access(LocalFile(clk0File).c_str(), 0) == -1)
             {
                 /* it is OK for '*.Z' or '*.gz' format */
                 string clkxFile = clkFile + ".*";
-                string cmd = wgetFull + " " + qr + " -nH -A " + clkxFile + cutDirs + url;
-                std::system(cmd.c_str());
+                _curl.GetFiles(url, clkxFile, _workDir);
+                string cmd;
 
                 /* extract '*.gz' */
                 string clkgzFile = clkFile + ".gz";
-                cmd = gzipFull + " -d -f " + clkgzFile;
-                std::system(cmd.c_str());
+                _zip.Decompress(LocalFile(clkgzFile));
                 string changeFileName;
 #ifdef _WIN32  /* for Windows */
-                changeFileName = "rename";
+                changeFileName = "move /y";
 #else          /* for Linux or Mac */
                 changeFileName = "mv";
 #endif
-                cmd = changeFileName + " " + clkFile + " " + clk0File;
+                cmd = changeFileName + " " + LocalFile(clkFile) + " " + LocalFile(clk0File);
                 std::system(cmd.c_str());
-                if (access(clk0File.c_str(), 0) == -1)
+                if (access(LocalFile(clk0File).c_str(), 0) == -1)
                 {
                     /* extract '*.Z' */
                     string clkzFile = clkFile + ".Z";
-                    cmd = gzipFull + " -d -f " + clkzFile;
-                    std::system(cmd.c_str());
+                    _zip.Decompress(LocalFile(clkzFile));
 
-                    cmd = changeFileName + " " + clkFile + " " + clk0File;
+                    cmd = changeFileName + " " + LocalFile(clkFile) + " " + LocalFile(clk0File);
                     std::system(cmd.c_str());
 
-                    if (access(clkFile.c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetOrbClk): failed to download " << acName << " MGEX precise clock file " <<
+                    if (access(LocalFile(clkFile).c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetOrbClk): failed to download " << acName << " MGEX precise clock file " <<
                         clk0File << endl;
                 }
 
-                if (access(clk0File.c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetOrbClk): successfully download " << acName << " MGEX precise clock file " <<
+                if (access(LocalFile(clk0File).c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetOrbClk): successfully download " << acName << " MGEX precise clock file " <<
                     clk0File << endl;
             }
             else cout << "*** INFO(FtpUtil::GetOrbClk): " << acName << " MGEX precise clock file " << clk0File <<
@@ -4112,12 +4210,8 @@ void FtpUtil::GetOrbClk(gtime_t ts, const char dir[], int mode, const ftpopt_t *
 **/
 void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(dir);
-#else           /* for Linux or Mac */
-    chdir(dir);
-#endif
+    /* the local files are in the directory */
+    _workDir = dir;
 
     /* compute GPS week and day of week */
     TimeUtil tu;
@@ -4156,22 +4250,19 @@ void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         if (ac == finalAcIGS[i]) isIGS = true;
     }
 
-    string ftpName = fopt->ftpFrom;
+    string ftpName = SelectArchive(IDX_EOP, ARC_ALL, fopt);
     str.ToUpper(ftpName);
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
     if (isUltra)  /* for ultra-rapid EOP products  */
     {
-        string url, cutDirs, acName;
+        string url, acName;
         if (ac == "esu")       /* ESA */
         {
             url = "http://navigation-office.esa.int/products/gnss-products/" + sWwww;
-            cutDirs = " --cut-dirs=3 ";
             acName = "ESA";
         }
         else if (ac == "gfu")  /* GFZ */
         {
             url = "ftp://ftp.gfz-potsdam.de/pub/GNSS/products/ultra/w" + sWwww;
-            cutDirs = " --cut-dirs=5 ";
             acName = "GFZ";
         }
         else if (ac == "igu")  /* IGS */
@@ -4180,7 +4271,6 @@ void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_EOP] + "/" + sWwww;
             else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_EOP] + "/" + sWwww;
             else url = _ftpArchive.CDDIS[IDX_SP3] + "/" + sWwww;
-            cutDirs = " --cut-dirs=4 ";
             acName = "IGS";
         }
 
@@ -4188,34 +4278,24 @@ void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         {
             string sHh = str.hh2str(fopt->hhEop[i]);
             string eopFile = ac + sWwww + sDow + "_" + sHh + ".erp";
-            if (access(eopFile.c_str(), 0) == -1)
+            if (access(LocalFile(eopFile).c_str(), 0) == -1)
             {
                 string cmd;
                 if (ac == "esu")  /* ESA */
                 {
                     string eopzFile = eopFile + ".Z";
-                    string url0 = url + "/" + eopzFile;
-                    cmd = wgetFull + " " + qr + " -nH " + cutDirs + url0;
-                    std::system(cmd.c_str());
-
-                    if (access(eopzFile.c_str(), 0) == 0)
+                    if (_curl.GetFile(url + "/" + eopzFile, LocalFile(eopzFile)) == XFER_OK)
                     {
                         /* extract '*.Z' */
-                        cmd = gzipFull + " -d -f " + eopzFile;
-                        std::system(cmd.c_str());
+                        _zip.Decompress(LocalFile(eopzFile));
                     }
                     else
                     {
                         string eopgzFile = eopFile + ".gz";
-                        string url0 = url + "/" + eopgzFile;
-                        cmd = wgetFull + " " + qr + " -nH " + cutDirs + url0;
-                        std::system(cmd.c_str());
-
-                        if (access(eopgzFile.c_str(), 0) == 0)
+                        if (_curl.GetFile(url + "/" + eopgzFile, LocalFile(eopgzFile)) == XFER_OK)
                         {
                             /* extract '*.gz' */
-                            cmd = gzipFull + " -d -f " + eopgzFile;
-                            std::system(cmd.c_str());
+                            _zip.Decompress(LocalFile(eopgzFile));
                         }
                     }
                 }
@@ -4223,39 +4303,36 @@ void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 {
                     /* it is OK for '*.Z' or '*.gz' format */
                     string eopxFile = eopFile + ".*";
-                    string cmd = wgetFull + " " + qr + " -nH -A " + eopxFile + cutDirs + url;
-                    std::system(cmd.c_str());
+                    _curl.GetFiles(url, eopxFile, _workDir);
 
                     string eopgzFile = eopFile + ".gz", eopzFile = eopFile + ".Z";
-                    if (access(eopgzFile.c_str(), 0) == 0)
+                    if (access(LocalFile(eopgzFile).c_str(), 0) == 0)
                     {
                         /* extract '*.gz' */
-                        cmd = gzipFull + " -d -f " + eopgzFile;
-                        std::system(cmd.c_str());
+                        _zip.Decompress(LocalFile(eopgzFile));
                     }
-                    if (access(eopFile.c_str(), 0) == -1 && access(eopzFile.c_str(), 0) == 0)
+                    if (access(LocalFile(eopFile).c_str(), 0) == -1 && access(LocalFile(eopzFile).c_str(), 0) == 0)
                     {
                         /* extract '*.Z' */
-                        cmd = gzipFull + " -d -f " + eopzFile;
-                        std::system(cmd.c_str());
+                        _zip.Decompress(LocalFile(eopzFile));
                     }
                 }
 
-                if (access(eopFile.c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetEop): failed to download " << acName << " ultra-rapid EOP file " <<
+                if (access(LocalFile(eopFile).c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetEop): failed to download " << acName << " ultra-rapid EOP file " <<
                     eopFile << endl;
-                else if (access(eopFile.c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetEop): successfully download " << acName << " ultra-rapid EOP file " <<
+                else if (access(LocalFile(eopFile).c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetEop): successfully download " << acName << " ultra-rapid EOP file " <<
                     eopFile << endl;
 
                 if (ac == "igu")
                 {
                     /* delete some temporary directories */
                     string tmpDir = "repro3";
-                    if (access(tmpDir.c_str(), 0) == 0)
+                    if (access(LocalFile(tmpDir).c_str(), 0) == 0)
                     {
 #ifdef _WIN32  /* for Windows */
-                        cmd = "rd /s /q " + tmpDir;
+                        cmd = "rd /s /q " + LocalFile(tmpDir);
 #else          /* for Linux or Mac */
-                        cmd = "rm -rf " + tmpDir;
+                        cmd = "rm -rf " + LocalFile(tmpDir);
 #endif
                         std::system(cmd.c_str());
                     }
@@ -4276,10 +4353,10 @@ void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         else if (ac == "jpl") acName = "JPL";
 
         string eopFile = ac + sWwww + "7.erp";
-        if (access(eopFile.c_str(), 0) == -1)
+        if (access(LocalFile(eopFile).c_str(), 0) == -1)
         {
             /* download the EOP file */
-            string url, cutDirs = " --cut-dirs=4 ";
+            string url;
             if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_EOP] + "/" + sWwww;
             else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_EOP] + "/" + sWwww;
             else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_EOP] + "/" + sWwww;
@@ -4287,36 +4364,34 @@ void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
             /* it is OK for '*.Z' or '*.gz' format */
             string eopxFile = eopFile + ".*";
-            string cmd = wgetFull + " " + qr + " -nH -A " + eopxFile + cutDirs + url;
-            std::system(cmd.c_str());
+            _curl.GetFiles(url, eopxFile, _workDir);
+            string cmd;
 
             string eopgzFile = eopFile + ".gz", eopzFile = eopFile + ".Z";
-            if (access(eopgzFile.c_str(), 0) == 0)
+            if (access(LocalFile(eopgzFile).c_str(), 0) == 0)
             {
                 /* extract '*.gz' */
-                cmd = gzipFull + " -d -f " + eopgzFile;
-                std::system(cmd.c_str());
+                _zip.Decompress(LocalFile(eopgzFile));
             }
-            if (access(eopFile.c_str(), 0) == -1 && access(eopzFile.c_str(), 0) == 0)
+            if (access(LocalFile(eopFile).c_str(), 0) == -1 && access(LocalFile(eopzFile).c_str(), 0) == 0)
             {
                 /* extract '*.Z' */
-                cmd = gzipFull + " -d -f " + eopzFile;
-                std::system(cmd.c_str());
+                _zip.Decompress(LocalFile(eopzFile));
             }
 
-            if (access(eopFile.c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetEop): failed to download " << acName << " final EOP file " <<
+            if (access(LocalFile(eopFile).c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetEop): failed to download " << acName << " final EOP file " <<
                 eopFile << endl;
-            else if (access(eopFile.c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetEop): successfully download " << acName << " final EOP file " <<
+            else if (access(LocalFile(eopFile).c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetEop): successfully download " << acName << " final EOP file " <<
                 eopFile << endl;
 
             /* delete some temporary directories */
             string tmpDir = "repro3";
-            if (access(tmpDir.c_str(), 0) == 0)
+            if (access(LocalFile(tmpDir).c_str(), 0) == 0)
             {
 #ifdef _WIN32  /* for Windows */
-                cmd = "rd /s /q " + tmpDir;
+                cmd = "rd /s /q " + LocalFile(tmpDir);
 #else          /* for Linux or Mac */
-                cmd = "rm -rf " + tmpDir;
+                cmd = "rm -rf " + LocalFile(tmpDir);
 #endif
                 std::system(cmd.c_str());
             }
@@ -4336,12 +4411,8 @@ void FtpUtil::GetEop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 **/
 void FtpUtil::GetSnx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(dir);
-#else           /* for Linux or Mac */
-    chdir(dir);
-#endif
+    /* the local files are in the directory */
+    _workDir = dir;
 
     /* compute GPS week and day of week */
     TimeUtil tu;
@@ -4351,13 +4422,12 @@ void FtpUtil::GetSnx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sWwww = str.wwww2str(wwww);
     string sDow(to_string(dow));
 
-    string ftpName = fopt->ftpFrom;
+    string ftpName = SelectArchive(IDX_SNX, ARC_ALL, fopt);
     str.ToUpper(ftpName);
     string snx0File = "igs" + sWwww + ".snx";
-    if (access(snx0File.c_str(), 0) == -1)
+    if (access(LocalFile(snx0File).c_str(), 0) == -1)
     {
-        string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;        
-        string url, cutDirs = " --cut-dirs=4 ";
+        string url;
         if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_SNX] + "/" + sWwww;
         else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_SNX] + "/" + sWwww;
         else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_SNX] + "/" + sWwww;
@@ -4366,38 +4436,36 @@ void FtpUtil::GetSnx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         /* it is OK for '*.Z' or '*.gz' format */
         string snxFile = "igs*P" + sWwww + ".snx";
         string snxxFile = snxFile + ".*";
-        string cmd = wgetFull + " " + qr + " -nH -A " + snxxFile + cutDirs + url;
-        std::system(cmd.c_str());
+        _curl.GetFiles(url, snxxFile, _workDir);
+        string cmd;
 
         /* extract '*.Z' */
         string snxzFile = snxFile + ".Z";
-        cmd = gzipFull + " -d -f " + snxzFile;
-        std::system(cmd.c_str());
+        _zip.Decompress(LocalFile(snxzFile));
         string changeFileName;
 #ifdef _WIN32  /* for Windows */
-        changeFileName = "rename";
+        changeFileName = "move /y";
 #else          /* for Linux or Mac */
         changeFileName = "mv";
 #endif
-        cmd = changeFileName + " " + snxFile + " " + snx0File;
+        cmd = changeFileName + " " + LocalFile(snxFile) + " " + LocalFile(snx0File);
         std::system(cmd.c_str());
-        if (access(snx0File.c_str(), 0) == -1)
+        if (access(LocalFile(snx0File).c_str(), 0) == -1)
         {
             /* extract '*.Z' */
             string snxgzFile = snxFile + ".gz";
-            cmd = gzipFull + " -d -f " + snxgzFile;
-            std::system(cmd.c_str());
+            _zip.Decompress(LocalFile(snxgzFile));
 
-            cmd = changeFileName + " " + snxFile + " " + snx0File;
+            cmd = changeFileName + " " + LocalFile(snxFile) + " " + LocalFile(snx0File);
             std::system(cmd.c_str());
-            if (access(snx0File.c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetSnx): failed to download IGS weekly SINEX file " <<
+            if (access(LocalFile(snx0File).c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetSnx): failed to download IGS weekly SINEX file " <<
                 snx0File << endl;
         }
 
         /* If the weekly SINEX file does not exist,  we use the daily SINEX file instead */
-        if (access(snx0File.c_str(), 0) == -1)
+        if (access(LocalFile(snx0File).c_str(), 0) == -1)
         {
-            string url, cutDirs = " --cut-dirs=4 ";
+            string url;
             if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_SNX] + "/" + sWwww;
             else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_SNX] + "/" + sWwww;
             else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_SNX] + "/" + sWwww;
@@ -4406,46 +4474,43 @@ void FtpUtil::GetSnx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             /* it is OK for '*.Z' or '*.gz' format */
             string snxFile = "igs*P" + sWwww + sDow + ".snx";
             string snxxFile = snxFile + ".*";
-            string cmd = wgetFull + " " + qr + " -nH -A " + snxxFile + cutDirs + url;
-            std::system(cmd.c_str());
+            _curl.GetFiles(url, snxxFile, _workDir);
 
             /* extract '*.Z' */
             string snxzFile = snxFile + ".Z";
-            cmd = gzipFull + " -d -f " + snxzFile;
-            std::system(cmd.c_str());
+            _zip.Decompress(LocalFile(snxzFile));
             string changeFileName;
 #ifdef _WIN32  /* for Windows */
-            changeFileName = "rename";
+            changeFileName = "move /y";
 #else          /* for Linux or Mac */
             changeFileName = "mv";
 #endif
-            cmd = changeFileName + " " + snxFile + " " + snx0File;
+            cmd = changeFileName + " " + LocalFile(snxFile) + " " + LocalFile(snx0File);
             std::system(cmd.c_str());
-            if (access(snx0File.c_str(), 0) == -1)
+            if (access(LocalFile(snx0File).c_str(), 0) == -1)
             {
                 /* extract '*.Z' */
                 string snxgzFile = snxFile + ".gz";
-                cmd = gzipFull + " -d -f " + snxgzFile;
-                std::system(cmd.c_str());
+                _zip.Decompress(LocalFile(snxgzFile));
 
-                cmd = changeFileName + " " + snxFile + " " + snx0File;
+                cmd = changeFileName + " " + LocalFile(snxFile) + " " + LocalFile(snx0File);
                 std::system(cmd.c_str());
-                if (access(snx0File.c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetSnx): failed to download IGS weekly SINEX file " <<
+                if (access(LocalFile(snx0File).c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetSnx): failed to download IGS weekly SINEX file " <<
                     snx0File << endl;
             }
         }
 
-        if (access(snx0File.c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetSnx): successfully download IGS weekly SINEX file " << 
+        if (access(LocalFile(snx0File).c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetSnx): successfully download IGS weekly SINEX file " << 
             snx0File << endl;
 
         /* delete some temporary directories */
         string tmpDir = "repro3";
-        if (access(tmpDir.c_str(), 0) == 0)
+        if (access(LocalFile(tmpDir).c_str(), 0) == 0)
         {
 #ifdef _WIN32  /* for Windows */
-            cmd = "rd /s /q " + tmpDir;
+            cmd = "rd /s /q " + LocalFile(tmpDir);
 #else          /* for Linux or Mac */
-            cmd = "rm -rf " + tmpDir;
+            cmd = "rm -rf " + LocalFile(tmpDir);
 #endif
             std::system(cmd.c_str());
         }
@@ -4464,12 +4529,8 @@ void FtpUtil::GetSnx(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 **/
 void FtpUtil::GetDcbMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(dir);
-#else           /* for Linux or Mac */
-    chdir(dir);
-#endif
+    /* the local files are in the directory */
+    _workDir = dir;
 
     /* compute day of year */
     TimeUtil tu;
@@ -4480,48 +4541,36 @@ void FtpUtil::GetDcbMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sYyyy = str.yyyy2str(yyyy);
     string sDoy = str.doy2str(doy);
 
-    string ftpName = fopt->ftpFrom;
+    string ftpName = SelectArchive(IDX_DCBM, ARC_ALL, fopt);
     str.ToUpper(ftpName);
     string dcbFile = "CAS0MGXRAP_" + sYyyy + sDoy + "0000_01D_01D_DCB.BSX";
-    if (access(dcbFile.c_str(), 0) == -1)
+    if (access(LocalFile(dcbFile).c_str(), 0) == -1)
     {
-        string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
-        string url, cutDirs = " --cut-dirs=5 ";
+        string url;
         if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_DCBM] + "/" + sYyyy;
-        else if (ftpName == "IGN")
-        {
-            url = _ftpArchive.IGN[IDX_DCBM] + "/" + sYyyy;
-            cutDirs = " --cut-dirs=6 ";
-        }
-        else if (ftpName == "WHU")
-        {
-            url = _ftpArchive.WHU[IDX_DCBM] + "/" + sYyyy;
-            cutDirs = " --cut-dirs=6 ";
-        }
+        else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_DCBM] + "/" + sYyyy;
+        else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_DCBM] + "/" + sYyyy;
         else url = _ftpArchive.CDDIS[IDX_DCBM] + "/" + sYyyy;
 
         /* it is OK for '*.Z' or '*.gz' format */
         string dcbxFile = dcbFile + ".*";
-        string cmd = wgetFull + " " + qr + " -nH -A " + dcbxFile + cutDirs + url;
-        std::system(cmd.c_str());
+        _curl.GetFiles(url, dcbxFile, _workDir);
 
         string dcbgzFile = dcbFile + ".gz", dcbzFile = dcbFile + ".Z";
-        if (access(dcbgzFile.c_str(), 0) == 0)
+        if (access(LocalFile(dcbgzFile).c_str(), 0) == 0)
         {
             /* extract '*.gz' */
-            cmd = gzipFull + " -d -f " + dcbgzFile;
-            std::system(cmd.c_str());
+            _zip.Decompress(LocalFile(dcbgzFile));
         }
-        else if (access(dcbzFile.c_str(), 0) == 0)
+        else if (access(LocalFile(dcbzFile).c_str(), 0) == 0)
         {
             /* extract '*.Z' */
-            cmd = gzipFull + " -d -f " + dcbzFile;
-            std::system(cmd.c_str());
+            _zip.Decompress(LocalFile(dcbzFile));
         }
 
-        if (access(dcbFile.c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetDcbMgex): failed to download multi-GNSS DCB file " <<
+        if (access(LocalFile(dcbFile).c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetDcbMgex): failed to download multi-GNSS DCB file " <<
             dcbFile << endl;
-        else if (access(dcbFile.c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetDcbMgex): successfully download multi-GNSS DCB file " <<
+        else if (access(LocalFile(dcbFile).c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetDcbMgex): successfully download multi-GNSS DCB file " <<
             dcbFile << endl;
     }
     else cout << "*** INFO(FtpUtil::GetDcbMgex): multi-GNSS DCB file " << dcbFile << " has existed!" << endl;
@@ -4539,12 +4588,11 @@ void FtpUtil::GetDcbMgex(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 **/
 void FtpUtil::GetDcbCode(gtime_t ts, const char dir[], const char dType[], const ftpopt_t *fopt)
 {
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(dir);
-#else           /* for Linux or Mac */
-    chdir(dir);
-#endif
+    /* product class of the transfers for the health history */
+    _curl.SetClass("DCB");
+
+    /* the local files are in the directory */
+    _workDir = dir;
 
     /* compute day of year */
     TimeUtil tu;
@@ -4578,47 +4626,44 @@ void FtpUtil::GetDcbCode(gtime_t ts, const char dir[], const char dType[], const
         dcb0File = "P2C2" + sYy + sMm + ".DCB";
     }
     
-    if (access(dcbFile.c_str(), 0) == -1 && access(dcb0File.c_str(), 0) == -1)
+    if (access(LocalFile(dcbFile).c_str(), 0) == -1 && access(LocalFile(dcb0File).c_str(), 0) == -1)
     {
         /* download DCB file */
-        string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
         string url = "ftp://ftp.aiub.unibe.ch/CODE/" + sYyyy;
 
         /* it is OK for '*.Z' or '*.gz' format */
         string dcbxFile = dcbFile + ".*";
-        string cmd = wgetFull + " " + qr + " -nH -A " + dcbxFile + " --cut-dirs=2 " + url;
-        std::system(cmd.c_str());
+        _curl.GetFiles(url, dcbxFile, _workDir);
+        string cmd;
 
         string dcbgzFile = dcbFile + ".gz", dcbzFile = dcbFile + ".Z";
-        if (access(dcbgzFile.c_str(), 0) == 0)
+        if (access(LocalFile(dcbgzFile).c_str(), 0) == 0)
         {
             /* extract '*.gz' */
-            cmd = gzipFull + " -d -f " + dcbgzFile;
-            std::system(cmd.c_str());
+            _zip.Decompress(LocalFile(dcbgzFile));
         }
-        else if (access(dcbzFile.c_str(), 0) == 0)
+        else if (access(LocalFile(dcbzFile).c_str(), 0) == 0)
         {
             /* extract '*.Z' */
-            cmd = gzipFull + " -d -f " + dcbzFile;
-            std::system(cmd.c_str());
+            _zip.Decompress(LocalFile(dcbzFile));
         }
 
-        if (access(dcbFile.c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetDcbCode): failed to download CODE DCB file " <<
+        if (access(LocalFile(dcbFile).c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetDcbCode): failed to download CODE DCB file " <<
             dcbFile << endl;
 
         if (type == "P2C2")
         {
             string changeFileName;
 #ifdef _WIN32  /* for Windows */
-            changeFileName = "rename";
+            changeFileName = "move /y";
 #else          /* for Linux or Mac */
             changeFileName = "mv";
 #endif
-            cmd = changeFileName + " " + dcbFile + " " + dcb0File;
+            cmd = changeFileName + " " + LocalFile(dcbFile) + " " + LocalFile(dcb0File);
             std::system(cmd.c_str());
         }
 
-        if (access(dcb0File.c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetDcbCode): successfully download CODE DCB file " << dcb0File << endl;
+        if (access(LocalFile(dcb0File).c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetDcbCode): successfully download CODE DCB file " << dcb0File << endl;
     }
     else cout << "*** INFO(FtpUtil::GetDcbCode): CODE DCB file " << dcb0File << " or " << dcbFile <<
         " has existed!" << endl;
@@ -4635,12 +4680,8 @@ void FtpUtil::GetDcbCode(gtime_t ts, const char dir[], const char dType[], const
 **/
 void FtpUtil::GetIono(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(dir);
-#else           /* for Linux or Mac */
-    chdir(dir);
-#endif
+    /* the local files are in the directory */
+    _workDir = dir;
 
     /* compute day of year */
     TimeUtil tu;
@@ -4652,15 +4693,14 @@ void FtpUtil::GetIono(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
 
-    string ftpName = fopt->ftpFrom;
+    string ftpName = SelectArchive(IDX_ION, ARC_ALL, fopt);
     str.ToUpper(ftpName);
     string ac(fopt->ionOpt);
     str.ToLower(ac);
     string ionFile = ac + "g" + sDoy + "0." + sYy + "i";
-    if (access(ionFile.c_str(), 0) == -1)
+    if (access(LocalFile(ionFile).c_str(), 0) == -1)
     {
-        string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
-        string url, cutDirs = " --cut-dirs=6 ";
+        string url;
         if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_ION] + "/" + 
             sYyyy + "/" + sDoy;
         else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_ION] + "/" + 
@@ -4671,36 +4711,34 @@ void FtpUtil::GetIono(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
         /* it is OK for '*.Z' or '*.gz' format */
         string ionxFile = ionFile + ".*";
-        string cmd = wgetFull + " " + qr + " -nH -A " + ionxFile + cutDirs + url;
-        std::system(cmd.c_str());
+        _curl.GetFiles(url, ionxFile, _workDir);
+        string cmd;
 
         string iongzFile = ionFile + ".gz", ionzFile = ionFile + ".Z";
-        if (access(iongzFile.c_str(), 0) == 0)
+        if (access(LocalFile(iongzFile).c_str(), 0) == 0)
         {
             /* extract '*.gz' */
-            cmd = gzipFull + " -d -f " + iongzFile;
-            std::system(cmd.c_str());
+            _zip.Decompress(LocalFile(iongzFile));
         }
-        else if (access(ionzFile.c_str(), 0) == 0)
+        else if (access(LocalFile(ionzFile).c_str(), 0) == 0)
         {
             /* extract '*.Z' */
-            cmd = gzipFull + " -d -f " + ionzFile;
-            std::system(cmd.c_str());
+            _zip.Decompress(LocalFile(ionzFile));
         }
 
-        if (access(ionFile.c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetIono): failed to download GIM file " <<
+        if (access(LocalFile(ionFile).c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetIono): failed to download GIM file " <<
             ionFile << endl;
-        else if (access(ionFile.c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetIono): successfully download GIM file " <<
+        else if (access(LocalFile(ionFile).c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetIono): successfully download GIM file " <<
             ionFile << endl;
 
         /* delete some temporary directories */
         string tmpDir = "topex";
-        if (access(tmpDir.c_str(), 0) == 0)
+        if (access(LocalFile(tmpDir).c_str(), 0) == 0)
         {
 #ifdef _WIN32  /* for Windows */
-            cmd = "rd /s /q " + tmpDir;
+            cmd = "rd /s /q " + LocalFile(tmpDir);
 #else          /* for Linux or Mac */
-            cmd = "rm -rf " + tmpDir;
+            cmd = "rm -rf " + LocalFile(tmpDir);
 #endif
             std::system(cmd.c_str());
         }
@@ -4719,12 +4757,8 @@ void FtpUtil::GetIono(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 **/
 void FtpUtil::GetRoti(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(dir);
-#else           /* for Linux or Mac */
-    chdir(dir);
-#endif
+    /* the local files are in the directory */
+    _workDir = dir;
 
     /* compute day of year */
     TimeUtil tu;
@@ -4736,13 +4770,12 @@ void FtpUtil::GetRoti(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     string sYy = str.yy2str(yy);
     string sDoy = str.doy2str(doy);
 
-    string ftpName = fopt->ftpFrom;
+    string ftpName = SelectArchive(IDX_ROTI, ARC_ALL, fopt);
     str.ToUpper(ftpName);
     string rotFile = "roti" + sDoy + "0." + sYy + "f";
-    if (access(rotFile.c_str(), 0) == -1)
+    if (access(LocalFile(rotFile).c_str(), 0) == -1)
     {
-        string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
-        string url, cutDirs = " --cut-dirs=6 ";
+        string url;
         if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_ROTI] + "/" +
             sYyyy + "/" + sDoy;
         else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_ROTI] + "/" +
@@ -4753,36 +4786,34 @@ void FtpUtil::GetRoti(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
         /* it is OK for '*.Z' or '*.gz' format */
         string rotxFile = rotFile + ".*";
-        string cmd = wgetFull + " " + qr + " -nH -A " + rotxFile + cutDirs + url;
-        std::system(cmd.c_str());
+        _curl.GetFiles(url, rotxFile, _workDir);
+        string cmd;
 
         string rotgzFile = rotFile + ".gz", rotzFile = rotFile + ".Z";
-        if (access(rotgzFile.c_str(), 0) == 0)
+        if (access(LocalFile(rotgzFile).c_str(), 0) == 0)
         {
             /* extract '*.gz' */
-            cmd = gzipFull + " -d -f " + rotgzFile;
-            std::system(cmd.c_str());
+            _zip.Decompress(LocalFile(rotgzFile));
         }
-        else if (access(rotzFile.c_str(), 0) == 0)
+        else if (access(LocalFile(rotzFile).c_str(), 0) == 0)
         {
             /* extract '*.Z' */
-            cmd = gzipFull + " -d -f " + rotzFile;
-            std::system(cmd.c_str());
+            _zip.Decompress(LocalFile(rotzFile));
         }
 
-        if (access(rotFile.c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetRoti): failed to download ROTI file " <<
+        if (access(LocalFile(rotFile).c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetRoti): failed to download ROTI file " <<
             rotFile << endl;
-        else if (access(rotFile.c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetRoti): successfully download ROTI file " <<
+        else if (access(LocalFile(rotFile).c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetRoti): successfully download ROTI file " <<
             rotFile << endl;
 
         /* delete some temporary directories */
         string tmpDir = "topex";
-        if (access(tmpDir.c_str(), 0) == 0)
+        if (access(LocalFile(tmpDir).c_str(), 0) == 0)
         {
 #ifdef _WIN32  /* for Windows */
-            cmd = "rd /s /q " + tmpDir;
+            cmd = "rd /s /q " + LocalFile(tmpDir);
 #else          /* for Linux or Mac */
-            cmd = "rm -rf " + tmpDir;
+            cmd = "rm -rf " + LocalFile(tmpDir);
 #endif
             std::system(cmd.c_str());
         }
@@ -4801,12 +4832,8 @@ void FtpUtil::GetRoti(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 **/
 void FtpUtil::GetTrop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(dir);
-#else           /* for Linux or Mac */
-    chdir(dir);
-#endif
+    /* the local files are in the directory */
+    _workDir = dir;
 
     /* compute day of year */
     TimeUtil tu;
@@ -4824,10 +4851,9 @@ void FtpUtil::GetTrop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
     string ac(fopt->trpOpt);
     str.ToLower(ac);
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
     if (ac == "igs")
     {
-        string ftpName = fopt->ftpFrom;
+        string ftpName = SelectArchive(IDX_ZTD, ARC_ALL, fopt);
         str.ToUpper(ftpName);
         string sitFile = fopt->obsOpt;
         if (fopt->getObs) sitFile = fopt->obsOpt;
@@ -4835,14 +4861,10 @@ void FtpUtil::GetTrop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         if (strlen(sitFile.c_str()) < 9)  /* the option of 'all' is selected; the length of "site.list" is nine */
         {
             /* download all the IGS ZPD files */
-            string url, cutDirs = " --cut-dirs=7 ";
+            string url;
             if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_ZTD] + "/" +
                 sYyyy + "/" + sDoy;
-            else if (ftpName == "IGN")
-            {
-                url = _ftpArchive.IGN[IDX_ZTD] + "/" + sYyyy + "/" + sDoy;
-                cutDirs = " --cut-dirs=6 ";
-            }
+            else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_ZTD] + "/" + sYyyy + "/" + sDoy;
             else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_ZTD] + "/" +
                 sYyyy + "/" + sDoy;
             else url = _ftpArchive.CDDIS[IDX_ZTD] + "/" + sYyyy + "/" + sDoy;
@@ -4850,8 +4872,7 @@ void FtpUtil::GetTrop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             /* it is OK for '*.Z' or '*.gz' format */
             string zpdFile = "*" + sDoy + "0." + sYy + "zpd";
             string zpdxFile = zpdFile + ".*";
-            string cmd = wgetFull + " " + qr + " -nH -A " + zpdxFile + cutDirs + url;
-            std::system(cmd.c_str());
+            _curl.GetFiles(url, zpdxFile, _workDir);
 
             /* get the file list */
             string suffix = "." + sYy + "zpd";
@@ -4859,11 +4880,10 @@ void FtpUtil::GetTrop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
             str.GetFilesAll(dir, suffix, zpdFiles);
             for (int i = 0; i < zpdFiles.size(); i++)
             {
-                if (access(zpdFiles[i].c_str(), 0) == 0)
+                if (access(LocalFile(zpdFiles[i]).c_str(), 0) == 0)
                 {
                     /* extract it */
-                    cmd = gzipFull + " -d -f " + zpdFiles[i];
-                    std::system(cmd.c_str());
+                    _zip.Decompress(LocalFile(zpdFiles[i]));
                 }
             }
         }
@@ -4885,41 +4905,34 @@ void FtpUtil::GetTrop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
                 {
                     str.ToLower(sitName);
                     string zpdFile = sitName + sDoy + "0." + sYy + "zpd";
-                    if (access(zpdFile.c_str(), 0) == -1)
+                    if (access(LocalFile(zpdFile).c_str(), 0) == -1)
                     {
-                        string url, cutDirs = " --cut-dirs=7 ";
+                        string url;
                         if (ftpName == "CDDIS") url = _ftpArchive.CDDIS[IDX_ZTD] + "/" +
                             sYyyy + "/" + sDoy;
-                        else if (ftpName == "IGN")
-                        {
-                            url = _ftpArchive.IGN[IDX_ZTD] + "/" + sYyyy + "/" + sDoy;
-                            cutDirs = " --cut-dirs=6 ";
-                        }
+                        else if (ftpName == "IGN") url = _ftpArchive.IGN[IDX_ZTD] + "/" + sYyyy + "/" + sDoy;
                         else if (ftpName == "WHU") url = _ftpArchive.WHU[IDX_ZTD] + "/" +
                             sYyyy + "/" + sDoy;
                         
                         /* it is OK for '*.Z' or '*.gz' format */
                         string zpdxFile = zpdFile + ".*";
-                        string cmd = wgetFull + " " + qr + " -nH -A " + zpdxFile + cutDirs + url;
-                        std::system(cmd.c_str());
+                        _curl.GetFiles(url, zpdxFile, _workDir);
 
                         string zpdgzFile = zpdFile + ".gz", zpdzFile = zpdFile + ".Z";
-                        if (access(zpdgzFile.c_str(), 0) == 0)
+                        if (access(LocalFile(zpdgzFile).c_str(), 0) == 0)
                         {
                             /* extract '*.gz' */
-                            cmd = gzipFull + " -d -f " + zpdgzFile;
-                            std::system(cmd.c_str());
+                            _zip.Decompress(LocalFile(zpdgzFile));
                         }
-                        else if (access(zpdzFile.c_str(), 0) == 0)
+                        else if (access(LocalFile(zpdzFile).c_str(), 0) == 0)
                         {
                             /* extract '*.Z' */
-                            cmd = gzipFull + " -d -f " + zpdzFile;
-                            std::system(cmd.c_str());
+                            _zip.Decompress(LocalFile(zpdzFile));
                         }
 
-                        if (access(zpdFile.c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetTrop): failed to download IGS tropospheric product file " <<
+                        if (access(LocalFile(zpdFile).c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetTrop): failed to download IGS tropospheric product file " <<
                             zpdFile << endl;
-                        else if (access(zpdFile.c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetTrop): successfully download IGS tropospheric product file " <<
+                        else if (access(LocalFile(zpdFile).c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetTrop): successfully download IGS tropospheric product file " <<
                             zpdFile << endl;
                     }
                     else cout << "*** INFO(FtpUtil::GetTrop): IGS tropospheric product file " << zpdFile << 
@@ -4934,33 +4947,29 @@ void FtpUtil::GetTrop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
     else if (ac == "cod")
     {
         string trpFile = "COD" + sWwww + sDow + ".TRO";
-        if (access(trpFile.c_str(), 0) == -1)
+        if (access(LocalFile(trpFile).c_str(), 0) == -1)
         {
             string url = "ftp://ftp.aiub.unibe.ch/CODE/" + sYyyy;
-            string cutDirs = " --cut-dirs=2 ";
 
             /* it is OK for '*.Z' or '*.gz' format */
             string trpxFile = trpFile + ".*";
-            string cmd = wgetFull + " " + qr + " -nH -A " + trpxFile + cutDirs + url;
-            std::system(cmd.c_str());
+            _curl.GetFiles(url, trpxFile, _workDir);
 
             string trpgzFile = trpFile + ".gz", trpzFile = trpFile + ".Z";
-            if (access(trpgzFile.c_str(), 0) == 0)
+            if (access(LocalFile(trpgzFile).c_str(), 0) == 0)
             {
                 /* extract '*.gz' */
-                cmd = gzipFull + " -d -f " + trpgzFile;
-                std::system(cmd.c_str());
+                _zip.Decompress(LocalFile(trpgzFile));
             }
-            else if (access(trpzFile.c_str(), 0) == 0)
+            else if (access(LocalFile(trpzFile).c_str(), 0) == 0)
             {
                 /* extract '*.Z' */
-                cmd = gzipFull + " -d -f " + trpzFile;
-                std::system(cmd.c_str());
+                _zip.Decompress(LocalFile(trpzFile));
             }
 
-            if (access(trpFile.c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetTrop): failed to download CODE tropospheric product file " <<
+            if (access(LocalFile(trpFile).c_str(), 0) == -1) cout << "*** INFO(FtpUtil::GetTrop): failed to download CODE tropospheric product file " <<
                 trpFile << endl;
-            else if (access(trpFile.c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetTrop): successfully download CODE tropospheric product file " <<
+            else if (access(LocalFile(trpFile).c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetTrop): successfully download CODE tropospheric product file " <<
                 trpFile << endl;
         }
         else cout << "*** INFO(FtpUtil::GetTrop): CODE tropospheric product file " << trpFile <<
@@ -4980,12 +4989,11 @@ void FtpUtil::GetTrop(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 **/
 void FtpUtil::GetRtOrbClkCNT(gtime_t ts, const char dir[], int mode, const ftpopt_t *fopt)
 {
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(dir);
-#else           /* for Linux or Mac */
-    chdir(dir);
-#endif
+    /* product class of the transfers for the health history */
+    _curl.SetClass("RTORBCLK");
+
+    /* the local files are in the directory */
+    _workDir = dir;
 
     /* compute GPS week and day of week */
     TimeUtil tu;
@@ -4995,21 +5003,19 @@ void FtpUtil::GetRtOrbClkCNT(gtime_t ts, const char dir[], int mode, const ftpop
     string sWwww = str.wwww2str(wwww);
     string sDow(to_string(dow));
 
-    string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
     if (mode == 1)       /* SP3 file downloaded */
     {
         string sp3File = "cnt" + sWwww + sDow + ".sp3";
-        if (access(sp3File.c_str(), 0) == -1)
+        if (access(LocalFile(sp3File).c_str(), 0) == -1)
         {
             string sp3gzFile = sp3File + ".gz";
             string url = "http://www.ppp-wizard.net/products/REAL_TIME/" + sp3gzFile;
-            string cmd = wgetFull + " " + qr + " -nH --cut-dirs=2 " + url;
-            std::system(cmd.c_str());
+            _curl.GetFile(url, LocalFile(sp3gzFile));
 
             /* extract '*.gz' */
-            cmd = gzipFull + " -d -f " + sp3gzFile;
-            std::system(cmd.c_str());
-            if (access(sp3File.c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetRtOrbClkCNT): successfully download CNES real-time precise orbit file " << 
+            _zip.Decompress(LocalFile(sp3gzFile));
+            string cmd;
+            if (access(LocalFile(sp3File).c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetRtOrbClkCNT): successfully download CNES real-time precise orbit file " << 
                 sp3File << endl;
             else cout << "*** INFO(FtpUtil::GetRtOrbClkCNT): failed to download CNES real-time precise orbit file " <<
                 sp3File << endl;
@@ -5018,12 +5024,12 @@ void FtpUtil::GetRtOrbClkCNT(gtime_t ts, const char dir[], int mode, const ftpop
             std::vector<string> tmpDir = { "FORMAT_BIAIS_OFFI1", "FORMATBIAS_OFF_v1" };
             for (int i = 0; i < tmpDir.size(); i++)
             {
-                if (access(tmpDir[i].c_str(), 0) == 0)
+                if (access(LocalFile(tmpDir[i]).c_str(), 0) == 0)
                 {
 #ifdef _WIN32  /* for Windows */
-                    cmd = "rd /s /q " + tmpDir[i];
+                    cmd = "rd /s /q " + LocalFile(tmpDir[i]);
 #else          /* for Linux or Mac */
-                    cmd = "rm -rf " + tmpDir[i];
+                    cmd = "rm -rf " + LocalFile(tmpDir[i]);
 #endif
                     std::system(cmd.c_str());
                 }
@@ -5035,17 +5041,16 @@ void FtpUtil::GetRtOrbClkCNT(gtime_t ts, const char dir[], int mode, const ftpop
     else if (mode == 2)  /* CLK file downloaded */
     {
         string clkFile = "cnt" + sWwww + sDow + ".clk";
-        if (access(clkFile.c_str(), 0) == -1)
+        if (access(LocalFile(clkFile).c_str(), 0) == -1)
         {
             string clkgzFile = clkFile + ".gz";
             string url = "http://www.ppp-wizard.net/products/REAL_TIME/" + clkgzFile;
-            string cmd = wgetFull + " " + qr + " -nH --cut-dirs=2 " + url;
-            std::system(cmd.c_str());
+            _curl.GetFile(url, LocalFile(clkgzFile));
 
             /* extract '*.gz' */
-            cmd = gzipFull + " -d -f " + clkgzFile;
-            std::system(cmd.c_str());
-            if (access(clkFile.c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetRtOrbClkCNT): successfully download CNES real-time precise clock file " <<
+            _zip.Decompress(LocalFile(clkgzFile));
+            string cmd;
+            if (access(LocalFile(clkFile).c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetRtOrbClkCNT): successfully download CNES real-time precise clock file " <<
                 clkFile << endl;
             else cout << "*** INFO(FtpUtil::GetRtOrbClkCNT): failed to download CNES real-time precise clock file " <<
                 clkFile << endl;
@@ -5054,12 +5059,12 @@ void FtpUtil::GetRtOrbClkCNT(gtime_t ts, const char dir[], int mode, const ftpop
             std::vector<string> tmpDir = { "FORMAT_BIAIS_OFFI1", "FORMATBIAS_OFF_v1" };
             for (int i = 0; i < tmpDir.size(); i++)
             {
-                if (access(tmpDir[i].c_str(), 0) == 0)
+                if (access(LocalFile(tmpDir[i]).c_str(), 0) == 0)
                 {
 #ifdef _WIN32  /* for Windows */
-                    cmd = "rd /s /q " + tmpDir[i];
+                    cmd = "rd /s /q " + LocalFile(tmpDir[i]);
 #else          /* for Linux or Mac */
-                    cmd = "rm -rf " + tmpDir[i];
+                    cmd = "rm -rf " + LocalFile(tmpDir[i]);
 #endif
                     std::system(cmd.c_str());
                 }
@@ -5081,12 +5086,11 @@ void FtpUtil::GetRtOrbClkCNT(gtime_t ts, const char dir[], int mode, const ftpop
 **/
 void FtpUtil::GetRtBiasCNT(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(dir);
-#else           /* for Linux or Mac */
-    chdir(dir);
-#endif
+    /* product class of the transfers for the health history */
+    _curl.SetClass("RTBIAS");
+
+    /* the local files are in the directory */
+    _workDir = dir;
 
     /* compute GPS week and day of week */
     TimeUtil tu;
@@ -5098,18 +5102,16 @@ void FtpUtil::GetRtBiasCNT(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 
     /* code and phase bias file downloaded */
     string biaFile = "cnt" + sWwww + sDow + ".bia";
-    if (access(biaFile.c_str(), 0) == -1)
+    if (access(LocalFile(biaFile).c_str(), 0) == -1)
     {
-        string wgetFull = fopt->wgetFull, gzipFull = fopt->gzipFull, qr = fopt->qr;
         string biagzFile = biaFile + ".gz";
         string url = "http://www.ppp-wizard.net/products/REAL_TIME/" + biagzFile;
-        string cmd = wgetFull + " " + qr + " -nH --cut-dirs=2 " + url;
-        std::system(cmd.c_str());
+        _curl.GetFile(url, LocalFile(biagzFile));
 
         /* extract '*.gz' */
-        cmd = gzipFull + " -d -f " + biagzFile;
-        std::system(cmd.c_str());
-        if (access(biaFile.c_str(), 0) == 0) cout << "*** INFO(GetRtBiasCNT): successfully download CNES real-time code and phase bias file " << 
+        _zip.Decompress(LocalFile(biagzFile));
+        string cmd;
+        if (access(LocalFile(biaFile).c_str(), 0) == 0) cout << "*** INFO(GetRtBiasCNT): successfully download CNES real-time code and phase bias file " << 
             biaFile << endl;
         else cout << "*** INFO(FtpUtil::GetRtBiasCNT): failed to download CNES real-time code and phase bias file " <<
             biaFile << endl;
@@ -5118,12 +5120,12 @@ void FtpUtil::GetRtBiasCNT(gtime_t ts, const char dir[], const ftpopt_t *fopt)
         std::vector<string> tmpDir = { "FORMAT_BIAIS_OFFI1", "FORMATBIAS_OFF_v1" };
         for (int i = 0; i < tmpDir.size(); i++)
         {
-            if (access(tmpDir[i].c_str(), 0) == 0)
+            if (access(LocalFile(tmpDir[i]).c_str(), 0) == 0)
             {
 #ifdef _WIN32  /* for Windows */
-                cmd = "rd /s /q " + tmpDir[i];
+                cmd = "rd /s /q " + LocalFile(tmpDir[i]);
 #else          /* for Linux or Mac */
-                cmd = "rm -rf " + tmpDir[i];
+                cmd = "rm -rf " + LocalFile(tmpDir[i]);
 #endif
                 std::system(cmd.c_str());
             }
@@ -5144,532 +5146,628 @@ void FtpUtil::GetRtBiasCNT(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 **/
 void FtpUtil::GetAntexIGS(gtime_t ts, const char dir[], const ftpopt_t *fopt)
 {
-    /* change directory */
-#ifdef _WIN32   /* for Windows */
-    _chdir(dir);
-#else           /* for Linux or Mac */
-    chdir(dir);
-#endif
+    /* product class of the transfers for the health history */
+    _curl.SetClass("ATX");
+
+    /* the local files are in the directory */
+    _workDir = dir;
 
     string atxFile("igs14.atx");
-    if (access(atxFile.c_str(), 0) == -1)
+    if (access(LocalFile(atxFile).c_str(), 0) == -1)
     {
-        string wgetFull = fopt->wgetFull, qr = fopt->qr;
         string url = "https://files.igs.org/pub/station/general/" + atxFile;
-        string cmd = wgetFull + " " + qr + " -nH --cut-dirs=3 " + url;
-        std::system(cmd.c_str());
+        _curl.GetFile(url, LocalFile(atxFile));
 
-        if (access(atxFile.c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetAntexIGS): successfully download IGS ANTEX file " << atxFile << endl;
+        if (access(LocalFile(atxFile).c_str(), 0) == 0) cout << "*** INFO(FtpUtil::GetAntexIGS): successfully download IGS ANTEX file " << atxFile << endl;
     }
     else cout << "*** INFO(FtpUtil::GetAntexIGS): IGS ANTEX file " << atxFile << " has existed!" << endl;
 } /* end of GetAntexIGS */
 
 /**
-* @brief     : FtpDownload - GNSS data downloading via FTP
-* @param[I]  : popt (processing options)
-* @param[I/O]: fopt (FTP options)
-* @return    : none
-* @note      :
+* @brief   : RunTask - run one download task of the observations or products
+* @param[I]: task (task of downloading, i.e., TASK_OBS, TASK_ORBCLK, ...)
+* @param[I]: popt (processing options)
+* @param[I]: fopt (FTP options)
+* @param[O]: none
+* @return  : none
+* @note    :
 **/
-void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t *fopt)
+void FtpUtil::RunTask(int task, const prcopt_t *popt, const ftpopt_t *fopt)
 {
-    /* Get FTP archive for CDDIS, IGN, or WHU */
-    init();
-
-    /* setting of the third-party softwares (.i.e, wget, gzip, crx2rnx etc.) */
     StringUtil str;
-    if (fopt->isPath3party)  /* the path of third-party softwares is NOT set in the environmental variable */
-    {
-        char cmdTmp[MAXCHARS] = { '\0' };
-        char sep = (char)FILEPATHSEP;
 
-        /* for wget */
-        sprintf(cmdTmp, "%s%c%s", fopt->dir3party, sep, "wget");
-        str.TrimSpace(cmdTmp);
-        str.CutFilePathSep(cmdTmp);
-        strcpy(fopt->wgetFull, cmdTmp);
-
-        /* for gzip */
-        sprintf(cmdTmp, "%s%c%s", fopt->dir3party, sep, "gzip");
-        str.TrimSpace(cmdTmp);
-        str.CutFilePathSep(cmdTmp);
-        strcpy(fopt->gzipFull, cmdTmp);
-
-        /* for crx2rnx */
-        sprintf(cmdTmp, "%s%c%s", fopt->dir3party, sep, "crx2rnx");
-        str.TrimSpace(cmdTmp);
-        str.CutFilePathSep(cmdTmp);
-        strcpy(fopt->crx2rnxFull, cmdTmp);
-    }
-    else  /* the path of third-party softwares is set in the environmental variable */
+    switch (task)
     {
-        str.SetStr(fopt->wgetFull, "wget", 5);
-        str.SetStr(fopt->gzipFull, "gzip", 5);
-        str.SetStr(fopt->crx2rnxFull, "crx2rnx", 8);
-    }
-
-    /* "-qr" (printInfoWget == false, not print information of 'wget') or "r" (printInfoWget == true, print information of 'wget') in 'wget' command line */
-    if (fopt->printInfoWget) str.SetStr(fopt->qr, "-r", 3);
-    else str.SetStr(fopt->qr, "-qr", 4);
-
-    /* IGS observation (short name 'd') downloaded */
-    if (fopt->getObs)
-    {
-        /* If the directory does not exist, creat it */
-        if (access(popt->obsDir, 0) == -1)
+    case TASK_OBS:  /* IGS observation (short name 'd') downloaded */
+        if (fopt->getObs)
         {
-            string tmpDir = popt->obsDir;
+            /* If the directory does not exist, creat it */
+            if (!_dryRun && access(popt->obsDir, 0) == -1)
+            {
+                string tmpDir = popt->obsDir;
 #ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + tmpDir;
+                string cmd = "mkdir " + tmpDir;
 #else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + tmpDir;
+                string cmd = "mkdir -p " + tmpDir;
 #endif
-            std::system(cmd.c_str());
-        }
+                std::system(cmd.c_str());
+            }
 
-        if (strcmp(fopt->obsTyp, "daily") == 0) GetDailyObsIgs(popt->ts, popt->obsDir, fopt);
-        else if (strcmp(fopt->obsTyp, "hourly") == 0) GetHourlyObsIgs(popt->ts, popt->obsDir, fopt);
-        else if (strcmp(fopt->obsTyp, "highrate") == 0) GetHrObsIgs(popt->ts, popt->obsDir, fopt);
-    }
+            if (strcmp(fopt->obsTyp, "daily") == 0) GetDailyObsIgs(popt->ts, popt->obsDir, fopt);
+            else if (strcmp(fopt->obsTyp, "hourly") == 0) GetHourlyObsIgs(popt->ts, popt->obsDir, fopt);
+            else if (strcmp(fopt->obsTyp, "highrate") == 0) GetHrObsIgs(popt->ts, popt->obsDir, fopt);
+        }
+        break;
 
-    /* MGEX observation (long name 'crx') downloaded */
-    if (fopt->getObm)
-    {
-        /* If the directory does not exist, creat it */
-        if (access(popt->obmDir, 0) == -1)
+    case TASK_OBM:  /* MGEX observation (long name 'crx') downloaded */
+        if (fopt->getObm)
         {
-            string tmpDir = popt->obmDir;
+            /* If the directory does not exist, creat it */
+            if (!_dryRun && access(popt->obmDir, 0) == -1)
+            {
+                string tmpDir = popt->obmDir;
 #ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + tmpDir;
+                string cmd = "mkdir " + tmpDir;
 #else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + tmpDir;
+                string cmd = "mkdir -p " + tmpDir;
 #endif
-            std::system(cmd.c_str());
-        }
+                std::system(cmd.c_str());
+            }
 
-        if (strcmp(fopt->obmTyp, "daily") == 0) GetDailyObsMgex(popt->ts, popt->obmDir, fopt);
-        else if (strcmp(fopt->obmTyp, "hourly") == 0) GetHourlyObsMgex(popt->ts, popt->obmDir, fopt);
-        else if (strcmp(fopt->obmTyp, "highrate") == 0) GetHrObsMgex(popt->ts, popt->obmDir, fopt);
-    }
+            if (strcmp(fopt->obmTyp, "daily") == 0) GetDailyObsMgex(popt->ts, popt->obmDir, fopt);
+            else if (strcmp(fopt->obmTyp, "hourly") == 0) GetHourlyObsMgex(popt->ts, popt->obmDir, fopt);
+            else if (strcmp(fopt->obmTyp, "highrate") == 0) GetHrObsMgex(popt->ts, popt->obmDir, fopt);
+        }
+        break;
 
-    /* Curtin University of Technology (CUT) observation (long name 'crx') downloaded */
-    if (fopt->getObc)
-    {
-        /* If the directory does not exist, creat it */
-        if (access(popt->obcDir, 0) == -1)
+    case TASK_OBC:  /* Curtin University of Technology (CUT) observation (long name 'crx') downloaded */
+        if (fopt->getObc)
         {
-            string tmpDir = popt->obcDir;
+            /* If the directory does not exist, creat it */
+            if (!_dryRun && access(popt->obcDir, 0) == -1)
+            {
+                string tmpDir = popt->obcDir;
 #ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + tmpDir;
+                string cmd = "mkdir " + tmpDir;
 #else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + tmpDir;
+                string cmd = "mkdir -p " + tmpDir;
 #endif
-            std::system(cmd.c_str());
-        }
+                std::system(cmd.c_str());
+            }
 
-        if (strcmp(fopt->obcTyp, "daily") == 0) GetDailyObsCut(popt->ts, popt->obcDir, fopt);
-    }
+            if (strcmp(fopt->obcTyp, "daily") == 0) GetDailyObsCut(popt->ts, popt->obcDir, fopt);
+        }
+        break;
 
-    /* Geoscience Australia (GA) observation (long name 'crx') downloaded */
-    if (fopt->getObg)
-    {
-        /* If the directory does not exist, creat it */
-        if (access(popt->obgDir, 0) == -1)
+    case TASK_OBG:  /* Geoscience Australia (GA) observation (long name 'crx') downloaded */
+        if (fopt->getObg)
         {
-            string tmpDir = popt->obgDir;
+            /* If the directory does not exist, creat it */
+            if (!_dryRun && access(popt->obgDir, 0) == -1)
+            {
+                string tmpDir = popt->obgDir;
 #ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + tmpDir;
+                string cmd = "mkdir " + tmpDir;
 #else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + tmpDir;
+                string cmd = "mkdir -p " + tmpDir;
 #endif
-            std::system(cmd.c_str());
-        }
+                std::system(cmd.c_str());
+            }
 
-        if (strcmp(fopt->obgTyp, "daily") == 0) GetDailyObsGa(popt->ts, popt->obgDir, fopt);
-        else if (strcmp(fopt->obgTyp, "hourly") == 0) GetHourlyObsGa(popt->ts, popt->obgDir, fopt);
-        else if (strcmp(fopt->obgTyp, "highrate") == 0) GetHrObsGa(popt->ts, popt->obgDir, fopt);
-    }
+            if (strcmp(fopt->obgTyp, "daily") == 0) GetDailyObsGa(popt->ts, popt->obgDir, fopt);
+            else if (strcmp(fopt->obgTyp, "hourly") == 0) GetHourlyObsGa(popt->ts, popt->obgDir, fopt);
+            else if (strcmp(fopt->obgTyp, "highrate") == 0) GetHrObsGa(popt->ts, popt->obgDir, fopt);
+        }
+        break;
 
-    /* Hong Kong CORS observation (long name 'crx') downloaded */
-    if (fopt->getObh)
-    {
-        /* If the directory does not exist, creat it */
-        if (access(popt->obhDir, 0) == -1)
+    case TASK_OBH:  /* Hong Kong CORS observation (long name 'crx') downloaded */
+        if (fopt->getObh)
         {
-            string tmpDir = popt->obhDir;
+            /* If the directory does not exist, creat it */
+            if (!_dryRun && access(popt->obhDir, 0) == -1)
+            {
+                string tmpDir = popt->obhDir;
 #ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + tmpDir;
+                string cmd = "mkdir " + tmpDir;
 #else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + tmpDir;
+                string cmd = "mkdir -p " + tmpDir;
 #endif
-            std::system(cmd.c_str());
-        }
+                std::system(cmd.c_str());
+            }
 
-        if (strcmp(fopt->obhTyp, "30s") == 0 || strcmp(fopt->obhTyp, "30 s") == 0)
-            Get30sObsHk(popt->ts, popt->obhDir, fopt);
-        else if (strcmp(fopt->obhTyp, "5s") == 0 || strcmp(fopt->obhTyp, "05s") == 0)
-            Get5sObsHk(popt->ts, popt->obhDir, fopt);
-        else if (strcmp(fopt->obhTyp, "1s") == 0 || strcmp(fopt->obhTyp, "01s") == 0)
-            Get1sObsHk(popt->ts, popt->obhDir, fopt);
-    }
+            if (strcmp(fopt->obhTyp, "30s") == 0 || strcmp(fopt->obhTyp, "30 s") == 0)
+                Get30sObsHk(popt->ts, popt->obhDir, fopt);
+            else if (strcmp(fopt->obhTyp, "5s") == 0 || strcmp(fopt->obhTyp, "05s") == 0)
+                Get5sObsHk(popt->ts, popt->obhDir, fopt);
+            else if (strcmp(fopt->obhTyp, "1s") == 0 || strcmp(fopt->obhTyp, "01s") == 0)
+                Get1sObsHk(popt->ts, popt->obhDir, fopt);
+        }
+        break;
 
-    /* NGS/NOAA CORS observation (short name 'd') downloaded */
-    if (fopt->getObn)
-    {
-        /* If the directory does not exist, creat it */
-        if (access(popt->obnDir, 0) == -1)
+    case TASK_OBN:  /* NGS/NOAA CORS observation (short name 'd') downloaded */
+        if (fopt->getObn)
         {
-            string tmpDir = popt->obnDir;
+            /* If the directory does not exist, creat it */
+            if (!_dryRun && access(popt->obnDir, 0) == -1)
+            {
+                string tmpDir = popt->obnDir;
 #ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + tmpDir;
+                string cmd = "mkdir " + tmpDir;
 #else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + tmpDir;
+                string cmd = "mkdir -p " + tmpDir;
 #endif
-            std::system(cmd.c_str());
-        }
+                std::system(cmd.c_str());
+            }
 
-        if (strcmp(fopt->obnTyp, "daily") == 0) GetDailyObsNgs(popt->ts, popt->obnDir, fopt);
-    }
+            if (strcmp(fopt->obnTyp, "daily") == 0) GetDailyObsNgs(popt->ts, popt->obnDir, fopt);
+        }
+        break;
 
-    /* EUREF Permanent Network (EPN) observation (long name 'crx' and short name 'd') downloaded */
-    if (fopt->getObe)
-    {
-        /* If the directory does not exist, creat it */
-        if (access(popt->obeDir, 0) == -1)
+    case TASK_OBE:  /* EUREF Permanent Network (EPN) observation (long name 'crx' and short name 'd') downloaded */
+        if (fopt->getObe)
         {
-            string tmpDir = popt->obeDir;
+            /* If the directory does not exist, creat it */
+            if (!_dryRun && access(popt->obeDir, 0) == -1)
+            {
+                string tmpDir = popt->obeDir;
 #ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + tmpDir;
+                string cmd = "mkdir " + tmpDir;
 #else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + tmpDir;
+                string cmd = "mkdir -p " + tmpDir;
 #endif
-            std::system(cmd.c_str());
-        }
+                std::system(cmd.c_str());
+            }
 
-        if (strcmp(fopt->obeTyp, "daily") == 0) GetDailyObsEpn(popt->ts, popt->obeDir, fopt);
-    }
+            if (strcmp(fopt->obeTyp, "daily") == 0) GetDailyObsEpn(popt->ts, popt->obeDir, fopt);
+        }
+        break;
 
-    /* broadcast ephemeris downloaded */
-    if (fopt->getNav)
-    {
-        /* If the directory does not exist, creat it */
-        if (access(popt->navDir, 0) == -1)
+    case TASK_NAV:  /* broadcast ephemeris downloaded */
+        if (fopt->getNav)
         {
-            string tmpDir = popt->navDir;
+            /* If the directory does not exist, creat it */
+            if (!_dryRun && access(popt->navDir, 0) == -1)
+            {
+                string tmpDir = popt->navDir;
 #ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + tmpDir;
+                string cmd = "mkdir " + tmpDir;
 #else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + tmpDir;
+                string cmd = "mkdir -p " + tmpDir;
 #endif
-            std::system(cmd.c_str());
-        }
-
-        GetNav(popt->ts, popt->navDir, fopt);
-    }
+                std::system(cmd.c_str());
+            }
 
-    /* precise orbit and clock product downloaded for the current day */
-    if (fopt->getOrbClk)
-    {
-        string ac(fopt->orbClkOpt);
-        str.ToLower(ac);
-
-        /* esu: ESA ultra-rapid orbit and clock products
-           gfu: GFZ ultra-rapid orbit and clock products
-           igu: IGS ultra-rapid orbit and clock products
-           wuu: WHU ultra-rapid orbit and clock products
-        */
-        std::vector<string> ultraAc = { "esu", "gfu", "igu", "wuu" };
-        bool isUltra = false;
-        for (int i = 0; i < ultraAc.size(); i++)
-        {
-            if (ac == ultraAc[i]) isUltra = true;
+            GetNav(popt->ts, popt->navDir, fopt);
         }
+        break;
 
-        /* cor: CODE rapid orbit and clock products
-           emp: NRCan rapid orbit and clock products
-           esr: ESA rapid orbit and clock products
-           gfr: GFZ rapid orbit and clock products
-           igr: IGS rapid orbit and clock products
-        */
-        std::vector<string> rapidAc = { "cor", "emp", "esr", "gfr", "igr" };
-        bool isRapid = false;
-        for (int i = 0; i < rapidAc.size(); i++)
+    case TASK_ORBCLK:  /* precise orbit and clock product downloaded for the current day */
+        if (fopt->getOrbClk)
         {
-            if (ac == rapidAc[i]) isRapid = true;
-        }
+            string ac(fopt->orbClkOpt);
+            str.ToLower(ac);
+
+            /* esu: ESA ultra-rapid orbit and clock products
+               gfu: GFZ ultra-rapid orbit and clock products
+               igu: IGS ultra-rapid orbit and clock products
+               wuu: WHU ultra-rapid orbit and clock products
+            */
+            std::vector<string> ultraAc = { "esu", "gfu", "igu", "wuu" };
+            bool isUltra = false;
+            for (int i = 0; i < ultraAc.size(); i++)
+            {
+                if (ac == ultraAc[i]) isUltra = true;
+            }
 
-        /* cod: CODE final orbit and clock products
-           emr: NRCan final orbit and clock products
-           esa: ESA final orbit and clock products
-           gfz: GFZ final orbit and clock products
-           grg: CNES final orbit and clock products
-           igs: IGS final orbit and clock products
-           jpl: JPL final orbit and clock products
-        */
-        std::vector<string> finalAcIGS = { "cod", "emr", "esa", "gfz", "grg", "igs", "jpl", "mit" };
-        bool isIGS = false;
-        for (int i = 0; i < finalAcIGS.size(); i++)
-        {
-            if (ac == finalAcIGS[i]) isIGS = true;
-        }
+            /* cor: CODE rapid orbit and clock products
+               emp: NRCan rapid orbit and clock products
+               esr: ESA rapid orbit and clock products
+               gfr: GFZ rapid orbit and clock products
+               igr: IGS rapid orbit and clock products
+            */
+            std::vector<string> rapidAc = { "cor", "emp", "esr", "gfr", "igr" };
+            bool isRapid = false;
+            for (int i = 0; i < rapidAc.size(); i++)
+            {
+                if (ac == rapidAc[i]) isRapid = true;
+            }
 
-        /* com: CODE multi-GNSS final orbit and clock products
-           gbm: GFZ multi-GNSS final orbit and clock products
-           grm: CNES multi-GNSS final orbit and clock products
-           wum: WHU multi-GNSS final orbit and clock products
-        */
-        std::vector<string> acMGEX = { "com", "gbm", "grm", "wum" };
-        bool isMGEX = false;
-        for (int i = 0; i < acMGEX.size(); i++)
-        {
-            if (ac == acMGEX[i]) isMGEX = true;
-        }
+            /* cod: CODE final orbit and clock products
+               emr: NRCan final orbit and clock products
+               esa: ESA final orbit and clock products
+               gfz: GFZ final orbit and clock products
+               grg: CNES final orbit and clock products
+               igs: IGS final orbit and clock products
+               jpl: JPL final orbit and clock products
+            */
+            std::vector<string> finalAcIGS = { "cod", "emr", "esa", "gfz", "grg", "igs", "jpl", "mit" };
+            bool isIGS = false;
+            for (int i = 0; i < finalAcIGS.size(); i++)
+            {
+                if (ac == finalAcIGS[i]) isIGS = true;
+            }
 
-        /* creation of sub-directory */
-        string subSp3Dir = popt->sp3Dir;
-        string subClkDir = popt->clkDir;
-        char tmpDir[MAXSTRPATH] = { '\0' };
-        char sep = (char)FILEPATHSEP;
-        if (isUltra)
-        {
-            sprintf(tmpDir, "%s%c%s", popt->sp3Dir, sep, "ultra");
-            subSp3Dir = tmpDir;
-        }
-        else if (isRapid)
-        {
-            sprintf(tmpDir, "%s%c%s", popt->sp3Dir, sep, "rapid");
-            subSp3Dir = tmpDir;
-            sprintf(tmpDir, "%s%c%s", popt->clkDir, sep, "rapid");
-            subClkDir = tmpDir;
-        }
-        else if (isIGS || isMGEX)
-        {
-            sprintf(tmpDir, "%s%c%s", popt->sp3Dir, sep, "final");
-            subSp3Dir = tmpDir;
-            sprintf(tmpDir, "%s%c%s", popt->clkDir, sep, "final");
-            subClkDir = tmpDir;
+            /* com: CODE multi-GNSS final orbit and clock products
+               gbm: GFZ multi-GNSS final orbit and clock products
+               grm: CNES multi-GNSS final orbit and clock products
+               wum: WHU multi-GNSS final orbit and clock products
+            */
+            std::vector<string> acMGEX = { "com", "gbm", "grm", "wum" };
+            bool isMGEX = false;
+            for (int i = 0; i < acMGEX.size(); i++)
+            {
+                if (ac == acMGEX[i]) isMGEX = true;
+            }
+
+            /* creation of sub-directory */
+            string subSp3Dir = popt->sp3Dir;
+            string subClkDir = popt->clkDir;
+            char tmpDir[MAXSTRPATH] = { '\0' };
+            char sep = (char)FILEPATHSEP;
+            if (isUltra)
+            {
+                sprintf(tmpDir, "%s%c%s", popt->sp3Dir, sep, "ultra");
+                subSp3Dir = tmpDir;
+            }
+            else if (isRapid)
+            {
+                sprintf(tmpDir, "%s%c%s", popt->sp3Dir, sep, "rapid");
+                subSp3Dir = tmpDir;
+                sprintf(tmpDir, "%s%c%s", popt->clkDir, sep, "rapid");
+                subClkDir = tmpDir;
+            }
+            else if (isIGS || isMGEX)
+            {
+                sprintf(tmpDir, "%s%c%s", popt->sp3Dir, sep, "final");
+                subSp3Dir = tmpDir;
+                sprintf(tmpDir, "%s%c%s", popt->clkDir, sep, "final");
+                subClkDir = tmpDir;
+            }
+
+            /* for sp3 */
+            if (!_dryRun && access(subSp3Dir.c_str(), 0) == -1)
+            {
+                /* If the directory does not exist, creat it */
+#ifdef _WIN32   /* for Windows */
+                string cmd = "mkdir " + subSp3Dir;
+#else           /* for Linux or Mac */
+                string cmd = "mkdir -p " + subSp3Dir;
+#endif
+                std::system(cmd.c_str());
+            }
+
+            GetOrbClk(popt->ts, subSp3Dir.c_str(), 1, fopt);  /* sp3 */
+
+            /* for clk */
+            if (isRapid || isIGS || isMGEX)
+            {
+                if (!_dryRun && access(subClkDir.c_str(), 0) == -1)
+                {
+                    /* If the directory does not exist, creat it */
+#ifdef _WIN32   /* for Windows */
+                    string cmd = "mkdir " + subClkDir;
+#else           /* for Linux or Mac */
+                    string cmd = "mkdir -p " + subClkDir;
+#endif
+                    std::system(cmd.c_str());
+                }
+
+                GetOrbClk(popt->ts, subClkDir.c_str(), 2, fopt);  /* clk */
+            }
+
+            if (fopt->minusAdd1day && (isRapid || isIGS || isMGEX))
+            {
+                TimeUtil tu;
+                gtime_t tt;
+                /* precise orbit and clock product downloaded for the day before */
+                tt = tu.TimeAdd(popt->ts, -86400.0);
+                GetOrbClk(tt, subSp3Dir.c_str(), 1, fopt);
+                GetOrbClk(tt, subClkDir.c_str(), 2, fopt);
+
+                /* precise orbit and clock product downloaded for the day after */
+                tt = tu.TimeAdd(popt->ts, 86400.0);
+                GetOrbClk(tt, subSp3Dir.c_str(), 1, fopt);
+                GetOrbClk(tt, subClkDir.c_str(), 2, fopt);
+            }
         }
+        break;
 
-        /* for sp3 */
-        if (access(subSp3Dir.c_str(), 0) == -1)
+    case TASK_EOP:  /* EOP file downloaded */
+        if (fopt->getEop)
         {
             /* If the directory does not exist, creat it */
+            if (!_dryRun && access(popt->eopDir, 0) == -1)
+            {
+                string tmpDir = popt->eopDir;
 #ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + subSp3Dir;
+                string cmd = "mkdir " + tmpDir;
 #else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + subSp3Dir;
+                string cmd = "mkdir -p " + tmpDir;
 #endif
-            std::system(cmd.c_str());
-        }
+                std::system(cmd.c_str());
+            }
 
-        GetOrbClk(popt->ts, subSp3Dir.c_str(), 1, fopt);  /* sp3 */
+            GetEop(popt->ts, popt->eopDir, fopt);
+        }
+        break;
 
-        /* for clk */
-        if (isRapid || isIGS || isMGEX)
+    case TASK_SNX:  /* IGS SINEX file downloaded */
+        if (fopt->getSnx)
         {
-            if (access(subClkDir.c_str(), 0) == -1)
+            /* If the directory does not exist, creat it */
+            if (!_dryRun && access(popt->snxDir, 0) == -1)
             {
-                /* If the directory does not exist, creat it */
+                string tmpDir = popt->snxDir;
 #ifdef _WIN32   /* for Windows */
-                string cmd = "mkdir " + subClkDir;
+                string cmd = "mkdir " + tmpDir;
 #else           /* for Linux or Mac */
-                string cmd = "mkdir -p " + subClkDir;
+                string cmd = "mkdir -p " + tmpDir;
 #endif
                 std::system(cmd.c_str());
             }
 
-            GetOrbClk(popt->ts, subClkDir.c_str(), 2, fopt);  /* clk */
+            GetSnx(popt->ts, popt->snxDir, fopt);
         }
+        break;
 
-        if (fopt->minusAdd1day && (isRapid || isIGS || isMGEX))
+    case TASK_DCB:  /* MGEX and/or CODE DCB files downloaded */
+        if (fopt->getDcb)
         {
-            TimeUtil tu;
-            gtime_t tt;
-            /* precise orbit and clock product downloaded for the day before */
-            tt = tu.TimeAdd(popt->ts, -86400.0);
-            GetOrbClk(tt, subSp3Dir.c_str(), 1, fopt);
-            GetOrbClk(tt, subClkDir.c_str(), 2, fopt);
-
-            /* precise orbit and clock product downloaded for the day after */
-            tt = tu.TimeAdd(popt->ts, 86400.0);
-            GetOrbClk(tt, subSp3Dir.c_str(), 1, fopt);
-            GetOrbClk(tt, subClkDir.c_str(), 2, fopt);
-        }
-    }
-    
-    /* EOP file downloaded */
-    if (fopt->getEop)
-    {
-        /* If the directory does not exist, creat it */
-        if (access(popt->eopDir, 0) == -1)
-        {
-            string tmpDir = popt->eopDir;
+            /* If the directory does not exist, creat it */
+            if (!_dryRun && access(popt->dcbDir, 0) == -1)
+            {
+                string tmpDir = popt->dcbDir;
 #ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + tmpDir;
+                string cmd = "mkdir " + tmpDir;
 #else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + tmpDir;
+                string cmd = "mkdir -p " + tmpDir;
 #endif
-            std::system(cmd.c_str());
-        }
+                std::system(cmd.c_str());
+            }
 
-        GetEop(popt->ts, popt->eopDir, fopt);
-    }
+            GetDcbCode(popt->ts, popt->dcbDir, "P1P2", fopt);
+            GetDcbCode(popt->ts, popt->dcbDir, "P1C1", fopt);
+            GetDcbCode(popt->ts, popt->dcbDir, "P2C2", fopt);
+            GetDcbMgex(popt->ts, popt->dcbDir, fopt);
+        }
+        break;
 
-    /* IGS SINEX file downloaded */
-    if (fopt->getSnx)
-    {
-        /* If the directory does not exist, creat it */
-        if (access(popt->snxDir, 0) == -1)
+    case TASK_ION:  /* global ionosphere map (GIM) downloaded */
+        if (fopt->getIon)
         {
-            string tmpDir = popt->snxDir;
+            /* If the directory does not exist, creat it */
+            if (!_dryRun && access(popt->ionDir, 0) == -1)
+            {
+                string tmpDir = popt->ionDir;
 #ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + tmpDir;
+                string cmd = "mkdir " + tmpDir;
 #else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + tmpDir;
+                string cmd = "mkdir -p " + tmpDir;
 #endif
-            std::system(cmd.c_str());
-        }
+                std::system(cmd.c_str());
+            }
 
-        GetSnx(popt->ts, popt->snxDir, fopt);
-    }
+            GetIono(popt->ts, popt->ionDir, fopt);
+        }
+        break;
 
-    /* MGEX and/or CODE DCB files downloaded */
-    if (fopt->getDcb)
-    {
-        /* If the directory does not exist, creat it */
-        if (access(popt->dcbDir, 0) == -1)
+    case TASK_ROTI:  /* Rate of TEC index (ROTI) file downloaded */
+        if (fopt->getRoti)
         {
-            string tmpDir = popt->dcbDir;
+            /* If the directory does not exist, creat it */
+            if (!_dryRun && access(popt->ionDir, 0) == -1)
+            {
+                string tmpDir = popt->ionDir;
 #ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + tmpDir;
+                string cmd = "mkdir " + tmpDir;
 #else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + tmpDir;
+                string cmd = "mkdir -p " + tmpDir;
 #endif
-            std::system(cmd.c_str());
-        }
+                std::system(cmd.c_str());
+            }
 
-        GetDcbCode(popt->ts, popt->dcbDir, "P1P2", fopt);
-        GetDcbCode(popt->ts, popt->dcbDir, "P1C1", fopt);
-        GetDcbCode(popt->ts, popt->dcbDir, "P2C2", fopt);
-        GetDcbMgex(popt->ts, popt->dcbDir, fopt);
-    }
+            GetRoti(popt->ts, popt->ionDir, fopt);
+        }
+        break;
 
-    /* global ionosphere map (GIM) downloaded */
-    if (fopt->getIon)
-    {
-        /* If the directory does not exist, creat it */
-        if (access(popt->ionDir, 0) == -1)
+    case TASK_TRP:  /* final tropospheric product downloaded */
+        if (fopt->getTrp)
         {
-            string tmpDir = popt->ionDir;
+            /* If the directory does not exist, creat it */
+            if (!_dryRun && access(popt->ztdDir, 0) == -1)
+            {
+                string tmpDir = popt->ztdDir;
 #ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + tmpDir;
+                string cmd = "mkdir " + tmpDir;
 #else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + tmpDir;
+                string cmd = "mkdir -p " + tmpDir;
 #endif
-            std::system(cmd.c_str());
-        }
+                std::system(cmd.c_str());
+            }
 
-        GetIono(popt->ts, popt->ionDir, fopt);
-    }
+            GetTrop(popt->ts, popt->ztdDir, fopt);
+        }
+        break;
 
-    /* Rate of TEC index (ROTI) file downloaded */
-    if (fopt->getRoti)
-    {
-        /* If the directory does not exist, creat it */
-        if (access(popt->ionDir, 0) == -1)
+    case TASK_RTORBCLK:  /* real-time precise orbit and clock products from CNES offline files downloaded */
+        if (fopt->getRtOrbClk)
         {
-            string tmpDir = popt->ionDir;
+            /* creation of sub-directory */
+            char tmpDir[MAXSTRPATH] = { '\0' };
+            char sep = (char)FILEPATHSEP;
+            sprintf(tmpDir, "%s%c%s", popt->sp3Dir, sep, "real_time");
+            string subSp3Dir = tmpDir;
+            /* for sp3 */
+            if (!_dryRun && access(subSp3Dir.c_str(), 0) == -1)
+            {
+                /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + tmpDir;
+                string cmd = "mkdir " + subSp3Dir;
 #else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + tmpDir;
+                string cmd = "mkdir -p " + subSp3Dir;
 #endif
-            std::system(cmd.c_str());
-        }
+                std::system(cmd.c_str());
+            }
 
-        GetRoti(popt->ts, popt->ionDir, fopt);
-    }
+            GetRtOrbClkCNT(popt->ts, subSp3Dir.c_str(), 1, fopt);  /* sp3 */
 
-    /* final tropospheric product downloaded */
-    if (fopt->getTrp)
-    {
-        /* If the directory does not exist, creat it */
-        if (access(popt->ztdDir, 0) == -1)
-        {
-            string tmpDir = popt->ztdDir;
+            /* creation of sub-directory */
+            sprintf(tmpDir, "%s%c%s", popt->clkDir, sep, "real_time");
+            string subClkDir = tmpDir;
+            /* for clk */
+            if (!_dryRun && access(subClkDir.c_str(), 0) == -1)
+            {
+                /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + tmpDir;
+                string cmd = "mkdir " + subClkDir;
 #else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + tmpDir;
+                string cmd = "mkdir -p " + subClkDir;
 #endif
-            std::system(cmd.c_str());
-        }
+                std::system(cmd.c_str());
+            }
 
-        GetTrop(popt->ts, popt->ztdDir, fopt);
-    }
+            GetRtOrbClkCNT(popt->ts, subClkDir.c_str(), 2, fopt);  /* clk */
 
-    /* real-time precise orbit and clock products from CNES offline files downloaded */
-    if (fopt->getRtOrbClk)
-    {
-        /* creation of sub-directory */
-        char tmpDir[MAXSTRPATH] = { '\0' };
-        char sep = (char)FILEPATHSEP;
-        sprintf(tmpDir, "%s%c%s", popt->sp3Dir, sep, "real_time");
-        string subSp3Dir = tmpDir;
-        /* for sp3 */
-        if (access(subSp3Dir.c_str(), 0) == -1)
+            if (fopt->minusAdd1day)
+            {
+                TimeUtil tu;
+                gtime_t tt;
+                /* real-time precise orbit and clock files downloaded for the day before */
+                tt = tu.TimeAdd(popt->ts, -86400.0);
+                GetRtOrbClkCNT(tt, subSp3Dir.c_str(), 1, fopt);
+                GetRtOrbClkCNT(tt, subClkDir.c_str(), 2, fopt);
+
+                /* real-time precise orbit and clock files downloaded for the day after */
+                tt = tu.TimeAdd(popt->ts, 86400.0);
+                GetRtOrbClkCNT(tt, subSp3Dir.c_str(), 1, fopt);
+                GetRtOrbClkCNT(tt, subClkDir.c_str(), 2, fopt);
+            }
+        }
+        break;
+
+    case TASK_RTBIAS:  /* real-time code and phase bias products from CNES offline files downloaded */
+        if (fopt->getRtBias)
         {
             /* If the directory does not exist, creat it */
+            if (!_dryRun && access(popt->biaDir, 0) == -1)
+            {
+                string tmpDir = popt->biaDir;
 #ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + subSp3Dir;
+                string cmd = "mkdir " + tmpDir;
 #else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + subSp3Dir;
+                string cmd = "mkdir -p " + tmpDir;
 #endif
-            std::system(cmd.c_str());
-        }
+                std::system(cmd.c_str());
+            }
 
-        GetRtOrbClkCNT(popt->ts, subSp3Dir.c_str(), 1, fopt);  /* sp3 */
+            GetRtBiasCNT(popt->ts, popt->biaDir, fopt);
+        }
+        break;
 
-        /* creation of sub-directory */
-        sprintf(tmpDir, "%s%c%s", popt->clkDir, sep, "real_time");
-        string subClkDir = tmpDir;
-        /* for clk */
-        if (access(subClkDir.c_str(), 0) == -1)
+    case TASK_ATX:  /* IGS ANTEX file downloaded */
+        if (fopt->getAtx)
         {
             /* If the directory does not exist, creat it */
+            if (!_dryRun && access(popt->tblDir, 0) == -1)
+            {
+                string tmpDir = popt->tblDir;
 #ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + subClkDir;
+                string cmd = "mkdir " + tmpDir;
 #else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + subClkDir;
+                string cmd = "mkdir -p " + tmpDir;
 #endif
-            std::system(cmd.c_str());
+                std::system(cmd.c_str());
+            }
+
+            GetAntexIGS(popt->ts, popt->tblDir, fopt);
         }
+        break;
+    default:
+        break;
+    }
+} /* end of RunTask */
 
-        GetRtOrbClkCNT(popt->ts, subClkDir.c_str(), 2, fopt);  /* clk */
+/**
+* @brief     : FtpDownload - GNSS data downloading via FTP
+* @param[I]  : popt (processing options)
+* @param[I/O]: fopt (FTP options)
+* @return    : none
+* @note      :
+**/
+void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t *fopt)
+{
+    /* Get FTP archive for CDDIS, IGN, or WHU */
+    init();
 
-        if (fopt->minusAdd1day)
-        {
-            TimeUtil tu;
-            gtime_t tt;
-            /* real-time precise orbit and clock files downloaded for the day before */
-            tt = tu.TimeAdd(popt->ts, -86400.0);
-            GetRtOrbClkCNT(tt, subSp3Dir.c_str(), 1, fopt);
-            GetRtOrbClkCNT(tt, subClkDir.c_str(), 2, fopt);
-
-            /* real-time precise orbit and clock files downloaded for the day after */
-            tt = tu.TimeAdd(popt->ts, 86400.0);
-            GetRtOrbClkCNT(tt, subSp3Dir.c_str(), 1, fopt);
-            GetRtOrbClkCNT(tt, subClkDir.c_str(), 2, fopt);
-        }
+    /* setting of the third-party softwares (.i.e, gzip, crx2rnx etc.) */
+    StringUtil str;
+    if (fopt->isPath3party)  /* the path of third-party softwares is NOT set in the environmental variable */
+    {
+        char cmdTmp[MAXCHARS] = { '\0' };
+        char sep = (char)FILEPATHSEP;
+
+        /* for gzip */
+        sprintf(cmdTmp, "%s%c%s", fopt->dir3party, sep, "gzip");
+        str.TrimSpace(cmdTmp);
+        str.CutFilePathSep(cmdTmp);
+        strcpy(fopt->gzipFull, cmdTmp);
+
+        /* for crx2rnx */
+        sprintf(cmdTmp, "%s%c%s", fopt->dir3party, sep, "crx2rnx");
+        str.TrimSpace(cmdTmp);
+        str.CutFilePathSep(cmdTmp);
+        strcpy(fopt->crx2rnxFull, cmdTmp);
     }
+    else  /* the path of third-party softwares is set in the environmental variable */
+    {
+        str.SetStr(fopt->gzipFull, "gzip", 5);
+        str.SetStr(fopt->crx2rnxFull, "crx2rnx", 8);
+    }
+
+    /* '*.gz' and '*.Z' are inflated while they are received, and Compact RINEX is converted to RINEX on the fly */
+    _curl.SetInflate(true);
+    _curl.SetCrx2Rnx(true);
+
+    /* the observation files are (not) written as '*.yyo.gz' by the decoder directly */
+    _gzipObs = fopt->gzipObs;
+    _curl.SetRnxGzip(fopt->gzipObs ? fopt->gzipThreads : 0);
+    _crx.SetZipThreads(fopt->gzipThreads);
+
+    /* the compressed Compact RINEX files are (not) kept as they are downloaded, to be read by RnxReader */
+    _keepCrx = fopt->keepCrx;
+    _curl.SetKeepCrx(fopt->keepCrx);
+
+    /* (not) print the information of each transfer */
+    _curl.SetVerbose(fopt->printInfoWget);
+
+    /* the remote directory listings are cached in memory, and (optionally) on disk under 'mainDir' */
+    string listDir = popt->mainDir;
+    listDir = listDir + (char)FILEPATHSEP + "listing_cache";
+    _curl.SetListCache(listDir, fopt->listCacheTtl);
+
+    /* the slow transfer is hedged by a duplicate request to the mirror archive */
+    if (fopt->hedgeMirror) _curl.SetHedge(fopt->hedgeDelay, fopt->hedgeSpeed * 1024.0);
+
+    /* the large file of HTTP(S), i.e., weekly SINEX and high-rate CLK files, is downloaded in segments */
+    _curl.SetSegment(fopt->segCount, fopt->segMinSize * 1024.0 * 1024.0);
+
+    /* the files matched in one remote directory, i.e., hourly observations, are multiplexed in one event loop */
+    _curl.SetMulti(fopt->multiXfer, fopt->maxHostConn);
+
+    /* the received data are inflated and converted by the conversion threads, so the loop thread only receives them */
+    _curl.SetConvThreads(fopt->convThreads);
+
+    /* the files are (not) only added to the download plan of the dry run, which changes nothing on the disk */
+    _dryRun = fopt->dryRun;
+    _curl.SetDryRun(fopt->dryRun);
 
-    /* real-time code and phase bias products from CNES offline files downloaded */
-    if (fopt->getRtBias)
+    /* the downloads are (not) journaled, and the files verified by the run before are skipped */
+    if (fopt->journal)
     {
         /* If the directory does not exist, creat it */
-        if (access(popt->biaDir, 0) == -1)
+        string tmpDir = popt->mainDir;
+        if (!_dryRun && access(tmpDir.c_str(), 0) == -1)
         {
-            string tmpDir = popt->biaDir;
 #ifdef _WIN32   /* for Windows */
             string cmd = "mkdir " + tmpDir;
 #else           /* for Linux or Mac */
@@ -5678,24 +5776,70 @@ void FtpUtil::FtpDownload(const prcopt_t *popt, ftpopt_t *fopt)
             std::system(cmd.c_str());
         }
 
-        GetRtBiasCNT(popt->ts, popt->biaDir, fopt);
+        string jnlFile = popt->mainDir;
+        jnlFile = jnlFile + (char)FILEPATHSEP + "download_journal.txt";
+        _curl.OpenJournal(jnlFile);
     }
 
-    /* IGS ANTEX file downloaded */
-    if (fopt->getAtx)
+    /* the health history of the hosts, which is used for 'ftpFrom = auto' */
+    string healthFile = popt->mainDir;
+    healthFile = healthFile + (char)FILEPATHSEP + "host_health.txt";
+    _curl.LoadHealth(healthFile);
+
+    /* the delays of the products after their nominal epochs, which predict the publication windows for the daemon */
+    if (_daemon)
     {
-        /* If the directory does not exist, creat it */
-        if (access(popt->tblDir, 0) == -1)
-        {
-            string tmpDir = popt->tblDir;
-#ifdef _WIN32   /* for Windows */
-            string cmd = "mkdir " + tmpDir;
-#else           /* for Linux or Mac */
-            string cmd = "mkdir -p " + tmpDir;
-#endif
-            std::system(cmd.c_str());
-        }
+        string latencyFile = popt->mainDir;
+        latencyFile = latencyFile + (char)FILEPATHSEP + "latency_model.txt";
+        _curl.LoadLatency(latencyFile);
+    }
 
-        GetAntexIGS(popt->ts, popt->tblDir, fopt);
+    /* the bandwidth limit of all the downloads, which is shared by the days in parallel and the backfill lane */
+    CurlUtil::SetRateLimit(fopt->bandwidth * 1.0E6 / 8.0);
+
+    /* the tasks are run by priority class, i.e., the small products critical for PPP first, then the other
+       products, and the observations at last */
+    vector<int> tasks;
+    for (int i = 0; i < NTASK; i++) tasks.push_back(i);
+    if (fopt->schedPriority) std::stable_sort(tasks.begin(), tasks.end(), [](int a, int b) { return TASK_PRIO[a] < TASK_PRIO[b]; });
+    for (size_t i = 0; i < tasks.size(); i++)
+    {
+        /* the backfill lane yields to the task due of the daemon, which is the real-time front */
+        if (!IsDue(tasks[i], popt, fopt)) continue;
+        _curl.SetTask(_daemon ? TASK_NAMES[tasks[i]] : "");
+        if (_daemon) CurlUtil::SetFrontBusy(true);
+        RunTask(tasks[i], popt, fopt);
+        if (_daemon) CurlUtil::SetFrontBusy(false);
     }
-} /* end of FtpDownload */
\ No newline at end of file
+    _curl.SetTask("");
+
+    /* update the latency model of the daemon, while the health history of the hosts is written once by the
+       caller after all the days */
+    if (_daemon) _curl.SaveLatency();
+} /* end of FtpDownload */
+
+/**
+* @brief   : SetDaemon - (not) run only the tasks due, for the daemon calling FtpDownload round by round
+* @param[I]: daemon (true: the task is run if it is due by the publication cadence of its product,
+*            false: all the tasks are run)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void FtpUtil::SetDaemon(bool daemon)
+{
+    _daemon = daemon;
+} /* end of SetDaemon */
+
+/**
+* @brief   : SetBackfill - run all the downloads in the backfill lane, which yields to the real-time front
+* @param[I]: bps (bandwidth cap of the lane (bytes/s), <= 0: none)
+* @param[O]: none
+* @return  : none
+* @note    : the cap is shared by all the downloaders of the lane in the process
+**/
+void FtpUtil::SetBackfill(double bps)
+{
+    CurlUtil::SetLaneLimit(bps);
+    _curl.SetBackfill(true);
+} /* end of SetBackfill */
\ No newline at end of file
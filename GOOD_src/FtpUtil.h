@@ -14,6 +14,15 @@ private:
         std::vector<string> WHU;    /* WHU FTP */
     };
     ftpArchive_t _ftpArchive;
+    CurlUtil _curl;               /* in-process HTTP(S)/FTP(S) transfer engine */
+    ZipUtil _zip;                 /* in-process decompression of the downloaded files */
+    CrxUtil _crx;                 /* in-process conversion of Compact RINEX to RINEX */
+    bool _gzipObs;                /* the observation files are written as '*.yyo.gz' */
+    bool _keepCrx;                /* the observation files are kept as the compressed Compact RINEX files '*.yyd.gz' */
+    bool _daemon;                 /* only the tasks due by the publication cadences of their products are run */
+    std::map<string, time_t> _polled;  /* time of the last poll of the daemon, key: "task yyyy doy" */
+    bool _dryRun;                 /* the downloads are only planned, so no directory is created */
+    string _workDir;              /* directory of the local files of the task, instead of the working directory of the process */
 
 private:
 
@@ -26,6 +35,87 @@ private:
     **/
     void init();
 
+    /**
+    * @brief   : SelectArchive - select the FTP archive (CDDIS, IGN, or WHU) for the product
+    * @param[I]: idx (index of the product, i.e., IDX_OBSD, IDX_SP3, ...)
+    * @param[I]: arcs (archives supported by the caller for the product, i.e., ARC_CDDIS | ARC_IGN, ARC_ALL)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : name of the archive in upper case
+    * @note    : for 'ftpFrom = auto', the archive with the shortest expected completion time in the
+    *            health history is selected among the ones supported, and the one never used for the
+    *            product is tried first
+    **/
+    string SelectArchive(int idx, int arcs, const ftpopt_t *fopt);
+
+    /**
+    * @brief   : IsDue - check whether the task of the day is due to be polled by the daemon
+    * @param[I]: task (task of downloading, i.e., TASK_OBS, TASK_ORBCLK, ...)
+    * @param[I]: popt (processing options)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : true: the task is run (and its poll is recorded), false: it was polled recently
+    * @note    : it is always true out of the daemon
+    **/
+    bool IsDue(int task, const prcopt_t *popt, const ftpopt_t *fopt);
+
+    /**
+    * @brief   : GetMaxParallel - get the maximum number of sites downloaded in parallel from the archive
+    * @param[I]: arcName (archive name, i.e., "CDDIS", "IGN", "WHU", "CUT", "GA", "HK", "NGS", or "EPN")
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : maximum number of sites in flight
+    * @note    : the setting for the archive in 'maxParallel' is used first, and then the default one
+    **/
+    int GetMaxParallel(const string &arcName, const ftpopt_t *fopt);
+
+    /**
+    * @brief   : RenameRnx - rename the RINEX file converted from Compact RINEX while it was received to the 'o' file
+    * @param[I]: rnxFile (local file downloaded, which is '*.rnx' or '*.rnx.gz' if it has been converted)
+    * @param[I]: oFile ('o' file)
+    * @param[O]: none
+    * @return  : true: 'oFile' exists, false: 'rnxFile' has not been converted
+    * @note    :
+    **/
+    bool RenameRnx(const string &rnxFile, const string &oFile);
+
+    /**
+    * @brief   : ObsFile - get the observation file written for the 'o' file
+    * @param[I]: oFile ('o' file)
+    * @param[O]: none
+    * @return  : 'oFile', or '<oFile>.gz' if the observation files are compressed, in the directory of the task
+    * @note    :
+    **/
+    string ObsFile(const string &oFile);
+
+    /**
+    * @brief   : LocalFile - get the path of the local file in the directory of the task
+    * @param[I]: file (local file)
+    * @param[O]: none
+    * @return  : '<_workDir>/<file>' if 'file' is a bare name, otherwise 'file'
+    * @note    : the days downloaded in parallel have their own directories, so the working directory of the
+    *            process is never changed
+    **/
+    string LocalFile(const string &file);
+
+    /**
+    * @brief   : GetMaxConvert - get the number of threads unpacking and converting the files downloaded in 'all' mode
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : number of threads, which is the number of hardware threads of the machine
+    * @note    :
+    **/
+    int GetMaxConvert();
+
+    /**
+    * @brief   : GroupBySite - group the local files by the site, i.e., the first four characters of the file name
+    * @param[I]: files (local files)
+    * @param[O]: sitFiles (files of each site, in the order of 'files')
+    * @return  : none
+    * @note    : the files of one site are converted to the same 'o' file, so they are handled one by one
+    **/
+    void GroupBySite(const vector<string> &files, vector<vector<string>> &sitFiles);
+
     /**
     * @brief   : GetDailyObsIgs - download IGS RINEX daily observation (30s) files (short name "d") according to 'site.list' file
     * @param[I]: ts (start time)
@@ -325,10 +415,25 @@ private:
     **/
     void GetAntexIGS(gtime_t ts, const char dir[], const ftpopt_t *fopt);
 
+    /**
+    * @brief   : RunTask - run one download task of the observations or products
+    * @param[I]: task (task of downloading, i.e., TASK_OBS, TASK_ORBCLK, ...)
+    * @param[I]: popt (processing options)
+    * @param[I]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void RunTask(int task, const prcopt_t *popt, const ftpopt_t *fopt);
+
 public:
     FtpUtil()
 	{
-
+        _gzipObs = false;
+        _keepCrx = false;
+        _daemon = false;
+        _dryRun = false;
+        _workDir = "";
 	}
 	~FtpUtil()
 	{
@@ -343,4 +448,23 @@ public:
     * @note      :
     **/
     void FtpDownload(const prcopt_t *popt, ftpopt_t *fopt);
+
+    /**
+    * @brief   : SetDaemon - (not) run only the tasks due, for the daemon calling FtpDownload round by round
+    * @param[I]: daemon (true: the task is run if it is due by the publication cadence of its product,
+    *            false: all the tasks are run)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void SetDaemon(bool daemon);
+
+    /**
+    * @brief   : SetBackfill - run all the downloads in the backfill lane, which yields to the real-time front
+    * @param[I]: bps (bandwidth cap of the lane (bytes/s), <= 0: none)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the cap is shared by all the downloaders of the lane in the process
+    **/
+    void SetBackfill(double bps);
 };
\ No newline at end of file
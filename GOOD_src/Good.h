@@ -11,7 +11,23 @@
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <sstream>
 #include <vector>
+#include <map>
+#include <set>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <memory>
+#include <future>
+#include <deque>
+#include <ctime>
+#include <csignal>
+#include <sys/stat.h>
 #ifdef _WIN32  /* for Windows */
 #include <string>
 #include <winsock2.h>
@@ -23,6 +39,7 @@
 #include <math.h>
 #include <unistd.h>
 #include <pthread.h>
+#include <dirent.h>
 #endif
 
 
@@ -33,6 +50,10 @@ using namespace std;
 #define MAXCHARS        1024      /* maximum characters in one line */
 #define MAXSTRPATH      1024      /* max length of stream path */
 
+#define PRIO_CRITICAL   0         /* priority class of the small products needed by PPP, i.e., SP3, CLK, ERP, DCB, ATX */
+#define PRIO_NORMAL     1         /* priority class of the other products, i.e., SINEX, GIM, ROTI, ZTD */
+#define PRIO_BULK       2         /* priority class of the observations */
+
 #ifdef _WIN32  /* for Windows */
 #define FILEPATHSEP '\\'
 #define strcasecmp  _stricmp
@@ -51,7 +72,7 @@ struct gtime_t
 struct ftpopt_t
 {                                 /* the type of GNSS data downloading */
     bool ftpDownloading;          /* the master switch for data downloading, 0:off  1:on, only for data downloading */
-    char ftpFrom[MAXCHARS];       /* FTP archive: CDDIS, IGN, or WHU */
+    char ftpFrom[MAXCHARS];       /* FTP archive: CDDIS, IGN, WHU, or AUTO */
     bool getObs;                  /* (0:off  1:on) IGS observation (RINEX version 2.xx, short name 'd') */
     char obsTyp[MAXCHARS];        /* 'daily', 'hourly', or 'highrate' */
     char obsOpt[MAXCHARS];        /* 'all'; the full path of 'site.list' */
@@ -97,14 +118,38 @@ struct ftpopt_t
     bool getRtOrbClk;             /* (0:off  1:on) real-time precise orbit and clock products from CNES offline files */
     bool getRtBias;               /* (0:off  1:on) real-time code and phase bias products from CNES offline files */
     bool getAtx;                  /* (0:off  1:on) ANTEX format antenna phase center correction */
-    char dir3party[MAXSTRPATH];   /* (optional) the directory where third-party softwares (i.e., 'wget', 'gzip', 'crx2rnx' etc) are stored. This option is not needed if you have set the path or environment variable for them */
+    char dir3party[MAXSTRPATH];   /* (optional) the directory where third-party softwares (i.e., 'gzip', 'crx2rnx' etc) are stored. This option is not needed if you have set the path or environment variable for them */
     bool isPath3party;            /* if true: the path need be set for third-party softwares */
-    char wgetFull[MAXCHARS];      /* if isPath3party == true, set the full path where 'wget' is */
     char gzipFull[MAXCHARS];      /* if isPath3party == true, set the full path where 'gzip' is */
     char crx2rnxFull[MAXCHARS];   /* if isPath3party == true, set the full path where 'crx2rnx' is */
     bool minusAdd1day;            /* (0:off  1:on) the day before and after the current day for precise satellite orbit and clock products downloading */
-    bool printInfoWget;           /* (0:off  1 : on) print the information generated by 'wget' */
-    char qr[MAXCHARS];            /* "-qr" (printInfoWget == false) or "r" (printInfoWget == true) in 'wget' command line */
+    bool printInfoWget;           /* (0:off  1 : on) print the information of each transfer (the name is kept from 'wget' for compatibility) */
+    int maxParallel;              /* maximum number of sites downloaded in parallel for site-by-site observation downloading */
+    std::map<string, int> maxParallelArc;  /* the maximum number of sites downloaded in parallel for the archive, i.e., "CDDIS", "IGN", "WHU", "CUT", "GA", "HK", "NGS", "EPN" */
+    int parallelDays;             /* number of days downloaded at the same time (1: one by one) */
+    bool journal;                 /* (0:off  1:on) the downloads are journaled under 'mainDir' to resume the run killed before */
+    bool daemon;                  /* (0:off  1:on) the current day is polled by the publication cadences of the products until it is stopped */
+    int daemonDays;               /* number of days before the current day polled by the daemon, for the late products */
+    bool backfill;                /* (0:off  1:on) the days of the start time are backfilled newest first in the lane yielding to the daemon */
+    double backfillBw;            /* bandwidth cap of the backfill lane (Mbit/s, 0: unlimited) */
+    bool dryRun;                  /* (0:off  1:on) the downloads are only planned, set by '--dry-run' of the command line */
+    int listCacheTtl;             /* time to live of the on-disk cache of remote directory listings in minutes (0: only cached in memory) */
+    bool hedgeMirror;             /* (0:off  1:on) the slow transfer is hedged by a duplicate request to the mirror archive (CDDIS, IGN, or WHU) */
+    double hedgeDelay;            /* the transfer without data or slower than 'hedgeSpeed' after so long (s) is hedged */
+    double hedgeSpeed;            /* minimum throughput of the transfer (KB/s) */
+    int segCount;                 /* number of segments of the large file of HTTP(S) downloaded concurrently (<= 1: off) */
+    double segMinSize;            /* the file not smaller than it (MB) is downloaded in segments */
+    bool schedPriority;           /* (0:off  1:on) the download tasks are run by priority class, i.e., critical, normal, and bulk */
+    double bandwidth;             /* bandwidth limit of all the downloads of the process (Mbit/s, 0: unlimited) */
+    int multiXfer;                /* maximum number of transfers in flight in the event loop (0: off) */
+    int maxHostConn;              /* maximum number of connections to one host in the event loop */
+    int convThreads;              /* number of threads inflating and converting the files received by the event loop (0: in the loop thread) */
+    bool gzipObs;                 /* (0:off  1:on) the observation files are written as the indexed gzip files '*.yyo.gz' */
+    int gzipThreads;              /* number of threads compressing each observation file */
+    bool keepCrx;                 /* (0:off  1:on) the observation files are kept as the compressed Compact RINEX files '*.yyd.gz' */
+    int rnx2crx;                  /* (0:off  1:'*.yyd'/'*.crx'  2:'*.yyd.gz'/'*.crx.gz') the RINEX files of the list are converted to Compact RINEX */
+    int rnx2crxThreads;           /* number of files converted to Compact RINEX in parallel */
+    char rnx2crxList[MAXCHARS];   /* the full path of the list of the RINEX files, one path per line */
 };
 
 struct prcopt_t
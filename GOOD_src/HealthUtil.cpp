@@ -0,0 +1,145 @@
+/*------------------------------------------------------------------------------
+* HealthUtil.cpp : health history of the hosts for archive selection
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) Group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader)
+*
+* References:
+*    
+*
+* history : 2026/10/16 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "Good.h"
+#include "HealthUtil.h"
+#include "CurlUtil.h"
+
+
+/* constants/macros ----------------------------------------------------------*/
+#define ALPHA           0.2       /* weight of the latest transfer in the moving averages */
+#define MINBYTES        65536.0   /* the transfer smaller than it is not used for the throughput */
+#define DEFSPEED        1.0E6     /* throughput of the host without large transfers (bytes/s) */
+#define MINSUCC         0.05      /* minimum rate of successful transfers */
+
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : Load - read the history of the hosts from the file
+* @param[I]: file (file of the history)
+* @param[O]: none
+* @return  : true: the history is read, false: the file does not exist
+* @note    : the history is written back to the same file by Save
+**/
+bool HealthUtil::Load(const string &file)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    _file = file;
+    _health.clear();
+
+    ifstream healthLst(file.c_str());
+    if (!healthLst.is_open()) return false;
+
+    /* host  class  n  speed  ttfb  errRate  missRate */
+    string line;
+    while (getline(healthLst, line))
+    {
+        if (line.empty() || line[0] == '#') continue;
+        istringstream iss(line);
+        string host, cls;
+        health_t h;
+        if (iss >> host >> cls >> h.n >> h.speed >> h.ttfb >> h.errRate >> h.missRate) _health[host + " " + cls] = h;
+    }
+
+    return true;
+} /* end of Load */
+
+/**
+* @brief   : Save - write the history of the hosts to the file
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void HealthUtil::Save()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    if (_file.empty()) return;
+
+    string tmpFile = _file + ".tmp";
+    ofstream healthLst(tmpFile.c_str());
+    if (!healthLst.is_open())
+    {
+        cerr << "*** ERROR(HealthUtil::Save): open file " << tmpFile << " failed, please check it" << endl;
+
+        return;
+    }
+
+    healthLst << "# host  class  transfers  throughput(bytes/s)  time_to_first_byte(s)  error_rate  missing_rate" << endl;
+    for (auto it = _health.begin(); it != _health.end(); ++it)
+    {
+        const health_t &h = it->second;
+        healthLst << it->first << "  " << fixed << setprecision(0) << h.n << "  " << h.speed << "  " << setprecision(3) <<
+            h.ttfb << "  " << h.errRate << "  " << h.missRate << endl;
+    }
+    healthLst.close();
+
+    remove(_file.c_str());
+    if (rename(tmpFile.c_str(), _file.c_str()) != 0) remove(tmpFile.c_str());
+} /* end of Save */
+
+/**
+* @brief   : Record - record one transfer of the host
+* @param[I]: host (scheme and host of URL, i.e., "ftp://igs.gnsswhu.cn")
+* @param[I]: cls (product class, i.e., "OBSD", "SP3", "ION")
+* @param[I]: stat (XFER_OK, XFER_NOFILE or XFER_FAILED)
+* @param[I]: ttfb (time to first byte (s))
+* @param[I]: nbytes (number of bytes received)
+* @param[I]: secs (time of the whole transfer (s))
+* @return  : none
+* @note    : the exponentially weighted moving averages are used
+**/
+void HealthUtil::Record(const string &host, const string &cls, int stat, double ttfb, double nbytes, double secs)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    string key = host + " " + (cls.empty() ? "ALL" : cls);
+    auto it = _health.find(key);
+    if (it == _health.end())
+    {
+        health_t h = { 0.0, 0.0, ttfb, 0.0, 0.0 };
+        it = _health.insert(std::make_pair(key, h)).first;
+    }
+
+    health_t &h = it->second;
+    h.n += 1.0;
+    h.errRate = (1.0 - ALPHA) * h.errRate + ALPHA * (stat == XFER_FAILED ? 1.0 : 0.0);
+    h.missRate = (1.0 - ALPHA) * h.missRate + ALPHA * (stat == XFER_NOFILE ? 1.0 : 0.0);
+    if (stat == XFER_FAILED) return;
+
+    h.ttfb = (1.0 - ALPHA) * h.ttfb + ALPHA * ttfb;
+    if (stat == XFER_OK && nbytes >= MINBYTES && secs > ttfb)
+    {
+        double speed = nbytes / (secs - ttfb);
+        h.speed = h.speed > 0.0 ? (1.0 - ALPHA) * h.speed + ALPHA * speed : speed;
+    }
+} /* end of Record */
+
+/**
+* @brief   : Expected - get the expected completion time of the transfer from the host
+* @param[I]: host (scheme and host of URL, i.e., "ftp://igs.gnsswhu.cn")
+* @param[I]: cls (product class, i.e., "OBSD", "SP3", "ION")
+* @param[I]: size (size of the file (bytes))
+* @return  : expected completion time (s), 0 if the host has not been used for the class
+* @note    : the time is enlarged by the rate of failed transfers and "file missing"
+**/
+double HealthUtil::Expected(const string &host, const string &cls, double size)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    auto it = _health.find(host + " " + (cls.empty() ? "ALL" : cls));
+    if (it == _health.end()) return 0.0;
+
+    const health_t &h = it->second;
+    double t = h.ttfb + size / (h.speed > 0.0 ? h.speed : DEFSPEED);
+    double succ = 1.0 - h.errRate - h.missRate;
+
+    return t / (succ > MINSUCC ? succ : MINSUCC);
+} /* end of Expected */
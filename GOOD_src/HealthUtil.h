@@ -0,0 +1,71 @@
+/*------------------------------------------------------------------------------
+* HealthUtil.h : header file of HealthUtil.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+class HealthUtil
+{
+private:
+    struct health_t
+    {                             /* health of the host for one product class */
+        double n;                 /* number of transfers recorded */
+        double speed;             /* throughput (bytes/s, 0: unknown) */
+        double ttfb;              /* time to first byte (s) */
+        double errRate;           /* rate of failed transfers */
+        double missRate;          /* rate of "file missing" */
+    };
+    std::mutex _lock;             /* lock of the records shared by all the threads */
+    std::map<string, health_t> _health;  /* key: "host class" */
+    string _file;                 /* file of the history */
+
+public:
+    HealthUtil()
+	{
+
+	}
+	~HealthUtil()
+	{
+
+	}
+
+    /**
+    * @brief   : Load - read the history of the hosts from the file
+    * @param[I]: file (file of the history)
+    * @param[O]: none
+    * @return  : true: the history is read, false: the file does not exist
+    * @note    : the history is written back to the same file by Save
+    **/
+    bool Load(const string &file);
+
+    /**
+    * @brief   : Save - write the history of the hosts to the file
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Save();
+
+    /**
+    * @brief   : Record - record one transfer of the host
+    * @param[I]: host (scheme and host of URL, i.e., "ftp://igs.gnsswhu.cn")
+    * @param[I]: cls (product class, i.e., "OBSD", "SP3", "ION")
+    * @param[I]: stat (XFER_OK, XFER_NOFILE or XFER_FAILED)
+    * @param[I]: ttfb (time to first byte (s))
+    * @param[I]: nbytes (number of bytes received)
+    * @param[I]: secs (time of the whole transfer (s))
+    * @return  : none
+    * @note    : the exponentially weighted moving averages are used
+    **/
+    void Record(const string &host, const string &cls, int stat, double ttfb, double nbytes, double secs);
+
+    /**
+    * @brief   : Expected - get the expected completion time of the transfer from the host
+    * @param[I]: host (scheme and host of URL, i.e., "ftp://igs.gnsswhu.cn")
+    * @param[I]: cls (product class, i.e., "OBSD", "SP3", "ION")
+    * @param[I]: size (size of the file (bytes))
+    * @return  : expected completion time (s), 0 if the host has not been used for the class
+    * @note    : the time is enlarged by the rate of failed transfers and "file missing"
+    **/
+    double Expected(const string &host, const string &cls, double size);
+};
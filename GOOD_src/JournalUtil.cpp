@@ -0,0 +1,224 @@
+/*------------------------------------------------------------------------------
+* JournalUtil.cpp : crash-safe journal of the downloads for resuming the long backfills
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) Group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader)
+*
+* References:
+*    zlib - a massively spiffy yet delicately unobtrusive compression library, https://zlib.net/
+*
+* history : 2026/10/16 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "Good.h"
+#include "JournalUtil.h"
+#include <zlib.h>
+
+
+/* constants/macros ----------------------------------------------------------*/
+#define CHUNK           262144    /* size of the data read at a time for CRC-32 */
+
+
+/* local functions -----------------------------------------------------------*/
+static const char *STATE_NAMES[] = { "pending", "downloading", "decompressed", "converted", "verified" };
+
+/* get the state of its name, -1 if it is unknown */
+static int StateOf(const string &name)
+{
+    for (int i = 0; i < (int)(sizeof(STATE_NAMES) / sizeof(STATE_NAMES[0])); i++)
+    {
+        if (name == STATE_NAMES[i]) return i;
+    }
+
+    return -1;
+}
+
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : Append - append the state of one target to the journal file
+* @param[I]: path (full path of the local file of the target)
+* @param[I]: e (state of the target)
+* @return  : none
+* @note    : the caller holds '_lock'
+**/
+void JournalUtil::Append(const string &path, const entry_t &e)
+{
+    if (!_fp) return;
+
+    /* time  state  size  crc32  url  path  file */
+    fprintf(_fp, "%s  %s  %lld  %08lx  %s  %s  %s\n", e.time.c_str(), STATE_NAMES[e.state], e.size, e.crc, e.url.c_str(),
+        path.c_str(), e.file.empty() ? "-" : e.file.c_str());
+    fflush(_fp);
+} /* end of Append */
+
+/**
+* @brief   : Open - read the journal and open it for appending the states of the targets
+* @param[I]: file (file of the journal)
+* @param[I]: readOnly (true: the journal is only read and left as it is, false: it is opened for appending)
+* @param[O]: none
+* @return  : true: OK, false: the file failed to be opened
+* @note    : the journal is compacted to the latest state of each target when it is opened, and it is
+*            opened only once, so the later calls return at once
+**/
+bool JournalUtil::Open(const string &file, bool readOnly)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    if (_fp || _readOnly) return true;
+
+    /* the latest line of the target overrides the former ones, and the incomplete last line is skipped */
+    _entries.clear();
+    ifstream jnlLst(file.c_str());
+    string line;
+    while (jnlLst.is_open() && getline(jnlLst, line))
+    {
+        if (line.empty() || line[0] == '#') continue;
+        istringstream iss(line);
+        string name, crc, path, fname;
+        entry_t e;
+        if (!(iss >> e.time >> name >> e.size >> crc >> e.url >> path >> fname)) continue;
+        e.state = StateOf(name);
+        if (e.state < 0) continue;
+        e.crc = strtoul(crc.c_str(), NULL, 16);
+        e.file = fname == "-" ? "" : fname;
+        _entries[path] = e;
+    }
+    jnlLst.close();
+    _file = file;
+    if (readOnly)
+    {
+        _readOnly = true;
+
+        return true;
+    }
+
+    /* the compacted journal replaces the old one at once */
+    string tmpFile = _file + ".tmp";
+    _fp = fopen(tmpFile.c_str(), "w");
+    if (!_fp)
+    {
+        cerr << "*** ERROR(JournalUtil::Open): open file " << tmpFile << " failed, please check it" << endl;
+
+        return false;
+    }
+    fprintf(_fp, "# time  state  size  crc32  url  local_file  final_file\n");
+    for (auto it = _entries.begin(); it != _entries.end(); ++it) Append(it->first, it->second);
+    fclose(_fp);
+    remove(_file.c_str());
+    if (rename(tmpFile.c_str(), _file.c_str()) != 0) remove(tmpFile.c_str());
+
+    _fp = fopen(_file.c_str(), "a");
+    if (!_fp)
+    {
+        cerr << "*** ERROR(JournalUtil::Open): open file " << _file << " failed, please check it" << endl;
+
+        return false;
+    }
+
+    return true;
+} /* end of Open */
+
+/**
+* @brief   : Close - close the journal
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void JournalUtil::Close()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    if (_fp) fclose(_fp);
+    _fp = nullptr;
+    _readOnly = false;
+} /* end of Close */
+
+/**
+* @brief   : IsOpen - check whether the journal is opened
+* @param[I]: none
+* @param[O]: none
+* @return  : true: opened, false: not opened
+* @note    :
+**/
+bool JournalUtil::IsOpen()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    return _fp != nullptr;
+} /* end of IsOpen */
+
+/**
+* @brief   : Record - append the new state of one target to the journal
+* @param[I]: path (full path of the local file of the target)
+* @param[I]: url (remote URL)
+* @param[I]: state (JNL_PENDING, ..., JNL_VERIFIED)
+* @param[I]: file (full path of the file the target ends in, empty: unknown)
+* @param[I]: size (size of 'file', -1: unknown)
+* @param[I]: crc (CRC-32 of 'file')
+* @return  : none
+* @note    : the line is flushed at once, so it survives the killed run
+**/
+void JournalUtil::Record(const string &path, const string &url, int state, const string &file, long long size,
+    unsigned long crc)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    if (!_fp) return;
+
+    char tstr[32];
+    time_t now = time(NULL);
+    strftime(tstr, sizeof(tstr), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+    entry_t e = { state, size, crc, url, file, tstr };
+    _entries[path] = e;
+    Append(path, e);
+} /* end of Record */
+
+/**
+* @brief   : IsVerified - check whether the target has been downloaded and verified before
+* @param[I]: path (full path of the local file of the target)
+* @param[I]: url (remote URL)
+* @return  : true: the latest state is JNL_VERIFIED and its file still has the size recorded, false: otherwise
+* @note    :
+**/
+bool JournalUtil::IsVerified(const string &path, const string &url)
+{
+    entry_t e;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        auto it = _entries.find(path);
+        if ((!_fp && !_readOnly) || it == _entries.end()) return false;
+        e = it->second;
+    }
+    if (e.state != JNL_VERIFIED || e.url != url || e.file.empty()) return false;
+
+    struct stat st;
+
+    return stat(e.file.c_str(), &st) == 0 && (long long)st.st_size == e.size;
+} /* end of IsVerified */
+
+/**
+* @brief   : Checksum - get the size and CRC-32 of the file
+* @param[I]: file (file name)
+* @param[O]: size (size of the file)
+* @param[O]: crc (CRC-32 of the file)
+* @return  : true: OK, false: the file failed to be read
+* @note    :
+**/
+bool JournalUtil::Checksum(const string &file, long long &size, unsigned long &crc)
+{
+    FILE *fp = fopen(file.c_str(), "rb");
+    if (!fp) return false;
+
+    vector<unsigned char> buf(CHUNK);
+    size = 0;
+    crc = crc32(0L, Z_NULL, 0);
+    size_t n;
+    while ((n = fread(buf.data(), 1, CHUNK, fp)) > 0)
+    {
+        crc = crc32(crc, buf.data(), (uInt)n);
+        size += (long long)n;
+    }
+    bool ok = !ferror(fp);
+    fclose(fp);
+
+    return ok;
+} /* end of Checksum */
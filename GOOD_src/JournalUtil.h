@@ -0,0 +1,112 @@
+/*------------------------------------------------------------------------------
+* JournalUtil.h : header file of JournalUtil.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+/* constants/macros ----------------------------------------------------------*/
+#define JNL_PENDING      0        /* the target is planned or to be downloaded again */
+#define JNL_DOWNLOADING  1        /* the target is being downloaded */
+#define JNL_DECOMPRESSED 2        /* the compressed target is saved as the decompressed file */
+#define JNL_CONVERTED    3        /* the Compact RINEX target is saved as the RINEX file */
+#define JNL_VERIFIED     4        /* the file the target ends in is complete, with its size and CRC-32 */
+
+class JournalUtil
+{
+private:
+    struct entry_t
+    {                             /* latest state of one target */
+        int state;                /* JNL_PENDING, ..., JNL_VERIFIED */
+        long long size;           /* size of the file the target ends in (-1: unknown) */
+        unsigned long crc;        /* CRC-32 of the file the target ends in */
+        string url;               /* remote URL */
+        string file;              /* full path of the file the target ends in (empty: unknown) */
+        string time;              /* time of the state in UTC, i.e., "2026-10-16T08:00:00Z" */
+    };
+    std::mutex _lock;             /* lock of the journal shared by all the threads */
+    std::map<string, entry_t> _entries;  /* key: full path of the local file of the target */
+    string _file;                 /* file of the journal */
+    FILE *_fp;                    /* pointer of '_file' opened for appending (nullptr: not opened) */
+    bool _readOnly;               /* the journal is only read, i.e., by the dry run, and never written */
+
+    /**
+    * @brief   : Append - append the state of one target to the journal file
+    * @param[I]: path (full path of the local file of the target)
+    * @param[I]: e (state of the target)
+    * @return  : none
+    * @note    : the caller holds '_lock'
+    **/
+    void Append(const string &path, const entry_t &e);
+
+public:
+    JournalUtil()
+	{
+        _fp = nullptr;
+        _readOnly = false;
+	}
+	~JournalUtil()
+	{
+        Close();
+	}
+
+    /**
+    * @brief   : Open - read the journal and open it for appending the states of the targets
+    * @param[I]: file (file of the journal)
+    * @param[I]: readOnly (true: the journal is only read and left as it is, false: it is opened for appending)
+    * @param[O]: none
+    * @return  : true: OK, false: the file failed to be opened
+    * @note    : the journal is compacted to the latest state of each target when it is opened, and it is
+    *            opened only once, so the later calls return at once
+    **/
+    bool Open(const string &file, bool readOnly = false);
+
+    /**
+    * @brief   : Close - close the journal
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Close();
+
+    /**
+    * @brief   : IsOpen - check whether the journal is opened
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true: opened, false: not opened
+    * @note    :
+    **/
+    bool IsOpen();
+
+    /**
+    * @brief   : Record - append the new state of one target to the journal
+    * @param[I]: path (full path of the local file of the target)
+    * @param[I]: url (remote URL)
+    * @param[I]: state (JNL_PENDING, ..., JNL_VERIFIED)
+    * @param[I]: file (full path of the file the target ends in, empty: unknown)
+    * @param[I]: size (size of 'file', -1: unknown)
+    * @param[I]: crc (CRC-32 of 'file')
+    * @return  : none
+    * @note    : the line is flushed at once, so it survives the killed run
+    **/
+    void Record(const string &path, const string &url, int state, const string &file = "", long long size = -1,
+        unsigned long crc = 0);
+
+    /**
+    * @brief   : IsVerified - check whether the target has been downloaded and verified before
+    * @param[I]: path (full path of the local file of the target)
+    * @param[I]: url (remote URL)
+    * @return  : true: the latest state is JNL_VERIFIED and its file still has the size recorded, false: otherwise
+    * @note    :
+    **/
+    bool IsVerified(const string &path, const string &url);
+
+    /**
+    * @brief   : Checksum - get the size and CRC-32 of the file
+    * @param[I]: file (file name)
+    * @param[O]: size (size of the file)
+    * @param[O]: crc (CRC-32 of the file)
+    * @return  : true: OK, false: the file failed to be read
+    * @note    :
+    **/
+    static bool Checksum(const string &file, long long &size, unsigned long &crc);
+};
@@ -0,0 +1,240 @@
+/*------------------------------------------------------------------------------
+* LatencyUtil.cpp : learned latency model of the publication of the products
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) Group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader)
+*
+* References:
+*    RINEX - The Receiver Independent Exchange Format, Version 3.05 (long file names)
+*
+* history : 2026/10/16 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "Good.h"
+#include "TimeUtil.h"
+#include "LatencyUtil.h"
+
+
+/* constants/macros ----------------------------------------------------------*/
+#define MAXSAMPLES      100       /* maximum number of the latest delays kept for each task and host */
+#define MINSAMPLES      5         /* minimum number of delays of the task for its window */
+#define MAXDELAY        720.0     /* the file seen later than it (hours) is not a new one */
+#define PCTLO           0.1       /* percentile of the delays for the start of the window */
+#define PCTHI           0.9       /* percentile of the delays for the end of the window */
+#define MJD1970         40587     /* MJD of 1970-01-01 */
+
+
+/* local functions -----------------------------------------------------------*/
+
+/* convert the time to seconds since 1970 */
+static double UnixOf(gtime_t tt)
+{
+    return (tt.mjd - MJD1970) * 86400.0 + tt.sod;
+}
+
+/* check whether the n characters of the string from i are all digits */
+static bool IsDigits(const string &s, size_t i, size_t n)
+{
+    if (i + n > s.size()) return false;
+    for (size_t k = i; k < i + n; k++)
+    {
+        if (!isdigit((unsigned char)s[k])) return false;
+    }
+
+    return true;
+}
+
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : Load - read the delays of the products from the file
+* @param[I]: file (file of the model)
+* @param[O]: none
+* @return  : true: the model is read, false: the file does not exist
+* @note    : the model is written back to the same file by Save
+**/
+bool LatencyUtil::Load(const string &file)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    _file = file;
+    _delays.clear();
+    _dirty = false;
+
+    ifstream latLst(file.c_str());
+    if (!latLst.is_open()) return false;
+
+    /* task  host  n  delay1  delay2  ... */
+    string line;
+    while (getline(latLst, line))
+    {
+        if (line.empty() || line[0] == '#') continue;
+        istringstream iss(line);
+        string task, host;
+        int n = 0;
+        if (!(iss >> task >> host >> n)) continue;
+        std::deque<double> &delays = _delays[task + " " + host];
+        double d;
+        for (int i = 0; i < n && iss >> d; i++) delays.push_back(d);
+        while (delays.size() > MAXSAMPLES) delays.pop_front();
+    }
+
+    return true;
+} /* end of Load */
+
+/**
+* @brief   : Save - write the delays of the products to the file if they have been changed
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void LatencyUtil::Save()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    if (_file.empty() || !_dirty) return;
+
+    string tmpFile = _file + ".tmp";
+    ofstream latLst(tmpFile.c_str());
+    if (!latLst.is_open())
+    {
+        cerr << "*** ERROR(LatencyUtil::Save): open file " << tmpFile << " failed, please check it" << endl;
+
+        return;
+    }
+
+    latLst << "# task  host  n  delays_after_the_nominal_epochs(h) ..." << endl;
+    for (auto it = _delays.begin(); it != _delays.end(); ++it)
+    {
+        latLst << it->first << "  " << it->second.size() << fixed << setprecision(3);
+        for (size_t i = 0; i < it->second.size(); i++) latLst << "  " << it->second[i];
+        latLst << endl;
+    }
+    latLst.close();
+
+    remove(_file.c_str());
+    if (rename(tmpFile.c_str(), _file.c_str()) != 0) remove(tmpFile.c_str());
+    _dirty = false;
+} /* end of Save */
+
+/**
+* @brief   : Record - record the delay of the new file after its nominal epoch
+* @param[I]: task (download task, i.e., "OBS", "ORBCLK", "NAV")
+* @param[I]: host (scheme and host of URL, i.e., "ftp://igs.gnsswhu.cn")
+* @param[I]: epoch (nominal epoch of the file (s since 1970))
+* @param[I]: seen (time the file is first seen (s since 1970))
+* @return  : none
+* @note    : only the latest delays of each task and host are kept
+**/
+void LatencyUtil::Record(const string &task, const string &host, double epoch, double seen)
+{
+    double delay = (seen - epoch) / 3600.0;
+    if (delay < 0.0 || delay > MAXDELAY) return;
+
+    std::lock_guard<std::mutex> lock(_lock);
+    std::deque<double> &delays = _delays[task + " " + host];
+    delays.push_back(delay);
+    while (delays.size() > MAXSAMPLES) delays.pop_front();
+    if (epoch > _latest[task]) _latest[task] = epoch;
+    _dirty = true;
+} /* end of Record */
+
+/**
+* @brief   : Window - get the publication window of the task predicted by the delays of all its hosts
+* @param[I]: task (download task, i.e., "OBS", "ORBCLK", "NAV")
+* @param[O]: lo (start of the window after the nominal epoch (hours))
+* @param[O]: hi (end of the window after the nominal epoch (hours))
+* @return  : true: OK, false: too few delays have been recorded
+* @note    : the window is between the low and high percentiles of the delays
+**/
+bool LatencyUtil::Window(const string &task, double *lo, double *hi)
+{
+    vector<double> delays;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        string prefix = task + " ";
+        for (auto it = _delays.lower_bound(prefix); it != _delays.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it)
+            delays.insert(delays.end(), it->second.begin(), it->second.end());
+    }
+    if (delays.size() < MINSAMPLES) return false;
+
+    std::sort(delays.begin(), delays.end());
+    size_t n = delays.size() - 1;
+    *lo = delays[(size_t)floor(PCTLO * n)];
+    *hi = delays[(size_t)ceil(PCTHI * n)];
+
+    return true;
+} /* end of Window */
+
+/**
+* @brief   : Latest - get the latest nominal epoch of the new files of the task in this run
+* @param[I]: task (download task, i.e., "OBS", "ORBCLK", "NAV")
+* @return  : latest nominal epoch (s since 1970), 0 if no new file has been seen
+* @note    :
+**/
+double LatencyUtil::Latest(const string &task)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    auto it = _latest.find(task);
+
+    return it == _latest.end() ? 0.0 : it->second;
+} /* end of Latest */
+
+/**
+* @brief   : EpochOf - get the nominal epoch of the file from its name
+* @param[I]: file (file name with or without path, i.e., "abmf288a.24d.gz", "igu24404_06.sp3.Z",
+*            "WUM0MGXULT_20242880100_01D_05M_ORB.SP3.gz")
+* @param[O]: epoch (nominal epoch (s since 1970))
+* @return  : true: OK, false: the name has no epoch known
+* @note    : the long names of RINEX 3, the short names of RINEX 2 and the names of the products by GPS
+*            week and day are supported
+**/
+bool LatencyUtil::EpochOf(const string &file, double *epoch)
+{
+    size_t pos = file.find_last_of("/\\");
+    string name = pos == string::npos ? file : file.substr(pos + 1);
+    TimeUtil tu;
+
+    /* long name, i.e., "ABMF00GLP_R_20242880000_01D_30S_MO.crx.gz", with '_YYYYDDDHHMM_' */
+    for (size_t i = name.find('_'); i != string::npos; i = name.find('_', i + 1))
+    {
+        if (!IsDigits(name, i + 1, 11) || i + 12 >= name.size() || name[i + 12] != '_') continue;
+        int yyyy = atoi(name.substr(i + 1, 4).c_str()), doy = atoi(name.substr(i + 5, 3).c_str());
+        int hh = atoi(name.substr(i + 8, 2).c_str()), mm = atoi(name.substr(i + 10, 2).c_str());
+        if (doy < 1 || doy > 366 || hh > 23 || mm > 59) return false;
+        *epoch = UnixOf(tu.yrdoy2time(yyyy, doy)) + hh * 3600.0 + mm * 60.0;
+
+        return true;
+    }
+
+    size_t dot = name.find('.');
+    if (dot == string::npos) return false;
+
+    /* short name, i.e., "abmf2880.24d", "abmf288a.24d" (hourly) or "abmf288a15.24d" (high-rate) */
+    if ((dot == 8 || dot == 10) && IsDigits(name, 4, 3) && IsDigits(name, dot + 1, 2) && dot + 3 < name.size() &&
+        isalpha((unsigned char)name[dot + 3]))
+    {
+        int doy = atoi(name.substr(4, 3).c_str());
+        char h = (char)tolower((unsigned char)name[7]);
+        if (doy < 1 || doy > 366 || (h != '0' && (h < 'a' || h > 'x'))) return false;
+        if (dot == 10 && !IsDigits(name, 8, 2)) return false;
+        int yy = atoi(name.substr(dot + 1, 2).c_str()), yyyy = yy <= 50 ? yy + 2000 : yy + 1900;
+        int hh = h == '0' ? 0 : h - 'a', mm = dot == 10 ? atoi(name.substr(8, 2).c_str()) : 0;
+        *epoch = UnixOf(tu.yrdoy2time(yyyy, doy)) + hh * 3600.0 + mm * 60.0;
+
+        return true;
+    }
+
+    /* product by GPS week and day, i.e., "igs20855.sp3", "igs20857.erp" (weekly) or "igu24404_06.sp3" */
+    if ((dot == 8 || (dot == 11 && name[8] == '_' && IsDigits(name, 9, 2))) && isalpha((unsigned char)name[0]) &&
+        IsDigits(name, 3, 5))
+    {
+        int week = atoi(name.substr(3, 4).c_str()), dow = name[7] - '0';
+        int hh = dot == 11 ? atoi(name.substr(9, 2).c_str()) : 0;
+        if (dow > 7 || hh > 23) return false;
+        *epoch = UnixOf(tu.gpst2time(week, (dow == 7 ? 0 : dow) * 86400.0)) + hh * 3600.0;
+
+        return true;
+    }
+
+    return false;
+} /* end of EpochOf */
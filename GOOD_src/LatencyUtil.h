@@ -0,0 +1,82 @@
+/*------------------------------------------------------------------------------
+* LatencyUtil.h : header file of LatencyUtil.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+class LatencyUtil
+{
+private:
+    std::mutex _lock;             /* lock of the model shared by all the threads */
+    std::map<string, std::deque<double>> _delays;  /* key: "task host", delays (hours) of the latest new files */
+    std::map<string, double> _latest;  /* key: task, latest nominal epoch of the new files (s since 1970) */
+    string _file;                 /* file of the model */
+    bool _dirty;                  /* the model has been changed since it was read */
+
+public:
+    LatencyUtil()
+	{
+        _dirty = false;
+	}
+	~LatencyUtil()
+	{
+
+	}
+
+    /**
+    * @brief   : Load - read the delays of the products from the file
+    * @param[I]: file (file of the model)
+    * @param[O]: none
+    * @return  : true: the model is read, false: the file does not exist
+    * @note    : the model is written back to the same file by Save
+    **/
+    bool Load(const string &file);
+
+    /**
+    * @brief   : Save - write the delays of the products to the file if they have been changed
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Save();
+
+    /**
+    * @brief   : Record - record the delay of the new file after its nominal epoch
+    * @param[I]: task (download task, i.e., "OBS", "ORBCLK", "NAV")
+    * @param[I]: host (scheme and host of URL, i.e., "ftp://igs.gnsswhu.cn")
+    * @param[I]: epoch (nominal epoch of the file (s since 1970))
+    * @param[I]: seen (time the file is first seen (s since 1970))
+    * @return  : none
+    * @note    : only the latest delays of each task and host are kept
+    **/
+    void Record(const string &task, const string &host, double epoch, double seen);
+
+    /**
+    * @brief   : Window - get the publication window of the task predicted by the delays of all its hosts
+    * @param[I]: task (download task, i.e., "OBS", "ORBCLK", "NAV")
+    * @param[O]: lo (start of the window after the nominal epoch (hours))
+    * @param[O]: hi (end of the window after the nominal epoch (hours))
+    * @return  : true: OK, false: too few delays have been recorded
+    * @note    : the window is between the low and high percentiles of the delays
+    **/
+    bool Window(const string &task, double *lo, double *hi);
+
+    /**
+    * @brief   : Latest - get the latest nominal epoch of the new files of the task in this run
+    * @param[I]: task (download task, i.e., "OBS", "ORBCLK", "NAV")
+    * @return  : latest nominal epoch (s since 1970), 0 if no new file has been seen
+    * @note    :
+    **/
+    double Latest(const string &task);
+
+    /**
+    * @brief   : EpochOf - get the nominal epoch of the file from its name
+    * @param[I]: file (file name with or without path, i.e., "abmf288a.24d.gz", "igu24404_06.sp3.Z",
+    *            "WUM0MGXULT_20242880100_01D_05M_ORB.SP3.gz")
+    * @param[O]: epoch (nominal epoch (s since 1970))
+    * @return  : true: OK, false: the name has no epoch known
+    * @note    : the long names of RINEX 3, the short names of RINEX 2 and the names of the products by GPS
+    *            week and day are supported
+    **/
+    static bool EpochOf(const string &file, double *epoch);
+};
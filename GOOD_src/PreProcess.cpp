@@ -14,16 +14,33 @@
 #include "Good.h"
 #include "StringUtil.h"
 #include "TimeUtil.h"
+#include "HealthUtil.h"
+#include "ZipUtil.h"
+#include "CrxUtil.h"
+#include "CurlUtil.h"
 #include "FtpUtil.h"
+#include "ThreadUtil.h"
 #include "PreProcess.h"
 
 
 /* constants/macros ----------------------------------------------------------*/
 #define MIN(x,y)    ((x) <= (y) ? (x) : (y))
+#define DAEMONTICK  60          /* interval of the rounds of the daemon (s) */
+
+
+/* global variables ----------------------------------------------------------*/
+static volatile sig_atomic_t _stop = 0;  /* the daemon is stopped after the current round */
 
 
 /* function definition -------------------------------------------------------*/
 
+/* stop the daemon after the current round, and the second signal terminates it at once */
+static void OnSignal(int sig)
+{
+    _stop = 1;
+    signal(sig, SIG_DFL);
+}
+
 /**
 * @brief   : init - some initializations before processing
 * @param[O]: popt (processing options)
@@ -65,18 +82,42 @@ void PreProcess::init(prcopt_t *popt, ftpopt_t *fopt)
     popt->ndays = 1;                             /* number of consecutive days */
     
     /* FTP downloading settings */
-    str.SetStr(fopt->dir3party, "", 1);          /* (optional) the directory where third-party softwares (i.e., 'wget', 'gzip', 'crx2rnx' etc) are stored. This option is not needed if you have set the path or environment variable for them */
+    str.SetStr(fopt->dir3party, "", 1);          /* (optional) the directory where third-party softwares (i.e., 'gzip', 'crx2rnx' etc) are stored. This option is not needed if you have set the path or environment variable for them */
     fopt->isPath3party = false;                  /* if true: the path need be set for third-party softwares */
-    str.SetStr(fopt->wgetFull, "", 1);           /* if isPath3party == true, set the full path where 'wget' is */
     str.SetStr(fopt->gzipFull, "", 1);           /* if isPath3party == true, set the full path where 'gzip' is */
     str.SetStr(fopt->crx2rnxFull, "", 1);        /* if isPath3party == true, set the full path where 'crx2rnx' is */
     fopt->minusAdd1day = true;                   /* (0:off  1:on) the day before and after the current day for precise satellite orbit and clock products downloading */
-    fopt->printInfoWget = false;                 /* (0:off  1:on) print the information generated by 'wget' */
-    str.SetStr(fopt->qr, "", 1);                 /* '-qr' (printInfoWget == false) or '-r' (printInfoWget == true) in 'wget' command line */
+    fopt->printInfoWget = false;                 /* (0:off  1:on) print the information of each transfer */
+    fopt->maxParallel = 1;                       /* maximum number of sites downloaded in parallel for site-by-site observation downloading */
+    fopt->maxParallelArc.clear();                /* the maximum number of sites downloaded in parallel for the archive */
+    fopt->parallelDays = 1;                      /* number of days downloaded at the same time */
+    fopt->journal = false;                       /* (0:off  1:on) the downloads are journaled under 'mainDir' */
+    fopt->daemon = false;                        /* (0:off  1:on) the current day is polled until it is stopped */
+    fopt->daemonDays = 1;                        /* number of days before the current day polled by the daemon */
+    fopt->backfill = false;                      /* (0:off  1:on) the days of the start time are backfilled by the daemon */
+    fopt->backfillBw = 0.0;                      /* bandwidth cap of the backfill lane (Mbit/s) */
+    fopt->dryRun = false;                        /* (0:off  1:on) the downloads are only planned */
+    fopt->listCacheTtl = 0;                      /* time to live of the on-disk cache of remote directory listings in minutes */
+    fopt->hedgeMirror = false;                   /* (0:off  1:on) the slow transfer is hedged by a duplicate request to the mirror archive */
+    fopt->hedgeDelay = 10.0;                     /* the transfer without data or slower than 'hedgeSpeed' after so long (s) is hedged */
+    fopt->hedgeSpeed = 20.0;                     /* minimum throughput of the transfer (KB/s) */
+    fopt->segCount = 1;                          /* number of segments of the large file of HTTP(S) downloaded concurrently */
+    fopt->segMinSize = 20.0;                     /* the file not smaller than it (MB) is downloaded in segments */
+    fopt->schedPriority = false;                 /* (0:off  1:on) the download tasks are run by priority class */
+    fopt->bandwidth = 0.0;                       /* bandwidth limit of all the downloads of the process (Mbit/s) */
+    fopt->multiXfer = 0;                         /* maximum number of transfers in flight in the event loop (0: off) */
+    fopt->maxHostConn = 8;                       /* maximum number of connections to one host in the event loop */
+    fopt->convThreads = 2;                       /* number of threads inflating and converting the files received by the event loop */
+    fopt->gzipObs = false;                       /* (0:off  1:on) the observation files are written as the indexed gzip files '*.yyo.gz' */
+    fopt->gzipThreads = 4;                       /* number of threads compressing each observation file */
+    fopt->keepCrx = false;                       /* (0:off  1:on) the observation files are kept as the compressed Compact RINEX files '*.yyd.gz' */
+    fopt->rnx2crx = 0;                           /* (0:off  1:'*.yyd'/'*.crx'  2:'*.yyd.gz'/'*.crx.gz') the RINEX files of the list are converted to Compact RINEX */
+    fopt->rnx2crxThreads = 4;                    /* number of files converted to Compact RINEX in parallel */
+    str.SetStr(fopt->rnx2crxList, "", 1);        /* the full path of the list of the RINEX files */
 
     /* initialization for FTP options */
     fopt->ftpDownloading = false;                /* the master switch for data downloading, 0:off  1:on, only for data downloading */
-    str.SetStr(fopt->ftpFrom, "", 1);            /* FTP archive: CDDIS, IGN, or WHU */
+    str.SetStr(fopt->ftpFrom, "", 1);            /* FTP archive: CDDIS, IGN, WHU, or AUTO */
     fopt->getObs = false;                        /* (0:off  1:on) IGS observation (RINEX version 2.xx, short name 'd') */
     fopt->getObm = false;                        /* (0:off  1:on) MGEX observation (RINEX version 3.xx, long name 'crx') */
     fopt->getObc = false;                        /* (0:off  1:on) Curtin University of Technology (CUT) observation (RINEX version 3.xx, long name 'crx') */
@@ -138,7 +179,7 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
 
     StringUtil str;
     TimeUtil tu;
-    char *p, sline[MAXCHARS] = { '\0' }, tmpLine[MAXCHARS] = { '\0' };
+    char *p, sline[MAXCHARS] = { '\0' }, tmpLine[MAXCHARS] = { '\0' }, name[MAXCHARS] = { '\0' };
     bool debug = false;
     int j = 0;
     gtime_t tt = { 0 };
@@ -148,9 +189,14 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
         if ((sline != nullptr) && (sline[0] == '#')) continue;
 
         p = strrchr(sline, '=');
+        if (!p) continue;
+
+        /* the option name is the token before '=', so the names in the comments are not taken */
+        if (sscanf(sline, "%[^=]", name) != 1) continue;
+        str.TrimSpace(name);
 
         /* processing directory */
-        if (strstr(sline, "mainDir"))                 /* the root/main directory of GNSS observations and products */
+        if (strcmp(name, "mainDir") == 0)             /* the root/main directory of GNSS observations and products */
         {
             sscanf(p + 1, "%[^%]", tmpLine);          /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
             str.TrimSpace(tmpLine);
@@ -158,7 +204,7 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
             strcpy(popt->mainDir, tmpLine);
             if (debug) cout << "* mainDir = " << popt->mainDir << endl;
         }
-        else if (strstr(sline, "obsDir"))             /* the directory of IGS RINEX format observation files (short name "d" files) */
+        else if (strcmp(name, "obsDir") == 0)         /* the directory of IGS RINEX format observation files (short name "d" files) */
         {
             sscanf(p + 1, "%d %[^%]", &j, &tmpLine);  /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
             str.TrimSpace(tmpLine);
@@ -173,7 +219,7 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
             else strcpy(popt->obsDir, tmpLine);  /* the full path should be given, i.e., 'obsDir         = 0  D:\data\obs' */
             if (debug) cout << "* obsDir = " << popt->obsDir << endl;
         }
-        else if (strstr(sline, "obmDir"))             /* the directory of MGEX RINEX format observation files (long name "crx" files) */
+        else if (strcmp(name, "obmDir") == 0)         /* the directory of MGEX RINEX format observation files (long name "crx" files) */
         {
             sscanf(p + 1, "%d %[^%]", &j, &tmpLine);  /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
             str.TrimSpace(tmpLine);
@@ -188,7 +234,7 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
             else strcpy(popt->obmDir, tmpLine);  /* the full path should be given, i.e., 'obmDir         = 0  D:\data\obm' */
             if (debug) cout << "* obmDir = " << popt->obmDir << endl;
         }
-        else if (strstr(sline, "obcDir"))             /* the directory of Curtin University of Technology (CUT) RINEX format observation files (long name "crx" files) */
+        else if (strcmp(name, "obcDir") == 0)         /* the directory of Curtin University of Technology (CUT) RINEX format observation files (long name "crx" files) */
         {
             sscanf(p + 1, "%d %[^%]", &j, &tmpLine);  /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
             str.TrimSpace(tmpLine);
@@ -203,7 +249,7 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
             else strcpy(popt->obcDir, tmpLine);  /* the full path should be given, i.e., 'obcDir         = 0  D:\data\obc' */
             if (debug) cout << "* obcDir = " << popt->obcDir << endl;
         }
-        else if (strstr(sline, "obgDir"))             /* the directory of Geoscience Australia (GA) RINEX format observation files (long name "crx" files) */
+        else if (strcmp(name, "obgDir") == 0)         /* the directory of Geoscience Australia (GA) RINEX format observation files (long name "crx" files) */
         {
             sscanf(p + 1, "%d %[^%]", &j, &tmpLine);  /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
             str.TrimSpace(tmpLine);
@@ -218,7 +264,7 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
             else strcpy(popt->obgDir, tmpLine);  /* the full path should be given, i.e., 'obgDir         = 0  D:\data\obg' */
             if (debug) cout << "* obgDir = " << popt->obgDir << endl;
         }
-        else if (strstr(sline, "obhDir"))             /* the directory of Hong Kong CORS RINEX format observation files (long name "crx" files) */
+        else if (strcmp(name, "obhDir") == 0)         /* the directory of Hong Kong CORS RINEX format observation files (long name "crx" files) */
         {
             sscanf(p + 1, "%d %[^%]", &j, &tmpLine);  /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
             str.TrimSpace(tmpLine);
@@ -233,7 +279,7 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
             else strcpy(popt->obhDir, tmpLine);  /* the full path should be given, i.e., 'obhDir         = 0  D:\data\obh' */
             if (debug) cout << "* obhDir = " << popt->obhDir << endl;
         }
-        else if (strstr(sline, "obnDir"))             /* the directory of NGS/NOAA CORS RINEX format observation files (short name "d" files) */
+        else if (strcmp(name, "obnDir") == 0)         /* the directory of NGS/NOAA CORS RINEX format observation files (short name "d" files) */
         {
             sscanf(p + 1, "%d %[^%]", &j, &tmpLine);  /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
             str.TrimSpace(tmpLine);
@@ -248,7 +294,7 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
             else strcpy(popt->obnDir, tmpLine);  /* the full path should be given, i.e., 'obnDir         = 0  D:\data\obn' */
             if (debug) cout << "* obnDir = " << popt->obnDir << endl;
         }
-        else if (strstr(sline, "obeDir"))             /* the directory of EUREF Permanent Network (EPN) RINEX format observation files (long name "crx" files and short name "d" files) */
+        else if (strcmp(name, "obeDir") == 0)         /* the directory of EUREF Permanent Network (EPN) RINEX format observation files (long name "crx" files and short name "d" files) */
         {
             sscanf(p + 1, "%d %[^%]", &j, &tmpLine);  /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
             str.TrimSpace(tmpLine);
@@ -263,7 +309,7 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
             else strcpy(popt->obeDir, tmpLine);  /* the full path should be given, i.e., 'obeDir         = 0  D:\data\obe' */
             if (debug) cout << "* obeDir = " << popt->obeDir << endl;
         }
-        else if (strstr(sline, "navDir"))             /* the directory of RINEX format broadcast ephemeris files */
+        else if (strcmp(name, "navDir") == 0)         /* the directory of RINEX format broadcast ephemeris files */
         {
             sscanf(p + 1, "%d %[^%]", &j, &tmpLine);  /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
             str.TrimSpace(tmpLine);
@@ -278,7 +324,7 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
             else strcpy(popt->navDir, tmpLine);  /* the full path should be given, i.e., 'navDir         = 0  D:\data\nav' */
             if (debug) cout << "* navDir = " << popt->navDir << endl;
         }
-        else if (strstr(sline, "sp3Dir"))             /* the directory of SP3 format precise ephemeris files */
+        else if (strcmp(name, "sp3Dir") == 0)         /* the directory of SP3 format precise ephemeris files */
         {
             sscanf(p + 1, "%d %[^%]", &j, &tmpLine);  /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
             str.TrimSpace(tmpLine);
@@ -293,7 +339,7 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
             else strcpy(popt->sp3Dir, tmpLine);  /* the full path should be given, i.e., 'sp3Dir         = 0  D:\data\sp3' */
             if (debug) cout << "* sp3Dir = " << popt->sp3Dir << endl;
         }
-        else if (strstr(sline, "clkDir"))             /* the directory of RINEX format precise clock files */
+        else if (strcmp(name, "clkDir") == 0)         /* the directory of RINEX format precise clock files */
         {
             sscanf(p + 1, "%d %[^%]", &j, &tmpLine);  /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
             str.TrimSpace(tmpLine);
@@ -308,7 +354,7 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
             else strcpy(popt->clkDir, tmpLine);  /* the full path should be given, i.e., 'clkDir         = 0  D:\data\clk' */
             if (debug) cout << "* clkDir = " << popt->clkDir << endl;
         }
-        else if (strstr(sline, "eopDir"))             /* the directory of earth rotation parameter files */
+        else if (strcmp(name, "eopDir") == 0)         /* the directory of earth rotation parameter files */
         {
             sscanf(p + 1, "%d %[^%]", &j, &tmpLine);  /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
             str.TrimSpace(tmpLine);
@@ -323,7 +369,7 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
             else strcpy(popt->eopDir, tmpLine);  /* the full path should be given, i.e., 'eopDir         = 0  D:\data\eop' */
             if (debug) cout << "* eopDir = " << popt->eopDir << endl;
         }
-        else if (strstr(sline, "snxDir"))             /* the directory of SINEX format IGS weekly solution files */
+        else if (strcmp(name, "snxDir") == 0)         /* the directory of SINEX format IGS weekly solution files */
         {
             sscanf(p + 1, "%d %[^%]", &j, &tmpLine);  /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
             str.TrimSpace(tmpLine);
@@ -338,7 +384,7 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
             else strcpy(popt->snxDir, tmpLine);  /* the full path should be given, i.e., 'snxDir         = 0  D:\data\snx' */
             if (debug) cout << "* snxDir = " << popt->snxDir << endl;
         }
-        else if (strstr(sline, "dcbDir"))             /* the directory of CODE and/or MGEX differential code bias (DCB) files */
+        else if (strcmp(name, "dcbDir") == 0)         /* the directory of CODE and/or MGEX differential code bias (DCB) files */
         {
             sscanf(p + 1, "%d %[^%]", &j, &tmpLine);  /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
             str.TrimSpace(tmpLine);
@@ -353,7 +399,7 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
             else strcpy(popt->dcbDir, tmpLine);  /* the full path should be given, i.e., 'dcbDir         = 0  D:\data\dcb' */
             if (debug) cout << "* dcbDir = " << popt->dcbDir << endl;
         }
-        else if (strstr(sline, "biaDir"))             /* the directory of CNES real-time phase bias files */
+        else if (strcmp(name, "biaDir") == 0)         /* the directory of CNES real-time phase bias files */
         {
             sscanf(p + 1, "%d %[^%]", &j, &tmpLine);  /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
             str.TrimSpace(tmpLine);
@@ -368,7 +414,7 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
             else strcpy(popt->biaDir, tmpLine);  /* the full path should be given, i.e., 'biaDir         = 0  D:\data\bia' */
             if (debug) cout << "* biaDir = " << popt->biaDir << endl;
         }
-        else if (strstr(sline, "ionDir"))             /* the directory of CODE and/or IGS global ionosphere map (GIM) files */
+        else if (strcmp(name, "ionDir") == 0)         /* the directory of CODE and/or IGS global ionosphere map (GIM) files */
         {
             sscanf(p + 1, "%d %[^%]", &j, &tmpLine);  /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
             str.TrimSpace(tmpLine);
@@ -383,7 +429,7 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
             else strcpy(popt->ionDir, tmpLine);  /* the full path should be given, i.e., 'ionDir         = 0  D:\data\ion' */
             if (debug) cout << "* ionDir = " << popt->ionDir << endl;
         }
-        else if (strstr(sline, "ztdDir"))             /* the directory of CODE and/or IGS tropospheric product files */
+        else if (strcmp(name, "ztdDir") == 0)         /* the directory of CODE and/or IGS tropospheric product files */
         {
             sscanf(p + 1, "%d %[^%]", &j, &tmpLine);  /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
             str.TrimSpace(tmpLine);
@@ -398,7 +444,7 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
             else strcpy(popt->ztdDir, tmpLine);  /* the full path should be given, i.e., 'ztdDir         = 0  D:\data\ztd' */
             if (debug) cout << "* ztdDir = " << popt->ztdDir << endl;
         }
-        else if (strstr(sline, "tblDir"))             /* the directory of table files for processing */
+        else if (strcmp(name, "tblDir") == 0)         /* the directory of table files for processing */
         {
             sscanf(p + 1, "%d %[^%]", &j, &tmpLine);  /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
             str.TrimSpace(tmpLine);
@@ -413,7 +459,7 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
             else strcpy(popt->tblDir, tmpLine);  /* the full path should be given, i.e., 'tblDir         = 0  D:\data\tbl' */
             if (debug) cout << "* tblDir = " << popt->tblDir << endl;
         }
-        else if (strstr(sline, "3partyDir"))          /* (optional) the directory where third-party softwares (i.e., 'wget', 'gzip', 'crx2rnx' etc) are stored. This option is not needed if you have set the path or environment variable for them */
+        else if (strcmp(name, "3partyDir") == 0)      /* (optional) the directory where third-party softwares (i.e., 'gzip', 'crx2rnx' etc) are stored. This option is not needed if you have set the path or environment variable for them */
         {
             sscanf(p + 1, "%d %[^%]", &j, &tmpLine);  /* %[^%] denotes regular expression, which means that using % as the end sign of the input string */
             str.TrimSpace(tmpLine);
@@ -436,7 +482,7 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
         }
 
         /* time settings */
-        else if (strstr(sline, "procTime"))           /* start time for processing */
+        else if (strcmp(name, "procTime") == 0)       /* start time for processing */
         {
             sscanf(p + 1, "%d", &j);
             if (j == 1)
@@ -468,21 +514,125 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
         }
 
         /* FTP downloading settings */
-        else if (strstr(sline, "minusAdd1day"))       /* (0:off  1:on) the day before and after the current day for precise satellite orbit and clock products downloading */
+        else if (strcmp(name, "minusAdd1day") == 0)   /* (0:off  1:on) the day before and after the current day for precise satellite orbit and clock products downloading */
         {
             sscanf(p + 1, "%d", &j);
             fopt->minusAdd1day = j == 1 ? true : false;
             if (debug) cout << "* minusAdd1day = " << fopt->minusAdd1day << endl;
         }
-        else if (strstr(sline, "printInfoWget"))      /* (0:off  1:on) print the information generated by 'wget' */
+        else if (strcmp(name, "printInfoWget") == 0)  /* (0:off  1:on) print the information of each transfer */
         {
             sscanf(p + 1, "%d", &j);
             fopt->printInfoWget = j == 1 ? true : false;
             if (debug) cout << "* printInfoWget = " << fopt->printInfoWget << endl;
         }
+        else if (strcmp(name, "maxParallel") == 0)    /* maximum number of sites downloaded in parallel (default), and optionally for the archive, i.e., 'cddis:2  ga:8' */
+        {
+            tmpLine[0] = '\0';
+            sscanf(p + 1, "%d %[^%]", &fopt->maxParallel, tmpLine);
+            if (fopt->maxParallel < 1) fopt->maxParallel = 1;
+
+            /* the settings for the archives, i.e., 'cddis:2' */
+            char *q = strtok(tmpLine, " \t\r\n");
+            while (q)
+            {
+                char *c = strchr(q, ':');
+                if (c && atoi(c + 1) > 0)
+                {
+                    string arcName(q, c - q);
+                    str.ToUpper(arcName);
+                    fopt->maxParallelArc[arcName] = atoi(c + 1);
+                }
+                q = strtok(nullptr, " \t\r\n");
+            }
+            if (debug) cout << "* maxParallel = " << fopt->maxParallel << "  " << fopt->maxParallelArc.size() << endl;
+        }
+        else if (strcmp(name, "parallelDays") == 0)   /* number of days downloaded at the same time (1: one by one) */
+        {
+            sscanf(p + 1, "%d", &fopt->parallelDays);
+            if (fopt->parallelDays < 1) fopt->parallelDays = 1;
+            if (debug) cout << "* parallelDays = " << fopt->parallelDays << endl;
+        }
+        else if (strcmp(name, "journal") == 0)        /* (0:off  1:on) the downloads are journaled under 'mainDir' to resume the run killed before */
+        {
+            sscanf(p + 1, "%d", &j);
+            fopt->journal = j == 1 ? true : false;
+            if (debug) cout << "* journal = " << fopt->journal << endl;
+        }
+        else if (strcmp(name, "daemon") == 0)         /* (0:off  1:on) the current day is polled until it is stopped; number of days before it polled */
+        {
+            fopt->daemonDays = 1;
+            sscanf(p + 1, "%d %d", &j, &fopt->daemonDays);
+            fopt->daemon = j == 1 ? true : false;
+            if (fopt->daemonDays < 0) fopt->daemonDays = 0;
+            if (debug) cout << "* daemon = " << fopt->daemon << "  " << fopt->daemonDays << endl;
+        }
+        else if (strcmp(name, "backfill") == 0)       /* (0:off  1:on) the days of the start time are backfilled newest first while polling; bandwidth cap (Mbit/s) */
+        {
+            sscanf(p + 1, "%d %lf", &j, &fopt->backfillBw);
+            fopt->backfill = j == 1 ? true : false;
+            if (fopt->backfillBw < 0.0) fopt->backfillBw = 0.0;
+            if (debug) cout << "* backfill = " << fopt->backfill << "  " << fopt->backfillBw << endl;
+        }
+        else if (strcmp(name, "listCacheTtl") == 0)   /* time to live of the on-disk cache of remote directory listings in minutes (0: only cached in memory) */
+        {
+            sscanf(p + 1, "%d", &fopt->listCacheTtl);
+            if (debug) cout << "* listCacheTtl = " << fopt->listCacheTtl << endl;
+        }
+        else if (strcmp(name, "hedgeMirror") == 0)    /* (0:off  1:on) the slow transfer is hedged by a duplicate request to the mirror archive; delay (s); minimum throughput (KB/s) */
+        {
+            sscanf(p + 1, "%d %lf %lf", &j, &fopt->hedgeDelay, &fopt->hedgeSpeed);
+            fopt->hedgeMirror = j == 1 ? true : false;
+            if (fopt->hedgeDelay <= 0.0) fopt->hedgeMirror = false;
+            if (debug) cout << "* hedgeMirror = " << fopt->hedgeMirror << "  " << fopt->hedgeDelay << "  " << fopt->hedgeSpeed << endl;
+        }
+        else if (strcmp(name, "segDownload") == 0)    /* number of segments of the large file of HTTP(S) downloaded concurrently (<= 1: off); minimum size of the file (MB) */
+        {
+            sscanf(p + 1, "%d %lf", &fopt->segCount, &fopt->segMinSize);
+            if (debug) cout << "* segDownload = " << fopt->segCount << "  " << fopt->segMinSize << endl;
+        }
+        else if (strcmp(name, "schedPriority") == 0)  /* (0:off  1:on) the download tasks are run by priority class; bandwidth limit of the process (Mbit/s) */
+        {
+            sscanf(p + 1, "%d %lf", &j, &fopt->bandwidth);
+            fopt->schedPriority = j == 1 ? true : false;
+            if (debug) cout << "* schedPriority = " << fopt->schedPriority << "  " << fopt->bandwidth << endl;
+        }
+        else if (strcmp(name, "multiXfer") == 0)      /* maximum number of transfers in flight in the event loop (0: off); maximum number of connections to one host */
+        {
+            sscanf(p + 1, "%d %d", &fopt->multiXfer, &fopt->maxHostConn);
+            if (fopt->multiXfer < 0) fopt->multiXfer = 0;
+            if (fopt->maxHostConn < 1) fopt->maxHostConn = 1;
+            if (debug) cout << "* multiXfer = " << fopt->multiXfer << "  " << fopt->maxHostConn << endl;
+        }
+        else if (strcmp(name, "convThreads") == 0)    /* number of threads inflating and converting the files received by the event loop (0: in the loop thread) */
+        {
+            sscanf(p + 1, "%d", &fopt->convThreads);
+            if (fopt->convThreads < 0) fopt->convThreads = 0;
+            if (debug) cout << "* convThreads = " << fopt->convThreads << endl;
+        }
+        else if (strcmp(name, "gzipObs") == 0)        /* (0:off  1:on) the observation files are written as the indexed gzip files; number of threads compressing each file */
+        {
+            sscanf(p + 1, "%d %d", &j, &fopt->gzipThreads);
+            fopt->gzipObs = j == 1 ? true : false;
+            if (fopt->gzipThreads < 1) fopt->gzipThreads = 1;
+            if (debug) cout << "* gzipObs = " << fopt->gzipObs << "  " << fopt->gzipThreads << endl;
+        }
+        else if (strcmp(name, "keepCrx") == 0)        /* (0:off  1:on) the observation files are kept as the compressed Compact RINEX files '*.yyd.gz' */
+        {
+            sscanf(p + 1, "%d", &j);
+            fopt->keepCrx = j == 1 ? true : false;
+            if (debug) cout << "* keepCrx = " << fopt->keepCrx << endl;
+        }
+        else if (strcmp(name, "rnx2crx") == 0)        /* (0:off  1:'*.yyd'/'*.crx'  2:'*.yyd.gz'/'*.crx.gz'); number of files converted in parallel; the list of the RINEX files */
+        {
+            sscanf(p + 1, "%d %d %s", &fopt->rnx2crx, &fopt->rnx2crxThreads, fopt->rnx2crxList);
+            if (fopt->rnx2crx < 0 || fopt->rnx2crx > 2) fopt->rnx2crx = 0;
+            if (fopt->rnx2crxThreads < 1) fopt->rnx2crxThreads = 1;
+            if (debug) cout << "* rnx2crx = " << fopt->rnx2crx << "  " << fopt->rnx2crxThreads << "  " << fopt->rnx2crxList << endl;
+        }
 
         /* handling of FTP downloading */
-        else if (strstr(sline, "ftpDownloading"))     /* the master switch for data downloading (0:off  1:on, only for data downloading); the FTP archive, i.e., CDDIS, IGN */
+        else if (strcmp(name, "ftpDownloading") == 0) /* the master switch for data downloading (0:off  1:on, only for data downloading); the FTP archive, i.e., CDDIS, IGN */
         {
             sscanf(p + 1, "%d %s", &j, &fopt->ftpFrom);
             fopt->ftpDownloading = j == 1 ? true : false;
@@ -495,8 +645,13 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
                 {
                     if ((sline != nullptr) && (sline[0] == '#')) continue;
                     p = strrchr(sline, '=');
+                    if (!p) continue;
 
-                    if (strstr(sline, "getObs"))      /* (0:off  1:on) IGS observation (RINEX version 2.xx, short name 'd') */
+                    /* the option name is the token before '=', so the names in the comments are not taken */
+                    if (sscanf(sline, "%[^=]", name) != 1) continue;
+                    str.TrimSpace(name);
+
+                    if (strcmp(name, "getObs") == 0)  /* (0:off  1:on) IGS observation (RINEX version 2.xx, short name 'd') */
                     {
                         sscanf(p + 1, "%d %s %s %d %d", &j, &fopt->obsTyp, &fopt->obsOpt, &hh, &nh);
                         fopt->getObs = j == 1 ? true : false;
@@ -505,7 +660,7 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
                         int imax = MIN(hh + nh, 24);
                         for (int i = hh; i < imax; i++) fopt->hhObs.push_back(i);
                     }
-                    else if (strstr(sline, "getObm")) /* (0:off  1:on) MGEX observation (RINEX version 3.xx, long name 'crx') */
+                    else if (strcmp(name, "getObm") == 0) /* (0:off  1:on) MGEX observation (RINEX version 3.xx, long name 'crx') */
                     {
                         sscanf(p + 1, "%d %s %s %d %d", &j, &fopt->obmTyp, &fopt->obmOpt, &hh, &nh);
                         fopt->getObm = j == 1 ? true : false;
@@ -514,13 +669,13 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
                         int imax = MIN(hh + nh, 24);
                         for (int i = hh; i < imax; i++) fopt->hhObm.push_back(i);
                     }
-                    else if (strstr(sline, "getObc")) /* (0:off  1:on) Curtin University of Technology (CUT) observation (RINEX version 3.xx, long name 'crx') */
+                    else if (strcmp(name, "getObc") == 0) /* (0:off  1:on) Curtin University of Technology (CUT) observation (RINEX version 3.xx, long name 'crx') */
                     {
                         sscanf(p + 1, "%d %s %s %d %d", &j, &fopt->obcTyp, &fopt->obcOpt, &hh, &nh);
                         fopt->getObc = j == 1 ? true : false;
                         if (debug) cout << "* getObc = " << fopt->getObc << "  " << fopt->obcTyp << "  " << fopt->obcOpt << endl;
                     }
-                    else if (strstr(sline, "getObg")) /* (0:off  1:on) Geoscience Australia (GA) observation (RINEX version 3.xx, long name 'crx') */
+                    else if (strcmp(name, "getObg") == 0) /* (0:off  1:on) Geoscience Australia (GA) observation (RINEX version 3.xx, long name 'crx') */
                     {
                         sscanf(p + 1, "%d %s %s %d %d", &j, &fopt->obgTyp, &fopt->obgOpt, &hh, &nh);
                         fopt->getObg = j == 1 ? true : false;
@@ -529,7 +684,7 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
                         int imax = MIN(hh + nh, 24);
                         for (int i = hh; i < imax; i++) fopt->hhObg.push_back(i);
                     }
-                    else if (strstr(sline, "getObh")) /* (0:off  1:on) Hong Kong CORS observation (RINEX version 3.xx, long name 'crx') */
+                    else if (strcmp(name, "getObh") == 0) /* (0:off  1:on) Hong Kong CORS observation (RINEX version 3.xx, long name 'crx') */
                     {
                         sscanf(p + 1, "%d %s %s %d %d", &j, &fopt->obhTyp, &fopt->obhOpt, &hh, &nh);
                         fopt->getObh = j == 1 ? true : false;
@@ -538,19 +693,19 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
                         int imax = MIN(hh + nh, 24);
                         for (int i = hh; i < imax; i++) fopt->hhObh.push_back(i);
                     }
-                    else if (strstr(sline, "getObn")) /* (0:off  1:on) NGS/NOAA CORS observation (RINEX version 2.xx, short name 'd') */
+                    else if (strcmp(name, "getObn") == 0) /* (0:off  1:on) NGS/NOAA CORS observation (RINEX version 2.xx, short name 'd') */
                     {
                         sscanf(p + 1, "%d %s %s %d %d", &j, &fopt->obnTyp, &fopt->obnOpt, &hh, &nh);
                         fopt->getObn = j == 1 ? true : false;
                         if (debug) cout << "* getObn = " << fopt->getObn << "  " << fopt->obnTyp << "  " << fopt->obnOpt << endl;
                     }
-                    else if (strstr(sline, "getObe")) /* (0:off  1:on) EUREF Permanent Network (EPN) observation (RINEX version 3.xx, long name 'crx' and RINEX version 2.xx, short name 'd') */
+                    else if (strcmp(name, "getObe") == 0) /* (0:off  1:on) EUREF Permanent Network (EPN) observation (RINEX version 3.xx, long name 'crx' and RINEX version 2.xx, short name 'd') */
                     {
                         sscanf(p + 1, "%d %s %s %d %d", &j, &fopt->obeTyp, &fopt->obeOpt, &hh, &nh);
                         fopt->getObe = j == 1 ? true : false;
                         if (debug) cout << "* getObe = " << fopt->getObe << "  " << fopt->obeTyp << "  " << fopt->obeOpt << endl;
                     }
-                    else if (strstr(sline, "getNav")) /* (0:off  1:on) broadcast ephemeris */
+                    else if (strcmp(name, "getNav") == 0) /* (0:off  1:on) broadcast ephemeris */
                     {
                         sscanf(p + 1, "%d %s %s %d %d", &j, &fopt->navTyp, &fopt->navOpt, &hh, &nh);
                         fopt->getNav = j == 1 ? true : false;
@@ -559,7 +714,7 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
                         int imax = MIN(hh + nh, 24);
                         for (int i = hh; i < imax; i += step) fopt->hhNav.push_back(i);
                     }
-                    else if (strstr(sline, "getOrbClk"))   /* (0:off  1:on) precise orbit and clock */
+                    else if (strcmp(name, "getOrbClk") == 0)   /* (0:off  1:on) precise orbit and clock */
                     {
                         sscanf(p + 1, "%d %s %d %d", &j, &fopt->orbClkOpt, &hh, &nh);
                         fopt->getOrbClk = j == 1 ? true : false;
@@ -579,7 +734,7 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
                         imax = MIN(hh + nh * step, 24);
                         for (int i = hh; i < imax; i += step) fopt->hhOrbClk.push_back(i);
                     }
-                    else if (strstr(sline, "getEop")) /* (0:off  1:on) earth rotation parameter */
+                    else if (strcmp(name, "getEop") == 0) /* (0:off  1:on) earth rotation parameter */
                     {
                         sscanf(p + 1, "%d %s %d %d", &j, &fopt->eopOpt, &hh, &nh);
                         fopt->getEop = j == 1 ? true : false;
@@ -598,49 +753,49 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
                         imax = MIN(hh + nh * step, 24);
                         for (int i = hh; i < imax; i += step) fopt->hhEop.push_back(i);
                     }
-                    else if (strstr(sline, "getSnx")) /* (0:off  1:on) IGS weekly SINEX */
+                    else if (strcmp(name, "getSnx") == 0) /* (0:off  1:on) IGS weekly SINEX */
                     {
                         sscanf(p + 1, "%d", &j);
                         fopt->getSnx = j == 1 ? true : false;
                         if (debug) cout << "* getSnx = " << fopt->getSnx << endl;
                     }
-                    else if (strstr(sline, "getDcb")) /* (0:off  1:on) CODE and/or MGEX differential code bias (DCB) */
+                    else if (strcmp(name, "getDcb") == 0) /* (0:off  1:on) CODE and/or MGEX differential code bias (DCB) */
                     {
                         sscanf(p + 1, "%d", &j);
                         fopt->getDcb = j == 1 ? true : false;
                         if (debug) cout << "* getDcb = " << fopt->getDcb << endl;
                     }
-                    else if (strstr(sline, "getIon")) /* (0:off  1:on) CODE and/or IGS global ionosphere map (GIM) */
+                    else if (strcmp(name, "getIon") == 0) /* (0:off  1:on) CODE and/or IGS global ionosphere map (GIM) */
                     {
                         sscanf(p + 1, "%d %s", &j, &fopt->ionOpt);
                         fopt->getIon = j == 1 ? true : false;
                         if (debug) cout << "* getIon = " << fopt->getIon << "  " << fopt->ionOpt << endl;
                     }
-                    else if (strstr(sline, "getRoti"))/* (0:off  1:on) Rate of TEC index (ROTI) */
+                    else if (strcmp(name, "getRoti") == 0)/* (0:off  1:on) Rate of TEC index (ROTI) */
                     {
                         sscanf(p + 1, "%d", &j);
                         fopt->getRoti = j == 1 ? true : false;
                         if (debug) cout << "* getRoti = " << fopt->getRoti << endl;
                     }
-                    else if (strstr(sline, "getTrp")) /* (0:off  1:on) CODE and/or IGS tropospheric product */
+                    else if (strcmp(name, "getTrp") == 0) /* (0:off  1:on) CODE and/or IGS tropospheric product */
                     {
                         sscanf(p + 1, "%d %s", &j, &fopt->trpOpt);
                         fopt->getTrp = j == 1 ? true : false;
                         if (debug) cout << "* getTrp = " << fopt->getTrp << "  " << fopt->trpOpt << endl;
                     }
-                    else if (strstr(sline, "getRtOrbClk")) /* (0:off  1:on) real-time precise orbit and clock products from CNES offline files */
+                    else if (strcmp(name, "getRtOrbClk") == 0) /* (0:off  1:on) real-time precise orbit and clock products from CNES offline files */
                     {
                         sscanf(p + 1, "%d", &j);
                         fopt->getRtOrbClk = j == 1 ? true : false;
                         if (debug) cout << "* getRtOrbClk = " << fopt->getRtOrbClk << endl;
                     }
-                    else if (strstr(sline, "getRtBias"))   /* (0:off  1:on) real-time code and phase bias products from CNES offline files */
+                    else if (strcmp(name, "getRtBias") == 0)   /* (0:off  1:on) real-time code and phase bias products from CNES offline files */
                     {
                         sscanf(p + 1, "%d", &j);
                         fopt->getRtBias = j == 1 ? true : false;
                         if (debug) cout << "* getRtBias = " << fopt->getRtBias << endl;
                     }
-                    else if (strstr(sline, "getAtx")) /* (0:off  1:on) ANTEX format antenna phase center correction */
+                    else if (strcmp(name, "getAtx") == 0) /* (0:off  1:on) ANTEX format antenna phase center correction */
                     {
                         sscanf(p + 1, "%d", &j);
                         fopt->getAtx = j == 1 ? true : false;
@@ -659,246 +814,400 @@ bool PreProcess::ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt
 } /* end of ReadCfgFile */
 
 /**
-* @brief   : run - start iPPP-RTK processing
-* @param[I]: cfgFile (configure file with full path)
+* @brief   : DownloadDay - download the data of one day
+* @param[I]: popt (processing options)
+* @param[I]: fopt (FTP options)
+* @param[I]: iday (index of the day after the start time)
+* @param[I]: ftp (downloader kept for all the days by the daemon, which runs only the tasks due, or by its
+*            backfill lane; nullptr: a new one runs all the tasks)
 * @param[O]: none
 * @return  : none
-* @note    :
+* @note    : the options are copied for the day, so the days can be downloaded by several threads at the
+*            same time
 **/
-void PreProcess::run(const char *cfgFile)
+void PreProcess::DownloadDay(const prcopt_t *popt, const ftpopt_t *fopt, int iday, FtpUtil *ftp)
 {
-    prcopt_t popt;
-    ftpopt_t fopt;
-    /* initialization */
-    init(&popt, &fopt);
+    TimeUtil tu;
+    StringUtil str;
+    prcopt_t dopt = *popt;
+    ftpopt_t dfopt = *fopt;
+    dopt.ts = tu.TimeAdd(popt->ts, 86400.0 * iday);
 
-    /* read configure file to get processing information */
-    ReadCfgFile(cfgFile, &popt, &fopt);
+    int yyyy, doy;
+    tu.time2yrdoy(dopt.ts, &yyyy, &doy);
+    string sYyyy = str.yyyy2str(yyyy);
+    string sDoy = str.doy2str(doy);
 
-    /* data downloading for GNSS further processing */
-    if (fopt.ftpDownloading)
+    /* creat new IGS observation sub-directory */
+    if (fopt->getObs)
     {
-        FtpUtil ftp;
-        TimeUtil tu;
-        StringUtil str;
-        string obsDirMain = popt.obsDir;
-        string obmDirMain = popt.obmDir;
-        string obcDirMain = popt.obcDir;
-        string obgDirMain = popt.obgDir;
-        string obhDirMain = popt.obhDir;
-        string obnDirMain = popt.obnDir;
-        string obeDirMain = popt.obeDir;
-        string navDirMain = popt.navDir;
-        string ztdDirMain = popt.ztdDir;
-        for (int i = 0; i < popt.ndays; i++)
-        {
-            int yyyy, doy;
-            tu.time2yrdoy(popt.ts, &yyyy, &doy);
-            string sYyyy = str.yyyy2str(yyyy);
-            string sDoy = str.doy2str(doy);
-
-            /* creat new IGS observation sub-directory */
-            if (fopt.getObs)
-            {
-                char dir[MAXSTRPATH] = { '\0' };
-                char sep = (char)FILEPATHSEP;
-                sprintf(dir, "%s%c%s%c%s", obsDirMain.c_str(), sep, sYyyy.c_str(), sep, sDoy.c_str());
-                str.TrimSpace(dir);
-                str.CutFilePathSep(dir);
-                strcpy(popt.obsDir, dir);
-                string tmpDir = dir;
-                if (access(tmpDir.c_str(), 0) == -1)
-                {
-                    /* If the directory does not exist, creat it */
+        char dir[MAXSTRPATH] = { '\0' };
+        char sep = (char)FILEPATHSEP;
+        sprintf(dir, "%s%c%s%c%s", popt->obsDir, sep, sYyyy.c_str(), sep, sDoy.c_str());
+        str.TrimSpace(dir);
+        str.CutFilePathSep(dir);
+        strcpy(dopt.obsDir, dir);
+        string tmpDir = dir;
+        if (!fopt->dryRun && access(tmpDir.c_str(), 0) == -1)
+        {
+            /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
-                    string cmd = "mkdir " + tmpDir;
+            string cmd = "mkdir " + tmpDir;
 #else           /* for Linux or Mac */
-                    string cmd = "mkdir -p " + tmpDir;
+            string cmd = "mkdir -p " + tmpDir;
 #endif
-                    std::system(cmd.c_str());
-                }
-            }
+            std::system(cmd.c_str());
+        }
+    }
 
-            /* creat new MGEX observation sub-directory */
-            if (fopt.getObm)
-            {
-                char dir[MAXSTRPATH] = { '\0' };
-                char sep = (char)FILEPATHSEP;
-                sprintf(dir, "%s%c%s%c%s", obmDirMain.c_str(), sep, sYyyy.c_str(), sep, sDoy.c_str());
-                str.TrimSpace(dir);
-                str.CutFilePathSep(dir);
-                strcpy(popt.obmDir, dir);
-                string tmpDir = dir;
-                if (access(tmpDir.c_str(), 0) == -1)
-                {
-                    /* If the directory does not exist, creat it */
+    /* creat new MGEX observation sub-directory */
+    if (fopt->getObm)
+    {
+        char dir[MAXSTRPATH] = { '\0' };
+        char sep = (char)FILEPATHSEP;
+        sprintf(dir, "%s%c%s%c%s", popt->obmDir, sep, sYyyy.c_str(), sep, sDoy.c_str());
+        str.TrimSpace(dir);
+        str.CutFilePathSep(dir);
+        strcpy(dopt.obmDir, dir);
+        string tmpDir = dir;
+        if (!fopt->dryRun && access(tmpDir.c_str(), 0) == -1)
+        {
+            /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
-                    string cmd = "mkdir " + tmpDir;
+            string cmd = "mkdir " + tmpDir;
 #else           /* for Linux or Mac */
-                    string cmd = "mkdir -p " + tmpDir;
+            string cmd = "mkdir -p " + tmpDir;
 #endif
-                    std::system(cmd.c_str());
-                }
-            }
+            std::system(cmd.c_str());
+        }
+    }
 
-            /* creat new Curtin University of Technology (CUT) observation sub-directory */
-            if (fopt.getObc)
-            {
-                char dir[MAXSTRPATH] = { '\0' };
-                char sep = (char)FILEPATHSEP;
-                sprintf(dir, "%s%c%s%c%s", obcDirMain.c_str(), sep, sYyyy.c_str(), sep, sDoy.c_str());
-                str.TrimSpace(dir);
-                str.CutFilePathSep(dir);
-                strcpy(popt.obcDir, dir);
-                string tmpDir = dir;
-                if (access(tmpDir.c_str(), 0) == -1)
-                {
-                    /* If the directory does not exist, creat it */
+    /* creat new Curtin University of Technology (CUT) observation sub-directory */
+    if (fopt->getObc)
+    {
+        char dir[MAXSTRPATH] = { '\0' };
+        char sep = (char)FILEPATHSEP;
+        sprintf(dir, "%s%c%s%c%s", popt->obcDir, sep, sYyyy.c_str(), sep, sDoy.c_str());
+        str.TrimSpace(dir);
+        str.CutFilePathSep(dir);
+        strcpy(dopt.obcDir, dir);
+        string tmpDir = dir;
+        if (!fopt->dryRun && access(tmpDir.c_str(), 0) == -1)
+        {
+            /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
-                    string cmd = "mkdir " + tmpDir;
+            string cmd = "mkdir " + tmpDir;
 #else           /* for Linux or Mac */
-                    string cmd = "mkdir -p " + tmpDir;
+            string cmd = "mkdir -p " + tmpDir;
 #endif
-                    std::system(cmd.c_str());
-                }
-            }
+            std::system(cmd.c_str());
+        }
+    }
 
-            /* creat new Geoscience Australia (GA) observation sub-directory */
-            if (fopt.getObg)
-            {
-                char dir[MAXSTRPATH] = { '\0' };
-                char sep = (char)FILEPATHSEP;
-                sprintf(dir, "%s%c%s%c%s", obgDirMain.c_str(), sep, sYyyy.c_str(), sep, sDoy.c_str());
-                str.TrimSpace(dir);
-                str.CutFilePathSep(dir);
-                strcpy(popt.obgDir, dir);
-                string tmpDir = dir;
-                if (access(tmpDir.c_str(), 0) == -1)
-                {
-                    /* If the directory does not exist, creat it */
+    /* creat new Geoscience Australia (GA) observation sub-directory */
+    if (fopt->getObg)
+    {
+        char dir[MAXSTRPATH] = { '\0' };
+        char sep = (char)FILEPATHSEP;
+        sprintf(dir, "%s%c%s%c%s", popt->obgDir, sep, sYyyy.c_str(), sep, sDoy.c_str());
+        str.TrimSpace(dir);
+        str.CutFilePathSep(dir);
+        strcpy(dopt.obgDir, dir);
+        string tmpDir = dir;
+        if (!fopt->dryRun && access(tmpDir.c_str(), 0) == -1)
+        {
+            /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
-                    string cmd = "mkdir " + tmpDir;
+            string cmd = "mkdir " + tmpDir;
 #else           /* for Linux or Mac */
-                    string cmd = "mkdir -p " + tmpDir;
+            string cmd = "mkdir -p " + tmpDir;
 #endif
-                    std::system(cmd.c_str());
-                }
-            }
+            std::system(cmd.c_str());
+        }
+    }
 
-            /* creat new Hong Kong CORS observation sub-directory */
-            if (fopt.getObh)
-            {
-                char dir[MAXSTRPATH] = { '\0' };
-                char sep = (char)FILEPATHSEP;
-                sprintf(dir, "%s%c%s%c%s", obhDirMain.c_str(), sep, sYyyy.c_str(), sep, sDoy.c_str());
-                str.TrimSpace(dir);
-                str.CutFilePathSep(dir);
-                strcpy(popt.obhDir, dir);
-                string tmpDir = dir;
-                if (access(tmpDir.c_str(), 0) == -1)
-                {
-                    /* If the directory does not exist, creat it */
+    /* creat new Hong Kong CORS observation sub-directory */
+    if (fopt->getObh)
+    {
+        char dir[MAXSTRPATH] = { '\0' };
+        char sep = (char)FILEPATHSEP;
+        sprintf(dir, "%s%c%s%c%s", popt->obhDir, sep, sYyyy.c_str(), sep, sDoy.c_str());
+        str.TrimSpace(dir);
+        str.CutFilePathSep(dir);
+        strcpy(dopt.obhDir, dir);
+        string tmpDir = dir;
+        if (!fopt->dryRun && access(tmpDir.c_str(), 0) == -1)
+        {
+            /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
-                    string cmd = "mkdir " + tmpDir;
+            string cmd = "mkdir " + tmpDir;
 #else           /* for Linux or Mac */
-                    string cmd = "mkdir -p " + tmpDir;
+            string cmd = "mkdir -p " + tmpDir;
 #endif
-                    std::system(cmd.c_str());
-                }
-            }
+            std::system(cmd.c_str());
+        }
+    }
 
-            /* creat new NGS/NOAA CORS observation sub-directory */
-            if (fopt.getObn)
-            {
-                char dir[MAXSTRPATH] = { '\0' };
-                char sep = (char)FILEPATHSEP;
-                sprintf(dir, "%s%c%s%c%s", obnDirMain.c_str(), sep, sYyyy.c_str(), sep, sDoy.c_str());
-                str.TrimSpace(dir);
-                str.CutFilePathSep(dir);
-                strcpy(popt.obnDir, dir);
-                string tmpDir = dir;
-                if (access(tmpDir.c_str(), 0) == -1)
-                {
-                    /* If the directory does not exist, creat it */
+    /* creat new NGS/NOAA CORS observation sub-directory */
+    if (fopt->getObn)
+    {
+        char dir[MAXSTRPATH] = { '\0' };
+        char sep = (char)FILEPATHSEP;
+        sprintf(dir, "%s%c%s%c%s", popt->obnDir, sep, sYyyy.c_str(), sep, sDoy.c_str());
+        str.TrimSpace(dir);
+        str.CutFilePathSep(dir);
+        strcpy(dopt.obnDir, dir);
+        string tmpDir = dir;
+        if (!fopt->dryRun && access(tmpDir.c_str(), 0) == -1)
+        {
+            /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
-                    string cmd = "mkdir " + tmpDir;
+            string cmd = "mkdir " + tmpDir;
 #else           /* for Linux or Mac */
-                    string cmd = "mkdir -p " + tmpDir;
+            string cmd = "mkdir -p " + tmpDir;
 #endif
-                    std::system(cmd.c_str());
-                }
-            }
+            std::system(cmd.c_str());
+        }
+    }
 
-            /* creat new EUREF Permanent Network (EPN) observation sub-directory */
-            if (fopt.getObe)
-            {
-                char dir[MAXSTRPATH] = { '\0' };
-                char sep = (char)FILEPATHSEP;
-                sprintf(dir, "%s%c%s%c%s", obeDirMain.c_str(), sep, sYyyy.c_str(), sep, sDoy.c_str());
-                str.TrimSpace(dir);
-                str.CutFilePathSep(dir);
-                strcpy(popt.obeDir, dir);
-                string tmpDir = dir;
-                if (access(tmpDir.c_str(), 0) == -1)
-                {
-                    /* If the directory does not exist, creat it */
+    /* creat new EUREF Permanent Network (EPN) observation sub-directory */
+    if (fopt->getObe)
+    {
+        char dir[MAXSTRPATH] = { '\0' };
+        char sep = (char)FILEPATHSEP;
+        sprintf(dir, "%s%c%s%c%s", popt->obeDir, sep, sYyyy.c_str(), sep, sDoy.c_str());
+        str.TrimSpace(dir);
+        str.CutFilePathSep(dir);
+        strcpy(dopt.obeDir, dir);
+        string tmpDir = dir;
+        if (!fopt->dryRun && access(tmpDir.c_str(), 0) == -1)
+        {
+            /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
-                    string cmd = "mkdir " + tmpDir;
+            string cmd = "mkdir " + tmpDir;
 #else           /* for Linux or Mac */
-                    string cmd = "mkdir -p " + tmpDir;
+            string cmd = "mkdir -p " + tmpDir;
 #endif
-                    std::system(cmd.c_str());
-                }
-            }
+            std::system(cmd.c_str());
+        }
+    }
 
-            /* creat new NAV sub-directory */
-            if (fopt.getNav)
-            {
-                char dir[MAXSTRPATH] = { '\0' };
-                char sep = (char)FILEPATHSEP;
-                sprintf(dir, "%s%c%s%c%s", navDirMain.c_str(), sep, sYyyy.c_str(), sep, sDoy.c_str());
-                str.TrimSpace(dir);
-                str.CutFilePathSep(dir);
-                strcpy(popt.navDir, dir);
-                string tmpDir = dir;
-                if (access(tmpDir.c_str(), 0) == -1)
-                {
-                    /* If the directory does not exist, creat it */
+    /* creat new NAV sub-directory */
+    if (fopt->getNav)
+    {
+        char dir[MAXSTRPATH] = { '\0' };
+        char sep = (char)FILEPATHSEP;
+        sprintf(dir, "%s%c%s%c%s", popt->navDir, sep, sYyyy.c_str(), sep, sDoy.c_str());
+        str.TrimSpace(dir);
+        str.CutFilePathSep(dir);
+        strcpy(dopt.navDir, dir);
+        string tmpDir = dir;
+        if (!fopt->dryRun && access(tmpDir.c_str(), 0) == -1)
+        {
+            /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
-                    string cmd = "mkdir " + tmpDir;
+            string cmd = "mkdir " + tmpDir;
 #else           /* for Linux or Mac */
-                    string cmd = "mkdir -p " + tmpDir;
+            string cmd = "mkdir -p " + tmpDir;
 #endif
-                    std::system(cmd.c_str());
-                }
-            }
+            std::system(cmd.c_str());
+        }
+    }
+
+    /* creat new ZTD sub-directory */
+    if (fopt->getTrp)
+    {
+        char dir[MAXSTRPATH] = { '\0' };
+        char sep = (char)FILEPATHSEP;
+        sprintf(dir, "%s%c%s%c%s", popt->ztdDir, sep, sYyyy.c_str(), sep, sDoy.c_str());
+        str.TrimSpace(dir);
+        str.CutFilePathSep(dir);
+        strcpy(dopt.ztdDir, dir);
+        string tmpDir = dir;
+        if (!fopt->dryRun && access(tmpDir.c_str(), 0) == -1)
+        {
+            /* If the directory does not exist, creat it */
+#ifdef _WIN32   /* for Windows */
+            string cmd = "mkdir " + tmpDir;
+#else           /* for Linux or Mac */
+            string cmd = "mkdir -p " + tmpDir;
+#endif
+            std::system(cmd.c_str());
+        }
+    }
+
+    /* the main entry of FTP downloader */
+    if (ftp) ftp->FtpDownload(&dopt, &dfopt);
+    else
+    {
+        FtpUtil dayFtp;
+        dayFtp.FtpDownload(&dopt, &dfopt);
+    }
+} /* end of DownloadDay */
+
+/**
+* @brief   : RunDaemon - poll the current day and the days before until the daemon is stopped
+* @param[I]: popt (processing options)
+* @param[I/O]: fopt (FTP options)
+* @param[O]: none
+* @return  : none
+* @note    : the options are read once, and one downloader is kept for all the rounds, so its connections
+*            stay warm; each product is polled by its own publication cadence, and the daemon is stopped by
+*            SIGINT or SIGTERM after the current round; with 'backfill' the days of the start time are
+*            downloaded newest first by another thread, which waits whenever a task is due in the rounds
+**/
+void PreProcess::RunDaemon(const prcopt_t *popt, ftpopt_t *fopt)
+{
+    /* the backfill keeps the on-disk listings of the past days */
+    ftpopt_t bfopt = *fopt;
+
+    /* the new files are seen in the next round, as the listings are not cached on disk */
+    fopt->listCacheTtl = 0;
+    signal(SIGINT, OnSignal);
+    signal(SIGTERM, OnSignal);
+    cout << "*** INFO(PreProcess::RunDaemon): the daemon is started for the current day and " << fopt->daemonDays <<
+        " day(s) before, stop it by Ctrl+C or SIGTERM" << endl;
+
+    /* the backfill lane, newest day first, in its own thread */
+    FtpUtil bfFtp;
+    bfFtp.SetBackfill(fopt->backfillBw * 1.0E6 / 8.0);
+    std::atomic<int> nextDay(fopt->backfill ? popt->ndays - 1 : -1);
+    std::atomic<bool> laneDone(false);
+    std::thread lane;
+    if (nextDay >= 0)
+    {
+        cout << "*** INFO(PreProcess::RunDaemon): the backfill of " << popt->ndays << " day(s) is started, newest first" << endl;
+        lane = std::thread([&]()
+        {
+            for (int k; !_stop && (k = nextDay--) >= 0; ) DownloadDay(popt, &bfopt, k, &bfFtp);
+            if (!_stop) cout << "*** INFO(PreProcess::RunDaemon): the backfill is finished" << endl;
+            laneDone = true;
+        });
+    }
+
+    TimeUtil tu;
+    FtpUtil ftp;
+    ftp.SetDaemon(true);
+    prcopt_t dopt = *popt;
+    while (!_stop)
+    {
+        /* the current day in UTC, and the days before for the late products */
+        time_t now = time(NULL);
+        struct tm *t = gmtime(&now);
+        dopt.ts = tu.yrdoy2time(t->tm_year + 1900, t->tm_yday + 1);
+        CurlUtil::ResetRun();
+        for (int k = fopt->daemonDays; k >= 0 && !_stop; k--) DownloadDay(&dopt, fopt, -k, &ftp);
+        CurlUtil::SaveHealth();
+
+        for (int i = 0; i < DAEMONTICK && !_stop; i++) std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+
+    /* the backfill stops after its current day */
+    if (lane.joinable())
+    {
+        if (!laneDone) cout << "*** INFO(PreProcess::RunDaemon): waiting for the day of the backfill in progress" << endl;
+        lane.join();
+    }
+    CurlUtil::SaveHealth();
+    cout << "*** INFO(PreProcess::RunDaemon): the daemon is stopped" << endl;
+} /* end of RunDaemon */
+
+/**
+* @brief   : run - start iPPP-RTK processing
+* @param[I]: cfgFile (configure file with full path)
+* @param[I]: dryRun (true: the downloads are only planned and summarized, false: downloaded)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void PreProcess::run(const char *cfgFile, bool dryRun)
+{
+    prcopt_t popt;
+    ftpopt_t fopt;
+    /* initialization */
+    init(&popt, &fopt);
+
+    /* read configure file to get processing information */
+    ReadCfgFile(cfgFile, &popt, &fopt);
+
+    /* data downloading for GNSS further processing, several days at the same time, each in its own directories
+       while the working directory of the process is never changed; with '--dry-run' the downloads
+       of all the days are only planned, and the plan is deduplicated across the days and the products,
+       i.e., the orbits of the days before and after, and the weekly products */
+    /* the daemon polls the near-real-time products and observations until it is stopped */
+    if (fopt.ftpDownloading && fopt.daemon && !dryRun)
+    {
+        RunDaemon(&popt, &fopt);
 
-            /* creat new ZTD sub-directory */
-            if (fopt.getTrp)
+        return;
+    }
+
+    if (fopt.ftpDownloading)
+    {
+        fopt.dryRun = dryRun;
+
+        /* the days are downloaded in parallel, each in its own directories */
+        ThreadUtil thr;
+        thr.RunOrdered(popt.ndays, fopt.parallelDays, [&](int k, ostringstream &log)
+        {
+            DownloadDay(&popt, &fopt, k);
+        });
+
+        if (dryRun)
+        {
+            /* the plan is the only file of the dry run, so only its directory is created */
+            string tmpDir = popt.mainDir;
+            if (access(tmpDir.c_str(), 0) == -1)
             {
-                char dir[MAXSTRPATH] = { '\0' };
-                char sep = (char)FILEPATHSEP;
-                sprintf(dir, "%s%c%s%c%s", ztdDirMain.c_str(), sep, sYyyy.c_str(), sep, sDoy.c_str());
-                str.TrimSpace(dir);
-                str.CutFilePathSep(dir);
-                strcpy(popt.ztdDir, dir);
-                string tmpDir = dir;
-                if (access(tmpDir.c_str(), 0) == -1)
-                {
-                    /* If the directory does not exist, creat it */
 #ifdef _WIN32   /* for Windows */
-                    string cmd = "mkdir " + tmpDir;
+                string cmd = "mkdir " + tmpDir;
 #else           /* for Linux or Mac */
-                    string cmd = "mkdir -p " + tmpDir;
+                string cmd = "mkdir -p " + tmpDir;
 #endif
-                    std::system(cmd.c_str());
-                }
+                std::system(cmd.c_str());
             }
 
-            /* the main entry of FTP downloader */
-            ftp.FtpDownload(&popt, &fopt);
+            string planFile = popt.mainDir;
+            planFile = planFile + (char)FILEPATHSEP + "download_plan.txt";
+            CurlUtil curl;
+            int nfile, nunknown;
+            long long nbytes;
+            if (!curl.WritePlan(planFile, &nfile, &nbytes, &nunknown)) cerr << "*** ERROR(PreProcess::run): write " <<
+                planFile << " file failed, please check it" << endl;
+            cout << "*** INFO(PreProcess::run): dry run, " << nfile << " files to be downloaded, " << fixed <<
+                setprecision(1) << nbytes / 1024.0 / 1024.0 << " MB in total";
+            if (nunknown > 0) cout << " besides " << nunknown << " files of unknown size";
+            cout << ", see " << planFile << endl;
+
+            return;
+        }
+
+        /* the health history of the hosts recorded by all the days */
+        CurlUtil::SaveHealth();
+    }
+
+    /* the RINEX observation files of the list are converted to Compact RINEX, several files at the same time */
+    if (fopt.rnx2crx > 0)
+    {
+        ifstream rnxLst(fopt.rnx2crxList);
+        if (!rnxLst.is_open())
+        {
+            cerr << "*** ERROR(PreProcess::run): open rnx.list = " << fopt.rnx2crxList <<
+                " file failed, please check it" << endl;
 
-            popt.ts = tu.TimeAdd(popt.ts, 86400.0);
+            return;
+        }
+        vector<string> rnxFiles;
+        string rnxFile;
+        while (getline(rnxLst, rnxFile))
+        {
+            rnxFile.erase(rnxFile.find_last_not_of(" \t\r") + 1);
+            rnxFile.erase(0, rnxFile.find_first_not_of(" \t"));
+            if (rnxFile.size() > 0) rnxFiles.push_back(rnxFile);
         }
+        CrxUtil crx;
+        int nconv = crx.Rnx2CrxFiles(rnxFiles, fopt.rnx2crx == 2, fopt.rnx2crxThreads);
+        cout << "*** INFO(PreProcess::run): " << nconv << " of " << rnxFiles.size() <<
+            " RINEX files are converted to Compact RINEX" << endl;
     }
 } /* end of run */
\ No newline at end of file
@@ -3,6 +3,8 @@
 *-----------------------------------------------------------------------------*/
 #pragma once
 
+class FtpUtil;                    /* downloader of the observations and products */
+
 class PreProcess
 {
 private:
@@ -26,6 +28,33 @@ private:
     **/
     bool ReadCfgFile(const char *cfgFile, prcopt_t *popt, ftpopt_t *fopt);
 
+    /**
+    * @brief   : DownloadDay - download the data of one day
+    * @param[I]: popt (processing options)
+    * @param[I]: fopt (FTP options)
+    * @param[I]: iday (index of the day after the start time)
+    * @param[I]: ftp (downloader kept for all the days by the daemon, which runs only the tasks due, or by its
+    *            backfill lane; nullptr: a new one runs all the tasks)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the options are copied for the day, so the days can be downloaded by several threads at the
+    *            same time
+    **/
+    void DownloadDay(const prcopt_t *popt, const ftpopt_t *fopt, int iday, FtpUtil *ftp = nullptr);
+
+    /**
+    * @brief   : RunDaemon - poll the current day and the days before until the daemon is stopped
+    * @param[I]: popt (processing options)
+    * @param[I/O]: fopt (FTP options)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the options are read once, and one downloader is kept for all the rounds, so its connections
+    *            stay warm; each product is polled by its own publication cadence, and the daemon is stopped by
+    *            SIGINT or SIGTERM after the current round; with 'backfill' the days of the start time are
+    *            downloaded newest first by another thread, which waits whenever a task is due in the rounds
+    **/
+    void RunDaemon(const prcopt_t *popt, ftpopt_t *fopt);
+
 public:
     PreProcess()
 	{
@@ -39,9 +68,10 @@ public:
     /**
     * @brief   : run - start iPPP-RTK processing
     * @param[I]: cfgFile (configure file with full path)
+    * @param[I]: dryRun (true: the downloads are only planned and summarized, false: downloaded)
     * @param[O]: none
     * @return  : none
     * @note    :
     **/
-    void run(const char *cfgFile);
+    void run(const char *cfgFile, bool dryRun = false);
 };
\ No newline at end of file
@@ -0,0 +1,385 @@
+/*------------------------------------------------------------------------------
+* RnxReader.cpp : reading of the observation files kept compressed, decoded on demand
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) Group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader)
+*
+* References:
+*    RINEX - The Receiver Independent Exchange Format, Version 2.11 and 3.05
+*    Hatanaka Y (2008) A compression format and tools for GNSS observation data. Bulletin of the
+*        Geographical Survey Institute, 55: 21-30
+*
+* history : 2026/10/16 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "Good.h"
+#include "ZipUtil.h"
+#include "CrxUtil.h"
+#include "RnxReader.h"
+
+
+/* constants/macros ----------------------------------------------------------*/
+#define CHUNK           65536     /* size of the buffer of the file read */
+#define CRXLABEL        "CRINEX VERS   / TYPE"  /* label of the first line of Compact RINEX */
+
+
+/* function definition -------------------------------------------------------*/
+
+/* get the integer of the fixed-width field of the line (0: blank or out of the line) */
+static int Field(const string &line, size_t pos, size_t n)
+{
+    if (pos >= line.size()) return 0;
+
+    return atoi(line.substr(pos, n).c_str());
+}
+
+/* check whether the header line has the label */
+static bool HasLabel(const string &line, const char *label)
+{
+    return line.size() > 60 && line.compare(60, strlen(label), label) == 0;
+}
+
+/* get the hour of the epoch line, "yyyymmddhh" (empty: the time is blank) */
+static string EpochHour(const string &line, double ver)
+{
+    int yyyy, mm, dd, hh;
+    if (ver >= 3.0)
+    {
+        yyyy = Field(line, 2, 4);
+        mm = Field(line, 7, 2);
+        dd = Field(line, 10, 2);
+        hh = Field(line, 13, 2);
+    }
+    else
+    {
+        yyyy = Field(line, 1, 2);
+        yyyy += yyyy < 80 ? 2000 : 1900;
+        mm = Field(line, 4, 2);
+        dd = Field(line, 7, 2);
+        hh = Field(line, 10, 2);
+    }
+    if (mm < 1 || dd < 1) return "";
+
+    char hour[48];
+    sprintf(hour, "%04d%02d%02d%02d", yyyy, mm, dd, hh);
+
+    return hour;
+}
+
+/**
+* @brief   : Fill - read the next piece of the file, and decompress and decode it to the RINEX lines
+* @param[I]: none
+* @param[O]: none
+* @return  : true: the piece is read, false: the end of the file has been reached before
+* @note    :
+**/
+bool RnxReader::Fill()
+{
+    if (!_fp || _eof) return false;
+
+    char data[CHUNK];
+    size_t n = fread(data, 1, CHUNK, _fp);
+    if (n > 0)
+    {
+        if (_fmt == ZIP_NONE) _raw.append(data, n);
+        else if (!_zip.Inflate(data, n, nullptr)) _failed = true;
+    }
+    else
+    {
+        _eof = true;
+        if (_fmt != ZIP_NONE && !_zip.EndInflate()) _failed = true;
+    }
+    if (_failed) _eof = true;
+
+    /* Compact RINEX is recognized by the label of the first line */
+    if (!_detected)
+    {
+        if (_raw.size() < 80 && !_eof) return true;
+        size_t end = _raw.find('\n');
+        _isCrx = _raw.substr(0, end).find(CRXLABEL) != string::npos;
+        if (_isCrx) _crx.BeginDecode();
+        _detected = true;
+    }
+    if (_isCrx)
+    {
+        if (!_raw.empty() && !_crx.Decode(_raw.data(), _raw.size(), nullptr)) _failed = true;
+        if (_eof && !_failed && !_crx.EndDecode(nullptr)) _failed = true;
+    }
+    else _buf.append(_raw);
+    _raw.clear();
+
+    return true;
+} /* end of Fill */
+
+/**
+* @brief   : Open - open the observation file to be read
+* @param[I]: file (RINEX or Compact RINEX file, i.e., '*.yyo', '*.yyd', '*.rnx' or '*.crx', which may
+*            be compressed as '*.gz' or '*.Z')
+* @param[O]: none
+* @return  : true: OK, false: the file does not exist or the compression is not supported
+* @note    : Compact RINEX is recognized by its first line, and nothing is expanded to the disk
+**/
+bool RnxReader::Open(const string &file)
+{
+    Close();
+
+    _fp = fopen(file.c_str(), "rb");
+    if (!_fp) return false;
+
+    _fmt = _zip.Format(file);
+    _zip.SetOutput(&_raw);
+    _crx.SetOutput(&_buf);
+    if (_fmt != ZIP_NONE && !_zip.BeginInflate(_fmt))
+    {
+        Close();
+
+        return false;
+    }
+
+    /* the RINEX file converted with 'gzipObs' can be sought by the hours */
+    if (_fmt == ZIP_GZIP && !_zip.ReadIndex(file, _keys, _offsets))
+    {
+        _keys.clear();
+        _offsets.clear();
+    }
+    _eof = false;
+
+    return true;
+} /* end of Open */
+
+/**
+* @brief   : Close - close the file
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void RnxReader::Close()
+{
+    if (_fp) fclose(_fp);
+    _fp = nullptr;
+    if (_fmt != ZIP_NONE) _zip.EndInflate();
+    _fmt = ZIP_NONE;
+    _detected = false;
+    _isCrx = false;
+    _eof = true;
+    _failed = false;
+    _raw.clear();
+    _buf.clear();
+    _pos = 0;
+    _header = false;
+    _head.clear();
+    _ver = 0.0;
+    _ntype = 0;
+    _pend.clear();
+    _keys.clear();
+    _offsets.clear();
+} /* end of Close */
+
+/**
+* @brief   : ReadLine - read the next line of RINEX
+* @param[I]: none
+* @param[O]: line (RINEX line without the line ending)
+* @return  : true: OK, false: the end of the file or the data failed to be decoded
+* @note    : the file is decompressed and decoded only as far as the line
+**/
+bool RnxReader::ReadLine(string &line)
+{
+    size_t end;
+    while ((end = _buf.find('\n', _pos)) == string::npos)
+    {
+        if (!Fill()) break;
+    }
+
+    /* the last line may have no line ending */
+    if (end == string::npos)
+    {
+        if (_pos >= _buf.size()) return false;
+        end = _buf.size();
+    }
+    line.assign(_buf, _pos, end - _pos);
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    _pos = end < _buf.size() ? end + 1 : end;
+
+    /* the lines read are dropped once they are the most of the buffer */
+    if (_pos > CHUNK && _pos * 2 > _buf.size())
+    {
+        _buf.erase(0, _pos);
+        _pos = 0;
+    }
+
+    return true;
+} /* end of ReadLine */
+
+/**
+* @brief   : ReadHeader - read the header of RINEX
+* @param[I]: none
+* @param[O]: lines (lines of the header, up to 'END OF HEADER')
+* @return  : true: OK, false: the header is not complete
+* @note    : the header read before is given if it is called again
+**/
+bool RnxReader::ReadHeader(vector<string> &lines)
+{
+    if (!_header)
+    {
+        string line;
+        while (ReadLine(line))
+        {
+            _head.push_back(line);
+            if (HasLabel(line, "RINEX VERSION / TYPE")) _ver = atof(line.substr(0, 9).c_str());
+            else if (HasLabel(line, "# / TYPES OF OBSERV") && Field(line, 0, 6) > 0) _ntype = Field(line, 0, 6);
+            else if (HasLabel(line, "END OF HEADER"))
+            {
+                _header = true;
+                break;
+            }
+        }
+    }
+    lines = _head;
+
+    return _header;
+} /* end of ReadHeader */
+
+/**
+* @brief   : ReadEpoch - read the next epoch of RINEX
+* @param[I]: none
+* @param[O]: lines (epoch line followed by the data lines, or the header lines of the event)
+* @return  : true: OK, false: the end of the file or the epoch is not valid
+* @note    : the header is read first if it has not been read, and the epochs of RINEX 2 are split by
+*            the number of the observation types
+**/
+bool RnxReader::ReadEpoch(vector<string> &lines)
+{
+    lines.clear();
+    if (!_pend.empty())
+    {
+        lines.swap(_pend);
+
+        return true;
+    }
+    if (!_header)
+    {
+        vector<string> head;
+        if (!ReadHeader(head)) return false;
+    }
+
+    string line;
+    if (!ReadLine(line)) return false;
+    lines.push_back(line);
+
+    /* the number of the lines following the epoch line */
+    int flag, num, nline;
+    if (_ver >= 3.0)
+    {
+        if (line.empty() || line[0] != '>')
+        {
+            _failed = true;
+
+            return false;
+        }
+        flag = Field(line, 31, 1);
+        num = Field(line, 32, 3);
+        nline = num;
+    }
+    else
+    {
+        flag = Field(line, 28, 1);
+        num = Field(line, 29, 3);
+        if (flag >= 2 && flag <= 5) nline = num;
+        else nline = (num > 12 ? (num - 1) / 12 : 0) + num * ((_ntype + 4) / 5);
+    }
+    for (int i = 0; i < nline; i++)
+    {
+        if (!ReadLine(line))
+        {
+            _failed = true;
+
+            return false;
+        }
+        lines.push_back(line);
+
+        /* the observation types of RINEX 2 may be changed by the event */
+        if (flag >= 2 && flag <= 5 && HasLabel(line, "# / TYPES OF OBSERV") && Field(line, 0, 6) > 0)
+            _ntype = Field(line, 0, 6);
+    }
+
+    return true;
+} /* end of ReadEpoch */
+
+/**
+* @brief   : SeekHour - skip to the first epoch of the hour
+* @param[I]: hour (hour, i.e., "yyyymmddhh")
+* @param[O]: none
+* @return  : true: OK, false: no epoch in or after the hour
+* @note    : the indexed gzip file is sought to the member of the hour directly, and the others are
+*            read through the epochs before it
+**/
+bool RnxReader::SeekHour(const string &hour)
+{
+    vector<string> lines;
+    if (!ReadHeader(lines)) return false;
+
+    if (!_keys.empty())
+    {
+        size_t i = 0;
+        while (i < _keys.size() && _keys[i] < hour) i++;
+        _raw.clear();
+        _buf.clear();
+        _pos = 0;
+        _pend.clear();
+        if (i >= _keys.size())
+        {
+            _eof = true;
+
+            return false;
+        }
+
+        /* the member starts with the epoch, and the members after it are inflated as one stream */
+        if (ZipUtil::Seek64(_fp, _offsets[i]) != 0 || !_zip.BeginInflate(ZIP_GZIP))
+        {
+            _failed = true;
+            _eof = true;
+
+            return false;
+        }
+        _eof = false;
+
+        return true;
+    }
+
+    while (ReadEpoch(lines))
+    {
+        string epHour = EpochHour(lines[0], _ver);
+        if (!epHour.empty() && epHour >= hour)
+        {
+            _pend.swap(lines);
+
+            return true;
+        }
+    }
+
+    return false;
+} /* end of SeekHour */
+
+/**
+* @brief   : Version - get the version of RINEX
+* @param[I]: none
+* @param[O]: none
+* @return  : version of RINEX (0.0: the header has not been read)
+* @note    :
+**/
+double RnxReader::Version()
+{
+    return _ver;
+} /* end of Version */
+
+/**
+* @brief   : Failed - check whether the reading stopped for the corrupted or truncated file
+* @param[I]: none
+* @param[O]: none
+* @return  : true: the file is not valid, false: OK or the end of the file
+* @note    :
+**/
+bool RnxReader::Failed()
+{
+    return _failed;
+} /* end of Failed */
@@ -0,0 +1,130 @@
+/*------------------------------------------------------------------------------
+* RnxReader.h : header file of RnxReader.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+class RnxReader
+{
+private:
+    FILE *_fp;                    /* file being read (nullptr: not opened) */
+    int _fmt;                     /* compression of the file, ZIP_GZIP, ZIP_LZW or ZIP_NONE */
+    ZipUtil _zip;                 /* streaming inflation of the file */
+    CrxUtil _crx;                 /* streaming decoding of Compact RINEX */
+    bool _detected;               /* the content has been checked for Compact RINEX */
+    bool _isCrx;                  /* the content is Compact RINEX, which is decoded as the lines are read */
+    bool _eof;                    /* the end of the file has been reached */
+    bool _failed;                 /* the file is corrupted, truncated or not valid */
+    string _raw;                  /* data decompressed but not decoded yet */
+    string _buf;                  /* RINEX lines decoded but not read yet */
+    size_t _pos;                  /* position of the next line in '_buf' */
+    bool _header;                 /* the header has been read */
+    vector<string> _head;         /* lines of the header */
+    double _ver;                  /* version of RINEX */
+    int _ntype;                   /* number of the observation types of RINEX 2 */
+    vector<string> _pend;         /* epoch read ahead by SeekHour */
+    vector<string> _keys;         /* hours of the members of the indexed gzip file (empty: not indexed) */
+    vector<long long> _offsets;   /* offsets of the members of '_keys' */
+
+    /**
+    * @brief   : Fill - read the next piece of the file, and decompress and decode it to the RINEX lines
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true: the piece is read, false: the end of the file has been reached before
+    * @note    :
+    **/
+    bool Fill();
+
+public:
+    RnxReader()
+	{
+        _fp = nullptr;
+        _fmt = ZIP_NONE;
+        _detected = false;
+        _isCrx = false;
+        _eof = true;
+        _failed = false;
+        _pos = 0;
+        _header = false;
+        _ver = 0.0;
+        _ntype = 0;
+	}
+	~RnxReader()
+	{
+        Close();
+	}
+
+    /**
+    * @brief   : Open - open the observation file to be read
+    * @param[I]: file (RINEX or Compact RINEX file, i.e., '*.yyo', '*.yyd', '*.rnx' or '*.crx', which may
+    *            be compressed as '*.gz' or '*.Z')
+    * @param[O]: none
+    * @return  : true: OK, false: the file does not exist or the compression is not supported
+    * @note    : Compact RINEX is recognized by its first line, and nothing is expanded to the disk
+    **/
+    bool Open(const string &file);
+
+    /**
+    * @brief   : Close - close the file
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void Close();
+
+    /**
+    * @brief   : ReadLine - read the next line of RINEX
+    * @param[I]: none
+    * @param[O]: line (RINEX line without the line ending)
+    * @return  : true: OK, false: the end of the file or the data failed to be decoded
+    * @note    : the file is decompressed and decoded only as far as the line
+    **/
+    bool ReadLine(string &line);
+
+    /**
+    * @brief   : ReadHeader - read the header of RINEX
+    * @param[I]: none
+    * @param[O]: lines (lines of the header, up to 'END OF HEADER')
+    * @return  : true: OK, false: the header is not complete
+    * @note    : the header read before is given if it is called again
+    **/
+    bool ReadHeader(vector<string> &lines);
+
+    /**
+    * @brief   : ReadEpoch - read the next epoch of RINEX
+    * @param[I]: none
+    * @param[O]: lines (epoch line followed by the data lines, or the header lines of the event)
+    * @return  : true: OK, false: the end of the file or the epoch is not valid
+    * @note    : the header is read first if it has not been read, and the epochs of RINEX 2 are split by
+    *            the number of the observation types
+    **/
+    bool ReadEpoch(vector<string> &lines);
+
+    /**
+    * @brief   : SeekHour - skip to the first epoch of the hour
+    * @param[I]: hour (hour, i.e., "yyyymmddhh")
+    * @param[O]: none
+    * @return  : true: OK, false: no epoch in or after the hour
+    * @note    : the indexed gzip file is sought to the member of the hour directly, and the others are
+    *            read through the epochs before it
+    **/
+    bool SeekHour(const string &hour);
+
+    /**
+    * @brief   : Version - get the version of RINEX
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : version of RINEX (0.0: the header has not been read)
+    * @note    :
+    **/
+    double Version();
+
+    /**
+    * @brief   : Failed - check whether the reading stopped for the corrupted or truncated file
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : true: the file is not valid, false: OK or the end of the file
+    * @note    :
+    **/
+    bool Failed();
+};
@@ -8,6 +8,7 @@
 *    
 *
 * history : 2020/09/25 1.0  new (by Feng Zhou)
+*           2026/10/16 1.1  list the files of the directory without changing the working directory of the process
 *-----------------------------------------------------------------------------*/
 #include "Good.h"
 #include "StringUtil.h"
@@ -237,55 +238,84 @@ void StringUtil::CutFilePathSep(char *strPath)
 } /* end of CutFilePathSep */
 
 /**
-* @brief   : GetFilesAll - get the name list of all the files from the current directory
-* @param[I]: dir (the current directory)
+* @brief   : GetFilesAll - get the name list of all the files in the directory
+* @param[I]: dir (the directory)
 * @param[I]: suffix (file suffix)
-* @param[O]: files (the name list of all the files)
+* @param[O]: files (the name list of all the files, in the alphabetical order)
 * @return  : none
-* @note    :
+* @note    : the directory is read directly, so neither the working directory of the process is changed nor
+*            the list file is written in it, and the days downloaded in parallel can list their own directories
 **/
 void StringUtil::GetFilesAll(string dir, string suffix, vector<string> &files)
 {
-    /* change directory */
+    vector<string> names;
 #ifdef _WIN32   /* for Windows */
-    _chdir(dir.c_str());
+    WIN32_FIND_DATAA data;
+    string pattern = dir + "\\*";
+    HANDLE h = FindFirstFileA(pattern.c_str(), &data);
+    if (h != INVALID_HANDLE_VALUE)
+    {
+        do
+        {
+            if (!(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) names.push_back(data.cFileName);
+        } while (FindNextFileA(h, &data));
+        FindClose(h);
+    }
 #else           /* for Linux or Mac */
-    chdir(dir.c_str());
+    DIR *dp = opendir(dir.c_str());
+    if (dp)
+    {
+        struct dirent *ent;
+        while ((ent = readdir(dp)) != nullptr)
+        {
+            string path = dir + (char)FILEPATHSEP + ent->d_name;
+            struct stat st;
+            if (stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode)) names.push_back(ent->d_name);
+        }
+        closedir(dp);
+    }
 #endif
 
-    string cmd, fileList = "files.list";
-#ifdef _WIN32   /* for Windows */
-    cmd = "dir /b | find \"" + suffix + "\"" + " > " + fileList;
-#else           /* for Linux or Mac */
-    cmd = "ls *" + suffix + "* > " + fileList;
-#endif
-    std::system(cmd.c_str());
+    /* the names including the suffix, as they are matched by 'ls *<suffix>*' */
+    std::sort(names.begin(), names.end());
+    for (size_t i = 0; i < names.size(); i++)
+    {
+        if (names[i].find(suffix) != string::npos) files.push_back(names[i]);
+    }
+} /* end of GetFilesAll */
 
-    if (access(fileList.c_str(), 0) == 0)
+/**
+* @brief   : WildMatch - check if the string matches the wildcard pattern
+* @param[I]: pattern (wildcard pattern, '*': any characters, '?': one character)
+* @param[I]: str (string to be checked)
+* @param[O]: none
+* @return  : true: matched, false: not matched
+* @note    : the same as the accept list (-A) of 'wget'
+**/
+bool StringUtil::WildMatch(const char *pattern, const char *str)
+{
+    const char *star = nullptr, *back = nullptr;
+    while (*str)
     {
-        ifstream filLst(fileList.c_str());
-        if (!filLst.is_open())
+        if (*pattern == '?' || *pattern == *str)
         {
-            cerr << "*** ERROR(StringUtil::GetFilesAll): open files.list = " << fileList << " file failed, please check it" << endl;
-
-            return;
+            pattern++;
+            str++;
         }
-
-        string fileName;
-        while (getline(filLst, fileName))
+        else if (*pattern == '*')
         {
-            files.push_back(fileName);
+            /* remember the position of '*' for backtracking */
+            star = pattern++;
+            back = str;
         }
-
-        /* close 'files.list' */
-        filLst.close();
+        else if (star)
+        {
+            pattern = star + 1;
+            str = ++back;
+        }
+        else return false;
     }
+    while (*pattern == '*') pattern++;
 
-    /* delete 'files.list' */
-#ifdef _WIN32   /* for Windows */
-    cmd = "del " + fileList;
-#else           /* for Linux or Mac */
-    cmd = "rm -rf " + fileList;
-#endif
-    std::system(cmd.c_str());
-} /* end of GetFilesAll */
\ No newline at end of file
+    return *pattern == '\0';
+} /* end of WildMatch */
\ No newline at end of file
@@ -127,12 +127,23 @@ public:
     void CutFilePathSep(char *strPath);
 
     /**
-    * @brief   : GetFilesAll - get the name list of all the files from the current directory
-    * @param[I]: dir (the current directory)
+    * @brief   : GetFilesAll - get the name list of all the files in the directory
+    * @param[I]: dir (the directory)
     * @param[I]: suffix (file suffix)
-    * @param[O]: files (the name list of all the files)
+    * @param[O]: files (the name list of all the files, in the alphabetical order)
     * @return  : none
-    * @note    :
+    * @note    : the directory is read directly, so neither the working directory of the process is changed nor
+    *            the list file is written in it, and the days downloaded in parallel can list their own directories
     **/
     void GetFilesAll(string dir, string suffix, vector<string> &files);
+
+    /**
+    * @brief   : WildMatch - check if the string matches the wildcard pattern
+    * @param[I]: pattern (wildcard pattern, '*': any characters, '?': one character)
+    * @param[I]: str (string to be checked)
+    * @param[O]: none
+    * @return  : true: matched, false: not matched
+    * @note    : the same as the accept list (-A) of 'wget'
+    **/
+    bool WildMatch(const char *pattern, const char *str);
 };
\ No newline at end of file
@@ -0,0 +1,84 @@
+/*------------------------------------------------------------------------------
+* ThreadUtil.cpp : multi-thread functions
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) Group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader)
+*
+* References:
+*    
+*
+* history : 2026/10/16 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "Good.h"
+#include "ThreadUtil.h"
+
+
+/* constants/macros ----------------------------------------------------------*/
+
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : RunOrdered - run the jobs on a bounded pool of worker threads, and print the
+*            messages of the jobs in the order they are submitted
+* @param[I]: njobs (number of jobs)
+* @param[I]: nthreads (maximum number of jobs in flight, <= 1: run one by one in the calling thread)
+* @param[I]: job (job function, the arguments are the index of job and the buffer of its messages)
+* @param[O]: none
+* @return  : none
+* @note    : the messages are the same as those of serial processing whatever the number of threads is
+**/
+void ThreadUtil::RunOrdered(int njobs, int nthreads, const std::function<void(int, ostringstream &)> &job)
+{
+    if (njobs <= 0) return;
+    if (nthreads > njobs) nthreads = njobs;
+    if (nthreads <= 1)
+    {
+        for (int i = 0; i < njobs; i++)
+        {
+            ostringstream log;
+            job(i, log);
+            cout << log.str() << flush;
+        }
+
+        return;
+    }
+
+    vector<ostringstream> logs(njobs);
+    vector<bool> done(njobs, false);
+    std::atomic<int> next(0);
+    std::mutex mtx;
+    std::condition_variable cv;
+
+    /* each worker takes the next job until all the jobs are taken */
+    vector<std::thread> workers;
+    for (int k = 0; k < nthreads; k++)
+    {
+        workers.push_back(std::thread([&]()
+        {
+            int i;
+            while ((i = next++) < njobs)
+            {
+                job(i, logs[i]);
+
+                std::lock_guard<std::mutex> lock(mtx);
+                done[i] = true;
+                cv.notify_one();
+            }
+        }));
+    }
+
+    /* the messages are printed once all the jobs before have been printed */
+    for (int i = 0; i < njobs; i++)
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [&]() { return done[i]; });
+        lock.unlock();
+
+        cout << logs[i].str() << flush;
+        logs[i].str("");
+    }
+
+    for (size_t k = 0; k < workers.size(); k++) workers[k].join();
+} /* end of RunOrdered */
+
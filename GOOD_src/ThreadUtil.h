@@ -0,0 +1,33 @@
+/*------------------------------------------------------------------------------
+* ThreadUtil.h : header file of ThreadUtil.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+class ThreadUtil
+{
+private:
+
+
+public:
+    ThreadUtil()
+	{
+
+	}
+	~ThreadUtil()
+	{
+
+	}
+
+    /**
+    * @brief   : RunOrdered - run the jobs on a bounded pool of worker threads, and print the
+    *            messages of the jobs in the order they are submitted
+    * @param[I]: njobs (number of jobs)
+    * @param[I]: nthreads (maximum number of jobs in flight, <= 1: run one by one in the calling thread)
+    * @param[I]: job (job function, the arguments are the index of job and the buffer of its messages)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the messages are the same as those of serial processing whatever the number of threads is
+    **/
+    void RunOrdered(int njobs, int nthreads, const std::function<void(int, ostringstream &)> &job);
+
+};
@@ -562,7 +562,7 @@ void TimeUtil::time2str(gtime_t tt, char *s, int n)
 **/
 char* TimeUtil::TimeStr(gtime_t tt, int n)
 {
-    static char buff[64];
+    static thread_local char buff[64];  /* one buffer per thread, for the days downloaded in parallel */
     time2str(tt, buff, n);
 
     return buff;
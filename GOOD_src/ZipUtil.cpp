@@ -0,0 +1,653 @@
+/*------------------------------------------------------------------------------
+* ZipUtil.cpp : in-process decompression of the downloaded products
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) Group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader)
+*
+* References:
+*    zlib - a massively spiffy yet delicately unobtrusive compression library, https://zlib.net/
+*    RFC 1952, GZIP file format specification version 4.3
+*    ncompress - the classic Unix compression utility, https://github.com/vapier/ncompress
+*    SAMv1, the BGZF compression format (gzip members indexed by the extra field)
+*
+* history : 2026/10/16 1.0  new, replacing the 'gzip -d -f' process spawned for each file
+*           2026/10/16 1.1  add the streaming LZW decoder of Unix compress ('*.Z')
+*           2026/10/16 1.2  chain the decoder of Compact RINEX after the inflation
+*           2026/10/16 1.3  write the indexed multi-member gzip file compressed by several threads
+*           2026/10/16 1.4  append the decompressed data to the memory for the reader of the kept files
+*           2026/10/16 1.5  write the decompressed file to '*.part' first, so the killed run leaves no half file
+*           2026/10/16 1.6  seek the members of the indexed gzip file beyond 2 GB
+*-----------------------------------------------------------------------------*/
+#include "Good.h"
+#include "ZipUtil.h"
+#include "CrxUtil.h"
+#include <zlib.h>
+
+
+/* constants/macros ----------------------------------------------------------*/
+#define CHUNK           65536     /* size of the buffer of the decompressed data */
+#define GZIPWBITS       (15 + 16) /* window bits of zlib for the gzip format only */
+#define INITBITS        9         /* initial code width of LZW */
+#define MAXBITS         16        /* maximum code width of LZW */
+#define CLEARCODE       256       /* code to clear the table in block mode */
+#define FIRSTCODE       257       /* first free entry of the table in block mode */
+#define MAXMEMBER       (4 << 20) /* maximum number of bytes of the data of one gzip member */
+#define GZHEADLEN       30        /* length of the header of the indexed gzip member */
+#define GZXLEN          18        /* length of the extra field, subfield 'GO' of the member size and the key */
+#define PARTSUFFIX      ".part"   /* suffix of the file being written */
+
+
+/* local functions -----------------------------------------------------------*/
+/* put the little-endian integer of 'n' bytes */
+static void PutLe(unsigned char *p, unsigned long v, int n)
+{
+    for (int i = 0; i < n; i++) p[i] = (unsigned char)(v >> (8 * i));
+}
+
+/* get the little-endian integer of 'n' bytes */
+static unsigned long GetLe(const unsigned char *p, int n)
+{
+    unsigned long v = 0;
+    for (int i = n - 1; i >= 0; i--) v = (v << 8) | p[i];
+
+    return v;
+}
+
+/* compress the data to one gzip member whose extra field has the size of the member and the key */
+static void DeflateMember(const string *data, const string *key, string *out)
+{
+    out->clear();
+    z_stream zs;
+    memset(&zs, 0, sizeof(zs));
+    if (deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) return;
+
+    string buf(GZHEADLEN + deflateBound(&zs, (uLong)data->size()) + 8, '\0');
+    zs.next_in = (Bytef *)data->data();
+    zs.avail_in = (uInt)data->size();
+    zs.next_out = (Bytef *)&buf[GZHEADLEN];
+    zs.avail_out = (uInt)(buf.size() - GZHEADLEN - 8);
+    int ret = deflate(&zs, Z_FINISH);
+    size_t len = GZHEADLEN + zs.total_out + 8;
+    deflateEnd(&zs);
+    if (ret != Z_STREAM_END) return;
+
+    /* header with FEXTRA, and the trailer of CRC-32 and the size of the data */
+    unsigned char *p = (unsigned char *)&buf[0];
+    p[0] = 0x1f; p[1] = 0x8b; p[2] = 8; p[3] = 4;
+    PutLe(p + 4, 0, 4);
+    p[8] = 0; p[9] = 255;
+    PutLe(p + 10, GZXLEN, 2);
+    p[12] = 'G'; p[13] = 'O';
+    PutLe(p + 14, GZXLEN - 4, 2);
+    PutLe(p + 16, (unsigned long)len, 4);
+    for (int i = 0; i < ZIP_KEYLEN; i++) p[20 + i] = i < (int)key->size() ? (*key)[i] : ' ';
+    unsigned char *t = p + len - 8;
+    PutLe(t, crc32(crc32(0L, Z_NULL, 0), (const Bytef *)data->data(), (uInt)data->size()), 4);
+    PutLe(t + 4, (unsigned long)data->size(), 4);
+    buf.resize(len);
+    out->swap(buf);
+}
+
+
+/* function definition -------------------------------------------------------*/
+
+/**
+* @brief   : Write - write the decompressed data to the file, or decode them as Compact RINEX first
+* @param[I]: data (decompressed data)
+* @param[I]: n (number of bytes of 'data')
+* @param[I]: fp (file the data or the RINEX lines are written to)
+* @return  : true: OK, false: the file failed to be written or the data are not valid Compact RINEX
+* @note    :
+**/
+bool ZipUtil::Write(const void *data, size_t n, FILE *fp)
+{
+    if (_crx) return _crx->Decode((const char *)data, n, fp);
+    if (_mem)
+    {
+        _mem->append((const char *)data, n);
+
+        return true;
+    }
+
+    return fwrite(data, 1, n, fp) == n;
+} /* end of Write */
+
+/**
+* @brief   : Unlzw - decode the next piece of the data of Unix compress and write them to the file
+* @param[I]: data (compressed data)
+* @param[I]: n (number of bytes of 'data')
+* @param[I]: fp (file the decompressed data are written to)
+* @return  : true: OK, false: the data are corrupted or the file failed to be written
+* @note    : the same as 'uncompress' (ncompress) and 'gzip -d', including the padding to the end of
+*            the group of eight codes when the code width changes
+**/
+bool ZipUtil::Unlzw(const unsigned char *data, size_t n, FILE *fp)
+{
+    lzw_t *lz = _lzw;
+    lz->out.clear();
+    for (size_t i = 0; i < n; i++)
+    {
+        /* header: magic number 0x1f 0x9d, and the flags of maximum code width and block mode */
+        if (lz->nhead < 3)
+        {
+            if ((lz->nhead == 0 && data[i] != 0x1f) || (lz->nhead == 1 && data[i] != 0x9d)) return false;
+            if (lz->nhead == 2)
+            {
+                lz->maxbits = data[i] & 0x1f;
+                lz->block = (data[i] & 0x80) != 0;
+                if (lz->maxbits < INITBITS || lz->maxbits > MAXBITS) return false;
+                lz->maxmaxcode = 1L << lz->maxbits;
+                lz->freeEnt = lz->block ? FIRSTCODE : 256;
+                lz->prefix.assign(lz->maxmaxcode, 0);
+                lz->suffix.assign(lz->maxmaxcode, 0);
+                for (int k = 0; k < 256; k++) lz->suffix[k] = (unsigned char)k;
+            }
+            lz->nhead++;
+            continue;
+        }
+
+        lz->bitbuf |= (unsigned long)data[i] << lz->nbuf;
+        lz->nbuf += 8;
+        while (true)
+        {
+            /* the padding to the end of the group of codes */
+            if (lz->skip > 0)
+            {
+                int k = lz->skip < lz->nbuf ? (int)lz->skip : lz->nbuf;
+                lz->bitbuf >>= k;
+                lz->nbuf -= k;
+                lz->skip -= k;
+                if (lz->skip > 0) break;
+            }
+
+            /* the code width is increased, and the rest of the current group of codes is padding */
+            if (lz->freeEnt > lz->maxcode)
+            {
+                lz->skip = (long)((8 - lz->ngroup) % 8) * lz->nbits;
+                lz->ngroup = 0;
+                lz->nbits++;
+                lz->maxcode = lz->nbits == lz->maxbits ? lz->maxmaxcode : (1L << lz->nbits) - 1;
+                continue;
+            }
+            if (lz->nbuf < lz->nbits) break;
+
+            long code = (long)(lz->bitbuf & ((1UL << lz->nbits) - 1));
+            lz->bitbuf >>= lz->nbits;
+            lz->nbuf -= lz->nbits;
+            lz->ngroup = (lz->ngroup + 1) % 8;
+
+            /* the first code is a literal */
+            if (lz->oldcode == -1)
+            {
+                if (code >= 256) return false;
+                lz->oldcode = code;
+                lz->finchar = (int)code;
+                lz->out.push_back((unsigned char)code);
+                continue;
+            }
+
+            /* the table is cleared, and the code width is reset */
+            if (code == CLEARCODE && lz->block)
+            {
+                lz->freeEnt = FIRSTCODE - 1;
+                lz->skip = (long)((8 - lz->ngroup) % 8) * lz->nbits;
+                lz->ngroup = 0;
+                lz->nbits = INITBITS;
+                lz->maxcode = (1L << INITBITS) - 1;
+                continue;
+            }
+
+            /* the string of the code is built in reverse order, and 'KwKwK' is the code not in the table yet */
+            long incode = code;
+            lz->stack.clear();
+            if (code >= lz->freeEnt)
+            {
+                if (code > lz->freeEnt) return false;
+                lz->stack.push_back((unsigned char)lz->finchar);
+                code = lz->oldcode;
+            }
+            while (code >= 256)
+            {
+                if (lz->stack.size() >= (size_t)lz->maxmaxcode) return false;
+                lz->stack.push_back(lz->suffix[code]);
+                code = lz->prefix[code];
+            }
+            lz->finchar = lz->suffix[code];
+            lz->stack.push_back((unsigned char)lz->finchar);
+            lz->out.insert(lz->out.end(), lz->stack.rbegin(), lz->stack.rend());
+
+            /* the new entry of the table */
+            if (lz->freeEnt < lz->maxmaxcode)
+            {
+                lz->prefix[lz->freeEnt] = (unsigned short)lz->oldcode;
+                lz->suffix[lz->freeEnt] = (unsigned char)lz->finchar;
+                lz->freeEnt++;
+            }
+            lz->oldcode = incode;
+        }
+    }
+
+    return lz->out.empty() || Write(lz->out.data(), lz->out.size(), fp);
+} /* end of Unlzw */
+
+/**
+* @brief   : Format - get the compression format from the suffix of the file name
+* @param[I]: file (file name or URL)
+* @param[O]: none
+* @return  : ZIP_GZIP ('*.gz'), ZIP_LZW ('*.Z') or ZIP_NONE
+* @note    :
+**/
+int ZipUtil::Format(const string &file)
+{
+    size_t len = file.size();
+    if (len > 3 && file.compare(len - 3, 3, ".gz") == 0) return ZIP_GZIP;
+    if (len > 2 && file.compare(len - 2, 2, ".Z") == 0) return ZIP_LZW;
+
+    return ZIP_NONE;
+} /* end of Format */
+
+/**
+* @brief   : SetCrx - set the decoder of Compact RINEX chained after the inflation
+* @param[I]: crx (decoder of Compact RINEX, nullptr: the decompressed data are written as they are)
+* @param[O]: none
+* @return  : none
+* @note    : the decoding is started by BeginInflate and ended by EndInflate, so only the RINEX file is
+*            written
+**/
+void ZipUtil::SetCrx(CrxUtil *crx)
+{
+    _crx = crx;
+} /* end of SetCrx */
+
+/**
+* @brief   : SetOutput - set the memory the decompressed data are appended to
+* @param[I]: mem (buffer of the decompressed data, nullptr: written to the file)
+* @param[O]: none
+* @return  : none
+* @note    : the file given to Inflate is ignored if it is set, so the data can be read piece by piece
+*            without being saved
+**/
+void ZipUtil::SetOutput(string *mem)
+{
+    _mem = mem;
+} /* end of SetOutput */
+
+/**
+* @brief   : BeginInflate - start the streaming inflation
+* @param[I]: fmt (format of the stream, ZIP_GZIP or ZIP_LZW)
+* @param[O]: none
+* @return  : true: OK, false: zlib failed to be initialized or the format is not supported
+* @note    : the stream started before is discarded
+**/
+bool ZipUtil::BeginInflate(int fmt)
+{
+    EndInflate();
+
+    _fmt = fmt;
+    _end = false;
+    if (_crx) _crx->BeginDecode();
+    if (fmt == ZIP_LZW)
+    {
+        _lzw = new lzw_t();
+        _lzw->nhead = 0;
+        _lzw->nbits = INITBITS;
+        _lzw->maxcode = (1L << INITBITS) - 1;
+        _lzw->oldcode = -1;
+        _lzw->finchar = 0;
+        _lzw->bitbuf = 0;
+        _lzw->nbuf = 0;
+        _lzw->ngroup = 0;
+        _lzw->skip = 0;
+
+        return true;
+    }
+    if (fmt != ZIP_GZIP) return false;
+
+    z_stream *zs = new z_stream();
+    zs->zalloc = Z_NULL;
+    zs->zfree = Z_NULL;
+    zs->opaque = Z_NULL;
+    zs->next_in = Z_NULL;
+    zs->avail_in = 0;
+    if (inflateInit2(zs, GZIPWBITS) != Z_OK)
+    {
+        delete zs;
+
+        return false;
+    }
+    _zs = zs;
+
+    return true;
+} /* end of BeginInflate */
+
+/**
+* @brief   : Inflate - inflate the next piece of compressed data and write them to the file
+* @param[I]: data (compressed data)
+* @param[I]: n (number of bytes of 'data')
+* @param[I]: fp (file the decompressed data are written to)
+* @return  : true: OK, false: the data are corrupted or the file failed to be written
+* @note    : the stream of several gzip members is supported, and the garbage after the last member is
+*            ignored as 'gzip -d' does
+**/
+bool ZipUtil::Inflate(const char *data, size_t n, FILE *fp)
+{
+    if (_lzw) return Unlzw((const unsigned char *)data, n, fp);
+
+    z_stream *zs = (z_stream *)_zs;
+    if (!zs) return false;
+
+    unsigned char out[CHUNK];
+    zs->next_in = (Bytef *)data;
+    zs->avail_in = (uInt)n;
+    while (zs->avail_in > 0)
+    {
+        /* the next gzip member begins with the magic number, otherwise the rest is garbage */
+        if (_end)
+        {
+            if (zs->next_in[0] != 0x1f) return true;
+            inflateReset(zs);
+            _end = false;
+        }
+
+        zs->next_out = out;
+        zs->avail_out = CHUNK;
+        int ret = inflate(zs, Z_NO_FLUSH);
+        if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) return false;
+
+        size_t nout = CHUNK - zs->avail_out;
+        if (nout > 0 && !Write(out, nout, fp)) return false;
+        if (ret == Z_STREAM_END) _end = true;
+        else if (ret == Z_BUF_ERROR) break;
+    }
+
+    return true;
+} /* end of Inflate */
+
+/**
+* @brief   : EndInflate - end the streaming inflation
+* @param[I]: fp (file the last RINEX lines are written to if Compact RINEX is decoded, nullptr: none)
+* @param[O]: none
+* @return  : true: the stream ends with a complete gzip member or has a valid header of Unix compress,
+*            and the Compact RINEX ends at the end of an epoch, false: the stream is truncated
+* @note    : the data of Unix compress have no trailer, so the truncation after the header is not detected
+**/
+bool ZipUtil::EndInflate(FILE *fp)
+{
+    bool ok = false;
+    if (_lzw)
+    {
+        ok = _lzw->nhead == 3;
+        delete _lzw;
+        _lzw = nullptr;
+    }
+    else if (_zs)
+    {
+        z_stream *zs = (z_stream *)_zs;
+        inflateEnd(zs);
+        delete zs;
+        _zs = nullptr;
+        ok = _end;
+    }
+    else return false;
+
+    /* the last line of Compact RINEX may have no line ending */
+    if (_crx && fp && !_crx->EndDecode(fp)) ok = false;
+
+    return ok;
+} /* end of EndInflate */
+
+/**
+* @brief   : Expand - decompress the compressed file
+* @param[I]: inFile (compressed file)
+* @param[I]: outFile (decompressed file, or RINEX file if the decoder of Compact RINEX is set)
+* @param[I]: fmt (format of 'inFile', ZIP_GZIP or ZIP_LZW)
+* @return  : true: OK, false: failed
+* @note    : it is written to '<outFile>.part' first, which is renamed to 'outFile' only if it succeeds
+**/
+bool ZipUtil::Expand(const string &inFile, const string &outFile, int fmt)
+{
+    FILE *fin = fopen(inFile.c_str(), "rb");
+    if (!fin) return false;
+    string partFile = outFile + PARTSUFFIX;
+    FILE *fout = fopen(partFile.c_str(), "wb");
+    if (!fout)
+    {
+        fclose(fin);
+
+        return false;
+    }
+
+    /* the file is inflated in the same way as the stream from the network */
+    ZipUtil zip;
+    zip.SetCrx(_crx);
+    bool ok = zip.BeginInflate(fmt);
+    char buf[CHUNK];
+    size_t n;
+    while (ok && (n = fread(buf, 1, CHUNK, fin)) > 0) ok = zip.Inflate(buf, n, fout);
+    if (ferror(fin)) ok = false;
+    if (!zip.EndInflate(fout)) ok = false;
+    fclose(fin);
+    if (fclose(fout) != 0) ok = false;
+    if (ok)
+    {
+        remove(outFile.c_str());
+        ok = rename(partFile.c_str(), outFile.c_str()) == 0;
+    }
+    if (!ok) remove(partFile.c_str());
+
+    return ok;
+} /* end of Expand */
+
+/**
+* @brief   : Decompress - decompress the '*.gz' or '*.Z' file to the file without the suffix, and remove
+*            the compressed file as 'gzip -d -f' does
+* @param[I]: file (compressed file)
+* @return  : true: OK, false: the file does not exist, is not compressed, or fails to be decompressed
+* @note    : both formats are decompressed in process
+**/
+bool ZipUtil::Decompress(const string &file)
+{
+    int fmt = Format(file);
+    if (fmt == ZIP_NONE || access(file.c_str(), 0) == -1) return false;
+
+    string outFile = file.substr(0, file.size() - (fmt == ZIP_GZIP ? 3 : 2));
+    if (!Expand(file, outFile, fmt))
+    {
+        cout << "*** WARNING(ZipUtil::Decompress): failed to decompress " << file << endl;
+
+        return false;
+    }
+    remove(file.c_str());
+
+    return true;
+} /* end of Decompress */
+
+/**
+* @brief   : SetThreads - set the number of threads compressing the members of the indexed gzip file
+* @param[I]: nthread (number of threads, < 1: one)
+* @param[O]: none
+* @return  : none
+* @note    :
+**/
+void ZipUtil::SetThreads(int nthread)
+{
+    _nthread = nthread < 1 ? 1 : nthread;
+} /* end of SetThreads */
+
+/**
+* @brief   : BeginDeflate - start the streaming compression of the indexed gzip file
+* @param[I]: none
+* @param[O]: none
+* @return  : none
+* @note    : the data written before the first Cut are in the member without the key, i.e., the header
+*            of RINEX
+**/
+void ZipUtil::BeginDeflate()
+{
+    _blk.clear();
+    _key.clear();
+    _blks.clear();
+    _keys.clear();
+    _nmember = 0;
+} /* end of BeginDeflate */
+
+/**
+* @brief   : Flush - compress the members filled in parallel and write them to the file in order
+* @param[I]: fp (file the gzip members are written to)
+* @param[O]: none
+* @return  : true: OK, false: zlib failed or the file failed to be written
+* @note    :
+**/
+bool ZipUtil::Flush(FILE *fp)
+{
+    size_t n = _blks.size();
+    vector<string> outs(n);
+    vector<std::thread> thrs;
+    for (size_t i = 1; i < n; i++) thrs.push_back(std::thread(DeflateMember, &_blks[i], &_keys[i], &outs[i]));
+    if (n > 0) DeflateMember(&_blks[0], &_keys[0], &outs[0]);
+    for (size_t i = 0; i < thrs.size(); i++) thrs[i].join();
+    _blks.clear();
+    _keys.clear();
+    _nmember += (long)n;
+
+    bool ok = true;
+    for (size_t i = 0; i < n && ok; i++) ok = !outs[i].empty() && fwrite(outs[i].data(), 1, outs[i].size(), fp) == outs[i].size();
+
+    return ok;
+} /* end of Flush */
+
+/**
+* @brief   : Deflate - compress the next piece of data and write them to the file
+* @param[I]: data (data to be compressed)
+* @param[I]: n (number of bytes of 'data')
+* @param[I]: fp (file the gzip members are written to)
+* @return  : true: OK, false: zlib failed or the file failed to be written
+* @note    : the data are compressed when the members for all the threads are filled
+**/
+bool ZipUtil::Deflate(const char *data, size_t n, FILE *fp)
+{
+    while (n > 0)
+    {
+        size_t k = MAXMEMBER - _blk.size() < n ? MAXMEMBER - _blk.size() : n;
+        _blk.append(data, k);
+        data += k;
+        n -= k;
+        if (_blk.size() < MAXMEMBER) break;
+
+        /* the rest of the large member is continued in the member without the key */
+        _blks.push_back(string());
+        _blks.back().swap(_blk);
+        _keys.push_back(_key);
+        _key.clear();
+        if ((int)_blks.size() >= _nthread && !Flush(fp)) return false;
+    }
+
+    return true;
+} /* end of Deflate */
+
+/**
+* @brief   : Cut - end the current member, and start the next one indexed by the key
+* @param[I]: key (key of the next member, i.e., "yyyymmddhh" of the first epoch in the hour)
+* @param[I]: fp (file the gzip members are written to)
+* @return  : true: OK, false: zlib failed or the file failed to be written
+* @note    :
+**/
+bool ZipUtil::Cut(const string &key, FILE *fp)
+{
+    if (!_blk.empty() || !_key.empty())
+    {
+        _blks.push_back(string());
+        _blks.back().swap(_blk);
+        _keys.push_back(_key);
+    }
+    _key = key;
+
+    return (int)_blks.size() < _nthread || Flush(fp);
+} /* end of Cut */
+
+/**
+* @brief   : EndDeflate - end the streaming compression
+* @param[I]: fp (file the gzip members are written to)
+* @param[O]: none
+* @return  : true: OK, false: zlib failed or the file failed to be written
+* @note    :
+**/
+bool ZipUtil::EndDeflate(FILE *fp)
+{
+    /* the empty data are written as one empty member */
+    if (!_blk.empty() || !_key.empty() || (_blks.empty() && _nmember == 0))
+    {
+        _blks.push_back(string());
+        _blks.back().swap(_blk);
+        _keys.push_back(_key);
+    }
+    _key.clear();
+
+    return Flush(fp);
+} /* end of EndDeflate */
+
+/**
+* @brief   : ReadIndex - read the keys and the offsets of the members of the indexed gzip file
+* @param[I]: file (indexed gzip file)
+* @param[O]: keys (keys of the indexed members, i.e., "yyyymmddhh")
+* @param[O]: offsets (offsets of the indexed members in the file)
+* @return  : true: OK, false: the file does not exist or is not the indexed gzip file
+* @note    : only the headers of the members are read, and the data from the offset can be inflated
+*            as an ordinary gzip stream
+**/
+bool ZipUtil::ReadIndex(const string &file, vector<string> &keys, vector<long long> &offsets)
+{
+    keys.clear();
+    offsets.clear();
+    FILE *fp = fopen(file.c_str(), "rb");
+    if (!fp) return false;
+
+    /* the members are walked through by their sizes in the extra field */
+    bool ok = true;
+    long long offset = 0;
+    unsigned char p[GZHEADLEN];
+    while (true)
+    {
+        size_t n = fread(p, 1, GZHEADLEN, fp);
+        if (n == 0 && offset > 0) break;
+        if (n < GZHEADLEN || p[0] != 0x1f || p[1] != 0x8b || p[3] != 4 || GetLe(p + 10, 2) != GZXLEN ||
+            p[12] != 'G' || p[13] != 'O')
+        {
+            ok = false;
+            break;
+        }
+        unsigned long len = GetLe(p + 16, 4);
+        string key((const char *)p + 20, ZIP_KEYLEN);
+        if (key[0] != ' ')
+        {
+            keys.push_back(key);
+            offsets.push_back(offset);
+        }
+        offset += (long long)len;
+        if (len < GZHEADLEN || Seek64(fp, offset) != 0)
+        {
+            ok = false;
+            break;
+        }
+    }
+    fclose(fp);
+
+    return ok;
+} /* end of ReadIndex */
+
+/**
+* @brief   : Seek64 - set the position of the file from its beginning
+* @param[I]: fp (file pointer)
+* @param[I]: offset (offset from the beginning of the file)
+* @return  : 0: OK, otherwise: failed
+* @note    : the offset may be beyond 2 GB, where 'long' of fseek is 32 bits on Windows
+**/
+int ZipUtil::Seek64(FILE *fp, long long offset)
+{
+#ifdef _WIN32   /* for Windows */
+    return _fseeki64(fp, (__int64)offset, SEEK_SET);
+#else           /* for Linux or Mac */
+    return fseeko(fp, (off_t)offset, SEEK_SET);
+#endif
+} /* end of Seek64 */
+
@@ -0,0 +1,241 @@
+/*------------------------------------------------------------------------------
+* ZipUtil.h : header file of ZipUtil.cpp
+*-----------------------------------------------------------------------------*/
+#pragma once
+
+/* constants/macros ----------------------------------------------------------*/
+#define ZIP_NONE        -1        /* not compressed */
+#define ZIP_GZIP        0         /* gzip ('*.gz') */
+#define ZIP_LZW         1         /* Unix compress ('*.Z') */
+#define ZIP_KEYLEN      10        /* length of the key of the member of the indexed gzip file, i.e., "yyyymmddhh" */
+
+class CrxUtil;                    /* decoding of Compact RINEX */
+
+class ZipUtil
+{
+private:
+    struct lzw_t
+    {                             /* state of the streaming LZW decoder of Unix compress */
+        int nhead;                /* number of bytes of the header received */
+        int maxbits;              /* maximum code width */
+        bool block;               /* block mode, i.e., code 256 clears the table */
+        int nbits;                /* current code width */
+        long maxcode;             /* the code width is increased when 'freeEnt' exceeds it */
+        long maxmaxcode;          /* number of the codes of 'maxbits' */
+        long freeEnt;             /* next free entry of the table */
+        long oldcode;             /* previous code (-1: none) */
+        int finchar;              /* first character of the previous string */
+        unsigned long bitbuf;     /* bits received but not decoded, LSB first */
+        int nbuf;                 /* number of bits in 'bitbuf' */
+        int ngroup;               /* number of codes read in the current group of eight */
+        long skip;                /* number of padding bits to be skipped */
+        vector<unsigned short> prefix;  /* prefix codes of the table entries */
+        vector<unsigned char> suffix;   /* last characters of the table entries */
+        vector<unsigned char> stack;    /* decoded string in reverse order */
+        vector<unsigned char> out;      /* decoded data to be written */
+    };
+    int _fmt;                     /* format of the stream, ZIP_GZIP or ZIP_LZW */
+    void *_zs;                    /* z_stream of the streaming inflation (nullptr: not started) */
+    bool _end;                    /* the last gzip member in the stream has ended */
+    lzw_t *_lzw;                  /* LZW decoder of the stream (nullptr: not started) */
+    CrxUtil *_crx;                /* the decompressed data are decoded as Compact RINEX (nullptr: written as they are) */
+    int _nthread;                 /* number of threads compressing the members of the indexed gzip file */
+    string _blk;                  /* data of the member being filled */
+    string _key;                  /* key of the member being filled (empty: not indexed) */
+    vector<string> _blks;         /* members filled and waiting to be compressed */
+    vector<string> _keys;         /* keys of '_blks' */
+    long _nmember;                /* number of the members written */
+    string *_mem;                 /* the decompressed data are appended to it instead of the file (nullptr: written to the file) */
+
+    /**
+    * @brief   : Write - write the decompressed data to the file, or decode them as Compact RINEX first
+    * @param[I]: data (decompressed data)
+    * @param[I]: n (number of bytes of 'data')
+    * @param[I]: fp (file the data or the RINEX lines are written to)
+    * @return  : true: OK, false: the file failed to be written or the data are not valid Compact RINEX
+    * @note    :
+    **/
+    bool Write(const void *data, size_t n, FILE *fp);
+
+    /**
+    * @brief   : Unlzw - decode the next piece of the data of Unix compress and write them to the file
+    * @param[I]: data (compressed data)
+    * @param[I]: n (number of bytes of 'data')
+    * @param[I]: fp (file the decompressed data are written to)
+    * @return  : true: OK, false: the data are corrupted or the file failed to be written
+    * @note    : the same as 'uncompress' (ncompress) and 'gzip -d', including the padding to the end of
+    *            the group of eight codes when the code width changes
+    **/
+    bool Unlzw(const unsigned char *data, size_t n, FILE *fp);
+
+    /**
+    * @brief   : Flush - compress the members filled in parallel and write them to the file in order
+    * @param[I]: fp (file the gzip members are written to)
+    * @param[O]: none
+    * @return  : true: OK, false: zlib failed or the file failed to be written
+    * @note    :
+    **/
+    bool Flush(FILE *fp);
+
+public:
+    ZipUtil()
+	{
+        _fmt = ZIP_GZIP;
+        _zs = nullptr;
+        _end = false;
+        _lzw = nullptr;
+        _crx = nullptr;
+        _nthread = 1;
+        _nmember = 0;
+        _mem = nullptr;
+	}
+	~ZipUtil()
+	{
+        EndInflate();
+	}
+
+    /**
+    * @brief   : Format - get the compression format from the suffix of the file name
+    * @param[I]: file (file name or URL)
+    * @param[O]: none
+    * @return  : ZIP_GZIP ('*.gz'), ZIP_LZW ('*.Z') or ZIP_NONE
+    * @note    :
+    **/
+    int Format(const string &file);
+
+    /**
+    * @brief   : SetCrx - set the decoder of Compact RINEX chained after the inflation
+    * @param[I]: crx (decoder of Compact RINEX, nullptr: the decompressed data are written as they are)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the decoding is started by BeginInflate and ended by EndInflate, so only the RINEX file is
+    *            written
+    **/
+    void SetCrx(CrxUtil *crx);
+
+    /**
+    * @brief   : SetOutput - set the memory the decompressed data are appended to
+    * @param[I]: mem (buffer of the decompressed data, nullptr: written to the file)
+    * @param[O]: none
+    * @return  : none
+    * @note    : the file given to Inflate is ignored if it is set, so the data can be read piece by piece
+    *            without being saved
+    **/
+    void SetOutput(string *mem);
+
+    /**
+    * @brief   : BeginInflate - start the streaming inflation
+    * @param[I]: fmt (format of the stream, ZIP_GZIP or ZIP_LZW)
+    * @param[O]: none
+    * @return  : true: OK, false: zlib failed to be initialized or the format is not supported
+    * @note    : the stream started before is discarded
+    **/
+    bool BeginInflate(int fmt = ZIP_GZIP);
+
+    /**
+    * @brief   : Inflate - inflate the next piece of compressed data and write them to the file
+    * @param[I]: data (compressed data)
+    * @param[I]: n (number of bytes of 'data')
+    * @param[I]: fp (file the decompressed data are written to)
+    * @return  : true: OK, false: the data are corrupted or the file failed to be written
+    * @note    : the stream of several gzip members is supported, and the garbage after the last member is
+    *            ignored as 'gzip -d' does
+    **/
+    bool Inflate(const char *data, size_t n, FILE *fp);
+
+    /**
+    * @brief   : EndInflate - end the streaming inflation
+    * @param[I]: fp (file the last RINEX lines are written to if Compact RINEX is decoded, nullptr: none)
+    * @param[O]: none
+    * @return  : true: the stream ends with a complete gzip member or has a valid header of Unix compress,
+    *            and the Compact RINEX ends at the end of an epoch, false: the stream is truncated
+    * @note    : the data of Unix compress have no trailer, so the truncation after the header is not detected
+    **/
+    bool EndInflate(FILE *fp = nullptr);
+
+    /**
+    * @brief   : Expand - decompress the compressed file
+    * @param[I]: inFile (compressed file)
+    * @param[I]: outFile (decompressed file, or RINEX file if the decoder of Compact RINEX is set)
+    * @param[I]: fmt (format of 'inFile', ZIP_GZIP or ZIP_LZW)
+    * @return  : true: OK, false: failed
+    * @note    : it is written to '<outFile>.part' first, which is renamed to 'outFile' only if it succeeds
+    **/
+    bool Expand(const string &inFile, const string &outFile, int fmt);
+
+    /**
+    * @brief   : Decompress - decompress the '*.gz' or '*.Z' file to the file without the suffix, and remove
+    *            the compressed file as 'gzip -d -f' does
+    * @param[I]: file (compressed file)
+    * @return  : true: OK, false: the file does not exist, is not compressed, or fails to be decompressed
+    * @note    : both formats are decompressed in process
+    **/
+    bool Decompress(const string &file);
+
+    /**
+    * @brief   : SetThreads - set the number of threads compressing the members of the indexed gzip file
+    * @param[I]: nthread (number of threads, < 1: one)
+    * @param[O]: none
+    * @return  : none
+    * @note    :
+    **/
+    void SetThreads(int nthread);
+
+    /**
+    * @brief   : BeginDeflate - start the streaming compression of the indexed gzip file
+    * @param[I]: none
+    * @param[O]: none
+    * @return  : none
+    * @note    : the data written before the first Cut are in the member without the key, i.e., the header
+    *            of RINEX
+    **/
+    void BeginDeflate();
+
+    /**
+    * @brief   : Deflate - compress the next piece of data and write them to the file
+    * @param[I]: data (data to be compressed)
+    * @param[I]: n (number of bytes of 'data')
+    * @param[I]: fp (file the gzip members are written to)
+    * @return  : true: OK, false: zlib failed or the file failed to be written
+    * @note    : the data are compressed when the members for all the threads are filled
+    **/
+    bool Deflate(const char *data, size_t n, FILE *fp);
+
+    /**
+    * @brief   : Cut - end the current member, and start the next one indexed by the key
+    * @param[I]: key (key of the next member, i.e., "yyyymmddhh" of the first epoch in the hour)
+    * @param[I]: fp (file the gzip members are written to)
+    * @return  : true: OK, false: zlib failed or the file failed to be written
+    * @note    :
+    **/
+    bool Cut(const string &key, FILE *fp);
+
+    /**
+    * @brief   : EndDeflate - end the streaming compression
+    * @param[I]: fp (file the gzip members are written to)
+    * @param[O]: none
+    * @return  : true: OK, false: zlib failed or the file failed to be written
+    * @note    :
+    **/
+    bool EndDeflate(FILE *fp);
+
+    /**
+    * @brief   : ReadIndex - read the keys and the offsets of the members of the indexed gzip file
+    * @param[I]: file (indexed gzip file)
+    * @param[O]: keys (keys of the indexed members, i.e., "yyyymmddhh")
+    * @param[O]: offsets (offsets of the indexed members in the file)
+    * @return  : true: OK, false: the file does not exist or is not the indexed gzip file
+    * @note    : only the headers of the members are read, and the data from the offset can be inflated
+    *            as an ordinary gzip stream
+    **/
+    bool ReadIndex(const string &file, vector<string> &keys, vector<long long> &offsets);
+
+    /**
+    * @brief   : Seek64 - set the position of the file from its beginning
+    * @param[I]: fp (file pointer)
+    * @param[I]: offset (offset from the beginning of the file)
+    * @return  : 0: OK, otherwise: failed
+    * @note    : the offset may be beyond 2 GB, where 'long' of fseek is 32 bits on Windows
+    **/
+    static int Seek64(FILE *fp, long long offset);
+};
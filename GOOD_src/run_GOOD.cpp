@@ -52,8 +52,15 @@ int main(int argc, char * argv[])
     _setmaxstdio(8192);   /* to open many files */
 #endif
 
+    /* 'run_GOOD  gamp_good.cfg  --dry-run' only plans the downloads, and prints the number of files and bytes */
+    bool dryRun = false;
+    for (int i = 2; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--dry-run") == 0) dryRun = true;
+    }
+
     PreProcess preProc;
-    preProc.run(cfgFile);
+    preProc.run(cfgFile, dryRun);
 
 #ifdef _WIN32  /* for Windows */
     /*cout << "Press any key to exit!" << endl;
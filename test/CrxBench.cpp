@@ -0,0 +1,221 @@
+/*------------------------------------------------------------------------------
+* CrxBench.cpp : benchmark of the Compact RINEX decoder
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) Group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader)
+*
+* References:
+*    [1] Y. Hatanaka, A compression format and tools for GNSS observation data, Bulletin of the
+*        Geographical Survey Institute, 55, 21-30, 2008
+*
+* usage   : CrxBench  workDir  [nepoch]  [nrun]
+*           the RINEX 2 and RINEX 3 observation files of 'nepoch' epochs (default: 20000) are generated in
+*           'workDir', converted to Compact RINEX by Rnx2Crx, and decoded in memory 'nrun' times (default: 5)
+*           64 KB at a time, as they are received by the downloads; the best throughput of the RINEX output
+*           is printed for each file
+*
+* history : 2026/10/16 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "Good.h"
+#include "ZipUtil.h"
+#include "CrxUtil.h"
+
+
+/* constants/macros ----------------------------------------------------------*/
+#define BENCHCHUNK      65536     /* bytes of Compact RINEX decoded at a time */
+#define BENCHPI         3.14159265358979323846  /* pi */
+
+
+/* get the next pseudo-random number in [0, 1) of the generator with the fixed seed */
+static double Random(unsigned long long &seed)
+{
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+    return (double)(seed >> 11) / 9007199254740992.0;
+}
+
+/* write the header line of RINEX, the label starting at column 61 */
+static void PutHeader(FILE *fp, const char *text, const char *label)
+{
+    fprintf(fp, "%-60.60s%-20s\n", text, label);
+}
+
+/* write one observation of F14.3 with the blank LLI and the signal strength, or the blank field */
+static void PutObs(FILE *fp, double v, bool blank)
+{
+    if (blank) fprintf(fp, "                ");
+    else fprintf(fp, "%14.3f %d", v, (int)(fmod(fabs(v), 7.0)) + 3);
+}
+
+/* generate the observation file of RINEX 2 or 3 with smooth pseudoranges and phases of 'nsat' satellites */
+static bool Generate(const string &file, int ver, int nepoch)
+{
+    FILE *fp = fopen(file.c_str(), "w");
+    if (!fp) return false;
+
+    const char *sys = ver == 2 ? "GR" : "GREC";
+    const int nsat = 40;
+    int ntype[4] = { 9, 9, 9, 9 };
+    if (ver == 3)
+    {
+        ntype[0] = 12;  /* GPS: L1C/L2W/L5Q */
+        ntype[1] = 8;   /* GLONASS: L1C/L2P */
+        ntype[2] = 12;  /* Galileo: E1/E5a/E5b */
+        ntype[3] = 8;   /* BDS: B1I/B3I */
+    }
+
+    char line[128];
+    sprintf(line, "%9.2f%-11s%-20s%-20s", ver == 2 ? 2.11 : 3.04, "", "OBSERVATION DATA", "M");
+    PutHeader(fp, line, "RINEX VERSION / TYPE");
+    PutHeader(fp, "CrxBench            GAMP II - GOOD      20200101 000000 UTC", "PGM / RUN BY / DATE");
+    PutHeader(fp, "BENC", "MARKER NAME");
+    PutHeader(fp, "  -2148744.3520  4426641.2050  4044655.8570", "APPROX POSITION XYZ");
+    PutHeader(fp, "        0.0830        0.0000        0.0000", "ANTENNA: DELTA H/E/N");
+    if (ver == 2)
+    {
+        PutHeader(fp, "     9    C1    L1    D1    S1    P2    L2    D2    S2    C5", "# / TYPES OF OBSERV");
+    }
+    else
+    {
+        PutHeader(fp, "G   12 C1C L1C D1C S1C C2W L2W D2W S2W C5Q L5Q D5Q S5Q", "SYS / # / OBS TYPES");
+        PutHeader(fp, "R    8 C1C L1C D1C S1C C2P L2P D2P S2P", "SYS / # / OBS TYPES");
+        PutHeader(fp, "E   12 C1C L1C D1C S1C C5Q L5Q D5Q S5Q C7Q L7Q D7Q S7Q", "SYS / # / OBS TYPES");
+        PutHeader(fp, "C    8 C2I L2I D2I S2I C6I L6I D6I S6I", "SYS / # / OBS TYPES");
+    }
+    PutHeader(fp, "    30.000", "INTERVAL");
+    PutHeader(fp, "  2020     1     1     0     0    0.0000000     GPS", "TIME OF FIRST OBS");
+    PutHeader(fp, "", "END OF HEADER");
+
+    /* the satellites of the systems, whose ranges vary by the revolution of half a sidereal day */
+    unsigned long long seed = 20200101ULL + ver;
+    int nsys = (int)strlen(sys);
+    vector<int> isys(nsat), prn(nsat);
+    vector<double> r0(nsat), amp(nsat), ph(nsat);
+    const double w = 2.0 * BENCHPI / 43082.0;
+    for (int i = 0; i < nsat; i++)
+    {
+        isys[i] = i % nsys;
+        prn[i] = i / nsys + 1;
+        r0[i] = 2.2E7 + 1.0E6 * Random(seed);
+        amp[i] = 2.0E6 + 1.0E6 * Random(seed);
+        ph[i] = 2.0 * BENCHPI * Random(seed);
+    }
+
+    for (int e = 0; e < nepoch; e++)
+    {
+        double t = 30.0 * e;
+        int sec = (int)t % 86400, hh = sec / 3600, mm = sec / 60 % 60, ss = sec % 60, dd = 1 + (int)t / 86400;
+
+        /* about a quarter of the satellites are set at a time */
+        vector<int> vis;
+        for (int i = 0; i < nsat; i++) if ((e / 240 + i) % 4 != 0) vis.push_back(i);
+        if (ver == 2)
+        {
+            fprintf(fp, " 20  1 %2d %2d %2d %10.7f  0%3d", dd, hh, mm, (double)ss, (int)vis.size());
+            for (size_t k = 0; k < vis.size(); k++)
+            {
+                if (k > 0 && k % 12 == 0) fprintf(fp, "\n%32s", "");
+                fprintf(fp, "%c%02d", sys[isys[vis[k]]], prn[vis[k]]);
+            }
+            fprintf(fp, "\n");
+        }
+        else fprintf(fp, "> 2020 01 %02d %02d %02d %10.7f  0%3d\n", dd, hh, mm, (double)ss, (int)vis.size());
+
+        for (size_t k = 0; k < vis.size(); k++)
+        {
+            int i = vis[k], n = ntype[isys[i]];
+            double r = r0[i] + amp[i] * sin(w * t + ph[i]), dr = amp[i] * w * cos(w * t + ph[i]);
+            if (ver == 3) fprintf(fp, "%c%02d", sys[isys[i]], prn[i]);
+            for (int j = 0; j < n; j++)
+            {
+                double v;
+                int f = j / 4, kind = j % 4;
+                if (kind == 0) v = r + 1.5 * f + 0.8 * Random(seed) - 0.4;
+                else if (kind == 1) v = r / (0.19 + 0.05 * f) + 0.008 * Random(seed) - 0.004;
+                else if (kind == 2) v = -dr / (0.19 + 0.05 * f) + 0.4 * Random(seed) - 0.2;
+                else v = floor(35.0 + 15.0 * sin(t / 3600.0 + i) + 2.0 * Random(seed)) + 0.25 * f;
+                PutObs(fp, v, ver == 2 && isys[i] == 1 && j == 8);
+                if (ver == 2 && j % 5 == 4 && j + 1 < n) fprintf(fp, "\n");
+            }
+            fprintf(fp, "\n");
+        }
+    }
+
+    return fclose(fp) == 0;
+}
+
+/* decode the Compact RINEX data in memory 'nrun' times, and get the best time (s) */
+static double Decode(const string &crx, int nrun, size_t *nout)
+{
+    double best = -1.0;
+    string mem;
+    for (int r = 0; r < nrun; r++)
+    {
+        mem.clear();
+        CrxUtil dec;
+        dec.SetOutput(&mem);
+        auto t0 = std::chrono::steady_clock::now();
+        dec.BeginDecode();
+        bool ok = true;
+        for (size_t i = 0; ok && i < crx.size(); i += BENCHCHUNK)
+        {
+            ok = dec.Decode(crx.data() + i, std::min((size_t)BENCHCHUNK, crx.size() - i), nullptr);
+        }
+        if (ok) ok = dec.EndDecode(nullptr);
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        if (!ok) return -1.0;
+        if (best < 0.0 || secs < best) best = secs;
+    }
+    *nout = mem.size();
+
+    return best;
+}
+
+
+/* CrxBench main -------------------------------------------------------------*/
+int main(int argc, char * argv[])
+{
+    if (argc < 2)
+    {
+        cerr << "*** ERROR(CrxBench): usage: CrxBench  workDir  [nepoch]  [nrun]" << endl;
+
+        return 1;
+    }
+    string workDir = argv[1];
+    int nepoch = argc > 2 ? atoi(argv[2]) : 20000;
+    int nrun = argc > 3 ? atoi(argv[3]) : 5;
+    if (nepoch < 1) nepoch = 1;
+    if (nrun < 1) nrun = 1;
+
+    const char *names[2] = { "bench0010.20o", "BENC00XXX_R_20200010000_01D_30S_MO.rnx" };
+    const char *crxNames[2] = { "bench0010.20d", "BENC00XXX_R_20200010000_01D_30S_MO.crx" };
+    for (int k = 0; k < 2; k++)
+    {
+        string rnxFile = workDir + (char)FILEPATHSEP + names[k];
+        string crxFile = workDir + (char)FILEPATHSEP + crxNames[k];
+        CrxUtil crx;
+        if (!Generate(rnxFile, k == 0 ? 2 : 3, nepoch) || !crx.Rnx2Crx(rnxFile, crxFile))
+        {
+            cerr << "*** ERROR(CrxBench): generate " << crxFile << " failed, please check it" << endl;
+
+            return 1;
+        }
+
+        ifstream crxLst(crxFile.c_str(), std::ios::binary);
+        string data((std::istreambuf_iterator<char>(crxLst)), std::istreambuf_iterator<char>());
+        size_t nout = 0;
+        double secs = Decode(data, nrun, &nout);
+        remove(rnxFile.c_str());
+        remove(crxFile.c_str());
+        if (secs <= 0.0)
+        {
+            cerr << "*** ERROR(CrxBench): decode " << crxFile << " failed" << endl;
+
+            return 1;
+        }
+        cout << "*** INFO(CrxBench): RINEX " << (k == 0 ? 2 : 3) << ", " << fixed << setprecision(1) <<
+            nout / 1.0E6 << " MB decoded, best of " << nrun << ": " << nout / 1.0E6 / secs << " MB/s" << endl;
+    }
+
+    return 0;
+}
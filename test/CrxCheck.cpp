@@ -0,0 +1,82 @@
+/*------------------------------------------------------------------------------
+* CrxCheck.cpp : decode the Compact RINEX file for the check of the decoder
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) Group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader)
+*
+* References:
+*    [1] Y. Hatanaka, A compression format and tools for GNSS observation data, Bulletin of the
+*        Geographical Survey Institute, 55, 21-30, 2008
+*
+* usage   : CrxCheck  crxFile  rnxFile  [chunk]
+*           CrxCheck  -r  rnxFile  outFile  [chunk]
+*           the data of 'crxFile' are decoded 'chunk' bytes at a time (default: 65536), as they are received
+*           by the downloads, and written to 'rnxFile', which 'make check' compares with the expected RINEX
+*           file of test/crx; the expected files are the output of crx2rnx (thirdParty) for the same input;
+*           with '-r', 'rnxFile' is converted to '<outFile>.crx' by Rnx2Crx first, and the round trip is
+*           decoded to 'outFile' in the same way, which 'make check' compares with 'rnxFile'
+*
+* history : 2026/10/16 1.0  new
+*           2026/10/16 1.1  the round trip of Rnx2Crx and the decoder
+*-----------------------------------------------------------------------------*/
+#include "Good.h"
+#include "ZipUtil.h"
+#include "CrxUtil.h"
+
+
+/* CrxCheck main -------------------------------------------------------------*/
+int main(int argc, char * argv[])
+{
+    bool roundTrip = argc > 1 && strcmp(argv[1], "-r") == 0;
+    if (roundTrip)
+    {
+        argc--;
+        argv++;
+    }
+    if (argc < 3)
+    {
+        cerr << "*** ERROR(CrxCheck): usage: CrxCheck  [-r]  crxFile  rnxFile  [chunk]" << endl;
+
+        return 1;
+    }
+    size_t chunk = argc > 3 ? (size_t)atoi(argv[3]) : 65536;
+    if (chunk < 1) chunk = 1;
+
+    CrxUtil crx;
+    string crxFile = argv[1];
+    if (roundTrip)
+    {
+        /* the RINEX file is compacted first, and the output should restore it */
+        crxFile = string(argv[2]) + ".crx";
+        if (!crx.Rnx2Crx(argv[1], crxFile))
+        {
+            cerr << "*** ERROR(CrxCheck): convert " << argv[1] << " failed" << endl;
+
+            return 1;
+        }
+    }
+
+    FILE *fin = fopen(crxFile.c_str(), "rb");
+    FILE *fout = fopen(argv[2], "wb");
+    if (!fin || !fout)
+    {
+        cerr << "*** ERROR(CrxCheck): open file " << (fin ? argv[2] : crxFile) << " failed, please check it" << endl;
+        if (fin) fclose(fin);
+        if (fout) fclose(fout);
+
+        return 1;
+    }
+
+    crx.BeginDecode();
+    bool ok = true;
+    vector<char> buf(chunk);
+    size_t n;
+    while (ok && (n = fread(buf.data(), 1, chunk, fin)) > 0) ok = crx.Decode(buf.data(), n, fout);
+    if (ok) ok = crx.EndDecode(fout);
+    fclose(fin);
+    if (fclose(fout) != 0) ok = false;
+    if (roundTrip) remove(crxFile.c_str());
+    if (!ok) cerr << "*** ERROR(CrxCheck): decode " << crxFile << " failed" << endl;
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,57 @@
+/*------------------------------------------------------------------------------
+* ZipCheck.cpp : decompress the file of Unix compress for the check of the LZW decoder
+*
+* Copyright (C) 2020-2099 by SpAtial SurveyIng and Navigation (SASIN) Group, all rights reserved.
+*    This file is part of GAMP II - GOOD (Gnss Observations and prOducts Downloader)
+*
+* References:
+*    [1] T. A. Welch, A technique for high-performance data compression, Computer, 17(6), 8-19, 1984
+*
+* usage   : ZipCheck  zFile  outFile  [chunk]
+*           the data of 'zFile' are inflated 'chunk' bytes at a time (default: 65536), as they are received
+*           by the downloads, and written to 'outFile', which 'make check' compares with the expected file
+*           of test/lzw; the '*.Z' file there is compressed with 10-bit codes at most ('compress -b 10'),
+*           so the table is filled and cleared, and the codes after the clear are padded to the end of
+*           their group of eight
+*
+* history : 2026/10/16 1.0  new
+*-----------------------------------------------------------------------------*/
+#include "Good.h"
+#include "ZipUtil.h"
+
+
+/* ZipCheck main -------------------------------------------------------------*/
+int main(int argc, char * argv[])
+{
+    if (argc < 3)
+    {
+        cerr << "*** ERROR(ZipCheck): usage: ZipCheck  zFile  outFile  [chunk]" << endl;
+
+        return 1;
+    }
+    size_t chunk = argc > 3 ? (size_t)atoi(argv[3]) : 65536;
+    if (chunk < 1) chunk = 1;
+
+    FILE *fin = fopen(argv[1], "rb");
+    FILE *fout = fopen(argv[2], "wb");
+    if (!fin || !fout)
+    {
+        cerr << "*** ERROR(ZipCheck): open file " << (fin ? argv[2] : argv[1]) << " failed, please check it" << endl;
+        if (fin) fclose(fin);
+        if (fout) fclose(fout);
+
+        return 1;
+    }
+
+    ZipUtil zip;
+    bool ok = zip.BeginInflate(zip.Format(argv[1]));
+    vector<char> buf(chunk);
+    size_t n;
+    while (ok && (n = fread(buf.data(), 1, chunk, fin)) > 0) ok = zip.Inflate(buf.data(), n, fout);
+    if (ok) ok = zip.EndInflate(fout);
+    fclose(fin);
+    if (fclose(fout) != 0) ok = false;
+    if (!ok) cerr << "*** ERROR(ZipCheck): inflate " << argv[1] << " failed" << endl;
+
+    return ok ? 0 : 1;
+}